@@ -33,8 +33,15 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/GarbageCollection.h"
 #include "Exporters/BP2AIBatchExporter.h"
+#include "Extractors/BlueprintExtractionCache.h"
+#include "Extractors/BlueprintGraphPathCache.h"
+#include "Trace/ResolvedPinValueCache.h"
+#include "Exporters/BP2AIExportPipeline.h"
+#include "Exporters/BP2AIExportManifest.h"
+#include "Exporters/BP2AIDocumentWriter.h"
 #include "Misc/Paths.h"
 #include "Settings/BP2AIExportConfig.h"
+#include "Logging/BP2AIScopedLogSilencer.h"
 
 
 
@@ -46,6 +53,17 @@ void FBP2AIModule::StartupModule()
 {
     
     UE_LOG(LogBP2AI, Log, TEXT("BP2AI: StartupModule() Begin."));
+
+    // 跨追踪的引脚值缓存在编辑器界面和命令行导出中都使用，需要先注册编辑通知
+    FResolvedPinValueCache::Get().Initialize();
+
+    // 命令行导出（-run=BP2AIExport）不需要样式、命令和菜单
+    if (IsRunningCommandlet())
+    {
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Running as commandlet, skipping UI registration."));
+        return;
+    }
+
     FBP2AIStyle::Initialize();
     FBP2AIStyle::ReloadTextures();
     FBP2AICommands::Register();
@@ -66,6 +84,19 @@ void FBP2AIModule::ShutdownModule()
 {
     UE_LOG(LogBP2AI, Log, TEXT("BP2AI: ShutdownModule() Begin."));
 
+    // 缓存条目向图表和蓝图注册了裸指针委托，模块卸载前必须注销
+    if (UObjectInitialized())
+    {
+        FBlueprintExtractionCache::Get().Reset();
+    }
+    FBlueprintGraphPathCache::Get().Reset();
+    FResolvedPinValueCache::Get().Shutdown();
+
+    if (IsRunningCommandlet())
+    {
+        return;
+    }
+
     if (UObjectInitialized()) 
     {
         UToolMenus::UnRegisterStartupCallback(this); 
@@ -117,59 +148,6 @@ void FBP2AIModule::GenerateExecFlowAction()
     else FSlateApplication::Get().AddWindow(ExecFlowPluginWindow.ToSharedRef());
 }
 
-namespace
-{
-    /**
-     * RAII helper to silence internal log categories during batch operations.
-     * Restores original verbosity on destruction.
-     */
-    struct FScopedLogSilencer
-    {
-        FScopedLogSilencer()
-        {
-            bShouldSilence = BP2AIExportConfig::bSilenceInternalCategoriesDuringBatchExport;
-            if (bShouldSilence)
-            {
-                OriginalDataTracer = LogDataTracer.GetVerbosity();
-                OriginalPathTracer = LogPathTracer.GetVerbosity();
-                OriginalFormatter = LogFormatter.GetVerbosity();
-                OriginalExtractor = LogExtractor.GetVerbosity();
-                OriginalNodeFactory = LogBlueprintNodeFactory.GetVerbosity();
-                OriginalModels = LogModels.GetVerbosity();
-
-                LogDataTracer.SetVerbosity(ELogVerbosity::NoLogging);
-                LogPathTracer.SetVerbosity(ELogVerbosity::NoLogging);
-                LogFormatter.SetVerbosity(ELogVerbosity::NoLogging);
-                LogExtractor.SetVerbosity(ELogVerbosity::NoLogging);
-                LogBlueprintNodeFactory.SetVerbosity(ELogVerbosity::NoLogging);
-                LogModels.SetVerbosity(ELogVerbosity::NoLogging);
-            }
-        }
-
-        ~FScopedLogSilencer()
-        {
-            if (bShouldSilence)
-            {
-                LogDataTracer.SetVerbosity(OriginalDataTracer);
-                LogPathTracer.SetVerbosity(OriginalPathTracer);
-                LogFormatter.SetVerbosity(OriginalFormatter);
-                LogExtractor.SetVerbosity(OriginalExtractor);
-                LogBlueprintNodeFactory.SetVerbosity(OriginalNodeFactory);
-                LogModels.SetVerbosity(OriginalModels);
-            }
-        }
-
-    private:
-        bool bShouldSilence;
-        ELogVerbosity::Type OriginalDataTracer;
-        ELogVerbosity::Type OriginalPathTracer;
-        ELogVerbosity::Type OriginalFormatter;
-        ELogVerbosity::Type OriginalExtractor;
-        ELogVerbosity::Type OriginalNodeFactory;
-        ELogVerbosity::Type OriginalModels;
-    };
-}
-
 void FBP2AIModule::HandleFolderExport(const TArray<FString>& SelectedPaths) const
 {
     if (SelectedPaths.Num() == 0)
@@ -199,6 +177,7 @@ void FBP2AIModule::HandleFolderExport(const TArray<FString>& SelectedPaths) cons
 
     TArray<FAssetData> BlueprintAssets;
     AssetRegistry.GetAssets(Filter, BlueprintAssets);
+    BlueprintAssets.RemoveAll([this](const FAssetData& AssetData) { return !CanExportBlueprintAsset(AssetData); });
 
     if (BlueprintAssets.Num() == 0)
     {
@@ -207,75 +186,88 @@ void FBP2AIModule::HandleFolderExport(const TArray<FString>& SelectedPaths) cons
     }
 
     const int32 TotalAssets = BlueprintAssets.Num();
-    int32 SuccessCount = 0;
-    int32 FailureCount = 0;
-    int32 ProcessedSinceGc = 0;
-    const int32 GcInterval = 20; // Adjusted to 20 as requested
+
+    // 增量导出：只根据资产注册表判断哪些蓝图需要重新导出（不加载资产）
+    const uint32 SettingsHash = FBP2AIBatchExporter::GetExportSettingsHash(true);
+    FBP2AIExportManifest Manifest;
+    Manifest.Load(FBP2AIExportManifest::GetDefaultManifestPath());
+
+    TMap<FName, FBP2AIExportManifestEntry> PendingEntries = Manifest.CollectPendingEntries(AssetRegistry, BlueprintAssets, SettingsHash);
+
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Incremental export -> %d of %d blueprint(s) changed."), PendingEntries.Num(), TotalAssets);
+    if (PendingEntries.Num() == 0)
+    {
+        return;
+    }
 
     // 创建进度条对话框
     FScopedSlowTask Progress(TotalAssets, LOCTEXT("BP2AIExportProgress", "Exporting Blueprints..."));
     Progress.MakeDialog(true); // true = 允许取消
 
-    for (int32 Index = 0; Index < TotalAssets; ++Index)
+    FBP2AIExportPipelineOptions PipelineOptions;
+    PipelineOptions.MaxInFlight = BP2AIExportConfig::PipelineMaxInFlight;
+    PipelineOptions.GcMemoryBudgetMB = BP2AIExportConfig::PipelineGcMemoryBudgetMB;
+    PipelineOptions.bParallel = BP2AIExportConfig::bParallelFolderExport;
+    PipelineOptions.PrefetchWindow = BP2AIExportConfig::PipelinePrefetchWindow;
+    PipelineOptions.PrefetchMemoryBudgetMB = BP2AIExportConfig::PipelinePrefetchMemoryBudgetMB;
+    PipelineOptions.bIncludeNestedFunctions = true;
+    PipelineOptions.ShouldExportAsset = [&PendingEntries](const FAssetData& AssetData)
+    {
+        return PendingEntries.Contains(AssetData.PackageName);
+    };
+    PipelineOptions.GetRecordedContentHash = [&Manifest](const FAssetData& AssetData)
+    {
+        const FBP2AIExportManifestEntry* PreviousEntry = Manifest.FindEntry(AssetData.PackageName);
+        return PreviousEntry ? PreviousEntry->ContentHash : 0;
+    };
+    PipelineOptions.OnAssetExported = [&PendingEntries, &Manifest](const FAssetData& AssetData, const FString& TargetFilePath, uint64 ContentHash)
+    {
+        if (FBP2AIExportManifestEntry* Entry = PendingEntries.Find(AssetData.PackageName))
+        {
+            Entry->OutputPath = TargetFilePath;
+            Entry->ContentHash = ContentHash;
+            Manifest.UpdateEntry(AssetData.PackageName, *Entry);
+        }
+    };
+    PipelineOptions.ResolveOutputPath = [this](const FAssetData& AssetData, const FString& BlueprintName)
+    {
+        return BuildExportFilePath(AssetData.PackagePath.ToString(), BlueprintName);
+    };
+    PipelineOptions.OnAssetStarted = [&Progress, &PendingEntries](int32 Index, int32 Total, const FAssetData& AssetData)
     {
         // 检查用户是否取消
         if (Progress.ShouldCancel())
         {
-            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Export cancelled by user. Processed: %d/%d"), SuccessCount + FailureCount, TotalAssets);
-            break;
+            return false;
         }
 
-        const FAssetData& AssetData = BlueprintAssets[Index];
-        if (!CanExportBlueprintAsset(AssetData))
+        if (!PendingEntries.Contains(AssetData.PackageName))
         {
             Progress.EnterProgressFrame(1.0f);
-            continue;
+            return true;
         }
 
         // 更新进度条显示当前资产路径
-        const FString AssetFullPath = AssetData.GetObjectPathString();
         Progress.EnterProgressFrame(1.0f, FText::Format(
             LOCTEXT("ExportingAsset", "[{0}/{1}] {2}"),
             FText::AsNumber(Index + 1),
-            FText::AsNumber(TotalAssets),
-            FText::FromString(AssetFullPath)
+            FText::AsNumber(Total),
+            FText::FromString(AssetData.GetObjectPathString())
         ));
+        return true;
+    };
 
-        UObject* LoadedObject = AssetData.GetAsset();
-        UBlueprint* Blueprint = Cast<UBlueprint>(LoadedObject);
-        if (!Blueprint)
-        {
-            ++FailureCount;
-            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to load blueprint asset '%s'."), *AssetData.AssetName.ToString());
-            continue;
-        }
-
-        const FCompleteBlueprintData CompleteData = FBP2AIBatchExporter::ExportCompleteBlueprint(Blueprint, true);
-        const FString TargetFilePath = BuildExportFilePath(AssetData.PackagePath.ToString(), CompleteData.BlueprintName);
+    FBP2AIExportPipeline Pipeline(PipelineOptions);
+    const FBP2AIExportPipelineSummary Summary = Pipeline.Run(BlueprintAssets);
 
-        const bool bSaved = FBP2AIBatchExporter::WriteCompleteBlueprintMarkdown(CompleteData, TargetFilePath, true);
-        const int32 ProgressIndex = SuccessCount + FailureCount + 1;
+    // 取消时已提交的条目同样有效
+    Manifest.Save();
 
-        if (bSaved)
-        {
-            ++SuccessCount;
-            UE_LOG(LogBP2AI, Log, TEXT("BP2AI: [%d/%d] %s"), ProgressIndex, TotalAssets, *AssetFullPath);
-        }
-        else
-        {
-            ++FailureCount;
-            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: [%d/%d] %s (Failed to save)"), ProgressIndex, TotalAssets, *AssetFullPath);
-        }
-
-        ++ProcessedSinceGc;
-        if (ProcessedSinceGc >= GcInterval)
-        {
-            ProcessedSinceGc = 0;
-            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
-        }
-    }
-
-    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Folder export summary -> Success: %d | Failed: %d | Total: %d"), SuccessCount, FailureCount, TotalAssets);
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Folder export summary -> Success: %d | Failed: %d | Unchanged: %d | Total: %d"), Summary.SuccessCount, Summary.FailureCount, Summary.SkippedCount, TotalAssets);
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Folder export files -> Written: %d (%.1f MB) | Identical content: %d | Write failures: %d"),
+        Summary.SuccessCount - Summary.UnchangedFileCount, Summary.BytesWritten / (1024.0 * 1024.0), Summary.UnchangedFileCount, Summary.WriteFailureCount);
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Folder export memory -> Peak: %.1f MB | Average: %.1f MB | GC: %d | Unloaded packages: %d"),
+        Summary.PeakWorkingSetBytes / (1024.0 * 1024.0), Summary.AverageWorkingSetBytes / (1024.0 * 1024.0), Summary.GcCount, Summary.UnloadedPackageCount);
 }
 
 TSharedRef<SWidget> FBP2AIModule::CreateBlueprintExecFlowWindow()
@@ -455,13 +447,27 @@ void FBP2AIModule::HandleSingleAssetExport(const FAssetData& AssetData) const
     const FCompleteBlueprintData CompleteData = FBP2AIBatchExporter::ExportCompleteBlueprint(Blueprint, true);
     const FString TargetFilePath = BuildExportFilePath(AssetData.PackagePath.ToString(), CompleteData.BlueprintName);
 
-    if (!FBP2AIBatchExporter::WriteCompleteBlueprintMarkdown(CompleteData, TargetFilePath, true))
+    FBP2AIExportManifest Manifest;
+    Manifest.Load(FBP2AIExportManifest::GetDefaultManifestPath());
+    const FBP2AIExportManifestEntry* PreviousEntry = Manifest.FindEntry(AssetData.PackageName);
+
+    const FBP2AIDocumentWriteResult WriteResult = FBP2AIBatchExporter::WriteCompleteBlueprintDocument(CompleteData, TargetFilePath, PreviousEntry ? PreviousEntry->ContentHash : 0);
+    if (!WriteResult.IsSuccess())
     {
         UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to save blueprint export to '%s'."), *TargetFilePath);
         return;
     }
 
-    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Export complete -> %s"), *TargetFilePath);
+    // 同步增量导出清单，下次文件夹导出可跳过该蓝图
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    FBP2AIExportManifestEntry Entry = FBP2AIExportManifest::BuildCurrentEntry(AssetRegistry, AssetData, FBP2AIBatchExporter::GetExportSettingsHash(true));
+    Entry.OutputPath = TargetFilePath;
+    Entry.ContentHash = WriteResult.ContentHash;
+    Manifest.UpdateEntry(AssetData.PackageName, Entry);
+    Manifest.Save();
+
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Export complete -> %s%s"), *TargetFilePath,
+        WriteResult.Status == EBP2AIDocumentWriteStatus::Unchanged ? TEXT(" (unchanged)") : TEXT(""));
 }
 
 
@@ -469,23 +475,7 @@ void FBP2AIModule::HandleSingleAssetExport(const FAssetData& AssetData) const
 
 FString FBP2AIModule::BuildExportFilePath(const FString& PackagePath, const FString& BlueprintName) const
 {
-    const FString BaseDir = FPaths::ProjectSavedDir() / TEXT("BP2AI/Exports");
-
-    FString RelativePath = PackagePath;
-    const FString GameRoot = TEXT("/Game");
-    if (RelativePath.StartsWith(GameRoot))
-    {
-        RelativePath = RelativePath.Mid(GameRoot.Len());
-    }
-    RelativePath.RemoveFromStart(TEXT("/"));
-
-    FString OutputDir = BaseDir;
-    if (!RelativePath.IsEmpty())
-    {
-        OutputDir = FPaths::Combine(BaseDir, RelativePath);
-    }
-
-    return FPaths::Combine(OutputDir, BlueprintName + TEXT(".md"));
+    return FBP2AIBatchExporter::BuildExportFilePath(FBP2AIBatchExporter::GetDefaultExportDir(), PackagePath, BlueprintName);
 }
 /* --- COMMENTED OUT LEGACY IMPLEMENTATION ---
 void FBP2AIModule::OnPluginWindowClosed(const TSharedRef<SWindow>& Window)
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Commandlets/BP2AIExportCommandlet.cpp
+
+#include "Commandlets/BP2AIExportCommandlet.h"
+#include "Logging/BP2AILog.h"
+#include "Logging/BP2AIScopedLogSilencer.h"
+#include "Exporters/BP2AIBatchExporter.h"
+#include "Exporters/BP2AIExportManifest.h"
+#include "Exporters/BP2AIExportPipeline.h"
+#include "Exporters/BP2AIExportShards.h"
+#include "Settings/BP2AIExportConfig.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+UBP2AIExportCommandlet::UBP2AIExportCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = true;
+}
+
+int32 UBP2AIExportCommandlet::Main(const FString& Params)
+{
+    // ---- 解析参数 ----
+    TArray<FString> PackagePaths;
+    FString PathsValue;
+    if (FParse::Value(*Params, TEXT("Paths="), PathsValue, false))
+    {
+        PathsValue.ParseIntoArray(PackagePaths, TEXT(","), true);
+        for (FString& Path : PackagePaths)
+        {
+            Path.TrimStartAndEndInline();
+            Path.RemoveFromEnd(TEXT("/"));
+        }
+    }
+    if (PackagePaths.Num() == 0)
+    {
+        PackagePaths.Add(TEXT("/Game"));
+    }
+
+    FString OutputDir = FBP2AIBatchExporter::GetDefaultExportDir();
+    FParse::Value(*Params, TEXT("Output="), OutputDir);
+    OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+
+    // 只限制同时在途的蓝图数；工作线程数由引擎的任务调度器决定
+    int32 MaxInFlight = BP2AIExportConfig::PipelineMaxInFlight;
+    FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+
+    int32 GcInterval = 0;
+    FParse::Value(*Params, TEXT("GcInterval="), GcInterval);
+
+    int32 GcBudgetMB = BP2AIExportConfig::PipelineGcMemoryBudgetMB;
+    FParse::Value(*Params, TEXT("GcBudgetMB="), GcBudgetMB);
+
+    int32 PrefetchWindow = BP2AIExportConfig::PipelinePrefetchWindow;
+    FParse::Value(*Params, TEXT("Prefetch="), PrefetchWindow);
+
+    const bool bFullExport = FParse::Param(*Params, TEXT("Full"));
+    const bool bUseManifest = !FParse::Param(*Params, TEXT("NoManifest"));
+    FString ManifestPath = OutputDir / TEXT("ExportManifest.json");
+    FParse::Value(*Params, TEXT("Manifest="), ManifestPath);
+
+    // 合并模式：只合并各分片的部分索引与部分清单
+    if (FParse::Param(*Params, TEXT("Merge")))
+    {
+        int32 ExpectedShardCount = 0;
+        FParse::Value(*Params, TEXT("ShardCount="), ExpectedShardCount);
+        return FBP2AIExportShards::Merge(OutputDir, bUseManifest ? ManifestPath : FString(), ExpectedShardCount) ? 0 : 1;
+    }
+
+    FBP2AIExportShard Shard;
+    FString ShardValue;
+    if (FParse::Value(*Params, TEXT("Shard="), ShardValue) && !FBP2AIExportShard::Parse(ShardValue, Shard))
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Invalid -Shard=%s, expected i/N with 0 <= i < N."), *ShardValue);
+        return 1;
+    }
+
+    UE_LOG(LogBP2AI, Display, TEXT("BP2AI: Commandlet export -> Paths=%s | Output=%s | MaxInFlight=%d | Full=%d | Shard=%d/%d | Manifest=%s"),
+        *FString::Join(PackagePaths, TEXT(",")), *OutputDir, MaxInFlight, bFullExport ? 1 : 0, Shard.Index, Shard.Count, bUseManifest ? *ManifestPath : TEXT("<none>"));
+
+    // ---- 资产注册表（命令行模式下不会自动扫描） ----
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.ScanPathsSynchronous(PackagePaths, true);
+
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.bRecursiveClasses = true;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    for (const FString& Path : PackagePaths)
+    {
+        Filter.PackagePaths.Add(FName(*Path));
+    }
+
+    TArray<FAssetData> AllAssets;
+    AssetRegistry.GetAssets(Filter, AllAssets);
+    // 按包名排序，保证输出顺序与日志在多次运行间稳定
+    AllAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+    const TArray<FAssetData> BlueprintAssets = FBP2AIExportShards::SelectShard(AssetRegistry, AllAssets, Shard);
+
+    FScopedLogSilencer LogSilencer;
+    const double StartTime = FPlatformTime::Seconds();
+
+    // ---- 增量判断 ----
+    const uint32 SettingsHash = FBP2AIBatchExporter::GetExportSettingsHash(true);
+    FBP2AIExportManifest Manifest;
+    if (bUseManifest)
+    {
+        Manifest.Load(ManifestPath);
+    }
+    TMap<FName, FBP2AIExportManifestEntry> PendingEntries = Manifest.CollectPendingEntries(AssetRegistry, BlueprintAssets, SettingsHash, bFullExport || !bUseManifest);
+
+    // 分片模式下主清单只读，本分片的新记录写入部分清单，由合并步骤并入
+    FBP2AIExportManifest ShardManifest;
+    FBP2AIExportManifest& UpdatedManifest = Shard.IsSharded() ? ShardManifest : Manifest;
+    TMap<FName, FString> ExportedFiles;
+
+    // ---- 导出 ----
+    FBP2AIExportPipelineOptions PipelineOptions;
+    PipelineOptions.MaxInFlight = FMath::Max(0, MaxInFlight);
+    PipelineOptions.GcInterval = GcInterval;
+    PipelineOptions.GcMemoryBudgetMB = GcBudgetMB;
+    PipelineOptions.bParallel = BP2AIExportConfig::bParallelFolderExport && MaxInFlight != 1;
+    PipelineOptions.bIncludeNestedFunctions = true;
+    PipelineOptions.PrefetchWindow = PrefetchWindow;
+    PipelineOptions.PrefetchMemoryBudgetMB = BP2AIExportConfig::PipelinePrefetchMemoryBudgetMB;
+    PipelineOptions.ShouldExportAsset = [&PendingEntries](const FAssetData& AssetData)
+    {
+        return PendingEntries.Contains(AssetData.PackageName);
+    };
+    PipelineOptions.ResolveOutputPath = [&OutputDir](const FAssetData& AssetData, const FString& BlueprintName)
+    {
+        return FBP2AIBatchExporter::BuildExportFilePath(OutputDir, AssetData.PackagePath.ToString(), BlueprintName);
+    };
+    PipelineOptions.GetRecordedContentHash = [&Manifest](const FAssetData& AssetData)
+    {
+        const FBP2AIExportManifestEntry* PreviousEntry = Manifest.FindEntry(AssetData.PackageName);
+        return PreviousEntry ? PreviousEntry->ContentHash : 0;
+    };
+    PipelineOptions.OnAssetExported = [&PendingEntries, &UpdatedManifest, &ExportedFiles](const FAssetData& AssetData, const FString& TargetFilePath, uint64 ContentHash)
+    {
+        ExportedFiles.Add(AssetData.PackageName, TargetFilePath);
+        if (FBP2AIExportManifestEntry* Entry = PendingEntries.Find(AssetData.PackageName))
+        {
+            Entry->OutputPath = TargetFilePath;
+            Entry->ContentHash = ContentHash;
+            UpdatedManifest.UpdateEntry(AssetData.PackageName, *Entry);
+        }
+    };
+
+    FBP2AIExportPipelineSummary Summary;
+    Summary.TotalAssets = BlueprintAssets.Num();
+    Summary.SkippedCount = BlueprintAssets.Num() - PendingEntries.Num();
+    if (PendingEntries.Num() > 0)
+    {
+        FBP2AIExportPipeline Pipeline(PipelineOptions);
+        Summary = Pipeline.Run(BlueprintAssets);
+    }
+
+    if (bUseManifest)
+    {
+        if (Shard.IsSharded())
+        {
+            ShardManifest.SaveTo(FBP2AIExportShards::GetPartialManifestPath(OutputDir, Shard));
+        }
+        else
+        {
+            Manifest.Save();
+        }
+    }
+
+    // ---- 部分索引：本次导出的文件 + 未变化资产上次的文件 ----
+    TArray<FBP2AIExportIndexEntry> IndexEntries;
+    IndexEntries.Reserve(BlueprintAssets.Num());
+    for (const FAssetData& AssetData : BlueprintAssets)
+    {
+        FString OutputFile;
+        if (const FString* ExportedFile = ExportedFiles.Find(AssetData.PackageName))
+        {
+            OutputFile = *ExportedFile;
+        }
+        else if (const FBP2AIExportManifestEntry* PreviousEntry = Manifest.FindEntry(AssetData.PackageName))
+        {
+            if (!PendingEntries.Contains(AssetData.PackageName))
+            {
+                OutputFile = PreviousEntry->OutputPath;
+            }
+        }
+        if (OutputFile.IsEmpty())
+        {
+            continue;
+        }
+
+        FPaths::MakePathRelativeTo(OutputFile, *(OutputDir + TEXT("/")));
+        IndexEntries.Add({ AssetData.PackageName.ToString(), OutputFile });
+    }
+
+    if (!Shard.IsSharded())
+    {
+        // 清理之前分片运行遗留的部分输出
+        IFileManager::Get().DeleteDirectory(*FBP2AIExportShards::GetShardDir(OutputDir), false, true);
+    }
+    bool bIndexWritten = FBP2AIExportShards::WritePartialIndex(OutputDir, Shard, IndexEntries);
+    if (bIndexWritten && !Shard.IsSharded())
+    {
+        // 单进程导出直接生成项目索引（清单已写入主清单）
+        bIndexWritten = FBP2AIExportShards::Merge(OutputDir, FString(), 1);
+    }
+
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    const double SafeSeconds = FMath::Max(ElapsedSeconds, UE_DOUBLE_SMALL_NUMBER);
+
+    // ---- 机器可读汇总 ----
+    TSharedRef<FJsonObject> SummaryObject = MakeShared<FJsonObject>();
+    SummaryObject->SetNumberField(TEXT("total"), Summary.TotalAssets);
+    SummaryObject->SetNumberField(TEXT("exported"), Summary.SuccessCount);
+    SummaryObject->SetNumberField(TEXT("failed"), Summary.FailureCount);
+    SummaryObject->SetNumberField(TEXT("unchanged"), Summary.SkippedCount);
+    SummaryObject->SetNumberField(TEXT("nodes"), static_cast<double>(Summary.NodeCount));
+    SummaryObject->SetNumberField(TEXT("seconds"), ElapsedSeconds);
+    SummaryObject->SetNumberField(TEXT("blueprintsPerSecond"), Summary.SuccessCount / SafeSeconds);
+    SummaryObject->SetNumberField(TEXT("nodesPerSecond"), Summary.NodeCount / SafeSeconds);
+    SummaryObject->SetNumberField(TEXT("peakWorkingSetMB"), Summary.PeakWorkingSetBytes / (1024.0 * 1024.0));
+    SummaryObject->SetNumberField(TEXT("averageWorkingSetMB"), Summary.AverageWorkingSetBytes / (1024.0 * 1024.0));
+    SummaryObject->SetNumberField(TEXT("gcCount"), Summary.GcCount);
+    SummaryObject->SetNumberField(TEXT("unloadedPackages"), Summary.UnloadedPackageCount);
+    SummaryObject->SetNumberField(TEXT("identicalContent"), Summary.UnchangedFileCount);
+    SummaryObject->SetNumberField(TEXT("writeFailures"), Summary.WriteFailureCount);
+    SummaryObject->SetNumberField(TEXT("bytesWritten"), static_cast<double>(Summary.BytesWritten));
+    SummaryObject->SetStringField(TEXT("output"), OutputDir);
+    SummaryObject->SetNumberField(TEXT("shardIndex"), Shard.Index);
+    SummaryObject->SetNumberField(TEXT("shardCount"), Shard.Count);
+
+    FString SummaryJson;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&SummaryJson);
+    FJsonSerializer::Serialize(SummaryObject, Writer);
+    UE_LOG(LogBP2AI, Display, TEXT("BP2AI_EXPORT_SUMMARY %s"), *SummaryJson);
+
+    return (Summary.FailureCount == 0 && bIndexWritten) ? 0 : 1;
+}
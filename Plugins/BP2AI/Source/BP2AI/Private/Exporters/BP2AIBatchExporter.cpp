@@ -6,6 +6,7 @@
 // Source/BP2AI/Private/Exporters/BP2AIBatchExporter.cpp
 
 #include "Exporters/BP2AIBatchExporter.h"
+#include "Exporters/BP2AIDocumentWriter.h"
 #include "Logging/BP2AILog.h"
 #include "Settings/BP2AIExportConfig.h"
 #include "EdGraph/EdGraph.h"
@@ -13,6 +14,11 @@
 #include "EdGraphSchema_K2.h"
 #include "Engine/Blueprint.h"
 #include "Trace/ExecutionFlow/ExecutionFlowGenerator.h"
+#include "Extractors/BlueprintDataExtractor.h"
+#include "Extractors/BlueprintGraphPreloader.h"
+#include "Extractors/BlueprintReferencedGraphs.h"
+#include "Trace/FMarkdownPathTracer.h"
+#include "Trace/ExecutionFlow/FlowHelpers/DefinitionGenerationHelper.h"
 #include "Trace/MarkdownGenerationContext.h"
 #include "Trace/Generation/GenerationShared.h"
 #include "Misc/FileHelper.h"
@@ -278,6 +284,8 @@ FGenerationSettings FBP2AIBatchExporter::CreateDefaultSettings() const
     Settings.bDefineUserGraphsSeparately = BP2AIExportConfig::bSeparateUserGraphs; // 从配置读取
     Settings.bExpandCompositesInline = false;                                       // 不内联展开
     Settings.bShowTrivialDefaultParams = BP2AIExportConfig::bShowDefaultParams;     // 从配置读取
+    Settings.bAnnotateCallTargets = true;                                           // 调用步骤标注 Target 类
+    Settings.bSuppressRedundantTraces = true;                                       // 省略仅含 "Previously detailed" 的追踪
     
     // 所有类别默认可见（构造函数已初始化，这里可以覆盖）
     Settings.CategoryVisibility.Add(EDocumentationGraphCategory::Functions, true);
@@ -291,6 +299,61 @@ FGenerationSettings FBP2AIBatchExporter::CreateDefaultSettings() const
     return Settings;
 }
 
+FString FBP2AIBatchExporter::GetDefaultExportDir()
+{
+    return FPaths::ProjectSavedDir() / TEXT("BP2AI/Exports");
+}
+
+FString FBP2AIBatchExporter::BuildExportFilePath(const FString& BaseDir, const FString& PackagePath, const FString& BlueprintName)
+{
+    FString RelativePath = PackagePath;
+    const FString GameRoot = TEXT("/Game");
+    if (RelativePath.StartsWith(GameRoot))
+    {
+        RelativePath = RelativePath.Mid(GameRoot.Len());
+    }
+    RelativePath.RemoveFromStart(TEXT("/"));
+
+    FString OutputDir = BaseDir;
+    if (!RelativePath.IsEmpty())
+    {
+        OutputDir = FPaths::Combine(BaseDir, RelativePath);
+    }
+
+    return FPaths::Combine(OutputDir, BlueprintName + TEXT(".md"));
+}
+
+uint32 FBP2AIBatchExporter::GetExportSettingsHash(bool bIncludeNestedFunctions)
+{
+    const FBP2AIBatchExporter Exporter;
+    const FGenerationSettings Settings = Exporter.CreateDefaultSettings();
+
+    uint32 Hash = GetTypeHash(bIncludeNestedFunctions);
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bTraceAllSelected));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bDefineUserGraphsSeparately));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bExpandCompositesInline));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bShowTrivialDefaultParams));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bShouldTraceSymbolicallyForData));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bUseSemanticData));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bUseSemanticDataGeneration));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bAnnotateCallTargets));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.bSuppressRedundantTraces));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.MaxDataTraceDepth));
+    Hash = HashCombine(Hash, GetTypeHash(Settings.SharedExpressionMinUses));
+
+    // 类别可见性按枚举值排序，避免受 TMap 插入顺序影响
+    TArray<TPair<EDocumentationGraphCategory, bool>> Visibility = Settings.CategoryVisibility.Array();
+    Visibility.Sort([](const TPair<EDocumentationGraphCategory, bool>& A, const TPair<EDocumentationGraphCategory, bool>& B)
+    {
+        return static_cast<int32>(A.Key) < static_cast<int32>(B.Key);
+    });
+    for (const TPair<EDocumentationGraphCategory, bool>& Pair : Visibility)
+    {
+        Hash = HashCombine(Hash, HashCombine(GetTypeHash(static_cast<int32>(Pair.Key)), GetTypeHash(Pair.Value)));
+    }
+    return Hash;
+}
+
 bool FBP2AIBatchExporter::IsGraphValid(UEdGraph* Graph) const
 {
     if (!Graph)
@@ -442,145 +505,169 @@ int32 FBP2AIBatchExporter::CountBlueprintBlocks(const FString& Content) const
     return Count;
 }
 
-FString FBP2AIBatchExporter::PostProcessMarkdown(const FString& Markdown, UEdGraph* Graph) const
+FExportedGraphInfo FBP2AIBatchExporter::ExportSingleGraphDetailed(UEdGraph* Graph, const FString& Category, bool bIncludeNestedFunctions)
 {
-    if (Markdown.IsEmpty()) { return Markdown; }
+    return ExportGraphSnapshotDetailed(CaptureGraphSnapshot(Graph, Category), bIncludeNestedFunctions);
+}
 
-    FString Result = Markdown;
+FGraphExportSnapshot FBP2AIBatchExporter::CaptureGraphSnapshot(UEdGraph* Graph, const FString& Category) const
+{
+    if (!IsGraphValid(Graph)) { return FGraphExportSnapshot(); }
 
-    // 1. 去除冗余块 (Remove Redundant Blocks)
-    int32 Seek = 0;
-    while (true)
-    {
-        int32 BlockStart = Result.Find(TEXT("**Trace Start:"), ESearchCase::IgnoreCase, ESearchDir::FromStart, Seek);
-        if (BlockStart == INDEX_NONE) { break; }
+    FBlueprintDataExtractor DataExtractor;
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> ExtractedNodes = DataExtractor.ExtractFromSelectedNodes(Graph->Nodes, false);
+    return BuildGraphSnapshot(Graph, Category, ExtractedNodes);
+}
 
-        // 查找块结束（下一个 Trace Start 或文件末尾）
-        int32 NextBlockStart = Result.Find(TEXT("**Trace Start:"), ESearchCase::IgnoreCase, ESearchDir::FromStart, BlockStart + 14);
-        int32 BlockEnd = (NextBlockStart == INDEX_NONE) ? Result.Len() : NextBlockStart;
+FGraphExportSnapshot FBP2AIBatchExporter::BuildGraphSnapshot(UEdGraph* Graph, const FString& Category, TMap<FGuid, TSharedPtr<FBlueprintNode>>& ExtractedNodes)
+{
+    FGraphExportSnapshot Snapshot;
+    Snapshot.bIsValid = true;
+    Snapshot.GraphName = Graph->GetName();
+    Snapshot.Category = Category;
+    Snapshot.NodeCount = Graph->Nodes.Num();
+    Snapshot.RootBlueprintName = FExecutionFlowGenerator::ExtractBlueprintName(Graph->Nodes);
+
+    // 引用（被调用/展开的图表）与标题都在这里解析，快照之后不再需要 UEdGraph
+    FMarkdownPathTracer::CaptureNodeReferences(ExtractedNodes);
+    Snapshot.Nodes = FBlueprintGraphSnapshot::Build(ExtractedNodes);
+    FBlueprintGraphSnapshot::ReleaseNodeMap(ExtractedNodes);
+
+    return Snapshot;
+}
 
-        FString BlockContent = Result.Mid(BlockStart, BlockEnd - BlockStart);
-        
-        // Check if the blueprint code block inside this section is trivial/redundant
-        bool bIsRedundant = false;
-        int32 CodeStart = BlockContent.Find(TEXT("```blueprint"));
-        if (CodeStart != INDEX_NONE)
+// 追踪时会按路径提取的图表：宏（含标准宏的深度追踪）、折叠图，以及独立定义时的函数/自定义事件/接口图表
+static void CollectReferencedGraphPaths(const FBlueprintGraphSnapshot& Graph, bool bIncludeNestedFunctions, TArray<FString>& OutPaths)
+{
+    for (FBPNodeHandle Handle = 0; Handle < Graph.NumNodes(); ++Handle)
+    {
+        for (const TCHAR* GraphKey : { TEXT("MacroGraphReference"), TEXT("BoundGraphName") })
         {
-             int32 CodeEnd = BlockContent.Find(TEXT("```"), ESearchCase::IgnoreCase, ESearchDir::FromStart, CodeStart + 12);
-             if (CodeEnd != INDEX_NONE)
-             {
-                 FString CodeBody = BlockContent.Mid(CodeStart + 12, CodeEnd - (CodeStart + 12));
-                 CodeBody.TrimStartAndEndInline();
-                 
-                 // Only consider it redundant if it's a single line pointing to "Previously detailed"
-                 if (CodeBody.Contains(TEXT("Previously detailed")) && !CodeBody.Contains(TEXT("\n")))
-                 {
-                     bIsRedundant = true;
-                 }
-             }
+            const FString* GraphPath = Graph.FindNodeProperty(Handle, GraphKey);
+            if (GraphPath && !GraphPath->IsEmpty())
+            {
+                OutPaths.Add(*GraphPath);
+            }
         }
 
-        if (bIsRedundant)
+        const FBlueprintNodeRecord& Node = Graph.GetNode(Handle);
+        const FString& UserGraphPath = Graph.GetString(Node.UserGraphPath);
+        if (!Node.bRefsResolved || UserGraphPath.IsEmpty())
         {
-            // 移除该块
-            Result.RemoveAt(BlockStart, BlockEnd - BlockStart);
-            // 不更新 Seek，因为后面的内容前移了
             continue;
         }
-        
-        Seek = BlockStart + 14; // 继续搜索下一个
+        const FMarkdownPathTracer::EUserGraphType GraphType = static_cast<FMarkdownPathTracer::EUserGraphType>(Node.UserGraphType);
+        const bool bExpandedInline = GraphType == FMarkdownPathTracer::EUserGraphType::Macro
+            || GraphType == FMarkdownPathTracer::EUserGraphType::CollapsedGraph;
+        if (bExpandedInline || bIncludeNestedFunctions)
+        {
+            OutPaths.Add(UserGraphPath);
+        }
     }
+}
 
-    // 2. 添加 Target 信息 (Add Target Info)
-    if (Graph)
+// 接口调用的定义只有签名，签名来自 BPI 的 UFunction：在游戏线程按名称提示解析一次
+static void CaptureInterfaceSignatures(const FBlueprintGraphSnapshot& Graph, FBlueprintInterfaceSignatureMap& InOutSignatures)
+{
+    for (FBPNodeHandle Handle = 0; Handle < Graph.NumNodes(); ++Handle)
     {
-        for (UEdGraphNode* Node : Graph->Nodes)
+        const FBlueprintNodeRecord& Node = Graph.GetNode(Handle);
+        if (!Node.bRefsResolved || static_cast<FMarkdownPathTracer::EUserGraphType>(Node.UserGraphType) != FMarkdownPathTracer::EUserGraphType::Interface)
         {
-            if (UK2Node_CallFunction* CallFuncNode = Cast<UK2Node_CallFunction>(Node))
+            continue;
+        }
+        const FString& GraphNameHint = Graph.GetString(Node.UserGraphNameHint);
+        if (!GraphNameHint.IsEmpty() && !InOutSignatures.Contains(GraphNameHint))
+        {
+            FBlueprintInterfaceSignature& Signature = InOutSignatures.Add(GraphNameHint);
+            FDefinitionGenerationHelper::ResolveInterfaceSignature(GraphNameHint, Signature.InputSpecs, Signature.OutputSpecs);
+        }
+    }
+}
+
+void FBP2AIBatchExporter::CaptureReferencedGraphs(FBlueprintExportSnapshot& Snapshot, TArray<FString> PendingPaths, FBlueprintGraphPreloader& Preloader)
+{
+    check(IsInGameThread());
+
+    // 同一图表可能以不同的路径写法被引用（节点属性原值 / GetPathName），按节点集合共享一份快照
+    TMap<uint32, TSharedPtr<const FBlueprintGraphSnapshot>> SnapshotsByNodeSet;
+    FBlueprintDataExtractor DataExtractor;
+    for (int32 Depth = 0; !PendingPaths.IsEmpty() && Depth < BP2AIExportConfig::PipelineReferencedGraphMaxDepth; ++Depth)
+    {
+        // 本层图表所在的包一次性加载，而不是在 ExtractNodesFromGraph 中逐个同步加载
+        Preloader.Load();
+
+        TArray<FString> NextPaths;
+        for (const FString& GraphPath : PendingPaths)
+        {
+            if (Snapshot.ReferencedGraphs.Contains(GraphPath))
             {
-                FString FuncName = CallFuncNode->GetFunctionName().ToString();
-                FString TargetClassName = TEXT("Self");
-                
-                // 尝试从 Target 引脚获取类型
-                UEdGraphPin* TargetPin = CallFuncNode->FindPin(TEXT("self"));
-                if (!TargetPin) { TargetPin = CallFuncNode->FindPin(TEXT("Target")); }
+                continue;
+            }
 
-                if (TargetPin && TargetPin->LinkedTo.Num() > 0)
-                {
-                    if (UEdGraphPin* LinkedPin = TargetPin->LinkedTo[0])
-                    {
-                        if (LinkedPin->PinType.PinSubCategoryObject.IsValid())
-                        {
-                            TargetClassName = LinkedPin->PinType.PinSubCategoryObject->GetName();
-                        }
-                        else if (LinkedPin->PinType.PinCategory == TEXT("object"))
-                        {
-                            TargetClassName = TEXT("Object");
-                        }
-                    }
-                }
-                else
-                {
-                    // 无连接，通常是 Self 或静态函数库
-                    if (UFunction* TargetFunc = CallFuncNode->GetTargetFunction())
-                    {
-                        if (UClass* OwnerClass = TargetFunc->GetOwnerClass())
-                        {
-                            TargetClassName = OwnerClass->GetName();
-                        }
-                    }
-                }
+            TMap<FGuid, TSharedPtr<FBlueprintNode>> GraphNodes;
+            if (!DataExtractor.ExtractNodesFromGraph(GraphPath, GraphNodes))
+            {
+                // 记录失败，构建阶段与直接追踪一样按提取失败处理
+                Snapshot.ReferencedGraphs.Add(GraphPath, nullptr);
+                continue;
+            }
 
-                // 在 Markdown 中查找并注入 Target 信息
-                // 查找模式: "* FuncName("
-                // 注入位置: 行尾
-                int32 SearchPos = 0;
-                FString SearchPattern = FString::Printf(TEXT("* %s("), *FuncName);
-                
-                // 防止死循环或过度搜索，限制次数（可选）
-                while (true)
-                {
-                    int32 FoundPos = Result.Find(SearchPattern, ESearchCase::IgnoreCase, ESearchDir::FromStart, SearchPos);
-                    if (FoundPos == INDEX_NONE) { break; }
-                    
-                    int32 LineEnd = Result.Find(TEXT("\n"), ESearchCase::IgnoreCase, ESearchDir::FromStart, FoundPos);
-                    if (LineEnd == INDEX_NONE) { LineEnd = Result.Len(); }
-                    
-                    FString LineContent = Result.Mid(FoundPos, LineEnd - FoundPos);
-                    // 避免重复添加
-                    if (!LineContent.Contains(TEXT("(Target:")))
-                    {
-                        FString Insertion = FString::Printf(TEXT(" (Target: %s)"), *TargetClassName);
-                        Result.InsertAt(LineEnd, Insertion);
-                        LineEnd += Insertion.Len();
-                    }
-                    
-                    SearchPos = LineEnd;
-                }
+            const uint32 NodeSetHash = GraphNodes.IsEmpty() ? 0 : GraphNodes.CreateConstIterator().Value()->NodeSetHash;
+            TSharedPtr<const FBlueprintGraphSnapshot>* Existing = NodeSetHash ? SnapshotsByNodeSet.Find(NodeSetHash) : nullptr;
+            if (Existing)
+            {
+                FBlueprintGraphSnapshot::ReleaseNodeMap(GraphNodes);
+                Snapshot.ReferencedGraphs.Add(GraphPath, *Existing);
+                continue;
             }
+
+            Preloader.AddReferencesFrom(GraphNodes);
+            FMarkdownPathTracer::CaptureNodeReferences(GraphNodes);
+            TSharedPtr<const FBlueprintGraphSnapshot> GraphSnapshot = MakeShared<FBlueprintGraphSnapshot>(FBlueprintGraphSnapshot::Build(GraphNodes));
+            FBlueprintGraphSnapshot::ReleaseNodeMap(GraphNodes);
+
+            CollectReferencedGraphPaths(*GraphSnapshot, Snapshot.bIncludeNestedFunctions, NextPaths);
+            if (NodeSetHash)
+            {
+                SnapshotsByNodeSet.Add(NodeSetHash, GraphSnapshot);
+            }
+            Snapshot.ReferencedGraphs.Add(GraphPath, MoveTemp(GraphSnapshot));
         }
+        PendingPaths = MoveTemp(NextPaths);
     }
 
-    return Result;
+    PendingPaths.RemoveAll([&Snapshot](const FString& GraphPath) { return Snapshot.ReferencedGraphs.Contains(GraphPath); });
+    if (!PendingPaths.IsEmpty())
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("CaptureReferencedGraphs: '%s' references graphs deeper than %d levels; %d path(s) were not captured."),
+            *Snapshot.Data.BlueprintName, BP2AIExportConfig::PipelineReferencedGraphMaxDepth, PendingPaths.Num());
+    }
 }
 
-FExportedGraphInfo FBP2AIBatchExporter::ExportSingleGraphDetailed(UEdGraph* Graph, const FString& Category, bool bIncludeNestedFunctions)
+FExportedGraphInfo FBP2AIBatchExporter::ExportGraphSnapshotDetailed(const FGraphExportSnapshot& Snapshot, bool bIncludeNestedFunctions,
+    const FBlueprintExportSnapshot* BlueprintSnapshot)
 {
     FExportedGraphInfo Info;
-    if (!IsGraphValid(Graph)) { return Info; }
-    Info.GraphName = Graph->GetName();
-    Info.Category = Category;
-    Info.NodeCount = Graph->Nodes.Num();
+    if (!Snapshot.bIsValid) { return Info; }
+    Info.GraphName = Snapshot.GraphName;
+    Info.Category = Snapshot.Category;
+    Info.NodeCount = Snapshot.NodeCount;
 
-    TArray<UEdGraphNode*> AllNodes = Graph->Nodes;
     FGenerationSettings Settings = CreateDefaultSettings();
     Settings.bDefineUserGraphsSeparately = bIncludeNestedFunctions;
     FMarkdownGenerationContext Context(FMarkdownGenerationContext::EOutputFormat::RawMarkdown);
     FExecutionFlowGenerator Generator;
-    Info.Markdown = Generator.GenerateDocumentForNodes(AllNodes, Settings, Context);
-
-    // Task 2.5: Post-process Markdown (Remove redundant blocks & add Target info)
-    Info.Markdown = PostProcessMarkdown(Info.Markdown, Graph);
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> NodeView = Snapshot.Nodes.CreateCompatibilityView();
+    {
+        TOptional<FBlueprintReferencedGraphScope> ReferencedGraphScope;
+        if (BlueprintSnapshot)
+        {
+            ReferencedGraphScope.Emplace(BlueprintSnapshot->ReferencedGraphs, BlueprintSnapshot->InterfaceSignatures);
+        }
+        Info.Markdown = Generator.GenerateDocumentForExtractedNodes(NodeView, Snapshot.RootBlueprintName, Settings, Context);
+    }
+    FBlueprintGraphSnapshot::ReleaseNodeMap(NodeView);
 
     Info.CharacterCount = Info.Markdown.Len();
     Info.LineCount = CountLines(Info.Markdown);
@@ -633,27 +720,15 @@ static TSet<FName> GetInterfaceFunctionNames(UBlueprint* Blueprint)
     return Names;
 }
 
-TArray<FExportedGraphInfo> FBP2AIBatchExporter::ExportAllGraphsDetailed(UBlueprint* Blueprint, bool bIncludeNestedFunctions)
+// 按导出顺序收集蓝图的所有图表（Event → Function → Interface → Macro → Delegate）
+static void CollectGraphsInExportOrder(UBlueprint* Blueprint, TArray<TPair<UEdGraph*, const TCHAR*>>& OutGraphs)
 {
-    TArray<FExportedGraphInfo> Result;
-    if (!Blueprint)
-    {
-        UE_LOG(LogBP2AI, Error, TEXT("ExportAllGraphsDetailed: Blueprint is null"));
-        return Result;
-    }
-    if (BP2AIExportConfig::bDetailedBlueprintLog)
-    {
-        UE_LOG(LogBP2AI, Log, TEXT("========================================"));
-        UE_LOG(LogBP2AI, Log, TEXT("BP2AIBatchExporter: Detailed export for blueprint '%s'"), *Blueprint->GetName());
-        UE_LOG(LogBP2AI, Log, TEXT("========================================"));
-    }
-
-    auto ExportArray = [&](const TArray<UEdGraph*>& GraphArray, const TCHAR* CategoryLabel)
+    auto AddArray = [&OutGraphs](const TArray<UEdGraph*>& GraphArray, const TCHAR* CategoryLabel)
     {
         for (UEdGraph* G : GraphArray)
         {
             if (!G) { continue; }
-            Result.Add(ExportSingleGraphDetailed(G, CategoryLabel, bIncludeNestedFunctions));
+            OutGraphs.Emplace(G, CategoryLabel);
         }
     };
 
@@ -700,13 +775,21 @@ TArray<FExportedGraphInfo> FBP2AIBatchExporter::ExportAllGraphsDetailed(UBluepri
         }
     }
 
-    ExportArray(Blueprint->UbergraphPages, TEXT("Event"));
-    ExportArray(StandardFunctions, TEXT("Function"));
-    ExportArray(InterfaceFunctions, TEXT("Interface"));
-    ExportArray(Blueprint->MacroGraphs, TEXT("Macro"));
-    ExportArray(Blueprint->DelegateSignatureGraphs, TEXT("Delegate"));
+    AddArray(Blueprint->UbergraphPages, TEXT("Event"));
+    AddArray(StandardFunctions, TEXT("Function"));
+    AddArray(InterfaceFunctions, TEXT("Interface"));
+    AddArray(Blueprint->MacroGraphs, TEXT("Macro"));
+    AddArray(Blueprint->DelegateSignatureGraphs, TEXT("Delegate"));
+}
+
+// 汇总统计日志（bDetailedBlueprintLog）
+static void LogDetailedExportSummary(const TArray<FExportedGraphInfo>& Result)
+{
+    if (!BP2AIExportConfig::bDetailedBlueprintLog)
+    {
+        return;
+    }
 
-    // 汇总统计
     int32 TotalChars = 0, TotalLines = 0, TotalBlocks = 0, TotalNodes = 0;
     for (const FExportedGraphInfo& G : Result)
     {
@@ -715,23 +798,45 @@ TArray<FExportedGraphInfo> FBP2AIBatchExporter::ExportAllGraphsDetailed(UBluepri
         TotalBlocks += G.BlueprintBlockCount;
         TotalNodes += G.NodeCount;
     }
-    if (BP2AIExportConfig::bDetailedBlueprintLog)
+    UE_LOG(LogBP2AI, Log, TEXT("📊 Detailed Export Summary:"));
+    UE_LOG(LogBP2AI, Log, TEXT("   Graphs: %d"), Result.Num());
+    UE_LOG(LogBP2AI, Log, TEXT("   Total Nodes: %d"), TotalNodes);
+    UE_LOG(LogBP2AI, Log, TEXT("   Total Characters: %d"), TotalChars);
+    UE_LOG(LogBP2AI, Log, TEXT("   Total Lines: %d"), TotalLines);
+    UE_LOG(LogBP2AI, Log, TEXT("   Total Blueprint Blocks: %d"), TotalBlocks);
+
+    UE_LOG(LogBP2AI, Log, TEXT("   Per-Graph Overview:"));
+    for (const FExportedGraphInfo& G : Result)
     {
-        UE_LOG(LogBP2AI, Log, TEXT("📊 Detailed Export Summary:"));
-        UE_LOG(LogBP2AI, Log, TEXT("   Graphs: %d"), Result.Num());
-        UE_LOG(LogBP2AI, Log, TEXT("   Total Nodes: %d"), TotalNodes);
-        UE_LOG(LogBP2AI, Log, TEXT("   Total Characters: %d"), TotalChars);
-        UE_LOG(LogBP2AI, Log, TEXT("   Total Lines: %d"), TotalLines);
-        UE_LOG(LogBP2AI, Log, TEXT("   Total Blueprint Blocks: %d"), TotalBlocks);
+        UE_LOG(LogBP2AI, Log, TEXT("      [%s] %s | Nodes=%d, Chars=%d, Lines=%d, Blocks=%d"), *G.Category, *G.GraphName, G.NodeCount, G.CharacterCount, G.LineCount, G.BlueprintBlockCount);
+    }
+    UE_LOG(LogBP2AI, Log, TEXT("========================================"));
+}
 
-        UE_LOG(LogBP2AI, Log, TEXT("   Per-Graph Overview:"));
-        for (const FExportedGraphInfo& G : Result)
-        {
-            UE_LOG(LogBP2AI, Log, TEXT("      [%s] %s | Nodes=%d, Chars=%d, Lines=%d, Blocks=%d"), *G.Category, *G.GraphName, G.NodeCount, G.CharacterCount, G.LineCount, G.BlueprintBlockCount);
-        }
+TArray<FExportedGraphInfo> FBP2AIBatchExporter::ExportAllGraphsDetailed(UBlueprint* Blueprint, bool bIncludeNestedFunctions)
+{
+    TArray<FExportedGraphInfo> Result;
+    if (!Blueprint)
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("ExportAllGraphsDetailed: Blueprint is null"));
+        return Result;
+    }
+    if (BP2AIExportConfig::bDetailedBlueprintLog)
+    {
         UE_LOG(LogBP2AI, Log, TEXT("========================================"));
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AIBatchExporter: Detailed export for blueprint '%s'"), *Blueprint->GetName());
+        UE_LOG(LogBP2AI, Log, TEXT("========================================"));
+    }
+
+    TArray<TPair<UEdGraph*, const TCHAR*>> GraphsToExport;
+    CollectGraphsInExportOrder(Blueprint, GraphsToExport);
+    for (const TPair<UEdGraph*, const TCHAR*>& Entry : GraphsToExport)
+    {
+        Result.Add(ExportSingleGraphDetailed(Entry.Key, Entry.Value, bIncludeNestedFunctions));
     }
 
+    LogDetailedExportSummary(Result);
+
     return Result;
 }
 
@@ -1447,36 +1552,43 @@ static bool IsInterfaceGraph(UEdGraph* Graph, UBlueprint* Blueprint, const TSet<
 FString FCompleteBlueprintData::ToMarkdown() const
 {
     FString Result;
-    Result += FString::Printf(TEXT("# %s\n\n"), *BlueprintName);
-    Result += FString::Printf(TEXT("**Asset Path**: `%s`\n\n"), *AssetPath);
-    Result += TEXT("---\n\n");
+    FBP2AIStringDocumentSink Sink(Result);
+    WriteMarkdown(Sink);
+    return Result;
+}
+
+void FCompleteBlueprintData::WriteMarkdown(FBP2AIDocumentSink& Out) const
+{
+    Out.Appendf(TEXT("# %s\n\n"), *BlueprintName);
+    Out.Appendf(TEXT("**Asset Path**: `%s`\n\n"), *AssetPath);
+    Out.Append(TEXT("---\n\n"));
     auto AppendFunctionList = [&](const TArray<FCompleteBlueprintData::FFunctionInfo>& InFunctions)
     {
         if (InFunctions.Num() == 0)
         {
-            Result += TEXT("(None)\n");
+            Out.Append(TEXT("(None)\n"));
             return;
         }
 
         for (const auto& F : InFunctions)
         {
-            Result += FString::Printf(TEXT("- %s%s"), *F.Name, F.bIsEvent ? TEXT(" (Event)") : TEXT(""));
+            Out.Appendf(TEXT("- %s%s"), *F.Name, F.bIsEvent ? TEXT(" (Event)") : TEXT(""));
             if (!F.ReturnType.IsEmpty())
             {
-                Result += FString::Printf(TEXT(" -> %s"), *F.ReturnType);
+                Out.Appendf(TEXT(" -> %s"), *F.ReturnType);
             }
             if (F.Parameters.Num() > 0)
             {
-                Result += TEXT(" ( ");
+                Out.Append(TEXT(" ( "));
                 for (int32 i = 0; i < F.Parameters.Num(); ++i)
                 {
                     const auto& P = F.Parameters[i];
-                    Result += FString::Printf(TEXT("%s: %s"), *P.Name, *P.Type);
-                    if (i < F.Parameters.Num() - 1) { Result += TEXT(", "); }
+                    Out.Appendf(TEXT("%s: %s"), *P.Name, *P.Type);
+                    if (i < F.Parameters.Num() - 1) { Out.Append(TEXT(", ")); }
                 }
-                Result += TEXT(" )");
+                Out.Append(TEXT(" )"));
             }
-            Result += TEXT("\n");
+            Out.Append(TEXT("\n"));
         }
     };
 
@@ -1487,24 +1599,25 @@ FString FCompleteBlueprintData::ToMarkdown() const
             return;
         }
 
-        Result += TEXT("## References\n\n");
+        Out.Append(TEXT("## References\n\n"));
         for (const auto& Ref : References)
         {
-            const FString TypeSuffix = Ref.Type.IsEmpty() ? TEXT("") : FString::Printf(TEXT(" (%s)"), *Ref.Type);
-            const FString SoftSuffix = Ref.bIsSoftReference ? TEXT(" [Soft]") : TEXT("");
-            const FString SourceSuffix = Ref.Source.IsEmpty() ? TEXT("") : FString::Printf(TEXT(" // %s"), *Ref.Source);
-            Result += FString::Printf(TEXT("- %s%s%s%s\n"), *Ref.Path, *TypeSuffix, *SoftSuffix, *SourceSuffix);
+            Out.Appendf(TEXT("- %s"), *Ref.Path);
+            if (!Ref.Type.IsEmpty()) { Out.Appendf(TEXT(" (%s)"), *Ref.Type); }
+            if (Ref.bIsSoftReference) { Out.Append(TEXT(" [Soft]")); }
+            if (!Ref.Source.IsEmpty()) { Out.Appendf(TEXT(" // %s"), *Ref.Source); }
+            Out.Append(TEXT("\n"));
         }
-        Result += TEXT("\n");
+        Out.Append(TEXT("\n"));
     };
 
     if (bIsInterface)
     {
-        Result += TEXT("## Interface Functions\n\n");
+        Out.Append(TEXT("## Interface Functions\n\n"));
         AppendFunctionList(Functions);
-        Result += TEXT("\n---\n\n");
+        Out.Append(TEXT("\n---\n\n"));
         AppendReferencesSection();
-        return Result;
+        return;
     }
     
     // Summary section removed by user request
@@ -1516,107 +1629,115 @@ FString FCompleteBlueprintData::ToMarkdown() const
         TotalLines += G.LineCount;
         TotalBlocks += G.BlueprintBlockCount;
     }
-    Result += TEXT("## Summary\n\n");
-    Result += FString::Printf(TEXT("- **Total Graphs**: %d\n"), Graphs.Num());
-    Result += FString::Printf(TEXT("- **Total Nodes**: %d\n"), TotalNodes);
-    Result += FString::Printf(TEXT("- **Total Blueprint Blocks**: %d\n"), TotalBlocks);
-    Result += FString::Printf(TEXT("- **Total Lines**: %d\n"), TotalLines);
-    Result += TEXT("\n---\n\n");
+    Out.Append(TEXT("## Summary\n\n"));
+    Out.Appendf(TEXT("- **Total Graphs**: %d\n"), Graphs.Num());
+    Out.Appendf(TEXT("- **Total Nodes**: %d\n"), TotalNodes);
+    Out.Appendf(TEXT("- **Total Blueprint Blocks**: %d\n"), TotalBlocks);
+    Out.Appendf(TEXT("- **Total Lines**: %d\n"), TotalLines);
+    Out.Append(TEXT("\n---\n\n"));
     */
 
     // Metadata（新）
-    Result += TEXT("## Metadata\n\n");
-    Result += FString::Printf(TEXT("- **Class**: %s\n"), *Metadata.ClassName);
-    Result += FString::Printf(TEXT("- **ParentClass**: %s\n"), *Metadata.ParentClass);
+    Out.Append(TEXT("## Metadata\n\n"));
+    Out.Appendf(TEXT("- **Class**: %s\n"), *Metadata.ClassName);
+    Out.Appendf(TEXT("- **ParentClass**: %s\n"), *Metadata.ParentClass);
     if (Metadata.Interfaces.Num() > 0)
     {
-        Result += TEXT("- **Interfaces**:\n");
+        Out.Append(TEXT("- **Interfaces**:\n"));
         for (const FString& I : Metadata.Interfaces)
         {
-            Result += FString::Printf(TEXT("  - %s\n"), *I);
+            Out.Appendf(TEXT("  - %s\n"), *I);
         }
     }
-    Result += TEXT("\n---\n\n");
+    Out.Append(TEXT("\n---\n\n"));
 
     // Components（新）
-    Result += TEXT("## Components\n\n");
+    Out.Append(TEXT("## Components\n\n"));
     for (const auto& C : Components)
     {
-        Result += FString::Printf(TEXT("- %s : %s"), *C.Name, *C.Type);
+        Out.Appendf(TEXT("- %s : %s"), *C.Name, *C.Type);
         if (!C.ParentName.IsEmpty())
         {
-            Result += FString::Printf(TEXT(" (Parent: %s)"), *C.ParentName);
+            Out.Appendf(TEXT(" (Parent: %s)"), *C.ParentName);
         }
-        Result += TEXT("\n");
+        Out.Append(TEXT("\n"));
     }
-    if (Components.Num() == 0) { Result += TEXT("(None)\n"); }
-    Result += TEXT("\n---\n\n");
+    if (Components.Num() == 0) { Out.Append(TEXT("(None)\n")); }
+    Out.Append(TEXT("\n---\n\n"));
 
     // Variables（新）
-    Result += TEXT("## Variables\n\n");
+    Out.Append(TEXT("## Variables\n\n"));
     for (const auto& V : Variables)
     {
-        Result += FString::Printf(TEXT("- %s : %s"), *V.Name, *V.Type);
-        if (!V.DefaultValue.IsEmpty()) { Result += FString::Printf(TEXT(" = %s"), *V.DefaultValue); }
-        if (V.bIsPublic) { Result += TEXT(" (Public)"); }
-        if (!V.Tooltip.IsEmpty()) { Result += FString::Printf(TEXT(" // %s"), *V.Tooltip); }
-        Result += TEXT("\n");
+        Out.Appendf(TEXT("- %s : %s"), *V.Name, *V.Type);
+        if (!V.DefaultValue.IsEmpty()) { Out.Appendf(TEXT(" = %s"), *V.DefaultValue); }
+        if (V.bIsPublic) { Out.Append(TEXT(" (Public)")); }
+        if (!V.Tooltip.IsEmpty()) { Out.Appendf(TEXT(" // %s"), *V.Tooltip); }
+        Out.Append(TEXT("\n"));
     }
-    if (Variables.Num() == 0) { Result += TEXT("(None)\n"); }
-    Result += TEXT("\n---\n\n");
+    if (Variables.Num() == 0) { Out.Append(TEXT("(None)\n")); }
+    Out.Append(TEXT("\n---\n\n"));
 
     // Functions（新）
-    Result += TEXT("## Functions\n\n");
+    Out.Append(TEXT("## Functions\n\n"));
     AppendFunctionList(Functions);
-    Result += TEXT("\n---\n\n");
+    Out.Append(TEXT("\n---\n\n"));
 
     // Graph Inventory（保留）
-    Result += TEXT("## Graph Inventory\n\n");
+    Out.Append(TEXT("## Graph Inventory\n\n"));
     TMap<FString, int32> CategoryCount;
     for (const FExportedGraphInfo& G : Graphs) { CategoryCount.FindOrAdd(G.Category)++; }
     for (const auto& Pair : CategoryCount)
     {
-        Result += FString::Printf(TEXT("- **%s**: %d\n"), *Pair.Key, Pair.Value);
+        Out.Appendf(TEXT("- **%s**: %d\n"), *Pair.Key, Pair.Value);
     }
-    Result += TEXT("\n---\n\n");
+    Out.Append(TEXT("\n---\n\n"));
 
     // Graph Logic（保留）
-    Result += TEXT("## Graph Logic\n\n");
+    Out.Append(TEXT("## Graph Logic\n\n"));
     for (const FExportedGraphInfo& G : Graphs)
     {
         // For delegates we only emit a header (no code blocks or trace content)
         if (G.Category.Equals(TEXT("Delegate"), ESearchCase::IgnoreCase))
         {
-            Result += FString::Printf(TEXT("### [%s] %s\n\n"), *G.Category, *G.GraphName);
-            Result += TEXT("\n---\n\n");
+            Out.Appendf(TEXT("### [%s] %s\n\n"), *G.Category, *G.GraphName);
+            Out.Append(TEXT("\n---\n\n"));
             continue;
         }
 
-        Result += FString::Printf(TEXT("### [%s] %s\n\n"), *G.Category, *G.GraphName);
+        Out.Appendf(TEXT("### [%s] %s\n\n"), *G.Category, *G.GraphName);
         // Stats removed by user request
         /*
-        Result += FString::Printf(TEXT("- **Nodes**: %d\n"), G.NodeCount);
-        Result += FString::Printf(TEXT("- **Lines**: %d\n"), G.LineCount);
-        Result += FString::Printf(TEXT("- **Blueprint Blocks**: %d\n\n"), G.BlueprintBlockCount);
+        Out.Appendf(TEXT("- **Nodes**: %d\n"), G.NodeCount);
+        Out.Appendf(TEXT("- **Lines**: %d\n"), G.LineCount);
+        Out.Appendf(TEXT("- **Blueprint Blocks**: %d\n\n"), G.BlueprintBlockCount);
         */
-        Result += G.Markdown;
-        Result += TEXT("\n\n---\n\n");
+        Out.Append(G.Markdown);
+        Out.Append(TEXT("\n\n---\n\n"));
     }
 
     AppendReferencesSection();
-
-    return Result;
 }
 
 FCompleteBlueprintData FBP2AIBatchExporter::ExportCompleteBlueprint(UBlueprint* Blueprint, bool bIncludeNestedFunctions)
 {
-    FCompleteBlueprintData Result;
+    // 同步路径与批量流水线共用同一实现，保证输出一致
+    return BuildFromSnapshot(CaptureBlueprintSnapshot(Blueprint, bIncludeNestedFunctions));
+}
+
+FBlueprintExportSnapshot FBP2AIBatchExporter::CaptureBlueprintSnapshot(UBlueprint* Blueprint, bool bIncludeNestedFunctions)
+{
+    check(IsInGameThread());
+
+    FBlueprintExportSnapshot Snapshot;
+    Snapshot.bIncludeNestedFunctions = bIncludeNestedFunctions;
     if (!Blueprint)
     {
         UE_LOG(LogBP2AI, Error, TEXT("ExportCompleteBlueprint: Blueprint is null"));
-        return Result;
+        return Snapshot;
     }
 
+    FCompleteBlueprintData& Result = Snapshot.Data;
     Result.BlueprintName = Blueprint->GetName();
     Result.AssetPath = Blueprint->GetPathName();
     Result.Metadata   = ExportMetadata(Blueprint);
@@ -1630,18 +1751,97 @@ FCompleteBlueprintData FBP2AIBatchExporter::ExportCompleteBlueprint(UBlueprint*
             UE_LOG(LogBP2AI, Log, TEXT("ExportCompleteBlueprint: '%s' detected as Blueprint Interface"), *Result.BlueprintName);
         }
         Result.Functions = ExportInterfaceFunctionSignatures(Blueprint);
-        return Result;
+        return Snapshot;
+    }
+
+    // 图表快照（节点模型 + Target 信息）
+    if (BP2AIExportConfig::bDetailedBlueprintLog)
+    {
+        UE_LOG(LogBP2AI, Log, TEXT("========================================"));
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AIBatchExporter: Detailed export for blueprint '%s'"), *Blueprint->GetName());
+        UE_LOG(LogBP2AI, Log, TEXT("========================================"));
     }
 
-    // 图表
     FBP2AIBatchExporter Exporter;
-    Result.Graphs = Exporter.ExportAllGraphsDetailed(Blueprint, bIncludeNestedFunctions);
+    FBlueprintDataExtractor DataExtractor;
+    FBlueprintGraphPreloader Preloader;
+    TArray<TPair<UEdGraph*, const TCHAR*>> GraphsToExport;
+    CollectGraphsInExportOrder(Blueprint, GraphsToExport);
+
+    // 先提取所有图表并收集引用，被引用但尚未加载的包批量加载（同步）后再解析引用
+    TArray<TMap<FGuid, TSharedPtr<FBlueprintNode>>> ExtractedGraphs;
+    ExtractedGraphs.SetNum(GraphsToExport.Num());
+    for (int32 Index = 0; Index < GraphsToExport.Num(); ++Index)
+    {
+        UEdGraph* Graph = GraphsToExport[Index].Key;
+        if (Exporter.IsGraphValid(Graph))
+        {
+            ExtractedGraphs[Index] = DataExtractor.ExtractFromSelectedNodes(Graph->Nodes, false);
+            Preloader.AddReferencesFrom(ExtractedGraphs[Index]);
+        }
+    }
+    Preloader.Load();
 
     // 阶段3：元数据
     Result.Components = ExportComponents(Blueprint);
     Result.Variables  = ExportVariables(Blueprint);
     Result.Functions  = ExportFunctions(Blueprint);
 
+    // 包加载完成后解析引用（函数图表要在类加载后才能定位），并捕获被引用的图表：
+    // 构建阶段在工作线程上只读取这些快照，不查找或加载 UEdGraph
+    TArray<FString> ReferencedPaths;
+    Snapshot.Graphs.Reserve(GraphsToExport.Num());
+    for (int32 Index = 0; Index < GraphsToExport.Num(); ++Index)
+    {
+        UEdGraph* Graph = GraphsToExport[Index].Key;
+        if (!Exporter.IsGraphValid(Graph))
+        {
+            Snapshot.Graphs.AddDefaulted();
+            continue;
+        }
+        const FGraphExportSnapshot& GraphSnapshot = Snapshot.Graphs.Add_GetRef(
+            BuildGraphSnapshot(Graph, GraphsToExport[Index].Value, ExtractedGraphs[Index]));
+        CollectReferencedGraphPaths(GraphSnapshot.Nodes, bIncludeNestedFunctions, ReferencedPaths);
+    }
+    CaptureReferencedGraphs(Snapshot, MoveTemp(ReferencedPaths), Preloader);
+
+    // 接口定义只在独立定义用户图表时生成
+    if (bIncludeNestedFunctions)
+    {
+        for (const FGraphExportSnapshot& GraphSnapshot : Snapshot.Graphs)
+        {
+            CaptureInterfaceSignatures(GraphSnapshot.Nodes, Snapshot.InterfaceSignatures);
+        }
+        for (const TPair<FString, TSharedPtr<const FBlueprintGraphSnapshot>>& Referenced : Snapshot.ReferencedGraphs)
+        {
+            if (Referenced.Value.IsValid())
+            {
+                CaptureInterfaceSignatures(*Referenced.Value, Snapshot.InterfaceSignatures);
+            }
+        }
+    }
+
+    return Snapshot;
+}
+
+FCompleteBlueprintData FBP2AIBatchExporter::BuildFromSnapshot(const FBlueprintExportSnapshot& Snapshot)
+{
+    FCompleteBlueprintData Result = Snapshot.Data;
+    if (Result.bIsInterface)
+    {
+        return Result;
+    }
+
+    // 图表（追踪 + 构建）：节点、标题、被引用的图表、枚举显示名与接口签名都来自快照，不查找任何 UObject
+    FBP2AIBatchExporter Exporter;
+    Result.Graphs.Reserve(Snapshot.Graphs.Num());
+    for (const FGraphExportSnapshot& GraphSnapshot : Snapshot.Graphs)
+    {
+        Result.Graphs.Add(Exporter.ExportGraphSnapshotDetailed(GraphSnapshot, Snapshot.bIncludeNestedFunctions, &Snapshot));
+    }
+
+    LogDetailedExportSummary(Result.Graphs);
+
     return Result;
 }
 
@@ -1653,25 +1853,41 @@ bool FBP2AIBatchExporter::WriteCompleteBlueprintMarkdown(const FCompleteBlueprin
         return false;
     }
 
-    const FString DirectoryPath = FPaths::GetPath(TargetFilePath);
-    if (bCreateDirectories && !DirectoryPath.IsEmpty())
+    const FBP2AIDocumentWriteResult Result = FBP2AIDocumentWriter::WriteDocument(TargetFilePath,
+        [&Data](FBP2AIDocumentSink& Sink) { Data.WriteMarkdown(Sink); }, 0, bCreateDirectories);
+    if (Result.IsSuccess() && BP2AIExportConfig::bDetailedBlueprintLog)
     {
-        if (!IFileManager::Get().MakeDirectory(*DirectoryPath, true) && !FPaths::DirectoryExists(DirectoryPath))
-        {
-            UE_LOG(LogBP2AI, Warning, TEXT("WriteCompleteBlueprintMarkdown: Failed to create directory '%s'."), *DirectoryPath);
-        }
+        UE_LOG(LogBP2AI, Log, TEXT("📘 Saved blueprint document: %s (%lld bytes%s)"), *TargetFilePath, Result.Bytes,
+            Result.Status == EBP2AIDocumentWriteStatus::Unchanged ? TEXT(", unchanged") : TEXT(""));
     }
+    return Result.IsSuccess();
+}
 
-    const FString Content = Data.ToMarkdown();
-    if (FFileHelper::SaveStringToFile(Content, *TargetFilePath))
+FBP2AIDocumentWriteResult FBP2AIBatchExporter::WriteCompleteBlueprintDocument(const FCompleteBlueprintData& Data, const FString& TargetFilePath, uint64 RecordedContentHash)
+{
+    if (TargetFilePath.IsEmpty())
     {
-        if (BP2AIExportConfig::bDetailedBlueprintLog)
-        {
-            UE_LOG(LogBP2AI, Log, TEXT("📘 Saved blueprint document: %s"), *TargetFilePath);
-        }
-        return true;
+        UE_LOG(LogBP2AI, Error, TEXT("WriteCompleteBlueprintDocument: Target file path is empty."));
+        return FBP2AIDocumentWriteResult();
     }
 
-    UE_LOG(LogBP2AI, Warning, TEXT("⚠️ Failed to save blueprint document: %s"), *TargetFilePath);
-    return false;
+    return FBP2AIDocumentWriter::WriteDocument(TargetFilePath,
+        [&Data](FBP2AIDocumentSink& Sink) { Data.WriteMarkdown(Sink); }, RecordedContentHash, true);
+}
+
+bool FBP2AIBatchExporter::WriteMarkdownFile(const FString& Content, const FString& TargetFilePath, bool bCreateDirectories)
+{
+    if (TargetFilePath.IsEmpty())
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("WriteMarkdownFile: Target file path is empty."));
+        return false;
+    }
+
+    const FBP2AIDocumentWriteResult Result = FBP2AIDocumentWriter::WriteDocument(TargetFilePath,
+        [&Content](FBP2AIDocumentSink& Sink) { Sink.Append(Content); }, 0, bCreateDirectories);
+    if (Result.IsSuccess() && BP2AIExportConfig::bDetailedBlueprintLog)
+    {
+        UE_LOG(LogBP2AI, Log, TEXT("📘 Saved blueprint document: %s"), *TargetFilePath);
+    }
+    return Result.IsSuccess();
 }
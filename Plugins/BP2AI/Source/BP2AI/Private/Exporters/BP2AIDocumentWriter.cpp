@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Exporters/BP2AIDocumentWriter.cpp
+
+#include "Exporters/BP2AIDocumentWriter.h"
+#include "Logging/BP2AILog.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#else
+#include <stdio.h>
+#endif
+
+namespace
+{
+    // 用临时文件替换目标文件。IFileManager::Move 在目标存在时先删除再移动，中间会短暂没有目标文件；
+    // 这里直接调用平台的替换式重命名：Windows 为 MoveFileExW(MOVEFILE_REPLACE_EXISTING)，POSIX 为 rename(2)。
+    // 同一卷内读者只会看到旧文件或完整的新文件，失败时旧文件保持不变
+    bool ReplaceFileWithTemp(const FString& TempFilePath, const FString& TargetFilePath)
+    {
+        const FString From = IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*TempFilePath);
+        const FString To = IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*TargetFilePath);
+#if PLATFORM_WINDOWS
+        return ::MoveFileExW(*From.Replace(TEXT("/"), TEXT("\\")), *To.Replace(TEXT("/"), TEXT("\\")),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return ::rename(TCHAR_TO_UTF8(*From), TCHAR_TO_UTF8(*To)) == 0;
+#endif
+    }
+
+    // 单个 TCHAR 编码为 UTF-8 的最大字节数（代理对两个 TCHAR 共 4 字节）
+    constexpr int32 MaxUTF8BytesPerChar = sizeof(TCHAR) == 2 ? 3 : 4;
+
+    bool IsHighSurrogate(TCHAR Char)
+    {
+        return sizeof(TCHAR) == 2 && Char >= 0xD800 && Char <= 0xDBFF;
+    }
+
+    bool IsLowSurrogate(TCHAR Char)
+    {
+        return sizeof(TCHAR) == 2 && Char >= 0xDC00 && Char <= 0xDFFF;
+    }
+}
+
+void FBP2AIDocumentSink::AppendLines(const TArray<FString>& Lines)
+{
+    for (int32 Index = 0; Index < Lines.Num(); ++Index)
+    {
+        if (Index > 0)
+        {
+            Append(TEXT("\n"));
+        }
+        Append(Lines[Index]);
+    }
+}
+
+FBP2AIDocumentWriter::FBP2AIDocumentWriter(const FString& InTargetFilePath)
+    : TargetFilePath(InTargetFilePath)
+    , TempFilePath(InTargetFilePath + TEXT(".tmp"))
+{
+}
+
+FBP2AIDocumentWriter::~FBP2AIDocumentWriter()
+{
+    if (Archive.IsValid())
+    {
+        Abort();
+    }
+}
+
+bool FBP2AIDocumentWriter::Open(bool bCreateDirectories)
+{
+    if (TargetFilePath.IsEmpty())
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Document writer target file path is empty."));
+        bError = true;
+        return false;
+    }
+
+    const FString DirectoryPath = FPaths::GetPath(TargetFilePath);
+    if (bCreateDirectories && !DirectoryPath.IsEmpty())
+    {
+        if (!IFileManager::Get().MakeDirectory(*DirectoryPath, true) && !FPaths::DirectoryExists(DirectoryPath))
+        {
+            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to create directory '%s'."), *DirectoryPath);
+        }
+    }
+
+    Archive.Reset(IFileManager::Get().CreateFileWriter(*TempFilePath, 0));
+    if (!Archive.IsValid())
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to open '%s' for writing."), *TempFilePath);
+        bError = true;
+        return false;
+    }
+
+    Buffer.SetNumUninitialized(BufferSize);
+    BufferUsed = 0;
+    BytesWritten = 0;
+    HashBuilder.Reset();
+    ContentHash = 0;
+    PendingHighSurrogate = 0;
+    bUnchanged = false;
+    bError = false;
+    return true;
+}
+
+void FBP2AIDocumentWriter::Append(FStringView Text)
+{
+    if ((!Archive.IsValid() && !bHashOnly) || bError || Text.IsEmpty())
+    {
+        return;
+    }
+
+    const TCHAR* Chars = Text.GetData();
+    int32 NumChars = Text.Len();
+
+    if (PendingHighSurrogate != 0)
+    {
+        const TCHAR Pair[2] = { PendingHighSurrogate, Chars[0] };
+        PendingHighSurrogate = 0;
+        if (IsLowSurrogate(Chars[0]))
+        {
+            EncodeChunk(Pair, 2);
+            ++Chars;
+            --NumChars;
+        }
+        else
+        {
+            EncodeChunk(Pair, 1);
+        }
+    }
+
+    if (NumChars > 0 && IsHighSurrogate(Chars[NumChars - 1]))
+    {
+        PendingHighSurrogate = Chars[NumChars - 1];
+        --NumChars;
+    }
+
+    EncodeChunk(Chars, NumChars);
+}
+
+void FBP2AIDocumentWriter::EncodeChunk(const TCHAR* Chars, int32 NumChars)
+{
+    while (NumChars > 0 && !bError)
+    {
+        const int32 Capacity = (BufferSize - BufferUsed) / MaxUTF8BytesPerChar;
+        if (Capacity < 2)
+        {
+            FlushBuffer();
+            continue;
+        }
+
+        int32 Count = FMath::Min(NumChars, Capacity);
+        if (Count < NumChars && IsHighSurrogate(Chars[Count - 1]))
+        {
+            // 不在缓冲区边界拆分代理对
+            --Count;
+        }
+
+        UTF8CHAR* const BufferStart = Buffer.GetData();
+        UTF8CHAR* const End = FPlatformString::Convert(BufferStart + BufferUsed, BufferSize - BufferUsed, Chars, Count);
+        if (!End)
+        {
+            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: UTF-8 conversion failed while writing '%s'."), *TargetFilePath);
+            bError = true;
+            return;
+        }
+
+        BufferUsed = static_cast<int32>(End - BufferStart);
+        Chars += Count;
+        NumChars -= Count;
+    }
+}
+
+void FBP2AIDocumentWriter::FlushBuffer()
+{
+    if (BufferUsed > 0 && !bError)
+    {
+        HashBuilder.Update(Buffer.GetData(), BufferUsed);
+        BytesWritten += BufferUsed;
+        if (Archive.IsValid())
+        {
+            Archive->Serialize(Buffer.GetData(), BufferUsed);
+            if (Archive->IsError())
+            {
+                UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Write error on '%s'."), *TempFilePath);
+                bError = true;
+            }
+        }
+    }
+    BufferUsed = 0;
+}
+
+bool FBP2AIDocumentWriter::IsExistingFileIdentical() const
+{
+    if (IFileManager::Get().FileSize(*TargetFilePath) != BytesWritten)
+    {
+        return false;
+    }
+
+    // 没有记录的哈希：读取现有文件比较（只在首次导出或清单丢失时发生）
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*TargetFilePath));
+    if (!Reader.IsValid())
+    {
+        return false;
+    }
+
+    TArray<uint8> ReadBuffer;
+    ReadBuffer.SetNumUninitialized(BufferSize);
+    FXxHash64Builder ExistingHash;
+    int64 Remaining = Reader->TotalSize();
+    while (Remaining > 0)
+    {
+        const int64 ChunkSize = FMath::Min<int64>(Remaining, BufferSize);
+        Reader->Serialize(ReadBuffer.GetData(), ChunkSize);
+        if (Reader->IsError())
+        {
+            return false;
+        }
+        ExistingHash.Update(ReadBuffer.GetData(), ChunkSize);
+        Remaining -= ChunkSize;
+    }
+    return ExistingHash.Finalize().Hash == ContentHash;
+}
+
+bool FBP2AIDocumentWriter::Commit()
+{
+    if (!Archive.IsValid())
+    {
+        return false;
+    }
+
+    if (PendingHighSurrogate != 0)
+    {
+        const TCHAR Orphan = PendingHighSurrogate;
+        PendingHighSurrogate = 0;
+        EncodeChunk(&Orphan, 1);
+    }
+    FlushBuffer();
+
+    const bool bClosed = Archive->Close() && !Archive->IsError();
+    Archive.Reset();
+    Buffer.Empty();
+    ContentHash = HashBuilder.Finalize().Hash;
+
+    if (!bClosed || bError)
+    {
+        IFileManager::Get().Delete(*TempFilePath, false, true, true);
+        UE_LOG(LogBP2AI, Warning, TEXT("⚠️ Failed to save blueprint document: %s"), *TargetFilePath);
+        return false;
+    }
+
+    if (bSkipIfUnchanged && IsExistingFileIdentical())
+    {
+        // 内容相同：保留原文件（修改时间不变，下游索引器不会被触发）
+        IFileManager::Get().Delete(*TempFilePath, false, true, true);
+        bUnchanged = true;
+        return true;
+    }
+
+    // 临时文件与目标在同一目录，替换式重命名在成功前不会动旧文件
+    if (!ReplaceFileWithTemp(TempFilePath, TargetFilePath))
+    {
+        IFileManager::Get().Delete(*TempFilePath, false, true, true);
+        UE_LOG(LogBP2AI, Warning, TEXT("⚠️ Failed to replace blueprint document: %s"), *TargetFilePath);
+        bError = true;
+        return false;
+    }
+    return true;
+}
+
+void FBP2AIDocumentWriter::Abort()
+{
+    if (Archive.IsValid())
+    {
+        Archive->Close();
+        Archive.Reset();
+    }
+    Buffer.Empty();
+    BufferUsed = 0;
+    PendingHighSurrogate = 0;
+    IFileManager::Get().Delete(*TempFilePath, false, true, true);
+}
+
+FBP2AIDocumentWriteResult FBP2AIDocumentWriter::WriteDocument(const FString& InTargetFilePath, TFunctionRef<void(FBP2AIDocumentSink&)> Render,
+    uint64 RecordedContentHash, bool bCreateDirectories)
+{
+    FBP2AIDocumentWriteResult Result;
+
+    // 有记录的哈希时先只做哈希：内容未变则不创建临时文件，也不读取现有文件
+    if (RecordedContentHash != 0)
+    {
+        const int64 ExistingSize = IFileManager::Get().FileSize(*InTargetFilePath);
+        if (ExistingSize >= 0)
+        {
+            int64 Bytes = 0;
+            const uint64 Hash = HashDocument(Render, Bytes);
+            if (Hash == RecordedContentHash && Bytes == ExistingSize)
+            {
+                Result.Status = EBP2AIDocumentWriteStatus::Unchanged;
+                Result.ContentHash = Hash;
+                Result.Bytes = Bytes;
+                return Result;
+            }
+        }
+    }
+
+    FBP2AIDocumentWriter Writer(InTargetFilePath);
+    if (!Writer.Open(bCreateDirectories))
+    {
+        return Result;
+    }
+
+    Render(Writer);
+    if (Writer.Commit())
+    {
+        Result.Status = Writer.WasUnchanged() ? EBP2AIDocumentWriteStatus::Unchanged : EBP2AIDocumentWriteStatus::Written;
+        Result.ContentHash = Writer.GetContentHash();
+        Result.Bytes = Writer.GetBytesWritten();
+    }
+    return Result;
+}
+
+uint64 FBP2AIDocumentWriter::HashDocument(TFunctionRef<void(FBP2AIDocumentSink&)> Render, int64& OutBytes)
+{
+    FBP2AIDocumentWriter Hasher;
+    Hasher.bHashOnly = true;
+    Hasher.Buffer.SetNumUninitialized(BufferSize);
+
+    Render(Hasher);
+    if (Hasher.PendingHighSurrogate != 0)
+    {
+        const TCHAR Orphan = Hasher.PendingHighSurrogate;
+        Hasher.PendingHighSurrogate = 0;
+        Hasher.EncodeChunk(&Orphan, 1);
+    }
+    Hasher.FlushBuffer();
+
+    OutBytes = Hasher.BytesWritten;
+    return Hasher.HashBuilder.Finalize().Hash;
+}
+
+FString FBP2AIDocumentWriter::ContentHashToString(uint64 Hash)
+{
+    return Hash != 0 ? FString::Printf(TEXT("%016llx"), Hash) : FString();
+}
+
+uint64 FBP2AIDocumentWriter::ContentHashFromString(const FString& HashString)
+{
+    return HashString.IsEmpty() ? 0 : FCString::Strtoui64(*HashString, nullptr, 16);
+}
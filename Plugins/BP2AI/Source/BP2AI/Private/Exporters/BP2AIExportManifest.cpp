@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Exporters/BP2AIExportManifest.cpp
+
+#include "Exporters/BP2AIExportManifest.h"
+#include "Exporters/BP2AIBatchExporter.h"
+#include "Exporters/BP2AIDocumentWriter.h"
+#include "Logging/BP2AILog.h"
+#include "Settings/BP2AIExportConfig.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Interfaces/IPluginManager.h"
+#include "IO/IoHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    FString GetPackageSavedHashString(IAssetRegistry& AssetRegistry, FName PackageName)
+    {
+        const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+        if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+        {
+            return FString();
+        }
+        return LexToString(PackageData->GetPackageSavedHash());
+    }
+
+    // 传递硬依赖闭包（不含自身），层数与快照阶段捕获被引用图表的上限一致：
+    // 输出会内联宏/折叠图/函数以及它们再引用的图表，间接依赖变化同样要使引用方失效。
+    // /Script 包没有包数据，只记录名字、不再展开
+    void CollectHardDependencyClosure(IAssetRegistry& AssetRegistry, FName PackageName, TSet<FName>& OutClosure)
+    {
+        TArray<FName> Frontier { PackageName };
+        TArray<FName> Dependencies;
+        for (int32 Depth = 0; Frontier.Num() > 0 && Depth < BP2AIExportConfig::PipelineReferencedGraphMaxDepth; ++Depth)
+        {
+            TArray<FName> NextFrontier;
+            for (const FName& Package : Frontier)
+            {
+                Dependencies.Reset();
+                AssetRegistry.GetDependencies(Package, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+                for (const FName& Dependency : Dependencies)
+                {
+                    bool bAlreadyInClosure = false;
+                    OutClosure.Add(Dependency, &bAlreadyInClosure);
+                    if (!bAlreadyInClosure && Dependency != PackageName && !Dependency.ToString().StartsWith(TEXT("/Script/")))
+                    {
+                        NextFrontier.Add(Dependency);
+                    }
+                }
+            }
+            Frontier = MoveTemp(NextFrontier);
+        }
+        OutClosure.Remove(PackageName);
+    }
+}
+
+FString FBP2AIExportManifest::GetDefaultManifestPath()
+{
+    return FBP2AIBatchExporter::GetDefaultExportDir() / TEXT("ExportManifest.json");
+}
+
+FString FBP2AIExportManifest::GetExporterVersion()
+{
+    FString PluginVersion = TEXT("Unknown");
+    if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("BP2AI")))
+    {
+        PluginVersion = Plugin->GetDescriptor().VersionName;
+    }
+    return FString::Printf(TEXT("%s/%d"), *PluginVersion, FormatVersion);
+}
+
+bool FBP2AIExportManifest::Load(const FString& InManifestPath)
+{
+    ManifestPath = InManifestPath;
+    Entries.Reset();
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *ManifestPath))
+    {
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AI: No export manifest at '%s', all assets will be exported."), *ManifestPath);
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Export manifest '%s' is corrupt, ignoring it."), *ManifestPath);
+        return false;
+    }
+
+    int32 Version = 0;
+    if (!Root->TryGetNumberField(TEXT("FormatVersion"), Version) || Version != FormatVersion)
+    {
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Export manifest format changed (%d -> %d), all assets will be exported."), Version, FormatVersion);
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* EntriesObject = nullptr;
+    if (!Root->TryGetObjectField(TEXT("Entries"), EntriesObject) || !EntriesObject)
+    {
+        return false;
+    }
+
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*EntriesObject)->Values)
+    {
+        const TSharedPtr<FJsonObject> EntryObject = Pair.Value.IsValid() ? Pair.Value->AsObject() : nullptr;
+        if (!EntryObject.IsValid())
+        {
+            continue;
+        }
+
+        FBP2AIExportManifestEntry Entry;
+        EntryObject->TryGetStringField(TEXT("PackageHash"), Entry.PackageHash);
+        EntryObject->TryGetStringField(TEXT("DependencyHash"), Entry.DependencyHash);
+        EntryObject->TryGetStringField(TEXT("ExporterVersion"), Entry.ExporterVersion);
+        EntryObject->TryGetStringField(TEXT("OutputPath"), Entry.OutputPath);
+        FString ContentHash;
+        EntryObject->TryGetStringField(TEXT("ContentHash"), ContentHash);
+        Entry.ContentHash = FBP2AIDocumentWriter::ContentHashFromString(ContentHash);
+        int64 SettingsHash = 0;
+        EntryObject->TryGetNumberField(TEXT("SettingsHash"), SettingsHash);
+        Entry.SettingsHash = static_cast<uint32>(SettingsHash);
+
+        Entries.Add(FName(*Pair.Key), MoveTemp(Entry));
+    }
+
+    UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Loaded export manifest with %d entries."), Entries.Num());
+    return true;
+}
+
+bool FBP2AIExportManifest::Save() const
+{
+    return SaveTo(ManifestPath);
+}
+
+bool FBP2AIExportManifest::SaveTo(const FString& InManifestPath) const
+{
+    if (InManifestPath.IsEmpty())
+    {
+        return false;
+    }
+
+    TSharedRef<FJsonObject> EntriesObject = MakeShared<FJsonObject>();
+    for (const TPair<FName, FBP2AIExportManifestEntry>& Pair : Entries)
+    {
+        TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+        EntryObject->SetStringField(TEXT("PackageHash"), Pair.Value.PackageHash);
+        EntryObject->SetStringField(TEXT("DependencyHash"), Pair.Value.DependencyHash);
+        EntryObject->SetStringField(TEXT("ExporterVersion"), Pair.Value.ExporterVersion);
+        EntryObject->SetNumberField(TEXT("SettingsHash"), static_cast<double>(Pair.Value.SettingsHash));
+        EntryObject->SetStringField(TEXT("OutputPath"), Pair.Value.OutputPath);
+        EntryObject->SetStringField(TEXT("ContentHash"), FBP2AIDocumentWriter::ContentHashToString(Pair.Value.ContentHash));
+        EntriesObject->SetObjectField(Pair.Key.ToString(), EntryObject);
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("FormatVersion"), FormatVersion);
+    Root->SetObjectField(TEXT("Entries"), EntriesObject);
+
+    FString JsonText;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+    if (!FJsonSerializer::Serialize(Root, Writer))
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(InManifestPath), true);
+    if (!FFileHelper::SaveStringToFile(JsonText, *InManifestPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to save export manifest '%s'."), *InManifestPath);
+        return false;
+    }
+    return true;
+}
+
+FBP2AIExportManifestEntry FBP2AIExportManifest::BuildCurrentEntry(IAssetRegistry& AssetRegistry, const FAssetData& AssetData, uint32 SettingsHash)
+{
+    FBP2AIExportManifestEntry Entry;
+    Entry.PackageHash = GetPackageSavedHashString(AssetRegistry, AssetData.PackageName);
+    Entry.ExporterVersion = GetExporterVersion();
+    Entry.SettingsHash = SettingsHash;
+
+    // 依赖哈希：排序后的传递硬依赖闭包 + 各自的保存哈希（/Script 包没有包数据，只记录名字）
+    TSet<FName> DependencyClosure;
+    CollectHardDependencyClosure(AssetRegistry, AssetData.PackageName, DependencyClosure);
+    TArray<FName> Dependencies = DependencyClosure.Array();
+    Dependencies.Sort(FNameLexicalLess());
+
+    FSHA1 Sha;
+    for (const FName& Dependency : Dependencies)
+    {
+        const FString Line = Dependency.ToString() + TEXT("=") + GetPackageSavedHashString(AssetRegistry, Dependency) + TEXT("\n");
+        Sha.UpdateWithString(*Line, Line.Len());
+    }
+    Sha.Final();
+    FSHAHash DependencyHash;
+    Sha.GetHash(DependencyHash.Hash);
+    Entry.DependencyHash = DependencyHash.ToString();
+
+    return Entry;
+}
+
+bool FBP2AIExportManifest::IsUpToDate(FName PackageName, const FBP2AIExportManifestEntry& CurrentEntry) const
+{
+    const FBP2AIExportManifestEntry* Previous = Entries.Find(PackageName);
+    if (!Previous || CurrentEntry.PackageHash.IsEmpty())
+    {
+        return false;
+    }
+
+    return Previous->PackageHash == CurrentEntry.PackageHash
+        && Previous->DependencyHash == CurrentEntry.DependencyHash
+        && Previous->ExporterVersion == CurrentEntry.ExporterVersion
+        && Previous->SettingsHash == CurrentEntry.SettingsHash
+        && !Previous->OutputPath.IsEmpty()
+        && IFileManager::Get().FileExists(*Previous->OutputPath);
+}
+
+void FBP2AIExportManifest::UpdateEntry(FName PackageName, const FBP2AIExportManifestEntry& Entry)
+{
+    Entries.Add(PackageName, Entry);
+}
+
+void FBP2AIExportManifest::Append(const FBP2AIExportManifest& Other)
+{
+    for (const TPair<FName, FBP2AIExportManifestEntry>& Pair : Other.Entries)
+    {
+        Entries.Add(Pair.Key, Pair.Value);
+    }
+}
+
+TMap<FName, FBP2AIExportManifestEntry> FBP2AIExportManifest::CollectPendingEntries(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Assets, uint32 SettingsHash, bool bFullExport) const
+{
+    TMap<FName, FBP2AIExportManifestEntry> PendingEntries;
+    for (const FAssetData& AssetData : Assets)
+    {
+        FBP2AIExportManifestEntry CurrentEntry = BuildCurrentEntry(AssetRegistry, AssetData, SettingsHash);
+        if (bFullExport || !IsUpToDate(AssetData.PackageName, CurrentEntry))
+        {
+            PendingEntries.Add(AssetData.PackageName, MoveTemp(CurrentEntry));
+        }
+    }
+    return PendingEntries;
+}
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Exporters/BP2AIExportPipeline.cpp
+
+#include "Exporters/BP2AIExportPipeline.h"
+#include "Exporters/BP2AIBatchExporter.h"
+#include "Exporters/BP2AIExportWriteQueue.h"
+#include "Logging/BP2AILog.h"
+#include "Engine/Blueprint.h"
+#include "Tasks/Task.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Package.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectIterator.h"
+#include "Misc/PackageName.h"
+#include "PackageTools.h"
+
+namespace
+{
+    // 流水线中的单个蓝图（游戏线程创建与提交，工作线程 / I/O 线程只访问 Snapshot/Document/WriteResult）
+    struct FPipelineItem
+    {
+        FAssetData AssetData;
+        FString AssetFullPath;
+        FString AssetName;
+        FString TargetFilePath;
+        int32 NodeCount = 0;
+        bool bLoadFailed = false;
+
+        // 保持 UBlueprint 存活直至提交：快照节点上的 TWeakObjectPtr 在追踪时用作跨追踪缓存键，构建期间不能失效
+        TStrongObjectPtr<UBlueprint> Blueprint;
+        TSharedPtr<FBlueprintExportSnapshot> Snapshot;
+
+        // 构建结果；写出阶段直接从它流式写文件，不再保留完整的文档字符串
+        TOptional<FCompleteBlueprintData> Document;
+        uint64 RecordedContentHash = 0;
+        FBP2AIDocumentWriteResult WriteResult;
+
+        UE::Tasks::FTask BuildTask;
+        UE::Tasks::FTaskEvent WriteDone { UE_SOURCE_LOCATION };
+    };
+
+    // 阶段2：追踪 + 构建。只读取快照（节点标题、被引用图表、枚举显示名与接口签名已在阶段1捕获），不查找或加载 UObject；
+    // 快照节点的 TWeakObjectPtr 仍被读作跨追踪缓存键，持有 GC 守卫使其在构建期间不被置空
+    void RunBuildStage(FPipelineItem& Item)
+    {
+        FGCScopeGuard GCGuard;
+        Item.Document.Emplace(FBP2AIBatchExporter::BuildFromSnapshot(*Item.Snapshot));
+        Item.Snapshot.Reset();
+    }
+
+    // 阶段3：写出（串行模式下在游戏线程直接执行）
+    void RunWriteStage(FPipelineItem& Item)
+    {
+        Item.WriteResult = FBP2AIBatchExporter::WriteCompleteBlueprintDocument(Item.Document.GetValue(), Item.TargetFilePath, Item.RecordedContentHash);
+        Item.Document.Reset();
+        Item.WriteDone.Trigger();
+    }
+
+    // 阶段3：交给专用 I/O 线程，构建任务完成后按入队顺序写出
+    void EnqueueWriteStage(FBP2AIExportWriteQueue& WriteQueue, const TSharedPtr<FPipelineItem>& Item)
+    {
+        FBP2AIExportWriteRequest Request;
+        Request.TargetFilePath = Item->TargetFilePath;
+        Request.RecordedContentHash = Item->RecordedContentHash;
+        Request.Prerequisite = Item->BuildTask;
+        Request.Render = [Item](FBP2AIDocumentSink& Sink) { Item->Document->WriteMarkdown(Sink); };
+        Request.OnCompleted = [Item](const FBP2AIDocumentWriteResult& Result)
+        {
+            Item->WriteResult = Result;
+            Item->Document.Reset();
+            Item->WriteDone.Trigger();
+        };
+        WriteQueue.Enqueue(MoveTemp(Request));
+    }
+
+    // 阶段0：异步预取窗口（只在游戏线程使用；加载回调也在游戏线程触发）
+    class FPackagePrefetcher
+    {
+    public:
+        static constexpr int32 MaxAutoWindow = 32;
+        // 加载后的蓝图包在内存中的大小相对磁盘大小的估算倍数
+        static constexpr int64 InMemoryExpansion = 4;
+
+        FPackagePrefetcher(const TArray<FAssetData>& InAssets, int32 InFixedWindow, int32 InMemoryBudgetMB)
+            : Assets(InAssets)
+            , FixedWindow(InFixedWindow)
+            , MemoryBudgetBytes(static_cast<int64>(InMemoryBudgetMB) * 1024 * 1024)
+        {
+            if (FixedWindow < 0 && Assets.Num() > 0)
+            {
+                IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+                int64 TotalBytes = 0;
+                for (const FAssetData& AssetData : Assets)
+                {
+                    const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName);
+                    TotalBytes += (PackageData.IsSet() && PackageData->DiskSize > 0) ? PackageData->DiskSize : 0;
+                }
+                AverageAssetBytes = FMath::Max<int64>(TotalBytes / Assets.Num(), 64 * 1024);
+            }
+        }
+
+        // 为 CurrentIndex 之后的资产补足预取请求
+        void TopUp(int32 CurrentIndex, const TFunction<bool(const FAssetData&)>& ShouldExport)
+        {
+            const int32 Window = ResolveWindow();
+            int32 Cursor = FMath::Max(NextToIssue, CurrentIndex + 1);
+            while (Requests.Num() < Window && Cursor < Assets.Num())
+            {
+                const FAssetData& AssetData = Assets[Cursor++];
+                if ((ShouldExport && !ShouldExport(AssetData)) || Requests.Contains(AssetData.PackageName))
+                {
+                    continue;
+                }
+
+                TSharedPtr<FRequest> Request = MakeShared<FRequest>();
+                Requests.Add(AssetData.PackageName, Request);
+                Request->RequestId = LoadPackageAsync(AssetData.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+                    [Request](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+                    {
+                        Request->bCompleted = true;
+                        if (LoadedPackage && Result == EAsyncLoadingResult::Succeeded)
+                        {
+                            Request->Package.Reset(LoadedPackage);
+                        }
+                    }));
+            }
+            NextToIssue = Cursor;
+        }
+
+        // 确保该包的预取已完成（之后的 GetAsset 直接命中内存）
+        void WaitFor(FName PackageName)
+        {
+            if (const TSharedPtr<FRequest>* Request = Requests.Find(PackageName))
+            {
+                if (!(*Request)->bCompleted && (*Request)->RequestId != INDEX_NONE)
+                {
+                    FlushAsyncLoading((*Request)->RequestId);
+                }
+            }
+        }
+
+        // 资产已由流水线条目持有，释放预取的强引用
+        void Release(FName PackageName)
+        {
+            Requests.Remove(PackageName);
+        }
+
+        // 推进一小段异步加载；没有未完成的请求时返回 false
+        bool Pump()
+        {
+            for (const TPair<FName, TSharedPtr<FRequest>>& Pair : Requests)
+            {
+                if (!Pair.Value->bCompleted)
+                {
+                    ProcessAsyncLoading(true, false, 0.002);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool IsPinned(FName PackageName) const
+        {
+            return Requests.Contains(PackageName);
+        }
+
+        // GC 前等待所有请求完成，已加载的包仍保持强引用
+        void FlushAll()
+        {
+            for (const TPair<FName, TSharedPtr<FRequest>>& Pair : Requests)
+            {
+                if (!Pair.Value->bCompleted && Pair.Value->RequestId != INDEX_NONE)
+                {
+                    FlushAsyncLoading(Pair.Value->RequestId);
+                }
+            }
+        }
+
+    private:
+        struct FRequest
+        {
+            int32 RequestId = INDEX_NONE;
+            bool bCompleted = false;
+            TStrongObjectPtr<UPackage> Package;
+        };
+
+        int32 ResolveWindow() const
+        {
+            if (FixedWindow >= 0)
+            {
+                return FixedWindow;
+            }
+            // 每次补足时按当前可用内存重新计算，内存紧张时窗口自动收缩
+            const int64 BudgetBytes = MemoryBudgetBytes > 0
+                ? MemoryBudgetBytes
+                : static_cast<int64>(FPlatformMemory::GetStats().AvailablePhysical / 4);
+            const int64 CostPerAsset = AverageAssetBytes * InMemoryExpansion;
+            return static_cast<int32>(FMath::Clamp<int64>(BudgetBytes / CostPerAsset, 1, MaxAutoWindow));
+        }
+
+        const TArray<FAssetData>& Assets;
+        const int32 FixedWindow;
+        const int64 MemoryBudgetBytes;
+        int64 AverageAssetBytes = 1024 * 1024;
+        int32 NextToIssue = 0;
+        TMap<FName, TSharedPtr<FRequest>> Requests;
+    };
+}
+
+FBP2AIExportPipeline::FBP2AIExportPipeline(const FBP2AIExportPipelineOptions& InOptions)
+    : Options(InOptions)
+{
+}
+
+int32 FBP2AIExportPipeline::ResolveMaxInFlight() const
+{
+    if (!Options.bParallel)
+    {
+        return 1;
+    }
+    if (Options.MaxInFlight > 0)
+    {
+        return Options.MaxInFlight;
+    }
+    // 每个工作线程保留两个在途项，使快照阶段与追踪阶段可以重叠
+    return FMath::Max(2, FTaskGraphInterface::Get().GetNumWorkerThreads() * 2);
+}
+
+uint64 FBP2AIExportPipeline::ResolveGcMemoryBudgetBytes() const
+{
+    if (Options.GcMemoryBudgetMB < 0)
+    {
+        return 0;
+    }
+    if (Options.GcMemoryBudgetMB > 0)
+    {
+        return static_cast<uint64>(Options.GcMemoryBudgetMB) * 1024 * 1024;
+    }
+    return FPlatformMemory::GetStats().TotalPhysical / 10 * 6;
+}
+
+FBP2AIExportPipelineSummary FBP2AIExportPipeline::Run(const TArray<FAssetData>& Assets)
+{
+    check(IsInGameThread());
+    check(Options.ResolveOutputPath);
+
+    FBP2AIExportPipelineSummary Summary;
+    Summary.TotalAssets = Assets.Num();
+
+    const int32 MaxInFlight = ResolveMaxInFlight();
+    TArray<TSharedPtr<FPipelineItem>> InFlight;
+    InFlight.Reserve(MaxInFlight);
+    TUniquePtr<FBP2AIExportWriteQueue> WriteQueue;
+    if (Options.bParallel)
+    {
+        WriteQueue = MakeUnique<FBP2AIExportWriteQueue>(MaxInFlight);
+    }
+    int32 CommittedSinceGc = 0;
+    FPackagePrefetcher Prefetcher(Assets, Options.PrefetchWindow, Options.PrefetchMemoryBudgetMB);
+
+    // 运行前已在内存中的包不属于“仅为导出而加载”，回收时不卸载
+    const uint64 GcMemoryBudgetBytes = ResolveGcMemoryBudgetBytes();
+    uint64 GcThresholdBytes = GcMemoryBudgetBytes;
+    TSet<FName> ResidentPackages;
+    for (TObjectIterator<UPackage> It; It; ++It)
+    {
+        ResidentPackages.Add(It->GetFName());
+    }
+
+    uint64 LastWorkingSetBytes = 0;
+    uint64 WorkingSetSampleSum = 0;
+    int32 WorkingSetSampleCount = 0;
+
+    // 阶段4：按顺序提交最早的条目
+    auto CommitOldest = [&]()
+    {
+        TSharedPtr<FPipelineItem> Item = InFlight[0];
+        InFlight.RemoveAt(0);
+
+        if (!Item->bLoadFailed)
+        {
+            // 等待期间推进预取的异步加载，让加载器与工作线程 / I/O 线程并行
+            while (!Item->WriteDone.IsCompleted())
+            {
+                if (!Prefetcher.Pump())
+                {
+                    Item->WriteDone.Wait();
+                    break;
+                }
+            }
+        }
+
+        const int32 ProgressIndex = Summary.SuccessCount + Summary.FailureCount + 1;
+        if (Item->bLoadFailed)
+        {
+            ++Summary.FailureCount;
+            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to load blueprint asset '%s'."), *Item->AssetName);
+        }
+        else if (Item->WriteResult.IsSuccess())
+        {
+            const bool bUnchanged = Item->WriteResult.Status == EBP2AIDocumentWriteStatus::Unchanged;
+            ++Summary.SuccessCount;
+            Summary.NodeCount += Item->NodeCount;
+            if (bUnchanged)
+            {
+                ++Summary.UnchangedFileCount;
+            }
+            else
+            {
+                Summary.BytesWritten += Item->WriteResult.Bytes;
+            }
+            UE_LOG(LogBP2AI, Log, TEXT("BP2AI: [%d/%d] %s%s"), ProgressIndex, Summary.TotalAssets, *Item->AssetFullPath, bUnchanged ? TEXT(" (Unchanged)") : TEXT(""));
+            if (Options.OnAssetExported)
+            {
+                Options.OnAssetExported(Item->AssetData, Item->TargetFilePath, Item->WriteResult.ContentHash);
+            }
+        }
+        else
+        {
+            ++Summary.FailureCount;
+            ++Summary.WriteFailureCount;
+            UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: [%d/%d] %s (Failed to save)"), ProgressIndex, Summary.TotalAssets, *Item->AssetFullPath);
+        }
+
+        Item->Blueprint.Reset();
+        ++CommittedSinceGc;
+
+        LastWorkingSetBytes = FPlatformMemory::GetStats().UsedPhysical;
+        Summary.PeakWorkingSetBytes = FMath::Max(Summary.PeakWorkingSetBytes, LastWorkingSetBytes);
+        WorkingSetSampleSum += LastWorkingSetBytes;
+        ++WorkingSetSampleCount;
+    };
+
+    auto Drain = [&]()
+    {
+        while (InFlight.Num() > 0)
+        {
+            CommitOldest();
+        }
+    };
+
+    auto ShouldReleaseMemory = [&]()
+    {
+        if (GcThresholdBytes > 0 && LastWorkingSetBytes >= GcThresholdBytes)
+        {
+            return true;
+        }
+        return Options.GcInterval > 0 && CommittedSinceGc >= Options.GcInterval;
+    };
+
+    // 排空流水线后卸载仅为导出而加载的包并回收（工作线程不再持有任何模型引用）
+    auto ReleaseMemory = [&]()
+    {
+        Drain();
+        Prefetcher.FlushAll();
+
+        TArray<UPackage*> PackagesToUnload;
+        for (TObjectIterator<UPackage> It; It; ++It)
+        {
+            UPackage* Package = *It;
+            const FName PackageName = Package->GetFName();
+            if (ResidentPackages.Contains(PackageName)
+                || Prefetcher.IsPinned(PackageName)
+                || Package->IsDirty()
+                || Package->HasAnyPackageFlags(PKG_CompiledIn)
+                || FPackageName::IsTempPackage(PackageName.ToString()))
+            {
+                continue;
+            }
+            PackagesToUnload.Add(Package);
+        }
+
+        const uint64 WorkingSetBefore = FPlatformMemory::GetStats().UsedPhysical;
+        if (PackagesToUnload.Num() > 0)
+        {
+            // UnloadPackages 会清除 RF_Standalone、重置加载器并执行 GC
+            FText ErrorMessage;
+            if (!UPackageTools::UnloadPackages(PackagesToUnload, ErrorMessage))
+            {
+                UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to unload export packages: %s"), *ErrorMessage.ToString());
+                CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            }
+            Summary.UnloadedPackageCount += PackagesToUnload.Num();
+        }
+        else
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+
+        ++Summary.GcCount;
+        CommittedSinceGc = 0;
+        LastWorkingSetBytes = FPlatformMemory::GetStats().UsedPhysical;
+
+        // 回收后仍超出预算（常驻内存本身就很大）时抬高阈值，避免每个蓝图都触发回收
+        GcThresholdBytes = (GcMemoryBudgetBytes > 0 && LastWorkingSetBytes >= GcMemoryBudgetBytes)
+            ? LastWorkingSetBytes + GcMemoryBudgetBytes / 10
+            : GcMemoryBudgetBytes;
+
+        UE_LOG(LogBP2AI, Log, TEXT("BP2AI: Released export memory (%d package(s) unloaded): %.1f MB -> %.1f MB"),
+            PackagesToUnload.Num(), WorkingSetBefore / (1024.0 * 1024.0), LastWorkingSetBytes / (1024.0 * 1024.0));
+    };
+
+    for (int32 Index = 0; Index < Assets.Num(); ++Index)
+    {
+        const FAssetData& AssetData = Assets[Index];
+        if (Options.OnAssetStarted && !Options.OnAssetStarted(Index, Summary.TotalAssets, AssetData))
+        {
+            Summary.bCancelled = true;
+            break;
+        }
+        if (Options.ShouldExportAsset && !Options.ShouldExportAsset(AssetData))
+        {
+            ++Summary.SkippedCount;
+            continue;
+        }
+
+        TSharedPtr<FPipelineItem> Item = MakeShared<FPipelineItem>();
+        Item->AssetData = AssetData;
+        Item->AssetFullPath = AssetData.GetObjectPathString();
+        Item->AssetName = AssetData.AssetName.ToString();
+
+        // 阶段0：为后续资产发起预取，并确保当前资产的预取已完成
+        Prefetcher.TopUp(Index, Options.ShouldExportAsset);
+        Prefetcher.WaitFor(AssetData.PackageName);
+
+        // 阶段1：加载 + 快照（游戏线程）
+        UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+        Prefetcher.Release(AssetData.PackageName);
+        if (!Blueprint)
+        {
+            Item->bLoadFailed = true;
+        }
+        else
+        {
+            Item->Blueprint.Reset(Blueprint);
+            Item->Snapshot = MakeShared<FBlueprintExportSnapshot>(
+                FBP2AIBatchExporter::CaptureBlueprintSnapshot(Blueprint, Options.bIncludeNestedFunctions));
+            Item->TargetFilePath = Options.ResolveOutputPath(AssetData, Item->Snapshot->Data.BlueprintName);
+            Item->RecordedContentHash = Options.GetRecordedContentHash ? Options.GetRecordedContentHash(AssetData) : 0;
+            for (const FGraphExportSnapshot& GraphSnapshot : Item->Snapshot->Graphs)
+            {
+                Item->NodeCount += GraphSnapshot.NodeCount;
+            }
+
+            if (WriteQueue.IsValid())
+            {
+                Item->BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Item]() { RunBuildStage(*Item); });
+                EnqueueWriteStage(*WriteQueue, Item);
+            }
+            else
+            {
+                RunBuildStage(*Item);
+                RunWriteStage(*Item);
+            }
+        }
+
+        InFlight.Add(Item);
+        while (InFlight.Num() >= MaxInFlight)
+        {
+            CommitOldest();
+        }
+
+        // GC 前排空流水线，避免工作线程持有的模型引用到被回收的对象
+        if (ShouldReleaseMemory())
+        {
+            ReleaseMemory();
+        }
+    }
+
+    Drain();
+
+    if (WorkingSetSampleCount > 0)
+    {
+        Summary.AverageWorkingSetBytes = WorkingSetSampleSum / WorkingSetSampleCount;
+    }
+
+    if (Summary.bCancelled)
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Export cancelled by user. Processed: %d/%d"), Summary.SuccessCount + Summary.FailureCount, Summary.TotalAssets);
+    }
+
+    return Summary;
+}
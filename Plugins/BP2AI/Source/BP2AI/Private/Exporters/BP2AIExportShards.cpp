@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Exporters/BP2AIExportShards.cpp
+
+#include "Exporters/BP2AIExportShards.h"
+#include "Exporters/BP2AIExportManifest.h"
+#include "Logging/BP2AILog.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    bool SaveJsonObject(const TSharedRef<FJsonObject>& Object, const FString& FilePath)
+    {
+        FString JsonText;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+        if (!FJsonSerializer::Serialize(Object, Writer))
+        {
+            return false;
+        }
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+        return FFileHelper::SaveStringToFile(JsonText, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    }
+
+    TSharedPtr<FJsonObject> LoadJsonObject(const FString& FilePath)
+    {
+        FString JsonText;
+        if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+        {
+            return nullptr;
+        }
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+        if (!FJsonSerializer::Deserialize(Reader, Object))
+        {
+            return nullptr;
+        }
+        return Object;
+    }
+}
+
+bool FBP2AIExportShard::Parse(const FString& Value, FBP2AIExportShard& OutShard)
+{
+    FString IndexStr;
+    FString CountStr;
+    if (!Value.Split(TEXT("/"), &IndexStr, &CountStr) || !IndexStr.IsNumeric() || !CountStr.IsNumeric())
+    {
+        return false;
+    }
+
+    const int32 ParsedIndex = FCString::Atoi(*IndexStr);
+    const int32 ParsedCount = FCString::Atoi(*CountStr);
+    if (ParsedCount < 1 || ParsedIndex < 0 || ParsedIndex >= ParsedCount)
+    {
+        return false;
+    }
+
+    OutShard.Index = ParsedIndex;
+    OutShard.Count = ParsedCount;
+    return true;
+}
+
+TArray<FAssetData> FBP2AIExportShards::SelectShard(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Assets, const FBP2AIExportShard& Shard)
+{
+    if (!Shard.IsSharded())
+    {
+        return Assets;
+    }
+
+    struct FSizedAsset
+    {
+        int32 AssetIndex;
+        int64 Size;
+    };
+
+    TArray<FSizedAsset> SizedAssets;
+    SizedAssets.Reserve(Assets.Num());
+    for (int32 Index = 0; Index < Assets.Num(); ++Index)
+    {
+        const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Assets[Index].PackageName);
+        const int64 DiskSize = PackageData.IsSet() ? PackageData->DiskSize : -1;
+        SizedAssets.Add({ Index, FMath::Max<int64>(DiskSize, 1) });
+    }
+
+    // 大包优先；大小相同按包名，保证每个进程得到相同的划分
+    SizedAssets.Sort([&Assets](const FSizedAsset& A, const FSizedAsset& B)
+    {
+        if (A.Size != B.Size)
+        {
+            return A.Size > B.Size;
+        }
+        return Assets[A.AssetIndex].PackageName.LexicalLess(Assets[B.AssetIndex].PackageName);
+    });
+
+    TArray<int64> ShardLoads;
+    ShardLoads.SetNumZeroed(Shard.Count);
+
+    TArray<FAssetData> Selected;
+    for (const FSizedAsset& SizedAsset : SizedAssets)
+    {
+        int32 LightestShard = 0;
+        for (int32 ShardIndex = 1; ShardIndex < Shard.Count; ++ShardIndex)
+        {
+            if (ShardLoads[ShardIndex] < ShardLoads[LightestShard])
+            {
+                LightestShard = ShardIndex;
+            }
+        }
+        ShardLoads[LightestShard] += SizedAsset.Size;
+
+        if (LightestShard == Shard.Index)
+        {
+            Selected.Add(Assets[SizedAsset.AssetIndex]);
+        }
+    }
+
+    Selected.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+    UE_LOG(LogBP2AI, Display, TEXT("BP2AI: Shard %d/%d -> %d of %d blueprint(s), %lld bytes."),
+        Shard.Index, Shard.Count, Selected.Num(), Assets.Num(), ShardLoads[Shard.Index]);
+    return Selected;
+}
+
+FString FBP2AIExportShards::GetShardDir(const FString& OutputDir)
+{
+    return OutputDir / TEXT("_Shards");
+}
+
+FString FBP2AIExportShards::GetPartialIndexPath(const FString& OutputDir, const FBP2AIExportShard& Shard)
+{
+    return GetShardDir(OutputDir) / FString::Printf(TEXT("Index_%s.json"), *Shard.GetName());
+}
+
+FString FBP2AIExportShards::GetPartialManifestPath(const FString& OutputDir, const FBP2AIExportShard& Shard)
+{
+    return GetShardDir(OutputDir) / FString::Printf(TEXT("ExportManifest_%s.json"), *Shard.GetName());
+}
+
+FString FBP2AIExportShards::GetProjectIndexPath(const FString& OutputDir)
+{
+    return OutputDir / TEXT("Index.json");
+}
+
+bool FBP2AIExportShards::WritePartialIndex(const FString& OutputDir, const FBP2AIExportShard& Shard, const TArray<FBP2AIExportIndexEntry>& Entries)
+{
+    TArray<TSharedPtr<FJsonValue>> EntryValues;
+    EntryValues.Reserve(Entries.Num());
+    for (const FBP2AIExportIndexEntry& Entry : Entries)
+    {
+        TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+        EntryObject->SetStringField(TEXT("Package"), Entry.PackageName);
+        EntryObject->SetStringField(TEXT("File"), Entry.OutputFile);
+        EntryValues.Add(MakeShared<FJsonValueObject>(EntryObject));
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("ShardIndex"), Shard.Index);
+    Root->SetNumberField(TEXT("ShardCount"), Shard.Count);
+    Root->SetArrayField(TEXT("Entries"), EntryValues);
+
+    const FString PartialIndexPath = GetPartialIndexPath(OutputDir, Shard);
+    if (!SaveJsonObject(Root, PartialIndexPath))
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Failed to write partial index '%s'."), *PartialIndexPath);
+        return false;
+    }
+    return true;
+}
+
+bool FBP2AIExportShards::Merge(const FString& OutputDir, const FString& ManifestPath, int32 ExpectedShardCount)
+{
+    const FString ShardDir = GetShardDir(OutputDir);
+
+    TArray<FString> IndexFiles;
+    IFileManager::Get().FindFiles(IndexFiles, *(ShardDir / TEXT("Index_*.json")), true, false);
+    IndexFiles.Sort();
+    if (IndexFiles.Num() == 0)
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: No partial indexes found in '%s'."), *ShardDir);
+        return false;
+    }
+
+    // ---- 读取并校验部分索引 ----
+    int32 ShardCount = ExpectedShardCount;
+    TSet<int32> SeenShards;
+    TMap<FString, FString> MergedEntries;
+    for (const FString& IndexFile : IndexFiles)
+    {
+        const TSharedPtr<FJsonObject> Root = LoadJsonObject(ShardDir / IndexFile);
+        int32 FileShardIndex = INDEX_NONE;
+        int32 FileShardCount = 0;
+        if (!Root.IsValid() || !Root->TryGetNumberField(TEXT("ShardIndex"), FileShardIndex) || !Root->TryGetNumberField(TEXT("ShardCount"), FileShardCount))
+        {
+            UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Partial index '%s' is corrupt."), *IndexFile);
+            return false;
+        }
+        if (ShardCount <= 0)
+        {
+            ShardCount = FileShardCount;
+        }
+        if (FileShardCount != ShardCount)
+        {
+            UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Partial index '%s' belongs to a %d-shard run, expected %d. Remove stale shard outputs and re-run."), *IndexFile, FileShardCount, ShardCount);
+            return false;
+        }
+        SeenShards.Add(FileShardIndex);
+
+        const TArray<TSharedPtr<FJsonValue>>* EntryValues = nullptr;
+        if (Root->TryGetArrayField(TEXT("Entries"), EntryValues))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *EntryValues)
+            {
+                const TSharedPtr<FJsonObject> EntryObject = Value.IsValid() ? Value->AsObject() : nullptr;
+                FString PackageName;
+                FString OutputFile;
+                if (EntryObject.IsValid() && EntryObject->TryGetStringField(TEXT("Package"), PackageName) && EntryObject->TryGetStringField(TEXT("File"), OutputFile))
+                {
+                    MergedEntries.Add(PackageName, OutputFile);
+                }
+            }
+        }
+    }
+
+    if (SeenShards.Num() != ShardCount)
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Only %d of %d shard(s) finished; project index not written."), SeenShards.Num(), ShardCount);
+        return false;
+    }
+
+    // ---- 写出项目索引（按包名排序，与分片数量无关） ----
+    MergedEntries.KeySort([](const FString& A, const FString& B) { return A < B; });
+
+    TArray<TSharedPtr<FJsonValue>> EntryValues;
+    EntryValues.Reserve(MergedEntries.Num());
+    for (const TPair<FString, FString>& Pair : MergedEntries)
+    {
+        TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+        EntryObject->SetStringField(TEXT("Package"), Pair.Key);
+        EntryObject->SetStringField(TEXT("File"), Pair.Value);
+        EntryValues.Add(MakeShared<FJsonValueObject>(EntryObject));
+    }
+
+    TSharedRef<FJsonObject> IndexRoot = MakeShared<FJsonObject>();
+    IndexRoot->SetStringField(TEXT("ExporterVersion"), FBP2AIExportManifest::GetExporterVersion());
+    IndexRoot->SetArrayField(TEXT("Blueprints"), EntryValues);
+
+    const FString ProjectIndexPath = GetProjectIndexPath(OutputDir);
+    if (!SaveJsonObject(IndexRoot, ProjectIndexPath))
+    {
+        UE_LOG(LogBP2AI, Error, TEXT("BP2AI: Failed to write project index '%s'."), *ProjectIndexPath);
+        return false;
+    }
+
+    // ---- 部分清单并入主清单 ----
+    if (!ManifestPath.IsEmpty())
+    {
+        FBP2AIExportManifest Manifest;
+        Manifest.Load(ManifestPath);
+        for (int32 ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+        {
+            FBP2AIExportShard Shard;
+            Shard.Index = ShardIndex;
+            Shard.Count = ShardCount;
+
+            FBP2AIExportManifest PartialManifest;
+            if (PartialManifest.Load(GetPartialManifestPath(OutputDir, Shard)))
+            {
+                Manifest.Append(PartialManifest);
+            }
+        }
+        Manifest.SaveTo(ManifestPath);
+    }
+
+    // 合并完成后清理部分输出，避免下一次合并读到过期分片
+    IFileManager::Get().DeleteDirectory(*ShardDir, false, true);
+
+    UE_LOG(LogBP2AI, Display, TEXT("BP2AI: Merged %d shard(s) into '%s' (%d blueprint(s))."), ShardCount, *ProjectIndexPath, MergedEntries.Num());
+    return true;
+}
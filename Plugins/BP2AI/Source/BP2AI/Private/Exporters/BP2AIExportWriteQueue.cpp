@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Exporters/BP2AIExportWriteQueue.cpp
+
+#include "Exporters/BP2AIExportWriteQueue.h"
+#include "Logging/BP2AILog.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+FBP2AIExportWriteQueue::FBP2AIExportWriteQueue(int32 InCapacity)
+    : Capacity(FMath::Max(1, InCapacity))
+{
+    Pending.Reserve(Capacity);
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    SpaceEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("BP2AIExportWriter"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("BP2AI: Failed to start the export writer thread, documents will be written synchronously."));
+    }
+}
+
+FBP2AIExportWriteQueue::~FBP2AIExportWriteQueue()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    FPlatformProcess::ReturnSynchEventToPool(SpaceEvent);
+}
+
+void FBP2AIExportWriteQueue::Enqueue(FBP2AIExportWriteRequest&& Request)
+{
+    if (!Thread)
+    {
+        Process(Request);
+        return;
+    }
+
+    while (true)
+    {
+        {
+            FScopeLock Lock(&Mutex);
+            if (Pending.Num() < Capacity)
+            {
+                Pending.Add(MoveTemp(Request));
+                break;
+            }
+        }
+        SpaceEvent->Wait();
+    }
+    WorkEvent->Trigger();
+}
+
+uint32 FBP2AIExportWriteQueue::Run()
+{
+    while (true)
+    {
+        FBP2AIExportWriteRequest Request;
+        bool bHasRequest = false;
+        {
+            FScopeLock Lock(&Mutex);
+            if (Pending.Num() > 0)
+            {
+                Request = MoveTemp(Pending[0]);
+                Pending.RemoveAt(0);
+                bHasRequest = true;
+            }
+            else if (bStopping)
+            {
+                break;
+            }
+        }
+
+        if (!bHasRequest)
+        {
+            WorkEvent->Wait();
+            continue;
+        }
+
+        SpaceEvent->Trigger();
+        Process(Request);
+    }
+    return 0;
+}
+
+void FBP2AIExportWriteQueue::Stop()
+{
+    // 不丢弃已入队的请求：线程在队列清空后退出
+    bStopping = true;
+    WorkEvent->Trigger();
+}
+
+void FBP2AIExportWriteQueue::Process(FBP2AIExportWriteRequest& Request)
+{
+    if (Request.Prerequisite.IsValid())
+    {
+        Request.Prerequisite.Wait();
+    }
+
+    const FBP2AIDocumentWriteResult Result = Request.Render
+        ? FBP2AIDocumentWriter::WriteDocument(Request.TargetFilePath, Request.Render, Request.RecordedContentHash, true)
+        : FBP2AIDocumentWriteResult();
+
+    // 先释放渲染闭包（持有构建好的文档），再通知完成
+    Request.Render = nullptr;
+    if (Request.OnCompleted)
+    {
+        Request.OnCompleted(Result);
+    }
+}
@@ -7,6 +7,10 @@
 
 
 #include "Extractors/BlueprintDataExtractor.h"
+#include "Extractors/BlueprintExtractionCache.h"
+#include "Extractors/BlueprintGraphPathCache.h"
+#include "Extractors/BlueprintReferencedGraphs.h"
+#include "Models/BlueprintGraphSnapshot.h"
 #include "Logging/BP2AILog.h"
 #include "Models/BlueprintNodeFactory.h"
 #include "EdGraph/EdGraphNode.h"
@@ -24,6 +28,7 @@
 #include "UObject/TopLevelAssetPath.h"
 #include "EdGraph/EdGraphSchema.h"
 #include "Editor.h"
+#include "Misc/ScopeLock.h"
 
 FBlueprintDataExtractor::FBlueprintDataExtractor()
 {
@@ -33,17 +38,21 @@ FBlueprintDataExtractor::~FBlueprintDataExtractor()
 {
 }
 
-TMap<FString, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSelectedNodes(
+TMap<FGuid, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSelectedNodes(
     const TArray<UEdGraphNode*>& SelectedNodes,
     bool bIncludeNestedFunctions) const
 {
-    TMap<FString, TSharedPtr<FBlueprintNode>> BlueprintNodes;
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> BlueprintNodes;
 
     if (SelectedNodes.Num() == 0)
     {
         return BlueprintNodes;
     }
 
+    // UEdGraphNode 的标题/引脚缓存不是线程安全的：提取与节点标题的延迟解析（FBlueprintNode::GetName）共用这把锁。
+    // 批量导出的工作线程只读取快照（标题与引用图表已在游戏线程捕获），不会走到这里。
+    FScopeLock ExtractionLock(&FBlueprintNode::GetEdGraphAccessLock());
+
     TArray<UEdGraphNode*> NodesToProcess = SelectedNodes;
 
     if (bIncludeNestedFunctions)
@@ -52,21 +61,14 @@ TMap<FString, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSe
     }
 
     UE_LOG(LogExtractor, Log, TEXT("FBlueprintDataExtractor: Starting node data extraction..."));
-    for (UEdGraphNode* Node : NodesToProcess)
+    for (const TSharedPtr<FBlueprintNode>& ExtractedNode : ExtractNodeData(NodesToProcess))
     {
-        if (!Node)
-        {
-            continue;
-        }
-
-        TSharedPtr<FBlueprintNode> ExtractedNode = ExtractNodeData(Node);
-
         if (ExtractedNode.IsValid()) {
             if (!ExtractedNode->Guid.IsEmpty()) {
-                BlueprintNodes.Add(ExtractedNode->Guid, ExtractedNode);
+                BlueprintNodes.Add(ExtractedNode->GraphNodeGuid, ExtractedNode);
             } else {
                 UE_LOG(LogExtractor, Error, TEXT("FBlueprintDataExtractor: Extracted node is missing GUID! Node Title: %s"), 
-                       Node->GetNodeTitle(ENodeTitleType::ListView).IsEmpty() ? TEXT("[NoTitle]") : *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+                       ExtractedNode->GetLogName().IsEmpty() ? TEXT("[NoTitle]") : *ExtractedNode->GetLogName());
             }
         }
     }
@@ -80,8 +82,8 @@ TMap<FString, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSe
         const TSharedPtr<FBlueprintNode>& Node = NodePair.Value;
         if (Node.IsValid() && Node->NodeType == TEXT("GetDataTableRow"))
         {
-            UE_LOG(LogExtractor, Error, TEXT("  Node: %s (GUID: %s)"), *Node->Name, *Node->Guid.Left(8));
-            TSharedPtr<FBlueprintPin> dtPin = Node->GetPin(TEXT("DataTable"), TEXT("EGPD_Input"));
+            UE_LOG(LogExtractor, Error, TEXT("  Node: %s (GUID: %s)"), *Node->GetLogName(), *Node->Guid.Left(8));
+            TSharedPtr<FBlueprintPin> dtPin = Node->GetPin(TEXT("DataTable"), EGPD_Input);
             if (dtPin.IsValid())
             {
                 UE_LOG(LogExtractor, Error, TEXT("    Pin: '%s' (ID:%s), SourcePinFor.Num: %d, DefaultObject: '%s'"),
@@ -95,7 +97,7 @@ TMap<FString, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSe
                     }
                 }
             }
-            TSharedPtr<FBlueprintPin> rnPin = Node->GetPin(TEXT("RowName"), TEXT("EGPD_Input"));
+            TSharedPtr<FBlueprintPin> rnPin = Node->GetPin(TEXT("RowName"), EGPD_Input);
             if (rnPin.IsValid())
             {
                 UE_LOG(LogExtractor, Error, TEXT("    Pin: '%s' (ID:%s), SourcePinFor.Num: %d, DefaultValue: '%s'"),
@@ -119,10 +121,32 @@ TMap<FString, TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractFromSe
 // REFACTORED ExtractNodesFromGraph - Main orchestrator
 // =============================================================================
 
-bool FBlueprintDataExtractor::ExtractNodesFromGraph(const FString& GraphPath, TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const
+bool FBlueprintDataExtractor::ExtractNodesFromGraph(const FString& GraphPath, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const
 {
     OutNodes.Empty();
 
+    // 批量导出构建阶段：只使用捕获阶段准备好的引用图表快照，不解析或加载 UEdGraph
+    if (const FBlueprintReferencedGraphMap* CapturedGraphs = FBlueprintReferencedGraphScope::GetActive())
+    {
+        const TSharedPtr<const FBlueprintGraphSnapshot>* Captured = CapturedGraphs->Find(GraphPath);
+        if (!Captured || !Captured->IsValid())
+        {
+            UE_LOG(LogExtractor, Warning, TEXT("ExtractNodesFromGraph: Graph '%s' was not captured with the blueprint snapshot."), *GraphPath);
+            return false;
+        }
+        OutNodes = (*Captured)->CreateCompatibilityView();
+        return true;
+    }
+
+    // 其余情况会查找/加载 UEdGraph，只允许在游戏线程
+    if (!IsInGameThread())
+    {
+        UE_LOG(LogExtractor, Warning, TEXT("ExtractNodesFromGraph: Graph '%s' cannot be resolved off the game thread without a captured snapshot."), *GraphPath);
+        return false;
+    }
+
+    FScopeLock ExtractionLock(&FBlueprintNode::GetEdGraphAccessLock());
+
     UE_LOG(LogExtractor, Error, TEXT("ExtractNodesFromGraph: ENTRY - Attempting to extract from GraphPath: '%s'"), *GraphPath);
 
     // Phase 1: Resolve the target graph
@@ -136,6 +160,12 @@ bool FBlueprintDataExtractor::ExtractNodesFromGraph(const FString& GraphPath, TM
     UE_LOG(LogExtractor, Error, TEXT("ExtractNodesFromGraph: Graph resolved for Path '%s'. Graph Name: '%s', PathName: '%s'. Contains %d nodes."), 
            *GraphPath, *TargetGraph->GetName(), *TargetGraph->GetPathName(), TargetGraph->Nodes.Num());
 
+    // 自上次编辑以来已转换过的图表直接复用缓存的节点模型
+    if (FBlueprintExtractionCache::Get().Find(TargetGraph, OutNodes))
+    {
+        return true;
+    }
+
     // Phase 2: Handle empty graphs (diagnostics + interventions)
     if (TargetGraph->Nodes.Num() == 0)
     {
@@ -153,6 +183,10 @@ bool FBlueprintDataExtractor::ExtractNodesFromGraph(const FString& GraphPath, TM
 
     // Phase 3: Process the graph nodes
     bool bSuccess = ProcessGraphNodes(TargetGraph, OutNodes);
+    if (bSuccess)
+    {
+        FBlueprintExtractionCache::Get().Store(TargetGraph, OutNodes);
+    }
 
     UE_LOG(LogExtractor, Error, TEXT("ExtractNodesFromGraph: EXIT - Finished extraction for graph '%s' (Path: '%s'). Final OutNodes count: %d. Success: %s"),
            *TargetGraph->GetName(), *GraphPath, OutNodes.Num(), bSuccess ? TEXT("true") : TEXT("false"));
@@ -166,15 +200,22 @@ bool FBlueprintDataExtractor::ExtractNodesFromGraph(const FString& GraphPath, TM
 
 UEdGraph* FBlueprintDataExtractor::ResolveTargetGraph(const FString& GraphPath) const
 {
-    // Try direct lookup first
+    // 会话级路径缓存：同一图表在追踪中会按路径反复解析
+    FBlueprintGraphPathCache& PathCache = FBlueprintGraphPathCache::Get();
+    if (UEdGraph* CachedGraph = PathCache.Find(GraphPath))
+    {
+        return CachedGraph;
+    }
+
+    // Try direct lookup first, then loading from package
     UEdGraph* TargetGraph = TryFindGraph(GraphPath);
-    if (TargetGraph)
+    if (!TargetGraph)
     {
-        return TargetGraph;
+        TargetGraph = LoadGraphFromPackage(GraphPath);
     }
 
-    // Try loading from package
-    return LoadGraphFromPackage(GraphPath);
+    PathCache.Add(GraphPath, TargetGraph);
+    return TargetGraph;
 }
 
 UEdGraph* FBlueprintDataExtractor::TryFindGraph(const FString& GraphPath) const
@@ -184,6 +225,13 @@ UEdGraph* FBlueprintDataExtractor::TryFindGraph(const FString& GraphPath) const
 
 UEdGraph* FBlueprintDataExtractor::LoadGraphFromPackage(const FString& GraphPath) const
 {
+    // 同步加载只能在游戏线程进行（批量导出的工作线程从捕获的快照提取，不会走到这里）
+    if (!IsInGameThread())
+    {
+        UE_LOG(LogExtractor, Warning, TEXT("ResolveTargetGraph: Graph '%s' is not loaded and cannot be loaded off the game thread."), *GraphPath);
+        return nullptr;
+    }
+
     UE_LOG(LogExtractor, Warning, TEXT("ResolveTargetGraph: Direct lookup failed for '%s'. Attempting package load..."), *GraphPath);
 
     FString PackageNameStr = FPackageName::ObjectPathToPackageName(GraphPath);
@@ -220,8 +268,8 @@ void FBlueprintDataExtractor::HandleEmptyGraph(UEdGraph* Graph, const FString& G
     // Perform diagnostics
     DiagnoseEmptyGraph(Graph, GraphPath, OwningBP);
     
-    // Attempt interventions if this is a problematic case
-    if (IsProblematicMainEventGraph(Graph, OwningBP))
+    // Attempt interventions if this is a problematic case (they reload/PostLoad UObjects: game thread only)
+    if (IsInGameThread() && IsProblematicMainEventGraph(Graph, OwningBP))
     {
         UE_LOG(LogExtractor, Error, TEXT("HandleEmptyGraph: Identified problematic case. Attempting interventions..."));
         bool bInterventionSuccess = AttemptGraphInterventions(Graph, OwningBP);
@@ -374,8 +422,8 @@ UBlueprint* FBlueprintDataExtractor::FindOwningBlueprint(UEdGraph* Graph, const
         }
     }
 
-    // If not found, try extracting from GraphPath
-    if (!OwningBP)
+    // If not found, try extracting from GraphPath (LoadObject: game thread only)
+    if (!OwningBP && IsInGameThread())
     {
         int32 LastColonIndex = -1;
         if (GraphPath.FindLastChar(TEXT(':'), LastColonIndex))
@@ -427,7 +475,7 @@ bool FBlueprintDataExtractor::IsProblematicMainEventGraph(UEdGraph* Graph, UBlue
 // Node Processing Helpers
 // =============================================================================
 
-bool FBlueprintDataExtractor::ProcessGraphNodes(UEdGraph* Graph, TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const
+bool FBlueprintDataExtractor::ProcessGraphNodes(UEdGraph* Graph, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const
 {
     if (!Graph)
     {
@@ -462,29 +510,19 @@ bool FBlueprintDataExtractor::ProcessGraphNodes(UEdGraph* Graph, TMap<FString, T
 void FBlueprintDataExtractor::ConvertNodesToBlueprints(
     const TArray<UEdGraphNode*>& Nodes, 
     const FString& GraphName,
-    TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const
+    TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const
 {
     int32 NodesSuccessfullyConverted = 0;
     int32 NodesFailedConversion = 0;
 
-    for (UEdGraphNode* Node : Nodes)
-    {
-        if (!Node)
-        {
-            UE_LOG(LogExtractor, Warning, TEXT("ConvertNodesToBlueprints: Encountered NULL UEdGraphNode in graph '%s'"), *GraphName);
-            continue;
-        }
-
-        UE_LOG(LogExtractor, Log, TEXT("ConvertNodesToBlueprints: Processing UEdGraphNode: Title='%s', Class='%s', GUID='%s'"), 
-               *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-               *Node->GetClass()->GetName(),
-               *Node->NodeGuid.ToString());
+    TArray<TSharedPtr<FBlueprintNode>> ExtractedNodes = ExtractNodeData(Nodes);
+    NodesFailedConversion = Nodes.Num() - ExtractedNodes.Num();
 
-        TSharedPtr<FBlueprintNode> ExtractedNode = ExtractNodeData(Node);
-        
+    for (const TSharedPtr<FBlueprintNode>& ExtractedNode : ExtractedNodes)
+    {
         if (ExtractedNode.IsValid() && !ExtractedNode->Guid.IsEmpty())
         {
-            OutNodes.Add(ExtractedNode->Guid, ExtractedNode);
+            OutNodes.Add(ExtractedNode->GraphNodeGuid, ExtractedNode);
             NodesSuccessfullyConverted++;
             UE_LOG(LogExtractor, Log, TEXT("  ConvertNodesToBlueprints: Successfully converted GUID '%s' (NodeType: '%s')"), 
                    *ExtractedNode->Guid, *ExtractedNode->NodeType);
@@ -494,13 +532,12 @@ void FBlueprintDataExtractor::ConvertNodesToBlueprints(
             NodesFailedConversion++;
             if (!ExtractedNode.IsValid())
             {
-                UE_LOG(LogExtractor, Error, TEXT("  ConvertNodesToBlueprints: ExtractNodeData returned NULL for UEdGraphNode: Title='%s'"),
-                       *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+                UE_LOG(LogExtractor, Error, TEXT("  ConvertNodesToBlueprints: Node model build returned NULL in graph '%s'"), *GraphName);
             }
-            else if (ExtractedNode->Guid.IsEmpty())
+            else
             {
                 UE_LOG(LogExtractor, Error, TEXT("  ConvertNodesToBlueprints: Extracted node has EMPTY GUID! Title='%s', NodeType='%s'"),
-                       *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *ExtractedNode->NodeType);
+                       *ExtractedNode->GetLogName(), *ExtractedNode->NodeType);
             }
         }
     }
@@ -509,7 +546,7 @@ void FBlueprintDataExtractor::ConvertNodesToBlueprints(
            *GraphName, NodesSuccessfullyConverted, NodesFailedConversion);
 }
 
-void FBlueprintDataExtractor::FinalizeExtractedNodes(TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes) const
+void FBlueprintDataExtractor::FinalizeExtractedNodes(TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes) const
 {
     if (Nodes.IsEmpty())
     {
@@ -540,7 +577,7 @@ void FBlueprintDataExtractor::FinalizeExtractedNodes(TMap<FString, TSharedPtr<FB
         const TSharedPtr<FBlueprintNode>& Node = NodePair.Value;
         if (Node.IsValid() && (Node->NodeType == TEXT("VariableGet") || Node->NodeType == TEXT("CommutativeAssociativeBinaryOperator")))
         {
-            UE_LOG(LogExtractor, Error, TEXT("🔧   Node: '%s' (GUID:%s, Type:%s)"), *Node->Name, *Node->Guid.Left(8), *Node->NodeType);
+            UE_LOG(LogExtractor, Error, TEXT("🔧   Node: '%s' (GUID:%s, Type:%s)"), *Node->GetLogName(), *Node->Guid.Left(8), *Node->NodeType);
         
             for (const auto& PinPair : Node->Pins)
             {
@@ -568,125 +605,92 @@ void FBlueprintDataExtractor::FinalizeExtractedNodes(TMap<FString, TSharedPtr<FB
 }
 
 // =============================================================================
-// Core extraction methods (unchanged)
+// Core extraction methods
 // =============================================================================
 
-TSharedPtr<FBlueprintNode> FBlueprintDataExtractor::ExtractNodeData(UEdGraphNode* GraphNode) const
+TArray<TSharedPtr<FBlueprintNode>> FBlueprintDataExtractor::ExtractNodeData(const TArray<UEdGraphNode*>& GraphNodes) const
 {
-    if (!GraphNode)
-    {
-        return nullptr;
-    }
-
-    return FBlueprintNodeFactory::CreateNode(GraphNode);
+    // 两阶段：调用线程上复制 UObject 数据，随后在工作线程上并行构建模型
+    return FBlueprintNodeFactory::CreateNodes(GraphNodes);
 }
 
-void FBlueprintDataExtractor::ResolveLinks(TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes) const
+void FBlueprintDataExtractor::ResolveLinks(TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes) const
 {
     UE_LOG(LogExtractor, Log, TEXT("FBlueprintDataExtractor: Starting link resolution..."));
     int32 ResolvedCount = 0;
     int32 BackRefCount = 0;
 
-    for (auto& NodePair : Nodes)
+    // Pass 1: index every pin by (node GUID, pin ID) - links captured by the factory use the same typed keys
+    int32 TotalPins = 0;
+    for (const auto& NodePair : Nodes)
     {
-        TSharedPtr<FBlueprintNode>& SourceNode = NodePair.Value;
-        if (!SourceNode.IsValid()) continue;
-
-        bool bIsBoundEvent = (SourceNode->NodeType == TEXT("ComponentBoundEvent") || SourceNode->NodeType == TEXT("ActorBoundEvent"));
-        int32 InitialPropCount = -1;
-        if (bIsBoundEvent) {
-            InitialPropCount = SourceNode->RawProperties.Num();
-            UE_LOG(LogExtractor, Error, TEXT("ResolveLinks: BEFORE Pins Loop for %s (%s). Initial RawProperties.Num() = %d"),
-                *SourceNode->Guid.Left(8), *SourceNode->NodeType, InitialPropCount);
-        }
-        UE_LOG(LogExtractor, Error, TEXT("🔧 LINK RESOLUTION DEBUG: Processing Node='%s' (GUID:%s)"), 
-    *SourceNode->Name, *SourceNode->Guid.Left(8));
+        if (NodePair.Value.IsValid()) { TotalPins += NodePair.Value->Pins.Num(); }
+    }
 
-        for (auto& PinPair : SourceNode->Pins) {
-            TSharedPtr<FBlueprintPin>& Pin = PinPair.Value;
-            if (Pin.IsValid() && Pin->IsInput()) {
-                UE_LOG(LogExtractor, Error, TEXT("🔧   Input Pin='%s', LinkedTo props in RawProperties:"), *Pin->Name);
-        
-                // Check what link info was stored during extraction
-                for (const auto& Prop : Pin->RawProperties) {
-                    if (Prop.Key.Contains(TEXT("LinkedTo"))) {
-                        UE_LOG(LogExtractor, Error, TEXT("🔧     %s = %s"), *Prop.Key, *Prop.Value);
-                    }
-                }
-        
-                UE_LOG(LogExtractor, Error, TEXT("🔧   SourcePinFor.Num after resolution: %d"), Pin->SourcePinFor.Num());
+    TMap<TPair<FGuid, FGuid>, TSharedPtr<FBlueprintPin>> PinIndex;
+    PinIndex.Reserve(TotalPins);
+    for (const auto& NodePair : Nodes)
+    {
+        const TSharedPtr<FBlueprintNode>& Node = NodePair.Value;
+        if (!Node.IsValid()) continue;
+        for (const auto& PinPair : Node->Pins)
+        {
+            if (PinPair.Value.IsValid())
+            {
+                PinIndex.Add(TPair<FGuid, FGuid>(Node->GraphNodeGuid, PinPair.Value->GraphPinId), PinPair.Value);
             }
         }
+    }
 
-        
-        for (auto& PinPair : SourceNode->Pins)
-        {
-            TSharedPtr<FBlueprintPin>& SourcePin = PinPair.Value;
-            if (!SourcePin.IsValid() || !SourcePin->IsOutput()) continue;
+    // Pass 2: resolve each output pin's captured LinkedTo targets (order preserved)
+    for (const auto& NodePair : Nodes)
+    {
+        const TSharedPtr<FBlueprintNode>& SourceNode = NodePair.Value;
+        if (!SourceNode.IsValid()) continue;
 
-            int32 LinkIndex = 0;
-            FName LinkNodeKeyName = FName(*FString::Printf(TEXT("LinkedTo_%d_NodeGuid"), LinkIndex));
-            FName LinkPinKeyName = FName(*FString::Printf(TEXT("LinkedTo_%d_PinID"), LinkIndex));
+        for (const auto& PinPair : SourceNode->Pins)
+        {
+            const TSharedPtr<FBlueprintPin>& SourcePin = PinPair.Value;
+            if (!SourcePin.IsValid() || !SourcePin->IsOutput() || SourcePin->LinkTargets.IsEmpty()) continue;
 
-            while(SourcePin->RawProperties.Contains(LinkNodeKeyName.ToString()) && SourcePin->RawProperties.Contains(LinkPinKeyName.ToString()))
+            SourcePin->LinkedPins.Reserve(SourcePin->LinkedPins.Num() + SourcePin->LinkTargets.Num());
+            for (const FBlueprintPin::FLinkTarget& Link : SourcePin->LinkTargets)
             {
-                const FString TargetNodeGuid = SourcePin->RawProperties.FindChecked(LinkNodeKeyName.ToString());
-                const FString TargetPinId = SourcePin->RawProperties.FindChecked(LinkPinKeyName.ToString());
-
-                UE_LOG(LogExtractor, Verbose, TEXT("  ResolveLinks: Source Pin '%s' attempting link to Node GUID '%s', Pin ID '%s'"), 
-                       *SourcePin->Name, *TargetNodeGuid.Left(8), *TargetPinId);
-
-                TSharedPtr<FBlueprintNode>* TargetNodePtr = Nodes.Find(TargetNodeGuid);
-
-                if (TargetNodePtr && TargetNodePtr->IsValid())
+                const TSharedPtr<FBlueprintPin>* TargetPinPtr = PinIndex.Find(TPair<FGuid, FGuid>(Link.NodeGuid, Link.PinId));
+                if (TargetPinPtr && TargetPinPtr->IsValid())
                 {
-                    TSharedPtr<FBlueprintPin>* TargetPinPtr = (*TargetNodePtr)->Pins.Find(TargetPinId);
-
-                    if (TargetPinPtr && TargetPinPtr->IsValid())
-                    {
-                        UE_LOG(LogExtractor, Verbose, TEXT("    ResolveLinks: Found Target Node '%s', Target Pin '%s'. Adding links."), 
-                               *(*TargetNodePtr)->Name, *(*TargetPinPtr)->Name);
-
-                        SourcePin->LinkedPins.Add(*TargetPinPtr);
-                        ResolvedCount++;
+                    SourcePin->LinkedPins.Add(*TargetPinPtr);
+                    ResolvedCount++;
 
-                        (*TargetPinPtr)->SourcePinFor.Add(SourcePin);
-                        BackRefCount++;
+                    (*TargetPinPtr)->SourcePinFor.Add(SourcePin);
+                    BackRefCount++;
 
-                        UE_LOG(LogExtractor, Log, TEXT("      ResolveLinks: Added SourcePinFor link to Target Pin '%s' (%s). New SourcePinFor count: %d"),
-                            *(*TargetPinPtr)->Name, *(*TargetPinPtr)->NodeGuid.Left(8), (*TargetPinPtr)->SourcePinFor.Num());
-
-                    } else {
-                        UE_LOG(LogExtractor, Warning, TEXT("    ResolveLinks: Found Target Node '%s', but Target Pin ID '%s' NOT FOUND on it."), 
-                               *(*TargetNodePtr)->Name, *TargetPinId);
-                    }
-                } else {
-                    UE_LOG(LogExtractor, Warning, TEXT("  ResolveLinks: Target Node GUID '%s' NOT FOUND in extracted nodes map. Linked from Node %s Pin %s."),
-                           *TargetNodeGuid.Left(8), *SourceNode->Guid.Left(8), *SourcePin->Name);
+                    UE_LOG(LogExtractor, Verbose, TEXT("  ResolveLinks: Linked '%s' (%s) -> '%s' (%s)"),
+                        *SourcePin->Name, *SourceNode->Guid.Left(8), *(*TargetPinPtr)->Name, *(*TargetPinPtr)->NodeGuid.Left(8));
                 }
-
-                LinkIndex++;
-                LinkNodeKeyName = FName(*FString::Printf(TEXT("LinkedTo_%d_NodeGuid"), LinkIndex));
-                LinkPinKeyName = FName(*FString::Printf(TEXT("LinkedTo_%d_PinID"), LinkIndex));
-            }
-        }
-
-        if (bIsBoundEvent) {
-            int32 FinalPropCount = SourceNode->RawProperties.Num();
-            if (FinalPropCount != InitialPropCount) {
-                UE_LOG(LogExtractor, Error, TEXT("ResolveLinks: AFTER Pins Loop for %s (%s). RawProperties.Num() CHANGED! Was %d, now %d"),
-                      *SourceNode->Guid.Left(8), *SourceNode->NodeType, InitialPropCount, FinalPropCount);
-                UE_LOG(LogExtractor, Error, TEXT("  Current Keys:"));
-                for(const auto& PropPair : SourceNode->RawProperties) { 
-                    UE_LOG(LogExtractor, Error, TEXT("    Key: %s"), *PropPair.Key); 
+                else
+                {
+                    UE_LOG(LogExtractor, Warning, TEXT("  ResolveLinks: Target Node %s / Pin %s not found in extracted nodes. Linked from Node %s Pin %s."),
+                        *Link.NodeGuid.ToString().Left(8), *Link.PinId.ToString().Left(8), *SourceNode->Guid.Left(8), *SourcePin->Name);
                 }
-            } else {
-                UE_LOG(LogExtractor, Error, TEXT("ResolveLinks: AFTER Pins Loop for %s (%s). RawProperties.Num() = %d (Unchanged)"),
-                      *SourceNode->Guid.Left(8), *SourceNode->NodeType, FinalPropCount);
             }
         }
     }
 
+    // Pass 3: stamp the node-set identity (links to nodes outside this set were dropped above)
+    TArray<FGuid> NodeGuids;
+    Nodes.GenerateKeyArray(NodeGuids);
+    NodeGuids.Sort();
+    uint32 NodeSetHash = GetTypeHash(NodeGuids.Num());
+    for (const FGuid& NodeGuid : NodeGuids)
+    {
+        NodeSetHash = HashCombineFast(NodeSetHash, GetTypeHash(NodeGuid));
+    }
+    for (const auto& NodePair : Nodes)
+    {
+        if (NodePair.Value.IsValid()) { NodePair.Value->NodeSetHash = NodeSetHash; }
+    }
+
     UE_LOG(LogExtractor, Log, TEXT("FBlueprintDataExtractor: Finished link resolution. Resolved %d forward links, added %d SourcePinFor back-references."), 
            ResolvedCount, BackRefCount);
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Extractors/BlueprintExtractionCache.cpp
+
+#include "Extractors/BlueprintExtractionCache.h"
+#include "Logging/BP2AILog.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/ScopeLock.h"
+
+FBlueprintExtractionCache& FBlueprintExtractionCache::Get()
+{
+    static FBlueprintExtractionCache Instance;
+    return Instance;
+}
+
+FBlueprintExtractionCache::~FBlueprintExtractionCache()
+{
+    // 静态析构时 UObject 可能已销毁，只丢弃数据，不再触碰委托
+    Entries.Empty();
+    BlueprintHooks.Empty();
+}
+
+bool FBlueprintExtractionCache::Find(const UEdGraph* Graph, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes)
+{
+    if (!Graph)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&Mutex);
+
+    const FObjectKey GraphKey(Graph);
+    const FEntry* Entry = Entries.Find(GraphKey);
+    if (!Entry)
+    {
+        return false;
+    }
+    if (Entry->Graph.Get() != Graph)
+    {
+        // 旧图表已被回收，地址被新对象复用；清理会注销委托，只在游戏线程进行
+        if (IsInGameThread())
+        {
+            RemoveEntryLocked(GraphKey);
+        }
+        return false;
+    }
+
+    OutNodes = Entry->Nodes.CreateCompatibilityView();
+    UE_LOG(LogExtractor, Log, TEXT("ExtractionCache: Hit for graph '%s' (%d nodes)."), *Graph->GetName(), OutNodes.Num());
+    return true;
+}
+
+void FBlueprintExtractionCache::Store(UEdGraph* Graph, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes)
+{
+    // 委托只能在游戏线程注册，否则与编辑器的广播存在竞争
+    if (!Graph || Nodes.IsEmpty() || !IsInGameThread())
+    {
+        return;
+    }
+
+    UBlueprint* OwningBlueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+
+    FScopeLock Lock(&Mutex);
+
+    const FObjectKey GraphKey(Graph);
+    RemoveEntryLocked(GraphKey);
+
+    FEntry& Entry = Entries.Add(GraphKey);
+    Entry.Graph = Graph;
+    // 标题保持按需解析：多数缓存命中只用于结构遍历
+    Entry.Nodes = FBlueprintGraphSnapshot::Build(Nodes, /*bResolveNames=*/ false);
+    Entry.GraphChangedHandle = Graph->AddOnGraphChangedHandler(
+        FOnGraphChanged::FDelegate::CreateRaw(this, &FBlueprintExtractionCache::HandleGraphChanged, GraphKey));
+
+    if (OwningBlueprint)
+    {
+        const FObjectKey BlueprintKey(OwningBlueprint);
+        Entry.Blueprint = BlueprintKey;
+
+        FBlueprintHooks& Hooks = BlueprintHooks.FindOrAdd(BlueprintKey);
+        if (Hooks.NumGraphs == 0)
+        {
+            Hooks.Blueprint = OwningBlueprint;
+            Hooks.ChangedHandle = OwningBlueprint->OnChanged().AddRaw(this, &FBlueprintExtractionCache::HandleBlueprintChanged);
+            Hooks.CompiledHandle = OwningBlueprint->OnCompiled().AddRaw(this, &FBlueprintExtractionCache::HandleBlueprintChanged);
+        }
+        Hooks.NumGraphs++;
+    }
+
+    UE_LOG(LogExtractor, Log, TEXT("ExtractionCache: Stored graph '%s' (%d nodes, %d cached graphs)."),
+           *Graph->GetName(), Nodes.Num(), Entries.Num());
+}
+
+void FBlueprintExtractionCache::Invalidate(const UEdGraph* Graph)
+{
+    if (!Graph)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+    RemoveEntryLocked(FObjectKey(Graph));
+}
+
+void FBlueprintExtractionCache::InvalidateBlueprint(const UBlueprint* Blueprint)
+{
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+
+    const FObjectKey BlueprintKey(Blueprint);
+    TArray<FObjectKey> GraphKeys;
+    for (const TPair<FObjectKey, FEntry>& Pair : Entries)
+    {
+        if (Pair.Value.Blueprint == BlueprintKey)
+        {
+            GraphKeys.Add(Pair.Key);
+        }
+    }
+    for (const FObjectKey& GraphKey : GraphKeys)
+    {
+        RemoveEntryLocked(GraphKey);
+    }
+}
+
+void FBlueprintExtractionCache::Reset()
+{
+    FScopeLock Lock(&Mutex);
+
+    TArray<FObjectKey> GraphKeys;
+    Entries.GetKeys(GraphKeys);
+    for (const FObjectKey& GraphKey : GraphKeys)
+    {
+        RemoveEntryLocked(GraphKey);
+    }
+    Entries.Empty();
+    BlueprintHooks.Empty();
+}
+
+int32 FBlueprintExtractionCache::Num() const
+{
+    FScopeLock Lock(&Mutex);
+    return Entries.Num();
+}
+
+void FBlueprintExtractionCache::HandleGraphChanged(const FEdGraphEditAction& Action, FObjectKey GraphKey)
+{
+    FScopeLock Lock(&Mutex);
+    RemoveEntryLocked(GraphKey);
+}
+
+void FBlueprintExtractionCache::HandleBlueprintChanged(UBlueprint* Blueprint)
+{
+    InvalidateBlueprint(Blueprint);
+}
+
+void FBlueprintExtractionCache::RemoveEntryLocked(FObjectKey GraphKey)
+{
+    const FEntry* Entry = Entries.Find(GraphKey);
+    if (!Entry)
+    {
+        return;
+    }
+
+    // 在广播过程中移除自身是安全的：多播委托会延迟压缩调用列表
+    if (UEdGraph* Graph = Entry->Graph.Get())
+    {
+        Graph->RemoveOnGraphChangedHandler(Entry->GraphChangedHandle);
+    }
+
+    const FObjectKey BlueprintKey = Entry->Blueprint;
+    Entries.Remove(GraphKey);
+
+    if (FBlueprintHooks* Hooks = BlueprintHooks.Find(BlueprintKey))
+    {
+        if (--Hooks->NumGraphs <= 0)
+        {
+            ReleaseBlueprintHooksLocked(BlueprintKey);
+        }
+    }
+}
+
+void FBlueprintExtractionCache::ReleaseBlueprintHooksLocked(FObjectKey BlueprintKey)
+{
+    FBlueprintHooks Hooks;
+    if (!BlueprintHooks.RemoveAndCopyValue(BlueprintKey, Hooks))
+    {
+        return;
+    }
+
+    if (UBlueprint* Blueprint = Hooks.Blueprint.Get())
+    {
+        Blueprint->OnChanged().Remove(Hooks.ChangedHandle);
+        Blueprint->OnCompiled().Remove(Hooks.CompiledHandle);
+    }
+}
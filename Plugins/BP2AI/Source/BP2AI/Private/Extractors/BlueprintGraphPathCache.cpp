@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Extractors/BlueprintGraphPathCache.cpp
+
+#include "Extractors/BlueprintGraphPathCache.h"
+#include "EdGraph/EdGraph.h"
+#include "Misc/ScopeRWLock.h"
+
+FBlueprintGraphPathCache& FBlueprintGraphPathCache::Get()
+{
+    static FBlueprintGraphPathCache Instance;
+    return Instance;
+}
+
+UEdGraph* FBlueprintGraphPathCache::Find(const FString& GraphPath)
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        const TWeakObjectPtr<UEdGraph>* Entry = Graphs.Find(GraphPath);
+        if (!Entry)
+        {
+            return nullptr;
+        }
+        if (UEdGraph* Graph = Entry->Get())
+        {
+            return Graph;
+        }
+    }
+
+    // 图表已被回收：移除过期条目（期间可能已被重新写入，移除前再检查一次）
+    FWriteScopeLock WriteLock(Lock);
+    if (const TWeakObjectPtr<UEdGraph>* Entry = Graphs.Find(GraphPath))
+    {
+        if (UEdGraph* Graph = Entry->Get())
+        {
+            return Graph;
+        }
+        Graphs.Remove(GraphPath);
+    }
+    return nullptr;
+}
+
+void FBlueprintGraphPathCache::Add(const FString& GraphPath, UEdGraph* Graph)
+{
+    if (GraphPath.IsEmpty() || !Graph)
+    {
+        return;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    Graphs.Add(GraphPath, Graph);
+}
+
+void FBlueprintGraphPathCache::Reset()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Graphs.Empty();
+}
+
+int32 FBlueprintGraphPathCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Graphs.Num();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Extractors/BlueprintGraphPreloader.cpp
+
+#include "Extractors/BlueprintGraphPreloader.h"
+#include "Extractors/BlueprintGraphPathCache.h"
+#include "Logging/BP2AILog.h"
+#include "EdGraph/EdGraph.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+void FBlueprintGraphPreloader::AddReferencesFrom(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes)
+{
+    for (const TPair<FGuid, TSharedPtr<FBlueprintNode>>& NodePair : Nodes)
+    {
+        const FBlueprintNode* Node = NodePair.Value.Get();
+        if (!Node)
+        {
+            continue;
+        }
+
+        for (const TCHAR* GraphKey : { TEXT("MacroGraphReference"), TEXT("BoundGraphName") })
+        {
+            const FString* GraphPath = Node->RawProperties.Find(GraphKey);
+            if (GraphPath && !GraphPath->IsEmpty())
+            {
+                GraphPaths.Add(*GraphPath);
+                AddPackageOf(*GraphPath);
+            }
+        }
+
+        // 函数图表的路径要在类加载后才能确定，这里只预加载其所在的蓝图包；原生类不需要加载
+        const FString* ParentClassPath = Node->RawProperties.Find(TEXT("FunctionParentClassPath"));
+        if (ParentClassPath && !ParentClassPath->IsEmpty() && !ParentClassPath->StartsWith(TEXT("/Script/")))
+        {
+            AddPackageOf(*ParentClassPath);
+        }
+    }
+}
+
+void FBlueprintGraphPreloader::AddPackageOf(const FString& ObjectPath)
+{
+    const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+    if (!PackageName.IsEmpty())
+    {
+        Packages.Add(FName(*PackageName));
+    }
+}
+
+int32 FBlueprintGraphPreloader::Load()
+{
+    // LoadPackageAsync / FlushAsyncLoading 只能在游戏线程调用
+    if (!IsInGameThread())
+    {
+        return 0;
+    }
+
+    // 先发起全部请求，再逐个等待：等待第一个请求时其余请求已在异步加载器中并行推进
+    TArray<int32> PendingRequests;
+    for (const FName& PackageName : Packages)
+    {
+        if (IssuedPackages.Contains(PackageName))
+        {
+            continue;
+        }
+        IssuedPackages.Add(PackageName);
+
+        const FString PackageNameStr = PackageName.ToString();
+        if (FindPackage(nullptr, *PackageNameStr))
+        {
+            continue;
+        }
+
+        const int32 RequestId = LoadPackageAsync(PackageNameStr);
+        if (RequestId != INDEX_NONE)
+        {
+            PendingRequests.Add(RequestId);
+        }
+    }
+
+    if (PendingRequests.Num() > 0)
+    {
+        UE_LOG(LogExtractor, Log, TEXT("GraphPreloader: Loading %d referenced package(s) (%d referenced in total)."),
+               PendingRequests.Num(), Packages.Num());
+    }
+    for (const int32 RequestId : PendingRequests)
+    {
+        FlushAsyncLoading(RequestId);
+    }
+
+    FBlueprintGraphPathCache& PathCache = FBlueprintGraphPathCache::Get();
+    for (const FString& GraphPath : GraphPaths)
+    {
+        if (!PathCache.Find(GraphPath))
+        {
+            PathCache.Add(GraphPath, FindObject<UEdGraph>(nullptr, *GraphPath));
+        }
+    }
+    return PendingRequests.Num();
+}
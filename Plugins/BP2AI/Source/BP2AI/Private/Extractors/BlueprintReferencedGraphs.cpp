@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Extractors/BlueprintReferencedGraphs.cpp
+
+#include "Extractors/BlueprintReferencedGraphs.h"
+#include "Models/BlueprintGraphSnapshot.h"
+
+namespace
+{
+    thread_local const FBlueprintReferencedGraphMap* GActiveReferencedGraphs = nullptr;
+    thread_local const FBlueprintInterfaceSignatureMap* GActiveInterfaceSignatures = nullptr;
+}
+
+FBlueprintReferencedGraphScope::FBlueprintReferencedGraphScope(const FBlueprintReferencedGraphMap& InGraphs, const FBlueprintInterfaceSignatureMap& InInterfaceSignatures)
+    : PreviousGraphs(GActiveReferencedGraphs)
+    , PreviousInterfaceSignatures(GActiveInterfaceSignatures)
+{
+    GActiveReferencedGraphs = &InGraphs;
+    GActiveInterfaceSignatures = &InInterfaceSignatures;
+}
+
+FBlueprintReferencedGraphScope::~FBlueprintReferencedGraphScope()
+{
+    GActiveReferencedGraphs = PreviousGraphs;
+    GActiveInterfaceSignatures = PreviousInterfaceSignatures;
+}
+
+const FBlueprintReferencedGraphMap* FBlueprintReferencedGraphScope::GetActive()
+{
+    return GActiveReferencedGraphs;
+}
+
+const FBlueprintInterfaceSignatureMap* FBlueprintReferencedGraphScope::GetActiveInterfaceSignatures()
+{
+    return GActiveInterfaceSignatures;
+}
@@ -13,6 +13,7 @@
 #include "Trace/MarkdownDataTracer.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Trace/Utils/MarkdownFormattingUtils.h"
+#include "Trace/Utils/MarkdownSpanSystem.h"
 #include "Logging/LogMacros.h"
 #include "Internationalization/Regex.h"
 #include "Trace/FMarkdownPathTracer.h"
@@ -24,8 +25,8 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatArguments( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins, 
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins, 
 		bool bSymbolicTraceForData, 
 		const TSet<FName>& ExcludePinNames, // Default value is handled by declaration
 		const FString& CurrentBlueprintContext // New parameter
@@ -45,7 +46,7 @@ namespace MarkdownNodeFormatters_Private
         if (bIsDebuggingParentCall)
         {
             UE_LOG(LogFormatter, Error, TEXT("FormatArguments DEBUG for Node '%s' (Type: %s, GUID: %s) - Context: '%s', ShowTrivialDefaultsGlobal: %s, bSymbolicTraceForData: %s"), 
-                *Node->Name, 
+                *Node->GetLogName(), 
                 *Node->NodeType, 
                 *Node->Guid.Left(8),
                 *CurrentBlueprintContext, // Log the context
@@ -63,7 +64,7 @@ namespace MarkdownNodeFormatters_Private
                     *Pin->Name, 
                     *Pin->FriendlyName, 
                     *Pin->Category,
-                    *Pin->Direction,
+                    Pin->GetDirectionString(),
                     Pin->IsHidden() ? TEXT("true") : TEXT("false"),
                     Pin->IsAdvancedView() ? TEXT("true") : TEXT("false"));
             }
@@ -109,7 +110,7 @@ namespace MarkdownNodeFormatters_Private
 						*PinValue
 					));
 					UE_LOG(LogFormatter, Verbose, TEXT("FormatArguments (Private): Added Pin '%s' (Displayed as '%s') with TracedValue '%s' to ArgsList for Node '%s'. ShowAllDefaults=%s, Linked=%s, ExplicitDefault=%s, Context='%s'"), 
-						*Pin->Name, *DisplayPinName, *PinValue, *Node->Name,
+						*Pin->Name, *DisplayPinName, *PinValue, *Node->GetLogName(),
 						DataTracer.bCurrentShowTrivialDefaultParams ? TEXT("true"):TEXT("false"), 
                         bIsLinked?TEXT("true"):TEXT("false"), 
                         bHasExplicitDefault?TEXT("true"):TEXT("false"),
@@ -124,7 +125,7 @@ namespace MarkdownNodeFormatters_Private
                             bIsPinTrivialDefault ? TEXT("true") : TEXT("false"));
                     }
 					UE_LOG(LogFormatter, Verbose, TEXT("FormatArguments (Private): SKIPPED Pin '%s' on Node '%s'. ShowAllDefaults=%s, Linked=%s, ExplicitDefault=%s, Context='%s'"),
-						*Pin->Name, *Node->Name,
+						*Pin->Name, *Node->GetLogName(),
 						DataTracer.bCurrentShowTrivialDefaultParams ? TEXT("true"):TEXT("false"), 
                         bIsLinked?TEXT("true"):TEXT("false"), 
                         bHasExplicitDefault?TEXT("true"):TEXT("false"),
@@ -145,15 +146,15 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatTarget( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-		TSharedPtr<const FBlueprintPin> TargetPin = Node->GetPin(TEXT("self"), TEXT("EGPD_Input"));
-		if (!TargetPin) TargetPin = Node->GetPin(TEXT("Target"), TEXT("EGPD_Input"));
-		if (!TargetPin) TargetPin = Node->GetPin(TEXT("WorldContextObject"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> TargetPin = Node->GetPin(TEXT("self"), EGPD_Input);
+		if (!TargetPin) TargetPin = Node->GetPin(TEXT("Target"), EGPD_Input);
+		if (!TargetPin) TargetPin = Node->GetPin(TEXT("WorldContextObject"), EGPD_Input);
 
 		if (!TargetPin.IsValid()) return TEXT("");
 		
@@ -161,13 +162,17 @@ namespace MarkdownNodeFormatters_Private
 
 		if (TargetValueStr == FMarkdownSpan::Variable(TEXT("self"))) { return TEXT(""); }
 		else if (TargetValueStr.Contains(TEXT("Default__")) || TargetValueStr.Contains(TEXT("Library")) || TargetValueStr == FMarkdownSpan::LiteralObject(TEXT("None"))) { return TEXT(""); }
-		else if (TargetValueStr.Contains(TEXT("<span")) || TargetValueStr.Contains(TEXT("("))) { return FString::Printf(TEXT(" on (%s)"), *TargetValueStr); }
-		else { return FString::Printf(TEXT(" on %s"), *TargetValueStr); }
+
+		const FString WrappedSuffix = FString::Printf(TEXT(" on (%s)"), *TargetValueStr);
+		const FString PlainSuffix = FString::Printf(TEXT(" on %s"), *TargetValueStr);
+		if (TargetValueStr.Contains(TEXT("<span")) || TargetValueStr.Contains(TEXT("("))) { return WrappedSuffix; }
+		// HTML 下带 span 的目标需要加括号；中立模式下按渲染格式决定
+		return FMarkdownSpanSystem::FormatSwitch(FMarkdownSpanSystem::HasNeutralSpans(TargetValueStr) ? WrappedSuffix : PlainSuffix, PlainSuffix);
 	}
 
 	FString FormatGeneric(TSharedPtr<const FBlueprintNode> Node)
 	{
-		FString NodeName = Node->Name.IsEmpty() ? FString() : FString::Printf(TEXT(" (%s)"), *Node->Name);
+		FString NodeName = Node->GetName().IsEmpty() ? FString() : FString::Printf(TEXT(" (%s)"), *Node->GetName());
         FString NodeTypeStr = Node->NodeType.IsEmpty() ? TEXT("UnknownType") : Node->NodeType;
 		return FString::Printf(TEXT("**%s**%s"), *NodeTypeStr, *NodeName);
 	}
@@ -179,15 +184,15 @@ FString FMarkdownNodeFormatter::FormatNodeDescription(
 	TSharedPtr<const FBlueprintNode> Node,
 	const TOptional<FCapturedEventData>& CapturedData,
 	FMarkdownDataTracer& DataTracer, 
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-	TSet<FString>& VisitedPins, 
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+	TSet<FResolvedPinKey>& VisitedPins, 
 	bool bGenerateLinkOnly, 
 	bool bSymbolicTraceForData,
     const FString& CurrentBlueprintContext // New parameter
 )
 {
 	UE_LOG(LogFormatter, Error, TEXT("FMarkdownNodeFormatter::FormatNodeDescription: Node='%s' (Type:%s), CtxRecv:'%s', LinkOnly:%d, Symbolic:%d"),
-		*Node->Name, *Node->NodeType, *CurrentBlueprintContext, bGenerateLinkOnly, bSymbolicTraceForData);
+		*Node->GetLogName(), *Node->NodeType, *CurrentBlueprintContext, bGenerateLinkOnly, bSymbolicTraceForData);
 	// The 'using namespace' is fine inside the function body if it refers to actual private helpers.
 	// Or, if all private helpers are fully qualified, it's not needed.
 	using namespace MarkdownNodeFormatters_Private;
@@ -243,7 +248,7 @@ FString FMarkdownNodeFormatter::FormatNodeDescription(
 			FString LinkText = FString::Printf(TEXT("[%s](#%s)"), *LinkTextToShow, *AnchorName);
 			return FString::Printf(TEXT("%s: %s"), *NodeTypeKeyword, *LinkText);
 		} else {
-			FString LinkTextToShow = Node->Name.IsEmpty() ? Node->NodeType : Node->Name;
+			FString LinkTextToShow = Node->GetName().IsEmpty() ? Node->NodeType : Node->GetName();
             FString AnchorName = FMarkdownPathTracer::SanitizeAnchorName(LinkTextToShow); // Simple anchor for non-callables
             FString LinkText = FString::Printf(TEXT("[%s](#%s)"), *LinkTextToShow, *AnchorName);
             return FString::Printf(TEXT("%s: %s"), *NodeTypeKeyword, *LinkText);
@@ -251,7 +256,7 @@ FString FMarkdownNodeFormatter::FormatNodeDescription(
 		
 		FString LinkTextToShow = MarkdownTracerUtils::ExtractSimpleNameFromPath(GraphName, CurrentBlueprintContext);
 		if (LinkTextToShow.IsEmpty()) LinkTextToShow = GraphName; 
-		if (LinkTextToShow.IsEmpty()) LinkTextToShow = Node->Name.IsEmpty() ? Node->NodeType : Node->Name;
+		if (LinkTextToShow.IsEmpty()) LinkTextToShow = Node->GetName().IsEmpty() ? Node->NodeType : Node->GetName();
 
 
 		FString AnchorName = FMarkdownPathTracer::SanitizeAnchorName(GraphName); 
@@ -260,7 +265,7 @@ FString FMarkdownNodeFormatter::FormatNodeDescription(
 
 		if (Node->NodeType == TEXT("CallFunction") || Node->NodeType == TEXT("MacroInstance"))
 		{
-			TSet<FString> ArgsVisitedPins; 
+			TSet<FResolvedPinKey> ArgsVisitedPins; 
 			// Pass CurrentBlueprintContext to FormatArguments
 			FString ArgsStr = MarkdownNodeFormatters_Private::FormatArguments(Node, DataTracer, AllNodes, ArgsVisitedPins, bSymbolicTraceForData, {}, CurrentBlueprintContext);
 			return BaseLinkText + ArgsStr;
@@ -316,12 +321,12 @@ FString FMarkdownNodeFormatter::FormatNodeDescription(
         FString BaseTunnelFormat = MarkdownNodeFormatters_Private::FormatGeneric(Node); 
 
         // Check if it's an "Outputs" tunnel and if we are in a context where call-site args are available (implies inline expansion)
-        bool bIsOutputTunnel = Node->Name.Contains(TEXT("Outputs")) || Node->Name.Contains(TEXT("Output"));
+        bool bIsOutputTunnel = Node->GetName().Contains(TEXT("Outputs")) || Node->GetName().Contains(TEXT("Output"));
         const TMap<FName, FString>* CallSiteArgsForOutputs = DataTracer.GetCurrentCallsiteArguments();
 
         if (bIsOutputTunnel && CallSiteArgsForOutputs != nullptr)
         {
-            UE_LOG(LogFormatter, Log, TEXT("FormatNodeDescription: Formatting OUTPUTS for Tunnel '%s' (GUID %s). CallSiteArgs are set."), *Node->Name, *Node->Guid.Left(8));
+            UE_LOG(LogFormatter, Log, TEXT("FormatNodeDescription: Formatting OUTPUTS for Tunnel '%s' (GUID %s). CallSiteArgs are set."), *Node->GetLogName(), *Node->Guid.Left(8));
             TArray<FString> OutputValueStrings;
             // Iterate INPUT data pins of this "Outputs" tunnel
             for (const TSharedPtr<FBlueprintPin>& TunnelInputPin : Node->GetInputPins(TEXT(""), false, true)) 
@@ -21,13 +21,13 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatIfThenElse( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-		TSharedPtr<const FBlueprintPin> ConditionPin = Node->GetPin(TEXT("Condition"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> ConditionPin = Node->GetPin(TEXT("Condition"), EGPD_Input);
 		FString ConditionStr = FMarkdownSpan::Error(TEXT("<?>"));
 		if (ConditionPin.IsValid())
 		{
@@ -42,13 +42,13 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatSwitch( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-		TSharedPtr<const FBlueprintPin> SelectionPin = Node->GetPin(TEXT("Selection"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> SelectionPin = Node->GetPin(TEXT("Selection"), EGPD_Input);
 		FString SelectionStr = FMarkdownSpan::Error(TEXT("<?>"));
 		FString SwitchTypeStr = TEXT("");
 
@@ -86,8 +86,8 @@ namespace MarkdownNodeFormatters_Private
     FString FormatSequence( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext // Context received, but not used by this formatter
 	)
@@ -100,14 +100,14 @@ namespace MarkdownNodeFormatters_Private
 FString FormatForEachLoop( 
     TSharedPtr<const FBlueprintNode> Node, 
     FMarkdownDataTracer& DataTracer, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-    TSet<FString>& VisitedDataPins,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+    TSet<FResolvedPinKey>& VisitedDataPins,
     bool bSymbolicTraceForData,
     const FString& CurrentBlueprintContext
 )
 {
-    UE_LOG(LogFormatter, Log, TEXT("FormatForEachLoop: Formatting node %s (Type: %s, GUID: %s). Context: '%s'"), *Node->Name, *Node->NodeType, *Node->Guid, *CurrentBlueprintContext);
-    TSharedPtr<const FBlueprintPin> ArrayPin = Node->GetPin(TEXT("Array"), TEXT("EGPD_Input"));
+    UE_LOG(LogFormatter, Log, TEXT("FormatForEachLoop: Formatting node %s (Type: %s, GUID: %s). Context: '%s'"), *Node->GetLogName(), *Node->NodeType, *Node->Guid, *CurrentBlueprintContext);
+    TSharedPtr<const FBlueprintPin> ArrayPin = Node->GetPin(TEXT("Array"), EGPD_Input);
     UE_LOG(LogFormatter, Log, TEXT("  ArrayInputPin valid: %s (PinName: %s, PinID: %s)"), 
         ArrayPin.IsValid() ? TEXT("true") : TEXT("false"),
         ArrayPin.IsValid() ? *ArrayPin->Name : TEXT("N/A"),
@@ -123,14 +123,14 @@ FString FormatForEachLoop(
     UE_LOG(LogFormatter, Log, TEXT("  Final Traced ArrayStr for loop header (from DataTracer): '%s'"), *ArrayStr);
 
     // Attempt to get Element and Index pins, trying both naming conventions
-    TSharedPtr<const FBlueprintPin> ElemPin = Node->GetPin(TEXT("Array Element"), TEXT("EGPD_Output"));
+    TSharedPtr<const FBlueprintPin> ElemPin = Node->GetPin(TEXT("Array Element"), EGPD_Output);
     if (!ElemPin.IsValid()) { 
-        ElemPin = Node->GetPin(TEXT("ArrayElement"), TEXT("EGPD_Output"));
+        ElemPin = Node->GetPin(TEXT("ArrayElement"), EGPD_Output);
     }
 
-    TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Array Index"), TEXT("EGPD_Output"));
+    TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Array Index"), EGPD_Output);
     if (!IndexPin.IsValid()) { 
-        IndexPin = Node->GetPin(TEXT("ArrayIndex"), TEXT("EGPD_Output"));
+        IndexPin = Node->GetPin(TEXT("ArrayIndex"), EGPD_Output);
     }
     
     UE_LOG(LogFormatter, Log, TEXT("  After checks - ElemPin valid: %s, IndexPin valid: %s"), ElemPin.IsValid() ? TEXT("true") : TEXT("false"), IndexPin.IsValid() ? TEXT("true") : TEXT("false"));
@@ -161,15 +161,15 @@ FString FormatForEachLoop(
 			SimpleMacroName = MarkdownTracerUtils::ExtractSimpleNameFromPath(**MacroPathPtr, CurrentBlueprintContext);
 		} else {
 			// Fallback if MacroGraphReference is missing (should be rare for standard macros)
-			// Try Node->Name, which might be "For Each Loop with Break" etc.
-			FString NodeNameStr = Node->Name;
+			// Try Node->GetName(), which might be "For Each Loop with Break" etc.
+			FString NodeNameStr = Node->GetName();
 			if (NodeNameStr.Contains(TEXT("Reverse For Each Loop"))) SimpleMacroName = TEXT("ReverseForEachLoop");
 			else if (NodeNameStr.Contains(TEXT("For Each Loop with Break"))) SimpleMacroName = TEXT("ForEachLoopWithBreak");
 			else if (NodeNameStr.Contains(TEXT("For Each Loop"))) SimpleMacroName = TEXT("ForEachLoop");
-			else SimpleMacroName = Node->Name; // Fallback to raw node name
+			else SimpleMacroName = Node->GetName(); // Fallback to raw node name
 		}
     
-		UE_LOG(LogFormatter, Log, TEXT("  FormatForEachLoop: Derived SimpleMacroName for Keyword: '%s' (Original Node Name: '%s')"), *SimpleMacroName, *Node->Name);
+		UE_LOG(LogFormatter, Log, TEXT("  FormatForEachLoop: Derived SimpleMacroName for Keyword: '%s' (Original Node Name: '%s')"), *SimpleMacroName, *Node->GetLogName());
 
 		if (SimpleMacroName == TEXT("ForEachLoopWithBreak")) {
 			Keyword = FMarkdownSpan::Keyword(TEXT("For Each Loop with Break"));
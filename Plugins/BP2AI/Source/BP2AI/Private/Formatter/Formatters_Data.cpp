@@ -22,22 +22,22 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatSetFieldsInStruct( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-		TSharedPtr<const FBlueprintPin> StructPin = Node->GetPin(TEXT("StructRef"), TEXT("EGPD_Input"));
-		if (!StructPin) StructPin = Node->GetPin(TEXT("Struct In"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> StructPin = Node->GetPin(TEXT("StructRef"), EGPD_Input);
+		if (!StructPin) StructPin = Node->GetPin(TEXT("Struct In"), EGPD_Input);
 
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString StructStr = StructPin.IsValid() ? DataTracer.TracePinValue(StructPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("[?Struct?]"));
 
 		TSet<FName> Exclusions;
         if(StructPin.IsValid()) Exclusions.Add(FName(*StructPin->Name));
-        TSharedPtr<const FBlueprintPin> OutputPin = Node->GetPin(TEXT("StructRef"), TEXT("EGPD_Output"));
-         if (!OutputPin) OutputPin = Node->GetPin(TEXT("Result"), TEXT("EGPD_Output")); 
+        TSharedPtr<const FBlueprintPin> OutputPin = Node->GetPin(TEXT("StructRef"), EGPD_Output);
+         if (!OutputPin) OutputPin = Node->GetPin(TEXT("Result"), EGPD_Output); 
          if(OutputPin.IsValid()) Exclusions.Add(FName(*OutputPin->Name));
 
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext to FormatArguments
@@ -50,8 +50,8 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatCallArrayFunction( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
@@ -60,8 +60,8 @@ namespace MarkdownNodeFormatters_Private
 		if (FuncName.IsEmpty()) return FMarkdownSpan::Error(TEXT("[Unknown Array Function]"));
 
 		TSharedPtr<const FBlueprintPin> ArrayPin = nullptr;
-        for(const auto& Pair : Node->Pins) { if(Pair.Value.IsValid() && Pair.Value->IsInput() && Pair.Value->ContainerType == TEXT("Array")){ ArrayPin = Pair.Value; break; }}
-        if (!ArrayPin) ArrayPin = Node->GetPin(TEXT("Target Array"), TEXT("EGPD_Input")); 
+        for(const auto& Pair : Node->Pins) { if(Pair.Value.IsValid() && Pair.Value->IsInput() && Pair.Value->PinContainerType == EPinContainerType::Array){ ArrayPin = Pair.Value; break; }}
+        if (!ArrayPin) ArrayPin = Node->GetPin(TEXT("Target Array"), EGPD_Input); 
 
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString ArrayStr = ArrayPin.IsValid() ? DataTracer.TracePinValue(ArrayPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("[?Array?]"));
@@ -81,13 +81,13 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatFormatText( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-        TSharedPtr<const FBlueprintPin> FormatPin = Node->GetPin(TEXT("Format"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> FormatPin = Node->GetPin(TEXT("Format"), EGPD_Input);
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString FormatStr = FormatPin.IsValid() ? DataTracer.TracePinValue(FormatPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("<?>"));
 
@@ -103,18 +103,18 @@ namespace MarkdownNodeFormatters_Private
 	FString MarkdownNodeFormatters_Private::FormatGetDataTableRow_NodeDescription(
     TSharedPtr<const FBlueprintNode> Node,
     FMarkdownDataTracer& DataTracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-    TSet<FString>& VisitedDataPins, // Note: This specific formatter might not need to pass VisitedDataPins *down* if it only calls RVR once per input.
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+    TSet<FResolvedPinKey>& VisitedDataPins, // Note: This specific formatter might not need to pass VisitedDataPins *down* if it only calls RVR once per input.
     bool bSymbolicTraceForData,    // This is the bSymbolicTrace flag from FormatNodeDescription's perspective
     const FString& CurrentBlueprintContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("GetDataTableRow"));
     UE_LOG(LogFormatter, Log, TEXT("FormatGetDataTableRow_NodeDescription: Node='%s' (GUID:%s), CtxRecv:'%s', SymbolicForData:%d"),
-        *Node->Name, *Node->Guid.Left(8), *CurrentBlueprintContext, bSymbolicTraceForData);
+        *Node->GetLogName(), *Node->Guid.Left(8), *CurrentBlueprintContext, bSymbolicTraceForData);
 
     // 1. Find and trace the 'DataTable' input pin
-    TSharedPtr<const FBlueprintPin> DataTableInputPin = Node->GetPin(TEXT("DataTable"), TEXT("EGPD_Input"));
+    TSharedPtr<const FBlueprintPin> DataTableInputPin = Node->GetPin(TEXT("DataTable"), EGPD_Input);
     FString DataTableNameStr = FMarkdownSpan::Error(TEXT("?DataTable?"));
     if (DataTableInputPin.IsValid())
     {
@@ -129,7 +129,7 @@ namespace MarkdownNodeFormatters_Private
     }
 
     // 2. Find and trace the 'RowName' input pin
-    TSharedPtr<const FBlueprintPin> RowNameInputPin = Node->GetPin(TEXT("RowName"), TEXT("EGPD_Input"));
+    TSharedPtr<const FBlueprintPin> RowNameInputPin = Node->GetPin(TEXT("RowName"), EGPD_Input);
     FString RowNameStr = FMarkdownSpan::Error(TEXT("?RowName?"));
     if (RowNameInputPin.IsValid())
     {
@@ -152,9 +152,9 @@ namespace MarkdownNodeFormatters_Private
 
     // Optional: Append original node title if it's custom and different from "Get Data Table Row"
     // This matches the pattern used for the desired output of Scenario 3.
-    if (!Node->Name.IsEmpty() && Node->Name != TEXT("Get Data Table Row") && Node->Name != Node->NodeType)
+    if (!Node->GetName().IsEmpty() && Node->GetName() != TEXT("Get Data Table Row") && Node->GetName() != Node->NodeType)
     {
-        Description += FString::Printf(TEXT(" (Node Title: %s)"), *Node->Name);
+        Description += FString::Printf(TEXT(" (Node Title: %s)"), *Node->GetName());
     }
     
     UE_LOG(LogFormatter, Log, TEXT("  FormatGetDataTableRow_NodeDescription: Result: '%s'"), *Description);
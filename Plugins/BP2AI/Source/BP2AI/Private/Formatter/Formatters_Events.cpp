@@ -25,8 +25,8 @@ namespace MarkdownNodeFormatters_Private
         TSharedPtr<const FBlueprintNode> Node,
         const TOptional<FCapturedEventData>& CapturedData, 
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData, // Parameter received
         const FString& CurrentBlueprintContext // Parameter received
     )
@@ -135,7 +135,7 @@ namespace MarkdownNodeFormatters_Private
             }
             else if (AxisNamePtr && !AxisNamePtr->IsEmpty()) { TempName = *AxisNamePtr; }
             else if (KeyNamePtr && !KeyNamePtr->IsEmpty()) { TempName = MarkdownTracerUtils::ExtractSimpleNameFromPath(*KeyNamePtr); } // No context needed here
-            else if (!Node->Name.IsEmpty()) { TempName = Node->Name; } 
+            else if (!Node->GetName().IsEmpty()) { TempName = Node->GetName(); } 
             else { TempName = Node->NodeType; } 
 
 
@@ -159,14 +159,14 @@ namespace MarkdownNodeFormatters_Private
     FString FormatTimeline(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData, // Parameter received
         const FString& CurrentBlueprintContext // Parameter received, not used by this formatter
     )
     {
         const FString TimelineName = Node->RawProperties.FindRef(TEXT("TimelineName"));
-        FString NameOrDefault = TimelineName.IsEmpty() ? Node->Name : TimelineName;
+        FString NameOrDefault = TimelineName.IsEmpty() ? Node->GetName() : TimelineName;
         if (NameOrDefault.IsEmpty()) NameOrDefault = TEXT("Timeline");
 
         FString Keyword = FMarkdownSpan::Keyword(TEXT("Timeline"));
@@ -178,8 +178,8 @@ namespace MarkdownNodeFormatters_Private
     FString FormatDelegateBinding(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData,
         const FString& CurrentBlueprintContext
     )
@@ -191,7 +191,7 @@ namespace MarkdownNodeFormatters_Private
         else ActionKeyword = TEXT("Delegate Op"); // Fallback
 
         // Find the delegate *input* pin (the event/function being bound)
-        TSharedPtr<const FBlueprintPin> DelegateInputPin = Node->GetPin(TEXT("Delegate"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> DelegateInputPin = Node->GetPin(TEXT("Delegate"), EGPD_Input);
         FString EventToBindStr = FMarkdownSpan::Error(TEXT("*(Missing Delegate Source)*"));
         if(DelegateInputPin.IsValid())
         {
@@ -231,8 +231,8 @@ namespace MarkdownNodeFormatters_Private
     FString FormatClearDelegate(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData, // Parameter received
         const FString& CurrentBlueprintContext // Context passed
     )
@@ -261,13 +261,13 @@ namespace MarkdownNodeFormatters_Private
     FString FormatCallDelegate(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData,
         const FString& CurrentBlueprintContext
     )
     {
-        TSharedPtr<const FBlueprintPin> DelegateInputPin = Node->GetPin(TEXT("Delegate"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> DelegateInputPin = Node->GetPin(TEXT("Delegate"), EGPD_Input);
         FString DelegateStr = FMarkdownSpan::Error(TEXT("?Delegate?"));
         if (DelegateInputPin.IsValid())
         {
@@ -294,14 +294,14 @@ namespace MarkdownNodeFormatters_Private
     FString FormatComposite(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer& DataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& VisitedDataPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FResolvedPinKey>& VisitedDataPins,
         bool bSymbolicTraceForData, // Parameter received, not used
         const FString& CurrentBlueprintContext // Context received, not used
     )
     {
         const FString GraphName = Node->RawProperties.FindRef(TEXT("BoundGraphName"));
-        FString NameOrDefault = GraphName.IsEmpty() ? Node->Name : GraphName;
+        FString NameOrDefault = GraphName.IsEmpty() ? Node->GetName() : GraphName;
         if (NameOrDefault.IsEmpty()) NameOrDefault = TEXT("Collapsed Graph");
 
         FString Keyword = FMarkdownSpan::Keyword(TEXT("Collapsed Graph"));
@@ -13,6 +13,7 @@
 #include "Trace/MarkdownDataTracer.h" 
 #include "Internationalization/Regex.h" 
 #include "Trace/Utils/MarkdownFormattingUtils.h"
+#include "Trace/Utils/MarkdownSpanSystem.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Kismet2/BlueprintEditorUtils.h" 
 #include "Trace/FMarkdownPathTracer.h"
@@ -24,8 +25,8 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatCallFunction( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext // Context received
 	)
@@ -49,7 +50,7 @@ namespace MarkdownNodeFormatters_Private
             // Use &DataTracer as the Tracer* parameter
             return MarkdownFormattingUtils::FormatConversion(Node, &DataTracer, AllNodes, 0, VisitedDataPins, nullptr, nullptr, bSymbolicTraceForData, CurrentBlueprintContext);
         }
-		UE_LOG(LogFormatter, Error, TEXT("🔧 DEBUG FUNCTION: Node='%s', FuncName='%s'"), *Node->Name, *FuncName);
+		UE_LOG(LogFormatter, Error, TEXT("🔧 DEBUG FUNCTION: Node='%s', FuncName='%s'"), *Node->GetLogName(), *FuncName);
 
 		
         // Check if it's a common unary operator (like Not_PreBool, handled by HandleUnaryOperator)
@@ -88,8 +89,10 @@ namespace MarkdownNodeFormatters_Private
 
         FString CallPrefix = TEXT("");
         if (!TargetStr.IsEmpty() && TargetStr != FMarkdownSpan::Variable(TEXT("self"))) {
-            if (TargetStr.Contains(TEXT("<span")) || TargetStr.Contains(TEXT("(")) || TargetStr.Contains(TEXT(")"))) { CallPrefix = FString::Printf(TEXT("(%s)."), *TargetStr); }
-            else { CallPrefix = TargetStr + TEXT("."); }
+            const FString WrappedPrefix = FString::Printf(TEXT("(%s)."), *TargetStr);
+            const FString PlainPrefix = TargetStr + TEXT(".");
+            if (TargetStr.Contains(TEXT("<span")) || TargetStr.Contains(TEXT("(")) || TargetStr.Contains(TEXT(")"))) { CallPrefix = WrappedPrefix; }
+            else { CallPrefix = FMarkdownSpanSystem::FormatSwitch(FMarkdownSpanSystem::HasNeutralSpans(TargetStr) ? WrappedPrefix : PlainPrefix, PlainPrefix); }
         }
 
         FString FuncNameSpan = FMarkdownSpan::FunctionName(FString::Printf(TEXT("%s"), *FuncName));
@@ -106,20 +109,20 @@ namespace MarkdownNodeFormatters_Private
 FString FormatMacroInstance( 
     TSharedPtr<const FBlueprintNode> Node, 
     FMarkdownDataTracer& DataTracer, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-    TSet<FString>& VisitedDataPins,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+    TSet<FResolvedPinKey>& VisitedDataPins,
     bool bSymbolicTraceForData,
     const FString& CurrentBlueprintContext // Context received
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("MacroInstance"));
     
-    UE_LOG(LogFormatter, Verbose, TEXT("  FormatMacroInstance: Node %s (%s), Symbolic=%d, Context='%s'"), *Node->Name, *Node->Guid, bSymbolicTraceForData, *CurrentBlueprintContext);
+    UE_LOG(LogFormatter, Verbose, TEXT("  FormatMacroInstance: Node %s (%s), Symbolic=%d, Context='%s'"), *Node->GetLogName(), *Node->Guid, bSymbolicTraceForData, *CurrentBlueprintContext);
 
     const FString* MacroPathPtr = Node->RawProperties.Find(TEXT("MacroGraphReference"));
     // Pass CurrentBlueprintContext to ExtractSimpleNameFromPath
     FString SimpleMacroName = MacroPathPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(**MacroPathPtr, CurrentBlueprintContext) : TEXT("UnknownMacro");
-    if (SimpleMacroName.IsEmpty()) SimpleMacroName = Node->Name.IsEmpty() ? Node->NodeType : Node->Name;
+    if (SimpleMacroName.IsEmpty()) SimpleMacroName = Node->GetName().IsEmpty() ? Node->NodeType : Node->GetName();
 
 
     // Handle known standard engine macros that are executable and have specific formatting
@@ -132,8 +135,8 @@ FString FormatMacroInstance(
     if (SimpleMacroName == TEXT("ForLoop") || SimpleMacroName == TEXT("ForLoopWithBreak"))
     {
         UE_LOG(LogFormatter, Log, TEXT("  FormatMacroInstance: Handling ForLoop/ForLoopWithBreak for node %s. Context: '%s'."), *Node->Guid, *CurrentBlueprintContext);
-        TSharedPtr<const FBlueprintPin> FirstPinInstance = Node->GetPin(TEXT("FirstIndex"), TEXT("EGPD_Input"));
-        TSharedPtr<const FBlueprintPin> LastPinInstance = Node->GetPin(TEXT("LastIndex"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> FirstPinInstance = Node->GetPin(TEXT("FirstIndex"), EGPD_Input);
+        TSharedPtr<const FBlueprintPin> LastPinInstance = Node->GetPin(TEXT("LastIndex"), EGPD_Input);
 
         FString FirstStr = FMarkdownSpan::Error(TEXT("?")); // Default to error string
         FString LastStr = FMarkdownSpan::Error(TEXT("?"));  // Default to error string
@@ -150,7 +153,7 @@ FString FormatMacroInstance(
         }
         
         FString Keyword = FMarkdownSpan::Keyword(TEXT("For Loop"));
-        TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Index"), TEXT("EGPD_Output"));
+        TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Index"), EGPD_Output);
         FString IndexType = IndexPin.IsValid() ? IndexPin->GetTypeSignature() : TEXT("?"); // Default to ? if pin not found
         FString LoopVarStr = FString::Printf(TEXT("[%s:%s]"), 
             *FMarkdownSpan::ParamName(TEXT("Index")), 
@@ -167,7 +170,7 @@ FString FormatMacroInstance(
     if (SimpleMacroName == TEXT("WhileLoop"))
     {
          UE_LOG(LogFormatter, Error, TEXT("  FormatMacroInstance: Hit WhileLoop branch for node %s. Should be handled in FormatNodeDescription."), *Node->Guid);
-         TSharedPtr<const FBlueprintPin> CondPin = Node->GetPin(TEXT("Condition"), TEXT("EGPD_Input"));
+         TSharedPtr<const FBlueprintPin> CondPin = Node->GetPin(TEXT("Condition"), EGPD_Input);
          // Pass bSymbolicTraceForData and CurrentBlueprintContext
          FString CondStr = CondPin.IsValid() ? DataTracer.TracePinValue(CondPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : TEXT("?");
          FString Keyword = FMarkdownSpan::Keyword(TEXT("While Loop"));
@@ -179,7 +182,7 @@ FString FormatMacroInstance(
     if (SimpleMacroName == TEXT("DoOnce")) { return FMarkdownSpan::Keyword(TEXT("Do Once")); }
     if (SimpleMacroName == TEXT("DoN"))
     {
-         TSharedPtr<const FBlueprintPin> NPin = Node->GetPin(TEXT("N"), TEXT("EGPD_Input"));
+         TSharedPtr<const FBlueprintPin> NPin = Node->GetPin(TEXT("N"), EGPD_Input);
          // Pass bSymbolicTraceForData and CurrentBlueprintContext
          FString NStr = NPin.IsValid() ? DataTracer.TracePinValue(NPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : TEXT("?");
          FString Keyword = FMarkdownSpan::Keyword(TEXT("Do N"));
@@ -187,8 +190,8 @@ FString FormatMacroInstance(
     }
     if (SimpleMacroName == TEXT("IsValid"))
     {
-         TSharedPtr<const FBlueprintPin> InputPin = Node->GetPin(TEXT("Input Object"), TEXT("EGPD_Input"));
-         if (!InputPin) InputPin = Node->GetPin(TEXT("InputObject"), TEXT("EGPD_Input")); 
+         TSharedPtr<const FBlueprintPin> InputPin = Node->GetPin(TEXT("Input Object"), EGPD_Input);
+         if (!InputPin) InputPin = Node->GetPin(TEXT("InputObject"), EGPD_Input); 
          // Pass bSymbolicTraceForData and CurrentBlueprintContext
          FString InputStr = InputPin.IsValid() ? DataTracer.TracePinValue(InputPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : TEXT("?");
          FString Keyword = FMarkdownSpan::Keyword(TEXT("Is Valid"));
@@ -212,27 +215,27 @@ FString FormatMacroInstance(
 FString MarkdownNodeFormatters_Private::FormatCallParentFunction( 
     TSharedPtr<const FBlueprintNode> Node, 
     FMarkdownDataTracer& DataTracer, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-    TSet<FString>& VisitedDataPins,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+    TSet<FResolvedPinKey>& VisitedDataPins,
     bool bSymbolicTraceForData,
     const FString& CurrentBlueprintContext
 )
 {
     check(Node.IsValid()); 
-    // Use Node->Name or Node->NodeType directly for logging
+    // Use Node->GetName() or Node->NodeType directly for logging
     UE_LOG(LogFormatter, Error, TEXT("FormatCallParentFunction BEGIN for Node '%s' (Node Type: '%s', GUID: %s). Context: '%s'"), 
-        Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name, // Corrected logging
+        Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName(), // Corrected logging
         *Node->NodeType,
         *Node->Guid.Left(8), 
         *CurrentBlueprintContext);
 
     // --- Log ALL RawProperties available on this FBlueprintNode model ---
-    UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: Dumping RawProperties for Node '%s':"), Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name);
+    UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: Dumping RawProperties for Node '%s':"), Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName());
     for (const auto& Pair : Node->RawProperties)
     {
         UE_LOG(LogFormatter, Error, TEXT("    RawProp: Key='%s', Value='%s'"), *Pair.Key, *Pair.Value);
     }
-    UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: End RawProperties Dump for Node '%s'."), Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name);
+    UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: End RawProperties Dump for Node '%s'."), Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName());
     // --- End Log ALL RawProperties ---
 
     const FString ParentFuncName = Node->RawProperties.FindRef(TEXT("SuperFunctionName"));
@@ -240,7 +243,7 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
 
     if (ParentFuncName.IsEmpty()) 
     {
-        UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: 'SuperFunctionName' is EMPTY for Node '%s'. Falling back to FormatGeneric. THIS IS LIKELY AN ISSUE IN THE FACTORY OR NODE MODEL POPULATION."), Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name);
+        UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: 'SuperFunctionName' is EMPTY for Node '%s'. Falling back to FormatGeneric. THIS IS LIKELY AN ISSUE IN THE FACTORY OR NODE MODEL POPULATION."), Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName());
         return FormatGeneric(Node);
     }
 
@@ -258,7 +261,7 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
         }
         UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: Derived ParentBlueprintNameForAnchor: '%s'"), *ParentBlueprintNameForAnchor);
     } else {
-        UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: Could NOT find 'FunctionParentClassPath' in RawProperties for Node '%s'. Using fallback anchor name."), Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name);
+        UE_LOG(LogFormatter, Error, TEXT("  FormatCallParentFunction: Could NOT find 'FunctionParentClassPath' in RawProperties for Node '%s'. Using fallback anchor name."), Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName());
     }
 
     FString UniqueHintForParentFunc = FString::Printf(TEXT("%s.%s"), *ParentBlueprintNameForAnchor, *ParentFuncName);
@@ -269,7 +272,7 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
     FString FuncNameLinked = FString::Printf(TEXT(" [`%s`](#%s)"), *ParentFuncName, *AnchorName);
 
     FString Result = FString::Printf(TEXT("%s%s%s"), *Keyword, *FuncNameLinked, *ArgsStr);
-    UE_LOG(LogFormatter, Error, TEXT("FormatCallParentFunction END for Node '%s'. Returning: '%s'"), Node->Name.IsEmpty() ? *Node->NodeType : *Node->Name, *Result);
+    UE_LOG(LogFormatter, Error, TEXT("FormatCallParentFunction END for Node '%s'. Returning: '%s'"), Node->GetLogName().IsEmpty() ? *Node->NodeType : *Node->GetLogName(), *Result);
     return Result;
 }
 	
@@ -277,8 +280,8 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
 	FString FormatReturnNode( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext 
 	)
@@ -294,8 +297,8 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
 	FString FormatLatentAction( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	 )
@@ -318,8 +321,8 @@ FString MarkdownNodeFormatters_Private::FormatCallParentFunction(
 	FString FormatPlayMontage( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	 )
@@ -14,19 +14,20 @@
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Trace/Utils/MarkdownFormattingUtils.h" // For FMarkdownSpan
 #include "Logging/LogMacros.h"
+#include "EdGraphSchema_K2.h"
 
 namespace MarkdownNodeFormatters_Private
 {
 	FString FormatSpawnActor( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
 	{
-		TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), EGPD_Input);
 		FString ClassName = FMarkdownSpan::Error(TEXT("?Class?"));
 		if (ClassPin.IsValid()) { 
             // Pass bSymbolicTraceForData and CurrentBlueprintContext
@@ -38,7 +39,7 @@ namespace MarkdownNodeFormatters_Private
              if (ClassPath) ClassName = FMarkdownSpan::LiteralObject(FString::Printf(TEXT("%s"), *MarkdownTracerUtils::ExtractSimpleNameFromPath(*ClassPath)));
         }
 
-		TSharedPtr<const FBlueprintPin> SpawnTransformPin = Node->GetPin(TEXT("SpawnTransform"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> SpawnTransformPin = Node->GetPin(TEXT("SpawnTransform"), EGPD_Input);
 		FString SpawnTransformStr = FMarkdownSpan::LiteralStructVal(TEXT("DefaultTransform"));
         if(SpawnTransformPin.IsValid() && !MarkdownTracerUtils::IsTrivialDefault(SpawnTransformPin)) {
              // Pass bSymbolicTraceForData and CurrentBlueprintContext
@@ -55,14 +56,14 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatAddComponent( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
     {
 		FString CompName = FMarkdownSpan::Error(TEXT("?Component?"));
-        TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("ComponentClass"), TEXT("EGPD_Input")); 
+        TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("ComponentClass"), EGPD_Input); 
          if (!ClassPin) ClassPin = Node->GetPin(TEXT("Return Value Class")); 
 
         if (ClassPin.IsValid()) {
@@ -94,13 +95,13 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatCreateWidget( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
     {
-		TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), EGPD_Input);
 		FString WidgetName = FMarkdownSpan::Error(TEXT("?Widget?"));
         if (ClassPin.IsValid()) { 
             // Pass bSymbolicTraceForData and CurrentBlueprintContext
@@ -112,7 +113,7 @@ namespace MarkdownNodeFormatters_Private
             if (ClassPath) WidgetName = FMarkdownSpan::WidgetName(FString::Printf(TEXT("%s"), *MarkdownTracerUtils::ExtractSimpleNameFromPath(*ClassPath)));
         }
 
-        TSharedPtr<const FBlueprintPin> OwnerPin = Node->GetPin(TEXT("OwningPlayer"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> OwnerPin = Node->GetPin(TEXT("OwningPlayer"), EGPD_Input);
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString OwnerStr = OwnerPin.IsValid() ? DataTracer.TracePinValue(OwnerPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Variable(TEXT("DefaultPlayer"));
 
@@ -127,17 +128,17 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatGenericCreateObject( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
     {
-        TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"), EGPD_Input);
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString ClassName = ClassPin.IsValid() ? DataTracer.TracePinValue(ClassPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("?Class?"));
 
-        TSharedPtr<const FBlueprintPin> OuterPin = Node->GetPin(TEXT("Outer"), TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> OuterPin = Node->GetPin(TEXT("Outer"), EGPD_Input);
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString OuterStr = OuterPin.IsValid() ? DataTracer.TracePinValue(OuterPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Variable(TEXT("DefaultOuter"));
 
@@ -152,14 +153,14 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatDynamicCast( 
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext
 	)
     {
-		TSharedPtr<const FBlueprintPin> ObjectPin = Node->GetPin(TEXT("ObjectToCast"), TEXT("EGPD_Input"));
-        if (!ObjectPin) ObjectPin = Node->GetPin(TEXT("Object"), TEXT("EGPD_Input"));
+		TSharedPtr<const FBlueprintPin> ObjectPin = Node->GetPin(TEXT("ObjectToCast"), EGPD_Input);
+        if (!ObjectPin) ObjectPin = Node->GetPin(TEXT("Object"), EGPD_Input);
 		// Pass bSymbolicTraceForData and CurrentBlueprintContext
 		FString ObjectStr = ObjectPin.IsValid() ? DataTracer.TracePinValue(ObjectPin, AllNodes, bSymbolicTraceForData, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("<?>"));
         
@@ -167,7 +168,7 @@ namespace MarkdownNodeFormatters_Private
         const FString* TargetTypePathProp = Node->RawProperties.Find(TEXT("TargetType"));
          if (TargetTypePathProp && !TargetTypePathProp->IsEmpty()){ TargetTypeName = MarkdownTracerUtils::ExtractSimpleNameFromPath(*TargetTypePathProp); } // No context needed here
         if (TargetTypeName == TEXT("UnknownType") || TargetTypeName == TEXT("Object")) { 
-             for(const auto& Pair : Node->Pins){ if(Pair.Value.IsValid() && Pair.Value->IsOutput() && Pair.Value->Category == TEXT("object")){ TargetTypeName = Pair.Value->GetTypeSignature(); break; }}
+             for(const auto& Pair : Node->Pins){ if(Pair.Value.IsValid() && Pair.Value->IsOutput() && Pair.Value->PinCategory == UEdGraphSchema_K2::PC_Object){ TargetTypeName = Pair.Value->GetTypeSignature(); break; }}
              TargetTypeName.RemoveFromEnd(TEXT("&")); 
         }
         if (TargetTypeName.IsEmpty()) TargetTypeName = TEXT("UnknownType");
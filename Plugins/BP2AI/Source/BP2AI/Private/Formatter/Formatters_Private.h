@@ -18,6 +18,7 @@
 class FBlueprintNode;
 class FBlueprintPin;
 class FMarkdownDataTracer;
+struct FResolvedPinKey;
 
 // Use a namespace to group these internal static functions
 namespace MarkdownNodeFormatters_Private
@@ -26,8 +27,8 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatArguments(
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins, 
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins, 
 		bool bSymbolicTraceForData,
 		const TSet<FName>& ExcludePinNames = {},
 		const FString& CurrentBlueprintContext = TEXT("") // New context parameter
@@ -36,8 +37,8 @@ namespace MarkdownNodeFormatters_Private
 	FString FormatTarget(
 		TSharedPtr<const FBlueprintNode> Node, 
 		FMarkdownDataTracer& DataTracer, 
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-		TSet<FString>& VisitedDataPins,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+		TSet<FResolvedPinKey>& VisitedDataPins,
 		bool bSymbolicTraceForData,
 		const FString& CurrentBlueprintContext = TEXT("") // New context parameter
 	);
@@ -54,42 +55,42 @@ namespace MarkdownNodeFormatters_Private
 	// All these will now take the CurrentBlueprintContext parameter
 
 	// Formatters_Variables.cpp
-	FString FormatVariableSet(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatVariableSet(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
 
 	// Formatters_Functions.cpp
-	FString FormatCallFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-	FString FormatMacroInstance(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-	FString FormatCallParentFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatReturnNode(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatLatentAction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatPlayMontage(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatCallFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatMacroInstance(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatCallParentFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatReturnNode(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatLatentAction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatPlayMontage(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
 
 	// Formatters_ControlFlow.cpp
-	FString FormatIfThenElse(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-	FString FormatSwitch(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatSequence(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatForEachLoop(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatIfThenElse(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatSwitch(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatSequence(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatForEachLoop(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
 
 	// Formatters_Objects.cpp
-    FString FormatSpawnActor(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatAddComponent(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatCreateWidget(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatGenericCreateObject(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatDynamicCast(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatSpawnActor(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatAddComponent(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatCreateWidget(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatGenericCreateObject(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatDynamicCast(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
 
 	// Formatters_Data.cpp
-    FString FormatSetFieldsInStruct(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatCallArrayFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatFormatText(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-	FString FormatGetDataTableRow_NodeDescription(TSharedPtr<const FBlueprintNode> Node,FMarkdownDataTracer& DataTracer,const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,TSet<FString>& VisitedDataPins,bool bSymbolicTraceForData,const FString& CurrentBlueprintContext);
+    FString FormatSetFieldsInStruct(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatCallArrayFunction(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatFormatText(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatGetDataTableRow_NodeDescription(TSharedPtr<const FBlueprintNode> Node,FMarkdownDataTracer& DataTracer,const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,TSet<FResolvedPinKey>& VisitedDataPins,bool bSymbolicTraceForData,const FString& CurrentBlueprintContext);
 
 	
 	// Formatters_Events.cpp
-	FString FormatEvent(TSharedPtr<const FBlueprintNode> Node, const TOptional<FCapturedEventData>& CapturedData, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-	FString FormatTimeline(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatDelegateBinding(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatClearDelegate(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatCallDelegate(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
-    FString FormatComposite(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatEvent(TSharedPtr<const FBlueprintNode> Node, const TOptional<FCapturedEventData>& CapturedData, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+	FString FormatTimeline(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatDelegateBinding(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatClearDelegate(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatCallDelegate(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
+    FString FormatComposite(TSharedPtr<const FBlueprintNode> Node, FMarkdownDataTracer& DataTracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FResolvedPinKey>& VisitedDataPins, bool bSymbolicTraceForData, const FString& CurrentBlueprintContext = TEXT(""));
 
 } // namespace MarkdownNodeFormatters_Private
\ No newline at end of file
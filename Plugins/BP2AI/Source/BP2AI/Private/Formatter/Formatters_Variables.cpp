@@ -18,8 +18,8 @@ namespace MarkdownNodeFormatters_Private
     FString FormatVariableSet( 
        TSharedPtr<const FBlueprintNode> Node, 
        FMarkdownDataTracer& DataTracer, 
-       const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-       TSet<FString>& VisitedDataPins,
+       const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+       TSet<FResolvedPinKey>& VisitedDataPins,
        bool bSymbolicTraceForData,
        const FString& CurrentBlueprintContext
     )
@@ -27,7 +27,7 @@ namespace MarkdownNodeFormatters_Private
        const FString VarName = Node->RawProperties.FindRef(TEXT("VariableName"));
        if (VarName.IsEmpty()) return FMarkdownSpan::Error(TEXT("[Unknown Variable Set]"));
 
-       TSharedPtr<const FBlueprintPin> ValuePin = Node->GetPin(VarName, TEXT("EGPD_Input"));
+       TSharedPtr<const FBlueprintPin> ValuePin = Node->GetPin(VarName, EGPD_Input);
        if (!ValuePin) { for(const auto& Pair : Node->Pins) { if (Pair.Value.IsValid() && Pair.Value->IsInput() && !Pair.Value->IsExecution() && Pair.Value->Name != TEXT("self")) { ValuePin = Pair.Value; break; } } }
 
        FString ValueStr = FMarkdownSpan::Error(TEXT("<?>"));
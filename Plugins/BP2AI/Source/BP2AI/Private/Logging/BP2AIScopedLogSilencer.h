@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Logging/BP2AIScopedLogSilencer.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/BP2AILog.h"
+#include "Settings/BP2AIExportConfig.h"
+
+/**
+ * RAII helper to silence internal log categories during batch operations.
+ * Restores original verbosity on destruction.
+ */
+struct FScopedLogSilencer
+{
+    FScopedLogSilencer()
+    {
+        bShouldSilence = BP2AIExportConfig::bSilenceInternalCategoriesDuringBatchExport;
+        if (bShouldSilence)
+        {
+            OriginalDataTracer = LogDataTracer.GetVerbosity();
+            OriginalPathTracer = LogPathTracer.GetVerbosity();
+            OriginalFormatter = LogFormatter.GetVerbosity();
+            OriginalExtractor = LogExtractor.GetVerbosity();
+            OriginalNodeFactory = LogBlueprintNodeFactory.GetVerbosity();
+            OriginalModels = LogModels.GetVerbosity();
+
+            LogDataTracer.SetVerbosity(ELogVerbosity::NoLogging);
+            LogPathTracer.SetVerbosity(ELogVerbosity::NoLogging);
+            LogFormatter.SetVerbosity(ELogVerbosity::NoLogging);
+            LogExtractor.SetVerbosity(ELogVerbosity::NoLogging);
+            LogBlueprintNodeFactory.SetVerbosity(ELogVerbosity::NoLogging);
+            LogModels.SetVerbosity(ELogVerbosity::NoLogging);
+        }
+    }
+
+    ~FScopedLogSilencer()
+    {
+        if (bShouldSilence)
+        {
+            LogDataTracer.SetVerbosity(OriginalDataTracer);
+            LogPathTracer.SetVerbosity(OriginalPathTracer);
+            LogFormatter.SetVerbosity(OriginalFormatter);
+            LogExtractor.SetVerbosity(OriginalExtractor);
+            LogBlueprintNodeFactory.SetVerbosity(OriginalNodeFactory);
+            LogModels.SetVerbosity(OriginalModels);
+        }
+    }
+
+private:
+    bool bShouldSilence;
+    ELogVerbosity::Type OriginalDataTracer;
+    ELogVerbosity::Type OriginalPathTracer;
+    ELogVerbosity::Type OriginalFormatter;
+    ELogVerbosity::Type OriginalExtractor;
+    ELogVerbosity::Type OriginalNodeFactory;
+    ELogVerbosity::Type OriginalModels;
+};
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Models/BlueprintGraphSnapshot.cpp
+
+#include "Models/BlueprintGraphSnapshot.h"
+#include "Models/BlueprintPin.h"
+#include "Logging/BP2AILog.h"
+
+// --- FBlueprintStringPool ---
+
+FBlueprintStringPool::FBlueprintStringPool()
+{
+	Strings.Add(FString());
+}
+
+FBPStringId FBlueprintStringPool::Intern(const FString& Value)
+{
+	if (Value.IsEmpty())
+	{
+		return 0;
+	}
+	if (const FBPStringId* Existing = Lookup.Find(Value))
+	{
+		return *Existing;
+	}
+	const FBPStringId Id = Strings.Add(Value);
+	Lookup.Add(Value, Id);
+	return Id;
+}
+
+void FBlueprintStringPool::FinishBuilding()
+{
+	Lookup.Empty();
+	Strings.Shrink();
+}
+
+SIZE_T FBlueprintStringPool::GetAllocatedSize() const
+{
+	SIZE_T Size = Strings.GetAllocatedSize() + Lookup.GetAllocatedSize();
+	for (const FString& String : Strings)
+	{
+		Size += String.GetAllocatedSize();
+	}
+	return Size;
+}
+
+// --- FBlueprintGraphSnapshot ---
+
+FBlueprintSnapshotRange FBlueprintGraphSnapshot::AddProperties(const TMap<FString, FString>& InProperties)
+{
+	FBlueprintSnapshotRange Range;
+	Range.First = Properties.Num();
+	Range.Num = InProperties.Num();
+	for (const TPair<FString, FString>& Pair : InProperties)
+	{
+		Properties.Add({ StringPool.Intern(Pair.Key), StringPool.Intern(Pair.Value) });
+	}
+	return Range;
+}
+
+FBlueprintGraphSnapshot FBlueprintGraphSnapshot::Build(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InNodes, bool bResolveNames)
+{
+	FBlueprintGraphSnapshot Snapshot;
+	Snapshot.Nodes.Reserve(InNodes.Num());
+	Snapshot.NodeIndexByGuid.Reserve(InNodes.Num());
+
+	// 第一遍：节点、引脚、属性；记录共享指针引脚到句柄的映射供第二遍连边
+	TMap<const FBlueprintPin*, FBPPinHandle> PinHandles;
+	for (const TPair<FGuid, TSharedPtr<FBlueprintNode>>& NodePair : InNodes)
+	{
+		const FBlueprintNode* Node = NodePair.Value.Get();
+		if (!Node)
+		{
+			continue;
+		}
+
+		const FBPNodeHandle NodeHandle = Snapshot.Nodes.Num();
+		FBlueprintNodeRecord& NodeRecord = Snapshot.Nodes.AddDefaulted_GetRef();
+		NodeRecord.Guid = Snapshot.StringPool.Intern(Node->Guid);
+		NodeRecord.GraphNodeGuid = NodePair.Key;
+		Snapshot.NodeSetHash = Node->NodeSetHash;
+		NodeRecord.NodeType = Snapshot.StringPool.Intern(Node->NodeType);
+		NodeRecord.NodeKind = Node->NodeKind;
+		NodeRecord.UEClass = Snapshot.StringPool.Intern(Node->UEClass);
+		if (bResolveNames || Node->IsNameResolved())
+		{
+			NodeRecord.Name = Snapshot.StringPool.Intern(Node->GetName());
+			NodeRecord.bNameResolved = true;
+		}
+		NodeRecord.bRefsResolved = Node->CapturedRefs.bResolved;
+		NodeRecord.UserGraphType = Node->CapturedRefs.UserGraphType;
+		NodeRecord.UserGraphPath = Snapshot.StringPool.Intern(Node->CapturedRefs.UserGraphPath);
+		NodeRecord.UserGraphNameHint = Snapshot.StringPool.Intern(Node->CapturedRefs.UserGraphNameHint);
+		NodeRecord.UserFunctionAssetPath = Snapshot.StringPool.Intern(Node->CapturedRefs.UserFunctionAssetPath);
+		NodeRecord.NodeComment = Snapshot.StringPool.Intern(Node->NodeComment);
+		NodeRecord.PreservedCompPropName = Snapshot.StringPool.Intern(Node->PreservedCompPropName);
+		NodeRecord.PreservedDelPropName = Snapshot.StringPool.Intern(Node->PreservedDelPropName);
+		NodeRecord.TestStringMember = Snapshot.StringPool.Intern(Node->TestStringMember);
+		NodeRecord.BoundEventOwnerClassPath = Snapshot.StringPool.Intern(Node->BoundEventOwnerClassPath);
+		NodeRecord.Position = Node->Position;
+		NodeRecord.OriginalEdGraphNode = Node->OriginalEdGraphNode;
+		NodeRecord.RawProperties = Snapshot.AddProperties(Node->RawProperties);
+		NodeRecord.Pins.First = Snapshot.Pins.Num();
+		Snapshot.NodeIndexByGuid.Add(NodePair.Key, NodeHandle);
+
+		for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& PinPair : Node->Pins)
+		{
+			const FBlueprintPin* Pin = PinPair.Value.Get();
+			if (!Pin)
+			{
+				continue;
+			}
+
+			PinHandles.Add(Pin, Snapshot.Pins.Num());
+			FBlueprintPinRecord& PinRecord = Snapshot.Pins.AddDefaulted_GetRef();
+			PinRecord.Node = NodeHandle;
+			PinRecord.Id = Snapshot.StringPool.Intern(Pin->Id);
+			PinRecord.PinId = Snapshot.StringPool.Intern(Pin->PinId);
+			PinRecord.NodeGuid = Snapshot.StringPool.Intern(Pin->NodeGuid);
+			PinRecord.Name = Snapshot.StringPool.Intern(Pin->Name);
+			PinRecord.FriendlyName = Snapshot.StringPool.Intern(Pin->FriendlyName);
+			PinRecord.Direction = Pin->Direction;
+			PinRecord.Category = Snapshot.StringPool.Intern(Pin->Category);
+			PinRecord.SubCategory = Snapshot.StringPool.Intern(Pin->SubCategory);
+			PinRecord.SubCategoryObject = Snapshot.StringPool.Intern(Pin->SubCategoryObject);
+			PinRecord.ContainerType = Snapshot.StringPool.Intern(Pin->ContainerType);
+			PinRecord.DefaultValue = Snapshot.StringPool.Intern(Pin->DefaultValue);
+			PinRecord.DefaultObject = Snapshot.StringPool.Intern(Pin->DefaultObject);
+			PinRecord.MapValueTerminalCategory = Snapshot.StringPool.Intern(Pin->MapValueTerminalCategory);
+			PinRecord.MapValueTerminalSubCategoryObjectPath = Snapshot.StringPool.Intern(Pin->MapValueTerminalSubCategoryObjectPath);
+			PinRecord.DefaultValueEnumDisplayName = Snapshot.StringPool.Intern(Pin->DefaultValueEnumDisplayName);
+			PinRecord.PinName = Pin->PinName;
+			PinRecord.GraphPinId = PinPair.Key;
+			PinRecord.GraphNodeGuid = Pin->GraphNodeGuid;
+			PinRecord.PinCategory = Pin->PinCategory;
+			PinRecord.PinSubCategory = Pin->PinSubCategory;
+			PinRecord.PinContainerType = Pin->PinContainerType;
+			PinRecord.bHidden = Pin->bHidden;
+			PinRecord.bAdvancedView = Pin->bAdvancedView;
+			PinRecord.bIsReference = Pin->bIsReference;
+			PinRecord.bIsConst = Pin->bIsConst;
+			PinRecord.bSubCategoryObjectIsEnum = Pin->bSubCategoryObjectIsEnum;
+			PinRecord.bMapValueTerminalIsEnum = Pin->bMapValueTerminalIsEnum;
+			PinRecord.DefaultStruct = Snapshot.AddProperties(Pin->DefaultStruct);
+			PinRecord.RawProperties = Snapshot.AddProperties(Pin->RawProperties);
+		}
+
+		NodeRecord.Pins.Num = Snapshot.Pins.Num() - NodeRecord.Pins.First;
+	}
+
+	// 第二遍：链接展开为边数组（顺序与原 LinkedPins/SourcePinFor 一致）
+	int32 DroppedLinks = 0;
+	auto AppendEdges = [&Snapshot, &PinHandles, &DroppedLinks](const TArray<TSharedPtr<FBlueprintPin>>& Links) -> FBlueprintSnapshotRange
+	{
+		FBlueprintSnapshotRange Range;
+		Range.First = Snapshot.Edges.Num();
+		for (const TSharedPtr<FBlueprintPin>& Linked : Links)
+		{
+			const FBPPinHandle* Handle = PinHandles.Find(Linked.Get());
+			if (Handle)
+			{
+				Snapshot.Edges.Add(*Handle);
+			}
+			else
+			{
+				++DroppedLinks;
+			}
+		}
+		Range.Num = Snapshot.Edges.Num() - Range.First;
+		return Range;
+	};
+
+	for (const TPair<const FBlueprintPin*, FBPPinHandle>& PinPair : PinHandles)
+	{
+		FBlueprintPinRecord& PinRecord = Snapshot.Pins[PinPair.Value];
+		PinRecord.LinkedPins = AppendEdges(PinPair.Key->LinkedPins);
+		PinRecord.SourcePinFor = AppendEdges(PinPair.Key->SourcePinFor);
+	}
+
+	if (DroppedLinks > 0)
+	{
+		UE_LOG(LogModels, Verbose, TEXT("FBlueprintGraphSnapshot: Dropped %d links to pins outside the snapshot."), DroppedLinks);
+	}
+
+	Snapshot.StringPool.FinishBuilding();
+	Snapshot.Nodes.Shrink();
+	Snapshot.Pins.Shrink();
+	Snapshot.Properties.Shrink();
+	Snapshot.Edges.Shrink();
+	return Snapshot;
+}
+
+TMap<FGuid, TSharedPtr<FBlueprintNode>> FBlueprintGraphSnapshot::CreateCompatibilityView() const
+{
+	TMap<FGuid, TSharedPtr<FBlueprintNode>> View;
+	View.Reserve(Nodes.Num());
+
+	auto CopyProperties = [this](const FBlueprintSnapshotRange& Range, TMap<FString, FString>& Out)
+	{
+		Out.Reserve(Range.Num);
+		for (const FBlueprintSnapshotProperty& Property : GetProperties(Range))
+		{
+			Out.Add(StringPool.Get(Property.Key), StringPool.Get(Property.Value));
+		}
+	};
+
+	TArray<TSharedPtr<FBlueprintPin>> PinObjects;
+	PinObjects.SetNum(Pins.Num());
+
+	for (const FBlueprintNodeRecord& NodeRecord : Nodes)
+	{
+		// 种类已在提取时计算，不再按字符串重新分类
+		TSharedPtr<FBlueprintNode> Node = MakeShared<FBlueprintNode>(StringPool.Get(NodeRecord.Guid), FString());
+		Node->NodeType = StringPool.Get(NodeRecord.NodeType);
+		Node->NodeKind = NodeRecord.NodeKind;
+		Node->OriginalEdGraphNode = NodeRecord.OriginalEdGraphNode;
+		Node->GraphNodeGuid = NodeRecord.GraphNodeGuid;
+		Node->NodeSetHash = NodeSetHash;
+		Node->UEClass = StringPool.Get(NodeRecord.UEClass);
+		if (NodeRecord.bNameResolved)
+		{
+			Node->SetName(StringPool.Get(NodeRecord.Name));
+		}
+		Node->CapturedRefs.bResolved = NodeRecord.bRefsResolved;
+		Node->CapturedRefs.UserGraphType = NodeRecord.UserGraphType;
+		Node->CapturedRefs.UserGraphPath = StringPool.Get(NodeRecord.UserGraphPath);
+		Node->CapturedRefs.UserGraphNameHint = StringPool.Get(NodeRecord.UserGraphNameHint);
+		Node->CapturedRefs.UserFunctionAssetPath = StringPool.Get(NodeRecord.UserFunctionAssetPath);
+		Node->NodeComment = StringPool.Get(NodeRecord.NodeComment);
+		Node->PreservedCompPropName = StringPool.Get(NodeRecord.PreservedCompPropName);
+		Node->PreservedDelPropName = StringPool.Get(NodeRecord.PreservedDelPropName);
+		Node->TestStringMember = StringPool.Get(NodeRecord.TestStringMember);
+		Node->BoundEventOwnerClassPath = StringPool.Get(NodeRecord.BoundEventOwnerClassPath);
+		Node->Position = NodeRecord.Position;
+		CopyProperties(NodeRecord.RawProperties, Node->RawProperties);
+
+		Node->Pins.Reserve(NodeRecord.Pins.Num);
+		for (int32 PinHandle = NodeRecord.Pins.First; PinHandle < NodeRecord.Pins.First + NodeRecord.Pins.Num; ++PinHandle)
+		{
+			const FBlueprintPinRecord& PinRecord = Pins[PinHandle];
+			TSharedPtr<FBlueprintPin> Pin = MakeShared<FBlueprintPin>(StringPool.Get(PinRecord.Id), StringPool.Get(PinRecord.NodeGuid));
+			Pin->PinId = StringPool.Get(PinRecord.PinId);
+			Pin->Name = StringPool.Get(PinRecord.Name);
+			Pin->PinName = PinRecord.PinName;
+			Pin->GraphPinId = PinRecord.GraphPinId;
+			Pin->GraphNodeGuid = PinRecord.GraphNodeGuid;
+			Pin->FriendlyName = StringPool.Get(PinRecord.FriendlyName);
+			Pin->Direction = PinRecord.Direction;
+			Pin->PinCategory = PinRecord.PinCategory;
+			Pin->PinSubCategory = PinRecord.PinSubCategory;
+			Pin->PinContainerType = PinRecord.PinContainerType;
+			Pin->bHidden = PinRecord.bHidden;
+			Pin->bAdvancedView = PinRecord.bAdvancedView;
+			Pin->Category = StringPool.Get(PinRecord.Category);
+			Pin->SubCategory = StringPool.Get(PinRecord.SubCategory);
+			Pin->SubCategoryObject = StringPool.Get(PinRecord.SubCategoryObject);
+			Pin->bIsReference = PinRecord.bIsReference;
+			Pin->bIsConst = PinRecord.bIsConst;
+			Pin->ContainerType = StringPool.Get(PinRecord.ContainerType);
+			Pin->DefaultValue = StringPool.Get(PinRecord.DefaultValue);
+			Pin->DefaultObject = StringPool.Get(PinRecord.DefaultObject);
+			Pin->MapValueTerminalCategory = StringPool.Get(PinRecord.MapValueTerminalCategory);
+			Pin->MapValueTerminalSubCategoryObjectPath = StringPool.Get(PinRecord.MapValueTerminalSubCategoryObjectPath);
+			Pin->bSubCategoryObjectIsEnum = PinRecord.bSubCategoryObjectIsEnum;
+			Pin->bMapValueTerminalIsEnum = PinRecord.bMapValueTerminalIsEnum;
+			Pin->DefaultValueEnumDisplayName = StringPool.Get(PinRecord.DefaultValueEnumDisplayName);
+			CopyProperties(PinRecord.DefaultStruct, Pin->DefaultStruct);
+			CopyProperties(PinRecord.RawProperties, Pin->RawProperties);
+
+			Node->Pins.Add(PinRecord.GraphPinId, Pin);
+			PinObjects[PinHandle] = MoveTemp(Pin);
+		}
+
+		View.Add(NodeRecord.GraphNodeGuid, MoveTemp(Node));
+	}
+
+	for (int32 PinHandle = 0; PinHandle < Pins.Num(); ++PinHandle)
+	{
+		FBlueprintPin& Pin = *PinObjects[PinHandle];
+		for (const FBPPinHandle Linked : GetLinkedPins(PinHandle))
+		{
+			Pin.LinkedPins.Add(PinObjects[Linked]);
+		}
+		for (const FBPPinHandle Source : GetSourcePins(PinHandle))
+		{
+			Pin.SourcePinFor.Add(PinObjects[Source]);
+		}
+	}
+
+	return View;
+}
+
+void FBlueprintGraphSnapshot::ReleaseNodeMap(TMap<FGuid, TSharedPtr<FBlueprintNode>>& InOutNodes)
+{
+	for (TPair<FGuid, TSharedPtr<FBlueprintNode>>& NodePair : InOutNodes)
+	{
+		if (NodePair.Value.IsValid())
+		{
+			NodePair.Value->BreakReferenceCycles();
+		}
+	}
+	InOutNodes.Empty();
+}
+
+FBPNodeHandle FBlueprintGraphSnapshot::FindNode(const FGuid& Guid) const
+{
+	const FBPNodeHandle* Handle = NodeIndexByGuid.Find(Guid);
+	return Handle ? *Handle : INDEX_NONE;
+}
+
+TConstArrayView<FBlueprintPinRecord> FBlueprintGraphSnapshot::GetNodePins(FBPNodeHandle Handle) const
+{
+	const FBlueprintSnapshotRange& Range = Nodes[Handle].Pins;
+	return TConstArrayView<FBlueprintPinRecord>(Pins.GetData() + Range.First, Range.Num);
+}
+
+TConstArrayView<FBPPinHandle> FBlueprintGraphSnapshot::GetLinkedPins(FBPPinHandle Handle) const
+{
+	const FBlueprintSnapshotRange& Range = Pins[Handle].LinkedPins;
+	return TConstArrayView<FBPPinHandle>(Edges.GetData() + Range.First, Range.Num);
+}
+
+TConstArrayView<FBPPinHandle> FBlueprintGraphSnapshot::GetSourcePins(FBPPinHandle Handle) const
+{
+	const FBlueprintSnapshotRange& Range = Pins[Handle].SourcePinFor;
+	return TConstArrayView<FBPPinHandle>(Edges.GetData() + Range.First, Range.Num);
+}
+
+TConstArrayView<FBlueprintSnapshotProperty> FBlueprintGraphSnapshot::GetProperties(const FBlueprintSnapshotRange& Range) const
+{
+	return TConstArrayView<FBlueprintSnapshotProperty>(Properties.GetData() + Range.First, Range.Num);
+}
+
+const FString* FBlueprintGraphSnapshot::FindNodeProperty(FBPNodeHandle Handle, const FString& Key) const
+{
+	for (const FBlueprintSnapshotProperty& Property : GetProperties(Nodes[Handle].RawProperties))
+	{
+		// 与 TMap<FString, FString>::Find 一致：键比较不区分大小写
+		if (StringPool.Get(Property.Key).Equals(Key, ESearchCase::IgnoreCase))
+		{
+			return &StringPool.Get(Property.Value);
+		}
+	}
+	return nullptr;
+}
+
+SIZE_T FBlueprintGraphSnapshot::GetAllocatedSize() const
+{
+	SIZE_T Size = StringPool.GetAllocatedSize()
+		+ Nodes.GetAllocatedSize()
+		+ Pins.GetAllocatedSize()
+		+ Properties.GetAllocatedSize()
+		+ Edges.GetAllocatedSize()
+		+ NodeIndexByGuid.GetAllocatedSize();
+	return Size;
+}
@@ -8,10 +8,12 @@
 
 #include "Models/BlueprintNode.h"
 #include "Logging/BP2AILog.h"
+#include "Misc/ScopeLock.h"
 
 FBlueprintNode::FBlueprintNode(const FString& InGuid, const FString& InNodeType)
     : Guid(InGuid)
     , NodeType(InNodeType)
+    , NodeKind(BlueprintNodeKind::FromNodeType(InNodeType))
     , Position(FVector2D::ZeroVector)
     , PreservedCompPropName(TEXT(""))
     , PreservedDelPropName(TEXT(""))
@@ -19,6 +21,49 @@ FBlueprintNode::FBlueprintNode(const FString& InGuid, const FString& InNodeType)
 {
     // Constructor body can remain empty
 }
+
+void FBlueprintNode::SetNodeType(const FString& InNodeType)
+{
+    NodeType = InNodeType;
+    NodeKind = BlueprintNodeKind::FromNodeType(InNodeType);
+}
+
+FCriticalSection& FBlueprintNode::GetEdGraphAccessLock()
+{
+    static FCriticalSection Lock;
+    return Lock;
+}
+
+const FString& FBlueprintNode::GetName() const
+{
+    if (!bNameResolved.load(std::memory_order_acquire))
+    {
+        // UEdGraphNode 的标题缓存不是线程安全的，与提取共用同一把锁
+        FScopeLock Lock(&GetEdGraphAccessLock());
+        if (!bNameResolved.load(std::memory_order_relaxed))
+        {
+            if (const UEdGraphNode* EdGraphNode = OriginalEdGraphNode.Get())
+            {
+                Name = EdGraphNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+            }
+            bNameResolved.store(true, std::memory_order_release);
+        }
+    }
+    return Name;
+}
+
+const FString& FBlueprintNode::GetLogName() const
+{
+    return (IsNameResolved() && !Name.IsEmpty()) ? Name : NodeType;
+}
+
+void FBlueprintNode::SetName(const FString& InName)
+{
+    // 只在节点共享给其他线程之前调用（快照兼容视图）
+    Name = InName;
+    bNameResolved.store(true, std::memory_order_release);
+}
+
 void FBlueprintNode::BreakReferenceCycles()
 {
     // Break circular references between pins
@@ -80,22 +125,22 @@ void FBlueprintNode::PreserveCriticalProperties()
 TSharedPtr<FBlueprintPin> FBlueprintNode::GetExecutionOutputPin(const FString& PinName) const
 {
     // Try specific name first
-    TSharedPtr<FBlueprintPin> Pin = GetPin(PinName, TEXT("EGPD_Output"));
+    TSharedPtr<FBlueprintPin> Pin = GetPin(PinName, EGPD_Output);
     if (Pin.IsValid() && Pin->IsExecution())
     {
         return Pin;
     }
     
     // Try common names
-    TArray<FString> CommonNames = { 
+    static const TCHAR* const CommonNames[] = { 
         TEXT("then"), TEXT("Trigger"), TEXT("Completed"), TEXT("LoopBody"), 
         TEXT("Exit"), TEXT("Success"), TEXT("A"), TEXT("Pressed"), 
         TEXT("Released"), TEXT("Update") 
     };
     
-    for (const FString& CommonName : CommonNames)
+    for (const TCHAR* CommonName : CommonNames)
     {
-        Pin = GetPin(CommonName, TEXT("EGPD_Output"));
+        Pin = GetPin(CommonName, EGPD_Output);
         if (Pin.IsValid() && Pin->IsExecution())
         {
             return Pin;
@@ -117,15 +162,15 @@ TSharedPtr<FBlueprintPin> FBlueprintNode::GetExecutionOutputPin(const FString& P
 TSharedPtr<FBlueprintPin> FBlueprintNode::GetExecutionInputPin() const
 {
     // Try common names
-    TArray<FString> CommonNames = { 
+    static const TCHAR* const CommonNames[] = { 
         TEXT("execute"), TEXT("exec"), TEXT("in"), TEXT("run"), 
         TEXT("TryGet"), TEXT("Enter"), TEXT("Play"), TEXT("PlayFromStart"), 
         TEXT("Cast"), TEXT("Bind"), TEXT("Add"), TEXT("Assign"), TEXT("Set")
     };
     
-    for (const FString& CommonName : CommonNames)
+    for (const TCHAR* CommonName : CommonNames)
     {
-        TSharedPtr<FBlueprintPin> Pin = GetPin(CommonName, TEXT("EGPD_Input"));
+        TSharedPtr<FBlueprintPin> Pin = GetPin(CommonName, EGPD_Input);
         if (Pin.IsValid() && Pin->IsExecution())
         {
             return Pin;
@@ -162,38 +207,29 @@ TSharedPtr<FBlueprintPin> FBlueprintNode::GetPin(const FString& InPinName) const
 {
     for (auto& PinPair : Pins)
     {
+        // FString::operator== 大小写不敏感，无需再做 ToLower 比较
         if (PinPair.Value->Name == InPinName)
         {
             return PinPair.Value;
         }
     }
     
-    // Try case insensitive match
-    for (auto& PinPair : Pins)
-    {
-        if (PinPair.Value->Name.ToLower() == InPinName.ToLower())
-        {
-            return PinPair.Value;
-        }
-    }
-    
     return nullptr;
 }
 
 TSharedPtr<FBlueprintPin> FBlueprintNode::GetPin(const FString& InPinName, const FString& Direction) const
 {
+    // 方向字符串只解析一次，循环内只比较枚举
+    const EEdGraphPinDirection WantedDirection = Direction.Equals(TEXT("EGPD_Output"), ESearchCase::IgnoreCase) ? EGPD_Output : EGPD_Input;
+    return GetPin(InPinName, WantedDirection);
+}
+
+TSharedPtr<FBlueprintPin> FBlueprintNode::GetPin(const FString& InPinName, EEdGraphPinDirection Direction) const
+{
+    // FString::operator== 已经大小写不敏感，一次遍历即可
     for (auto& PinPair : Pins)
     {
-        if (PinPair.Value->Name == InPinName && PinPair.Value->Direction == Direction)
-        {
-            return PinPair.Value;
-        }
-    }
-    
-    // Try case insensitive match
-    for (auto& PinPair : Pins)
-    {
-        if (PinPair.Value->Name.ToLower() == InPinName.ToLower() && PinPair.Value->Direction == Direction)
+        if (PinPair.Value->Direction == Direction && PinPair.Value->Name == InPinName)
         {
             return PinPair.Value;
         }
@@ -205,13 +241,14 @@ TSharedPtr<FBlueprintPin> FBlueprintNode::GetPin(const FString& InPinName, const
 TArray<TSharedPtr<FBlueprintPin>> FBlueprintNode::GetOutputPins(const FString& Category, bool bIncludeHidden) const
 {
     TArray<TSharedPtr<FBlueprintPin>> Result;
+    const FName CategoryName = Category.IsEmpty() ? NAME_None : FName(*Category);
     
     for (auto& PinPair : Pins)
     {
         auto& Pin = PinPair.Value;
         if (Pin->IsOutput() && (bIncludeHidden || (!Pin->IsHidden() && !Pin->IsAdvancedView())))
         {
-            if (Category.IsEmpty() || Pin->Category == Category)
+            if (CategoryName.IsNone() || Pin->PinCategory == CategoryName)
             {
                 Result.Add(Pin);
             }
@@ -229,6 +266,7 @@ TArray<TSharedPtr<FBlueprintPin>> FBlueprintNode::GetOutputPins(const FString& C
 TArray<TSharedPtr<FBlueprintPin>> FBlueprintNode::GetInputPins(const FString& Category, bool bIncludeHidden, bool bExcludeExec) const
 {
     TArray<TSharedPtr<FBlueprintPin>> Result;
+    const FName CategoryName = Category.IsEmpty() ? NAME_None : FName(*Category);
     
     for (auto& PinPair : Pins)
     {
@@ -240,7 +278,7 @@ TArray<TSharedPtr<FBlueprintPin>> FBlueprintNode::GetInputPins(const FString& Ca
                 continue;
             }
             
-            if (Category.IsEmpty() || Pin->Category == Category)
+            if (CategoryName.IsNone() || Pin->PinCategory == CategoryName)
             {
                 Result.Add(Pin);
             }
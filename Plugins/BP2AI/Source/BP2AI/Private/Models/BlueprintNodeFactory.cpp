@@ -68,7 +68,11 @@
 #include "Logging/LogMacros.h"
 #include "Misc/Paths.h"
 #include "Containers/Map.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
 #include "Logging/BP2AILog.h"
+#include "Trace/Utils/MarkdownFormattingUtils.h" // ConvertEnumInternalToDisplay
 
 
 #include "Kismet2/BlueprintEditorUtils.h"  // For FBlueprintEditorUtils::FindBlueprintForNode
@@ -137,14 +141,120 @@ namespace BlueprintNodeFactory_Private
 // --- END Helper Functions ---
 
 
-// --- Define static members ---
-TMap<FName, FBlueprintNodeFactory::FNodePropertyExtractorFunc> FBlueprintNodeFactory::PropertyExtractors;
-bool FBlueprintNodeFactory::bExtractorsInitialized = false;
+// --- Extractor registry and per-class dispatch cache ---
+namespace BlueprintNodeFactory_Private
+{
+	using FNodePropertyExtractorFunc = FBlueprintNodeFactory::FNodePropertyExtractorFunc;
+
+	struct FExtractorRegistration
+	{
+		FNodePropertyExtractorFunc Primary;
+		TArray<FNodePropertyExtractorFunc> Additive;
+	};
+
+	// Everything CaptureNode needs to know about a concrete node class, resolved once
+	struct FResolvedNodeClass
+	{
+		TArray<const FNodePropertyExtractorFunc*, TInlineAllocator<2>> Extractors;	// Primary first, then additive
+		bool bHasPrimary = false;
+		bool bIsK2Node = false;
+		bool bIsComposite = false;
+		bool bIsVariableAccess = false;		// VariableGet / VariableSet
+	};
+
+	// Written only inside InitializeExtractors (run once under a magic static), read-only afterwards
+	TMap<const UClass*, FExtractorRegistration> GExtractorRegistry;
+
+	FRWLock GResolvedClassesLock;
+	TMap<FObjectKey, TUniquePtr<FResolvedNodeClass>> GResolvedClasses;
+
+	const FResolvedNodeClass& ResolveNodeClass(const UClass* NodeClass)
+	{
+		const FObjectKey ClassKey(NodeClass);
+		{
+			FReadScopeLock ReadLock(GResolvedClassesLock);
+			if (const TUniquePtr<FResolvedNodeClass>* Found = GResolvedClasses.Find(ClassKey))
+			{
+				return **Found;
+			}
+		}
+
+		TUniquePtr<FResolvedNodeClass> Resolved = MakeUnique<FResolvedNodeClass>();
+		TArray<const FNodePropertyExtractorFunc*, TInlineAllocator<2>> Additive;
+		for (const UClass* Class = NodeClass; Class; Class = Class->GetSuperClass())
+		{
+			const FExtractorRegistration* Registration = GExtractorRegistry.Find(Class);
+			if (!Registration) continue;
+
+			// Nearest registered class wins for the primary handler
+			if (!Resolved->bHasPrimary && Registration->Primary)
+			{
+				Resolved->Extractors.Add(&Registration->Primary);
+				Resolved->bHasPrimary = true;
+			}
+			for (const FNodePropertyExtractorFunc& Func : Registration->Additive)
+			{
+				Additive.Add(&Func);
+			}
+		}
+		Resolved->Extractors.Append(Additive);
+		Resolved->bIsK2Node = NodeClass->IsChildOf(UK2Node::StaticClass());
+		Resolved->bIsComposite = NodeClass->IsChildOf(UK2Node_Composite::StaticClass());
+		Resolved->bIsVariableAccess = NodeClass->IsChildOf(UK2Node_VariableGet::StaticClass()) || NodeClass->IsChildOf(UK2Node_VariableSet::StaticClass());
+
+		UE_LOG(LogBlueprintNodeFactory, Log, TEXT("ResolveNodeClass: '%s' -> %d extractor(s)%s"),
+			*NodeClass->GetName(), Resolved->Extractors.Num(), Resolved->bHasPrimary ? TEXT("") : TEXT(" (no primary handler)"));
+
+		FWriteScopeLock WriteLock(GResolvedClassesLock);
+		// Another thread may have resolved the same class meanwhile; keep the first
+		TUniquePtr<FResolvedNodeClass>& Slot = GResolvedClasses.FindOrAdd(ClassKey);
+		if (!Slot.IsValid())
+		{
+			Slot = MoveTemp(Resolved);
+		}
+		return *Slot;
+	}
+}
 
 
 // --- Namespace for Handler Implementations ---
 namespace NodeFactoryExtractors
 {
+	// --- Call target class (all UK2Node_CallFunction subclasses) ---
+	// Recorded once at extraction so the path tracer can annotate the call step directly ("CallTargetClass")
+	static void ExtractCallTargetClass(UK2Node_CallFunction* CallFuncNode, TSharedPtr<FBlueprintNode> OutNodeModel)
+	{
+		FString TargetClassName = TEXT("Self");
+
+		UEdGraphPin* TargetPin = CallFuncNode->FindPin(TEXT("self"));
+		if (!TargetPin) { TargetPin = CallFuncNode->FindPin(TEXT("Target")); }
+
+		if (TargetPin && TargetPin->LinkedTo.Num() > 0)
+		{
+			if (UEdGraphPin* LinkedPin = TargetPin->LinkedTo[0])
+			{
+				if (LinkedPin->PinType.PinSubCategoryObject.IsValid())
+				{
+					TargetClassName = LinkedPin->PinType.PinSubCategoryObject->GetName();
+				}
+				else if (LinkedPin->PinType.PinCategory == TEXT("object"))
+				{
+					TargetClassName = TEXT("Object");
+				}
+			}
+		}
+		else if (UFunction* TargetFunc = CallFuncNode->GetTargetFunction())
+		{
+			// Unconnected target: self call or static function library
+			if (UClass* OwnerClass = TargetFunc->GetOwnerClass())
+			{
+				TargetClassName = OwnerClass->GetName();
+			}
+		}
+
+		OutNodeModel->RawProperties.Add(TEXT("CallTargetClass"), TargetClassName);
+	}
+
 	// --- Function/Event Handlers ---
 	static void ExtractProps_CallFunction(UEdGraphNode* GraphNode, TSharedPtr<FBlueprintNode> OutNodeModel)
 {
@@ -278,7 +388,7 @@ namespace NodeFactoryExtractors
 			if (Cast<UK2Node_ClearDelegate>(GraphNode)) {
 				UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  Extractor: DelegateReference_MemberName not found or N/A for Node %s (UK2Node_ClearDelegate). This might be expected."), *OutNodeModel->Guid.Left(8));
 			} else {
-				UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Extractor: Failed to extract DelegateReference_MemberName for Node %s (%s)"), *OutNodeModel->Guid.Left(8), *OutNodeModel->NodeType);
+				UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Extractor: Failed to extract DelegateReference_MemberName for Node %s (%s)"), *OutNodeModel->Guid.Left(8), *GraphNode->GetClass()->GetName());
 			}
 		}
 	}
@@ -651,7 +761,7 @@ namespace NodeFactoryExtractors
                 UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  ExtractProps_Composite: Pre-existing Pin on Model: Name='%s', ID='%s', Direction='%s', Category='%s', TypeSig='%s'"),
                     *PinPair.Value->Name, 
                     *PinPair.Value->Id.Left(8), 
-                    *PinPair.Value->Direction, 
+                    PinPair.Value->GetDirectionString(), 
                     *PinPair.Value->Category,
                     *PinPair.Value->GetTypeSignature() // Added TypeSignature for more detail
                 );
@@ -898,63 +1008,67 @@ static void ExtractProps_VariableGet(UEdGraphNode* GraphNode, TSharedPtr<FBluepr
 
 void FBlueprintNodeFactory::InitializeExtractors()
 {
-	if (bExtractorsInitialized) return;
-
 	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Initializing Property Extractors Map..."));
 
 	// --- Register Handlers (Alphabetical by Node Type for easier maintenance) ---
 
 	// A
-	PropertyExtractors.Add(UK2Node_AddComponent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_AddComponent);
-	PropertyExtractors.Add(UK2Node_AddDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
-	PropertyExtractors.Add(UK2Node_ActorBoundEvent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_ActorBoundEvent);
-	PropertyExtractors.Add(UK2Node_AssignDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
+	RegisterExtractor(UK2Node_AddComponent::StaticClass(), &NodeFactoryExtractors::ExtractProps_AddComponent);
+	RegisterExtractor(UK2Node_AddDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
+	RegisterExtractor(UK2Node_ActorBoundEvent::StaticClass(), &NodeFactoryExtractors::ExtractProps_ActorBoundEvent);
+	RegisterExtractor(UK2Node_AssignDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
 	// B
-	PropertyExtractors.Add(UK2Node_BreakStruct::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_BreakStruct);
+	RegisterExtractor(UK2Node_BreakStruct::StaticClass(), &NodeFactoryExtractors::ExtractProps_BreakStruct);
 	// C
-	PropertyExtractors.Add(UK2Node_CallArrayFunction::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_CallArrayFunction);
-	PropertyExtractors.Add(UK2Node_CallDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
-	PropertyExtractors.Add(UK2Node_CallFunction::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_CallFunction);
-	PropertyExtractors.Add(UK2Node_CallParentFunction::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_CallParentFunction);
-	PropertyExtractors.Add(UK2Node_ClearDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
-	PropertyExtractors.Add(UK2Node_CommutativeAssociativeBinaryOperator::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Operator);
-	PropertyExtractors.Add(UK2Node_ComponentBoundEvent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_ComponentBoundEvent);
-	PropertyExtractors.Add(UK2Node_Composite::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Composite);
-	PropertyExtractors.Add(UK2Node_CreateDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_CreateDelegate);
-	PropertyExtractors.Add(UK2Node_CreateWidget::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_CreateWidget);
-	PropertyExtractors.Add(UK2Node_CustomEvent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Event); // Handled by base Event
+	RegisterExtractor(UK2Node_CallArrayFunction::StaticClass(), &NodeFactoryExtractors::ExtractProps_CallArrayFunction);
+	RegisterExtractor(UK2Node_CallDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
+	RegisterExtractor(UK2Node_CallFunction::StaticClass(), &NodeFactoryExtractors::ExtractProps_CallFunction);
+	RegisterExtractor(UK2Node_CallParentFunction::StaticClass(), &NodeFactoryExtractors::ExtractProps_CallParentFunction);
+	RegisterExtractor(UK2Node_ClearDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
+	RegisterExtractor(UK2Node_CommutativeAssociativeBinaryOperator::StaticClass(), &NodeFactoryExtractors::ExtractProps_Operator);
+	RegisterExtractor(UK2Node_ComponentBoundEvent::StaticClass(), &NodeFactoryExtractors::ExtractProps_ComponentBoundEvent);
+	RegisterExtractor(UK2Node_Composite::StaticClass(), &NodeFactoryExtractors::ExtractProps_Composite);
+	RegisterExtractor(UK2Node_CreateDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_CreateDelegate);
+	RegisterExtractor(UK2Node_CreateWidget::StaticClass(), &NodeFactoryExtractors::ExtractProps_CreateWidget);
+	RegisterExtractor(UK2Node_CustomEvent::StaticClass(), &NodeFactoryExtractors::ExtractProps_Event); // Handled by base Event
 	// D
-	PropertyExtractors.Add(UK2Node_DynamicCast::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DynamicCast);
+	RegisterExtractor(UK2Node_DynamicCast::StaticClass(), &NodeFactoryExtractors::ExtractProps_DynamicCast);
 	// E
-	PropertyExtractors.Add(UK2Node_EnhancedInputAction::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_EnhancedInputAction);
-	PropertyExtractors.Add(UK2Node_Event::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Event); // Base event handler
+	RegisterExtractor(UK2Node_EnhancedInputAction::StaticClass(), &NodeFactoryExtractors::ExtractProps_EnhancedInputAction);
+	RegisterExtractor(UK2Node_Event::StaticClass(), &NodeFactoryExtractors::ExtractProps_Event); // Base event handler
 	// G
-	PropertyExtractors.Add(UK2Node_GetClassDefaults::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_GetClassDefaults);
-	PropertyExtractors.Add(UK2Node_GenericCreateObject::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_GenericCreateObject);
-	PropertyExtractors.Add(UK2Node_GetSubsystem::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_GetSubsystem); // Handles variants (GetEngineSubsystem, GetSubsystemFromPC inherit)
+	RegisterExtractor(UK2Node_GetClassDefaults::StaticClass(), &NodeFactoryExtractors::ExtractProps_GetClassDefaults);
+	RegisterExtractor(UK2Node_GenericCreateObject::StaticClass(), &NodeFactoryExtractors::ExtractProps_GenericCreateObject);
+	RegisterExtractor(UK2Node_GetSubsystem::StaticClass(), &NodeFactoryExtractors::ExtractProps_GetSubsystem); // Handles variants (GetEngineSubsystem, GetSubsystemFromPC inherit)
 	// I
-	PropertyExtractors.Add(UK2Node_InputAction::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_InputAction);
-	PropertyExtractors.Add(UK2Node_InputAxisEvent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_InputAxisEvent);
-	PropertyExtractors.Add(UK2Node_InputAxisKeyEvent::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_InputAxisKeyEvent);
-	PropertyExtractors.Add(UK2Node_InputKey::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_InputKey); // Handles InputKey and InputDebugKey
+	RegisterExtractor(UK2Node_InputAction::StaticClass(), &NodeFactoryExtractors::ExtractProps_InputAction);
+	RegisterExtractor(UK2Node_InputAxisEvent::StaticClass(), &NodeFactoryExtractors::ExtractProps_InputAxisEvent);
+	RegisterExtractor(UK2Node_InputAxisKeyEvent::StaticClass(), &NodeFactoryExtractors::ExtractProps_InputAxisKeyEvent);
+	RegisterExtractor(UK2Node_InputKey::StaticClass(), &NodeFactoryExtractors::ExtractProps_InputKey); // Handles InputKey and InputDebugKey
 	// UK2Node_InputTouchEvent has no specific properties, so no handler needed currently
 	// M
-	PropertyExtractors.Add(UK2Node_MacroInstance::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_MacroInstance);
-	PropertyExtractors.Add(UK2Node_MakeStruct::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_MakeStruct);
-	PropertyExtractors.Add(UK2Node_Message::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Message); // Interface messages
+	RegisterExtractor(UK2Node_MacroInstance::StaticClass(), &NodeFactoryExtractors::ExtractProps_MacroInstance);
+	RegisterExtractor(UK2Node_MakeStruct::StaticClass(), &NodeFactoryExtractors::ExtractProps_MakeStruct);
+	RegisterExtractor(UK2Node_Message::StaticClass(), &NodeFactoryExtractors::ExtractProps_Message); // Interface messages
 	// P
-	PropertyExtractors.Add(UK2Node_PromotableOperator::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Operator);
+	RegisterExtractor(UK2Node_PromotableOperator::StaticClass(), &NodeFactoryExtractors::ExtractProps_Operator);
 	// R
-	PropertyExtractors.Add(UK2Node_RemoveDelegate::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
+	RegisterExtractor(UK2Node_RemoveDelegate::StaticClass(), &NodeFactoryExtractors::ExtractProps_DelegateBinding);
 	// S
-	PropertyExtractors.Add(UK2Node_SpawnActorFromClass::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_SpawnActorFromClass);
-	PropertyExtractors.Add(UK2Node_SwitchEnum::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_SwitchEnum);
+	RegisterExtractor(UK2Node_SpawnActorFromClass::StaticClass(), &NodeFactoryExtractors::ExtractProps_SpawnActorFromClass);
+	RegisterExtractor(UK2Node_SwitchEnum::StaticClass(), &NodeFactoryExtractors::ExtractProps_SwitchEnum);
 	// Add SwitchName, SwitchString, SwitchInteger if specific handlers are needed later
 	// T
-	PropertyExtractors.Add(UK2Node_Timeline::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_Timeline);
+	RegisterExtractor(UK2Node_Timeline::StaticClass(), &NodeFactoryExtractors::ExtractProps_Timeline);
 	// V
-	PropertyExtractors.Add(UK2Node_VariableGet::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_VariableGet);
-	PropertyExtractors.Add(UK2Node_VariableSet::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_VariableSet);
+	RegisterExtractor(UK2Node_VariableGet::StaticClass(), &NodeFactoryExtractors::ExtractProps_VariableGet);
+	RegisterExtractor(UK2Node_VariableSet::StaticClass(), &NodeFactoryExtractors::ExtractProps_VariableSet);
+
+	// Additive: call target class applies to every CallFunction subclass, not only exact-class handlers
+	RegisterExtractor(UK2Node_CallFunction::StaticClass(), [](UEdGraphNode* GraphNode, TSharedPtr<FBlueprintNode> OutNodeModel)
+	{
+		NodeFactoryExtractors::ExtractCallTargetClass(CastChecked<UK2Node_CallFunction>(GraphNode), OutNodeModel);
+	}, /*bAdditive*/ true);
 
 	// Add handlers for nodes previously missed in registration (IfThenElse, Sequence, etc.)
 	// If they don't have specific properties to extract, no handler is strictly needed,
@@ -962,454 +1076,430 @@ void FBlueprintNodeFactory::InitializeExtractors()
 	// We can add empty handlers or handlers that just log for now if desired.
 	// Example (Empty Handler - can be added to NodeFactoryExtractors namespace):
 	// static void ExtractProps_NoOp(UEdGraphNode* GraphNode, TSharedPtr<FBlueprintNode> OutNodeModel) { }
-	// PropertyExtractors.Add(UK2Node_IfThenElse::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_NoOp);
-	// PropertyExtractors.Add(UK2Node_ExecutionSequence::StaticClass()->GetFName(), &NodeFactoryExtractors::ExtractProps_NoOp);
+	// RegisterExtractor(UK2Node_IfThenElse::StaticClass(), &NodeFactoryExtractors::ExtractProps_NoOp);
+	// RegisterExtractor(UK2Node_ExecutionSequence::StaticClass(), &NodeFactoryExtractors::ExtractProps_NoOp);
 	// ... etc. for other nodes without specific properties like Knot, Select, MakeArray, FormatText ...
 
-	bExtractorsInitialized = true;
-	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Property Extractors Map Initialized with %d handlers."), PropertyExtractors.Num());
+	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Property Extractors Map Initialized with %d classes."), BlueprintNodeFactory_Private::GExtractorRegistry.Num());
 }
 
-
-void FBlueprintNodeFactory::EnsureExtractorsInitialized()
+void FBlueprintNodeFactory::RegisterExtractor(const UClass* NodeClass, FNodePropertyExtractorFunc Func, bool bAdditive)
 {
-	// Simple check, could add thread safety if needed in a multi-threaded context
-	if (!bExtractorsInitialized)
+	check(NodeClass);
+	BlueprintNodeFactory_Private::FExtractorRegistration& Registration = BlueprintNodeFactory_Private::GExtractorRegistry.FindOrAdd(NodeClass);
+	if (bAdditive)
+	{
+		Registration.Additive.Add(MoveTemp(Func));
+	}
+	else
 	{
-		InitializeExtractors();
+		Registration.Primary = MoveTemp(Func);
 	}
 }
 
-// --- Refactored CreateNode using Handler Map ---
-TSharedPtr<FBlueprintNode> FBlueprintNodeFactory::CreateNode(UEdGraphNode* GraphNode)
-{
-	EnsureExtractorsInitialized(); // Make sure the map is ready
-
-	// --- Standard Checks ---
-	if (!GraphNode || !GraphNode->GetClass()) {
-		if(GraphNode){ UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("FBlueprintNodeFactory::CreateNode: GraphNode has NULL Class! GUID: %s"), *GraphNode->NodeGuid.ToString()); }
-		else { UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("FBlueprintNodeFactory::CreateNode: Input GraphNode is NULL.")); }
-		return nullptr;
-	}
 
-	FString ClassPath = GraphNode->GetClass()->GetPathName();
-	FName ClassFName = GraphNode->GetClass()->GetFName(); // Use FName for map lookup
-	FString NodeGuid = GraphNode->NodeGuid.ToString();
-	FString NodeType = GetNodeTypeName(ClassPath);
+void FBlueprintNodeFactory::EnsureExtractorsInitialized()
+{
+	// Function-local static: initialized exactly once, other threads wait until registration is complete
+	static const bool bInitialized = (InitializeExtractors(), true);
+	(void)bInitialized;
+}
 
-	// --- Node Creation ---
-	TSharedPtr<FBlueprintNode> Node = MakeShared<FBlueprintNode>(NodeGuid, NodeType);
-	Node->OriginalEdGraphNode = GraphNode;
-	
-	// --- Standard Property Assignment ---
-	Node->Name = GraphNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
-	Node->UEClass = ClassPath;
-	Node->Position = FVector2D(GraphNode->NodePosX, GraphNode->NodePosY);
-	Node->NodeComment = GraphNode->NodeComment;
+// --- Two-phase creation helpers ---
+namespace BlueprintNodeFactory_Private
+{
+	// 节点数低于此值时第二阶段在调用线程上串行执行，任务调度开销不划算
+	constexpr int32 ParallelBuildMinNodes = 32;
 
-	// --- Pin Extraction ---
-	for (UEdGraphPin* GraphPin : GraphNode->Pins)
+	const TCHAR* ContainerTypeToString(EPinContainerType ContainerType)
 	{
-		if (!GraphPin) continue;
-
-		FString PinId = GraphPin->PinId.ToString();
-		if (PinId.IsEmpty()) {
-			UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Factory: Node '%s' (Class: %s, GUID: %s) has a pin with an empty PinId. Skipping this pin's data extraction."),
-				*GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-				*GraphNode->GetClass()->GetName(),
-				*NodeGuid);
-			continue;
+		switch (ContainerType)
+		{
+		case EPinContainerType::Array: return TEXT("Array");
+		case EPinContainerType::Set:   return TEXT("Set");
+		case EPinContainerType::Map:   return TEXT("Map");
+		default:                       return TEXT("None");
 		}
+	}
 
-		TSharedPtr<FBlueprintPin> Pin = MakeShared<FBlueprintPin>(PinId, NodeGuid);
-
-		Pin->Name = GraphPin->PinName.ToString();
-		FText FriendlyNameText = GraphPin->PinFriendlyName;
-		Pin->FriendlyName = FriendlyNameText.IsEmpty() ? FString() : FriendlyNameText.ToString();
-		Pin->Direction = (GraphPin->Direction == EGPD_Input) ? TEXT("EGPD_Input") : TEXT("EGPD_Output");
+	FString PathNameOf(const UObject* Object)
+	{
+		return Object ? Object->GetPathName() : FString();
+	}
 
-		// --- DETAILED LOGGING AND TYPE EXTRACTION FOR PIN ---
+	// Legacy debug dump for one test struct pin; reads UObjects, so it runs during capture
+	void LogStructPinDebug(UEdGraphPin* GraphPin)
+	{
 		const FEdGraphPinType& PinType = GraphPin->PinType;
-		FString PinCategoryStr = PinType.PinCategory.ToString();
-		FString PinSubCategoryStr = PinType.PinSubCategory.ToString();
-		FString PinSubCategoryObjectStr = PinType.PinSubCategoryObject.IsValid() ? PinType.PinSubCategoryObject->GetPathName() : TEXT("None");
-		
-		FString PinValueTypeStr = TEXT("N/A");
-		if (PinType.PinValueType.TerminalCategory != NAME_None) { // Check if TerminalCategory itself is valid first
-			if (PinType.PinValueType.TerminalCategory == NAME_Struct || PinType.PinValueType.TerminalCategory == NAME_Enum ) {
-				if (PinType.PinValueType.TerminalSubCategoryObject.IsValid()) {
-					PinValueTypeStr = PinType.PinValueType.TerminalSubCategoryObject->GetPathName();
-				} else {
-					PinValueTypeStr = FString::Printf(TEXT("%s (TerminalSubCategoryObject invalid)"), *PinType.PinValueType.TerminalCategory.ToString());
-				}
-			} else { // For simple terminal categories like int, bool, byte etc.
-				PinValueTypeStr = PinType.PinValueType.TerminalCategory.ToString();
-			}
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧 COMPREHENSIVE DEBUG: Found target pin '%s'"), *GraphPin->PinName.ToString());
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   Category='%s', DefaultValue='%s'"), *PinType.PinCategory.ToString(), *GraphPin->DefaultValue);
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultTextValue='%s'"), *GraphPin->DefaultTextValue.ToString());
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->AutogeneratedDefaultValue='%s'"), *GraphPin->AutogeneratedDefaultValue);
+
+		if (GraphPin->DefaultObject) {
+			UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultObject='%s'"), *GraphPin->DefaultObject->GetPathName());
+		} else {
+			UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultObject=NULL"));
+		}
 
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   PinType.PinSubCategory='%s'"), *PinType.PinSubCategory.ToString());
+		if (UScriptStruct* StructType = Cast<UScriptStruct>(PinType.PinSubCategoryObject.Get())) {
+			UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   Found UScriptStruct: '%s', StructureSize=%d"), *StructType->GetName(), StructType->GetStructureSize());
 		}
 
-		const UEnum* ContainerEnum = StaticEnum<EPinContainerType>();
-		FString ContainerTypeStr = ContainerEnum ? ContainerEnum->GetNameStringByValue(static_cast<int64>(PinType.ContainerType)) : TEXT("UnknownContainer");
-		/*
-		UE_LOG(LogBlueprintNodeFactory, Warning, 
-			TEXT("Factory PIN DETAIL: Node '%s' (Class: %s, GUID: %s), Pin '%s' (ID: %s), Direction: %s --- Category: '%s', SubCategory: '%s', SubCatObj: '%s', ValueType(Terminal): '%s', ContainerType: '%s', bIsArray: %d, bIsSet: %d, bIsMap: %d"),
-			*GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-            *GraphNode->GetClass()->GetName(),
-			*NodeGuid,
-			*GraphPin->PinName.ToString(),
-			*PinId,
-			(GraphPin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output")),
-			*PinCategoryStr,
-			*PinSubCategoryStr,
-			*PinSubCategoryObjectStr,
-            *PinValueTypeStr, 
-			*ContainerTypeStr,
-			PinType.IsArray(),
-			PinType.IsSet(),
-			PinType.IsMap()
-		);*/
-		// --- END DETAILED LOGGING AND TYPE EXTRACTION ---
-
-		Pin->Category = PinCategoryStr; 
-		Pin->SubCategory = PinSubCategoryStr;
-		if (PinType.PinSubCategoryObject.IsValid()) { 
-			Pin->SubCategoryObject = PinSubCategoryObjectStr; 
-		} else { 
-			Pin->SubCategoryObject = TEXT(""); // Explicitly clear if not valid
+		if (UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(GraphPin->GetOwningNode())) {
+			UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   VarRef.MemberName='%s'"), *VarSetNode->VariableReference.GetMemberName().ToString());
 		}
 
-		Pin->bIsReference = PinType.bIsReference;
-		Pin->bIsConst = PinType.bIsConst;
-		Pin->ContainerType = ContainerTypeStr; 
-		
-		// Populate map value type information if this is a map pin
-		if (Pin->ContainerType == TEXT("Map"))
+		UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧 END COMPREHENSIVE DEBUG for pin '%s'"), *GraphPin->PinName.ToString());
+	}
+
+	// Diagnostics only: data links leaving DataTable/array accessor nodes
+	void LogLinkInspection(UEdGraphNode* GraphNode)
+	{
+		const FName ClassFName = GraphNode->GetClass()->GetFName();
+		if (ClassFName != TEXT("K2Node_GetDataTableRowNames") &&
+			ClassFName != TEXT("K2Node_GetArrayItem") &&
+			ClassFName != TEXT("K2Node_GetDataTableRow"))
 		{
-			// From FEdGraphPinType::PinValueType (which is FEdGraphTerminalType)
-			// This holds the type for Array/Set elements, OR Map Values.
-			// PinCategory/PinSubCategoryObject on the main pin hold Map Key info.
-			Pin->MapValueTerminalCategory = PinType.PinValueType.TerminalCategory.ToString();
-			if (PinType.PinValueType.TerminalSubCategoryObject.IsValid())
-			{
-				Pin->MapValueTerminalSubCategoryObjectPath = PinType.PinValueType.TerminalSubCategoryObject->GetPathName();
-			}
-			else
+			return;
+		}
+
+		for (UEdGraphPin* GraphPin : GraphNode->Pins)
+		{
+			if (!GraphPin || GraphPin->Direction != EGPD_Output || GraphPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) continue;
+
+			for (UEdGraphPin* LinkedPin : GraphPin->LinkedTo)
 			{
-				Pin->MapValueTerminalSubCategoryObjectPath = TEXT(""); // Ensure it's empty if not valid
+				if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+
+				UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("Factory UEdGraphPin::LinkedTo Inspection: Node '%s' (GUID:%s, Class:%s)"),
+					*GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
+					*GraphNode->NodeGuid.ToString().Left(8),
+					*GraphNode->GetClass()->GetName());
+				UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Processing Source Output Pin on this Node: '%s' (ID:%s, Category:%s)"),
+					*GraphPin->PinName.ToString(),
+					*GraphPin->PinId.ToString().Left(8),
+					*GraphPin->PinType.PinCategory.ToString());
+				UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("    This Source Pin is LinkedTo Target: NodeName='%s' (GUID:%s, Class:%s), TargetPinName='%s' (ID:%s, Direction:%s, Category:%s)"),
+					*LinkedPin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(),
+					*LinkedPin->GetOwningNode()->NodeGuid.ToString().Left(8),
+					*LinkedPin->GetOwningNode()->GetClass()->GetName(),
+					*LinkedPin->PinName.ToString(),
+					*LinkedPin->PinId.ToString().Left(8),
+					(LinkedPin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output")),
+					*LinkedPin->PinType.PinCategory.ToString());
 			}
-			// Log this new info for verification during factory processing
-			UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  Factory MAP VALUE TYPE for Pin '%s' on Node '%s': MapValueTermCategory='%s', MapValueTermSubCatObjPath='%s' (Derived from PinType.PinValueType)"),
-				*Pin->Name, *Node->Name, *Pin->MapValueTerminalCategory, *Pin->MapValueTerminalSubCategoryObjectPath);
 		}
+	}
 
-		if (GraphNode->IsA(UK2Node_Composite::StaticClass())) // Check if the parent GraphNode is a Composite
+	// Struct variable pins without a default: rebuild "(Member=Value,...)" from the node's expanded member pins
+	// Pin name format: "VariableName_MemberName_Index_GUID"
+	void ReconstructStructDefault(const FBlueprintNodeCapture& Capture, FBlueprintPin& Pin)
+	{
+		if (Capture.VariableMemberName.IsNone())
 		{
-			UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("CreateNode (Composite Pin LOG): Node '%s' (GUID:%s, Class:%s), PinName='%s', PinFriendlyName='%s', PinID='%s', Direction='%s', Category='%s', SubCategory='%s', SubCatObjPath='%s', ContainerType='%s'"),
-				*GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-				*GraphNode->NodeGuid.ToString().Left(8),
-				*GraphNode->GetClass()->GetName(),
-				*GraphPin->PinName.ToString(),
-				*GraphPin->PinFriendlyName.ToString(),
-				*GraphPin->PinId.ToString().Left(8),
-				(GraphPin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output")),
-				*GraphPin->PinType.PinCategory.ToString(),
-				*GraphPin->PinType.PinSubCategory.ToString(),
-				PinType.PinSubCategoryObject.IsValid() ? *PinType.PinSubCategoryObject->GetPathName() : TEXT("None"),
-				*ContainerTypeStr
-			);
+			return;
 		}
 
-		
-		
-		if (GraphPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Text)
+		const FString MemberPrefix = Capture.VariableMemberName.ToString() + TEXT("_");
+		TMap<FString, FString> CollectedDefaults;
+
+		for (const FBlueprintPinCapture& NodePin : Capture.Pins)
 		{
-			// FText literals are stored in DefaultTextValue, not the FString DefaultValue.
-			// FText::ToString() reliably gives us the displayable source string.
-			Pin->DefaultValue = GraphPin->DefaultTextValue.ToString();
+			if (NodePin.Direction != EGPD_Input || NodePin.DefaultValue.IsEmpty()) continue;
+
+			FString MemberName = NodePin.PinName.ToString();
+			if (!MemberName.StartsWith(MemberPrefix)) continue;
+			MemberName.RightChopInline(MemberPrefix.Len());
+
+			// Remove the index and GUID suffix (everything from the second underscore)
+			int32 FirstUnderscorePos = INDEX_NONE;
+			int32 SecondUnderscorePos = INDEX_NONE;
+			for (int32 i = 0; i < MemberName.Len(); ++i) {
+				if (MemberName[i] == TEXT('_')) {
+					if (FirstUnderscorePos == INDEX_NONE) {
+						FirstUnderscorePos = i;
+					} else {
+						SecondUnderscorePos = i;
+						break;
+					}
+				}
+			}
+			if (SecondUnderscorePos > 0) {
+				MemberName.LeftInline(SecondUnderscorePos);
+			}
+
+			CollectedDefaults.Add(MemberName, NodePin.DefaultValue);
 		}
-		else
+
+		if (CollectedDefaults.Num() == 0)
 		{
-			// For all other types, the existing logic of using the FString property is correct.
-			Pin->DefaultValue = GraphPin->DefaultValue;
-
-			if (Pin->Name == TEXT("MyStringTestStructVar")) {
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧 COMPREHENSIVE DEBUG: Found target pin '%s'"), *Pin->Name);
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   Category='%s', DefaultValue='%s'"), *PinCategoryStr, *Pin->DefaultValue);
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultValue='%s'"), *GraphPin->DefaultValue);
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   SubCategoryObject='%s'"), *PinSubCategoryObjectStr);
-    
-    // 🔧 NEW: Check ALL GraphPin properties that might contain struct defaults
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultTextValue='%s'"), *GraphPin->DefaultTextValue.ToString());
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->AutogeneratedDefaultValue='%s'"), *GraphPin->AutogeneratedDefaultValue);
-    
-    // Check if there's a DefaultObject
-    if (GraphPin->DefaultObject) {
-        UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultObject='%s'"), *GraphPin->DefaultObject->GetPathName());
-        UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   DefaultObject->GetName()='%s'"), *GraphPin->DefaultObject->GetName());
-    } else {
-        UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   GraphPin->DefaultObject=NULL"));
-    }
-    
-    // 🔧 Use the existing PinType variable (don't redeclare it)
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   PinType.PinCategory='%s'"), *PinType.PinCategory.ToString());
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   PinType.PinSubCategory='%s'"), *PinType.PinSubCategory.ToString());
-    
-    if (PinType.PinSubCategoryObject.IsValid()) {
-        UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   PinType.PinSubCategoryObject='%s'"), *PinType.PinSubCategoryObject->GetPathName());
-        
-        // Try to get the struct itself
-        if (UScriptStruct* StructType = Cast<UScriptStruct>(PinType.PinSubCategoryObject.Get())) {
-            UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   Found UScriptStruct: '%s'"), *StructType->GetName());
-            
-            // 🔧 Try alternative ways to get struct default values
-            UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   StructType->GetStructureSize()=%d"), StructType->GetStructureSize());
-            
-            // Check if the schema has any useful methods
-            if (const UEdGraphSchema* Schema = GraphPin->GetSchema()) {
-                UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   Schema class: '%s'"), *Schema->GetClass()->GetName());
-                // Note: Skipping schema method calls for now due to API differences
-            }
-        }
-    }
-    
-    // 🔧 Check if the owning node has any struct-related properties
-    if (UEdGraphNode* OwningNode = GraphPin->GetOwningNode()) {
-        UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   OwningNode='%s', Class='%s'"), 
-            *OwningNode->GetName(), *OwningNode->GetClass()->GetName());
-            
-        // For VariableSet nodes, check if there are any additional properties
-        if (UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(OwningNode)) {
-            UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   VariableSet node - checking for more properties..."));
-            
-            // Check the variable reference
-            const FMemberReference& VarRef = VarSetNode->VariableReference;
-            UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧   VarRef.MemberName='%s'"), *VarRef.GetMemberName().ToString());
-        }
-    }
-    
-    UE_LOG(LogBlueprintNodeFactory, Error, TEXT("🔧 END COMPREHENSIVE DEBUG for pin '%s'"), *Pin->Name);
-}
+			return;
 		}
-		// --- END NEW ---
 
-		
-		if (GraphPin->DefaultObject) { 
-			Pin->DefaultObject = GraphPin->DefaultObject->GetPathName(); 
+		TArray<FString> MemberPairs;
+		MemberPairs.Reserve(CollectedDefaults.Num());
+		for (const TPair<FString, FString>& Pair : CollectedDefaults) {
+			FString Value = Pair.Value.TrimStartAndEnd();
+			// Add quotes if it's a non-numeric value without quotes
+			if (!Value.StartsWith(TEXT("\"")) && !Value.EndsWith(TEXT("\"")) && !Value.IsNumeric()) {
+				Value = FString::Printf(TEXT("\"%s\""), *Value);
+			}
+			MemberPairs.Add(FString::Printf(TEXT("%s=%s"), *Pair.Key, *Value));
+			Pin.DefaultStruct.Add(Pair.Key, Pair.Value.TrimStartAndEnd().TrimQuotes());
 		}
 
-if (PinCategoryStr == TEXT("struct") && Pin->DefaultValue.IsEmpty()) {
-    // Get the owning node
-    UEdGraphNode* OwningNode = GraphPin->GetOwningNode();
-    if (OwningNode) {
-        // Check if this is a VariableSet or VariableGet node
-        UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(OwningNode);
-        UK2Node_VariableGet* VarGetNode = Cast<UK2Node_VariableGet>(OwningNode);
-        
-        FName VariableName = NAME_None;
-        if (VarSetNode) {
-            VariableName = VarSetNode->VariableReference.GetMemberName();
-        } else if (VarGetNode) {
-            VariableName = VarGetNode->VariableReference.GetMemberName();
-        }
-        
-        if (VariableName != NAME_None) {
-            // Look for expanded struct member pins on the same node
-            FString VariableNameStr = VariableName.ToString();
-            TMap<FString, FString> CollectedDefaults;
-            
-            // Iterate through all pins on this node to find expanded struct members
-            for (UEdGraphPin* NodePin : OwningNode->Pins) {
-                if (NodePin && NodePin->Direction == EGPD_Input) {
-                    FString NodePinName = NodePin->PinName.ToString();
-                    
-                    // Check if this pin is an expanded member of our struct variable
-                    if (NodePinName.StartsWith(VariableNameStr + TEXT("_")) && !NodePin->DefaultValue.IsEmpty()) {
-                        // Extract the member name from the pin name
-                        // Format: "VariableName_MemberName_Index_GUID"
-                        FString MemberName = NodePinName;
-                        MemberName.RemoveFromStart(VariableNameStr + TEXT("_"));
-                        
-                        // Remove the index and GUID suffix (everything after the second underscore)
-                        int32 FirstUnderscorePos = -1;
-                        int32 SecondUnderscorePos = -1;
-                        for (int32 i = 0; i < MemberName.Len(); ++i) {
-                            if (MemberName[i] == TEXT('_')) {
-                                if (FirstUnderscorePos == -1) {
-                                    FirstUnderscorePos = i;
-                                } else {
-                                    SecondUnderscorePos = i;
-                                    break;
-                                }
-                            }
-                        }
-                        
-                        if (SecondUnderscorePos > 0) {
-                            MemberName = MemberName.Left(SecondUnderscorePos);
-                        }
-                        
-                        // Store the default value for this member
-                        CollectedDefaults.Add(MemberName, NodePin->DefaultValue);
-                    }
-                }
-            }
-            
-            // If we found expanded pin defaults, reconstruct the struct default
-            if (CollectedDefaults.Num() > 0) {
-                // Reconstruct the struct default value string
-                TArray<FString> MemberPairs;
-                for (const auto& Pair : CollectedDefaults) {
-                    FString Value = Pair.Value.TrimStartAndEnd();
-                    // Add quotes if it's a string value without quotes
-                    if (!Value.StartsWith(TEXT("\"")) && !Value.EndsWith(TEXT("\""))) {
-                        // Check if it's a numeric value
-                        bool bIsNumeric = Value.IsNumeric();
-                        if (!bIsNumeric) {
-                            Value = FString::Printf(TEXT("\"%s\""), *Value);
-                        }
-                    }
-                    MemberPairs.Add(FString::Printf(TEXT("%s=%s"), *Pair.Key, *Value));
-                }
-                
-                FString ReconstructedDefault = FString::Printf(TEXT("(%s)"), *FString::Join(MemberPairs, TEXT(",")));
-                
-                // Store the reconstructed default value in the pin
-                Pin->RawProperties.Add(TEXT("BlueprintVariableDefault"), ReconstructedDefault);
-                
-                // Also populate DefaultStruct map
-                for (const auto& Pair : CollectedDefaults) {
-                    FString CleanValue = Pair.Value.TrimStartAndEnd().TrimQuotes();
-                    Pin->DefaultStruct.Add(Pair.Key, CleanValue);
-                }
-                
-                // Optional: Add a debug log for successful extraction (generic)
-                UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Extracted %d struct member defaults for variable '%s'"), 
-                    Pin->DefaultStruct.Num(), *VariableNameStr);
-            }
-        }
-    }
+		Pin.RawProperties.Add(TEXT("BlueprintVariableDefault"), FString::Printf(TEXT("(%s)"), *FString::Join(MemberPairs, TEXT(","))));
+
+		UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Extracted %d struct member defaults for variable '%s'"),
+			Pin.DefaultStruct.Num(), *Capture.VariableMemberName.ToString());
+	}
 }
-		
-		Pin->RawProperties.Add(TEXT("bHidden"), GraphPin->bHidden ? TEXT("true") : TEXT("false"));
-		Pin->RawProperties.Add(TEXT("bAdvancedView"), GraphPin->bAdvancedView ? TEXT("true") : TEXT("false"));
-		Pin->RawProperties.Add(TEXT("AutogeneratedDefaultValue"), GraphPin->AutogeneratedDefaultValue);
-
-		// --- Store Link Info directly here ---
-		int32 LinkIndex = 0;
-		for (UEdGraphPin* LinkedPin : GraphPin->LinkedTo) {
-		   if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
-			
-		   FString LinkedPinId = LinkedPin->PinId.ToString();
-		   FString LinkedNodeGuid = LinkedPin->GetOwningNode()->NodeGuid.ToString();
-		   FName LinkNodeKey = FName(*FString::Printf(TEXT("LinkedTo_%d_NodeGuid"), LinkIndex));
-		   FName LinkPinKey = FName(*FString::Printf(TEXT("LinkedTo_%d_PinID"), LinkIndex));
-		   Pin->RawProperties.Add(LinkNodeKey.ToString(), LinkedNodeGuid);
-		   Pin->RawProperties.Add(LinkPinKey.ToString(), LinkedPinId);
-		   LinkIndex++;
+
+// --- CreateNode: capture + build for a single node ---
+TSharedPtr<FBlueprintNode> FBlueprintNodeFactory::CreateNode(UEdGraphNode* GraphNode)
+{
+	FBlueprintNodeCapture Capture;
+	if (!CaptureNode(GraphNode, Capture))
+	{
+		return nullptr;
+	}
+	return BuildNode(Capture);
+}
+
+TArray<TSharedPtr<FBlueprintNode>> FBlueprintNodeFactory::CreateNodes(TConstArrayView<UEdGraphNode*> GraphNodes)
+{
+	// Phase 1: UObject reads only, on the calling thread
+	TArray<FBlueprintNodeCapture> Captures;
+	Captures.Reserve(GraphNodes.Num());
+	for (UEdGraphNode* GraphNode : GraphNodes)
+	{
+		FBlueprintNodeCapture Capture;
+		if (CaptureNode(GraphNode, Capture))
+		{
+			Captures.Add(MoveTemp(Capture));
 		}
-		// --- End Link Info Storage ---
+	}
+
+	// Phase 2: models and derived strings across workers. The calling thread blocks in ParallelFor,
+	// so captured object pointers cannot be collected while their names are read.
+	TArray<TSharedPtr<FBlueprintNode>> Nodes;
+	Nodes.SetNum(Captures.Num());
+	ParallelFor(Captures.Num(), [&Captures, &Nodes](int32 Index)
+	{
+		Nodes[Index] = BuildNode(Captures[Index]);
+	}, Captures.Num() < BlueprintNodeFactory_Private::ParallelBuildMinNodes ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("FBlueprintNodeFactory::CreateNodes: Built %d of %d nodes."), Nodes.Num(), GraphNodes.Num());
+	return Nodes;
+}
+
+bool FBlueprintNodeFactory::CaptureNode(UEdGraphNode* GraphNode, FBlueprintNodeCapture& OutCapture)
+{
+	EnsureExtractorsInitialized(); // Make sure the map is ready
+
+	// --- Standard Checks ---
+	if (!GraphNode || !GraphNode->GetClass()) {
+		if(GraphNode){ UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("FBlueprintNodeFactory::CreateNode: GraphNode has NULL Class! GUID: %s"), *GraphNode->NodeGuid.ToString()); }
+		else { UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("FBlueprintNodeFactory::CreateNode: Input GraphNode is NULL.")); }
+		return false;
+	}
+
+	UClass* NodeClass = GraphNode->GetClass();
+
+	// NodeType/UEClass are derived from the class path in BuildNode
+	TSharedPtr<FBlueprintNode> Node = MakeShared<FBlueprintNode>(GraphNode->NodeGuid.ToString(), FString());
+	Node->OriginalEdGraphNode = GraphNode;
+	Node->GraphNodeGuid = GraphNode->NodeGuid;
+
+	OutCapture.Node = Node;
+	OutCapture.NodeClass = NodeClass;
+	OutCapture.Comment = GraphNode->NodeComment;
+	OutCapture.PosX = GraphNode->NodePosX;
+	OutCapture.PosY = GraphNode->NodePosY;
 
-		Node->Pins.Add(PinId, Pin);
+	const BlueprintNodeFactory_Private::FResolvedNodeClass& Resolved = BlueprintNodeFactory_Private::ResolveNodeClass(NodeClass);
+	OutCapture.bIsComposite = Resolved.bIsComposite;
+	if (Resolved.bIsVariableAccess)
+	{
+		OutCapture.VariableMemberName = CastChecked<UK2Node_Variable>(GraphNode)->VariableReference.GetMemberName();
 	}
 
-	// --- Pin Link Info Storage ---
-	 for (UEdGraphPin* GraphPin : GraphNode->Pins)
-	 {
+	// --- Pin Capture ---
+	OutCapture.Pins.Reserve(GraphNode->Pins.Num());
+	for (UEdGraphPin* GraphPin : GraphNode->Pins)
+	{
 		if (!GraphPin) continue;
-		FString PinId = GraphPin->PinId.ToString();
-		TSharedPtr<FBlueprintPin> Pin = Node->Pins.FindRef(PinId);
-		if (Pin.IsValid()) {
-			int32 LinkIndex = 0;
-			for (UEdGraphPin* LinkedPin : GraphPin->LinkedTo) {
-			   if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
-				 if (GraphNode && GraphPin && 
-                (GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetDataTableRowNames") || 
-                 GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetArrayItem") ||
-                 GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetDataTableRow") /* Also log if GetDataTableRow itself has output links */
-                 ))
-            {
-                // Only log if the Source Pin (GraphPin) is an OUTPUT pin and NOT an EXEC pin,
-                // as we are interested in how DATA links are being established.
-                 if (GraphNode && GraphPin && 
-                (GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetDataTableRowNames") || 
-                 GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetArrayItem") ||
-                 GraphNode->GetClass()->GetFName() == TEXT("K2Node_GetDataTableRow") 
-                 ))
-            {
-                // Only log if the Source Pin (GraphPin) is an OUTPUT pin and NOT an EXEC pin,
-                // as we are interested in how DATA links are being established.
-                if (GraphPin->Direction == EGPD_Output && GraphPin->PinType.PinCategory != TEXT("exec"))
-                {
-                    UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("Factory UEdGraphPin::LinkedTo Inspection: Node '%s' (GUID:%s, Class:%s)"),
-                        *GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-                        *GraphNode->NodeGuid.ToString().Left(8),
-                        *GraphNode->GetClass()->GetName());
-                    UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Processing Source Output Pin on this Node: '%s' (ID:%s, Category:%s)"),
-                        *GraphPin->PinName.ToString(),
-                        *GraphPin->PinId.ToString().Left(8),
-                        *GraphPin->PinType.PinCategory.ToString());
-                    UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("    This Source Pin is LinkedTo Target: NodeName='%s' (GUID:%s, Class:%s), TargetPinName='%s' (ID:%s, Direction:%s, Category:%s)"),
-                        *LinkedPin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(), // Uses LinkedPin
-                        *LinkedPin->GetOwningNode()->NodeGuid.ToString().Left(8),                      // Uses LinkedPin
-                        *LinkedPin->GetOwningNode()->GetClass()->GetName(),                             // Uses LinkedPin
-                        *LinkedPin->PinName.ToString(),                                                 // Uses LinkedPin
-                        *LinkedPin->PinId.ToString().Left(8),                                           // Uses LinkedPin
-                        (LinkedPin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output")),          // Uses LinkedPin
-                        *LinkedPin->PinType.PinCategory.ToString());                                    // Uses LinkedPin
-                }
-            }
-            }
 
-				
-			   FString LinkedPinId = LinkedPin->PinId.ToString();
-			   FString LinkedNodeGuid = LinkedPin->GetOwningNode()->NodeGuid.ToString();
-			   FName LinkNodeKey = FName(*FString::Printf(TEXT("LinkedTo_%d_NodeGuid"), LinkIndex));
-			   FName LinkPinKey = FName(*FString::Printf(TEXT("LinkedTo_%d_PinID"), LinkIndex));
-			   Pin->RawProperties.Add(LinkNodeKey.ToString(), LinkedNodeGuid);
-			   Pin->RawProperties.Add(LinkPinKey.ToString(), LinkedPinId);
-			   LinkIndex++;
+		if (!GraphPin->PinId.IsValid()) {
+			UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  Factory: Node (Class: %s, GUID: %s) has a pin with an empty PinId. Skipping this pin's data extraction."),
+				*NodeClass->GetName(),
+				*Node->Guid);
+			continue;
+		}
+
+		const FEdGraphPinType& PinType = GraphPin->PinType;
+		FBlueprintPinCapture& PinCapture = OutCapture.Pins.AddDefaulted_GetRef();
+		PinCapture.PinId = GraphPin->PinId;
+		PinCapture.PinName = GraphPin->PinName;
+		PinCapture.FriendlyName = GraphPin->PinFriendlyName;
+		PinCapture.Direction = GraphPin->Direction;
+		PinCapture.PinCategory = PinType.PinCategory;
+		PinCapture.PinSubCategory = PinType.PinSubCategory;
+		PinCapture.PinSubCategoryObject = PinType.PinSubCategoryObject.Get();
+		PinCapture.TerminalCategory = PinType.PinValueType.TerminalCategory;
+		PinCapture.TerminalSubCategoryObject = PinType.PinValueType.TerminalSubCategoryObject.Get();
+		PinCapture.ContainerType = PinType.ContainerType;
+		PinCapture.bIsReference = PinType.bIsReference;
+		PinCapture.bIsConst = PinType.bIsConst;
+		PinCapture.bHidden = GraphPin->bHidden;
+		PinCapture.bAdvancedView = GraphPin->bAdvancedView;
+		PinCapture.DefaultValue = GraphPin->DefaultValue;
+		PinCapture.DefaultTextValue = GraphPin->DefaultTextValue;
+		PinCapture.AutogeneratedDefaultValue = GraphPin->AutogeneratedDefaultValue;
+		PinCapture.DefaultObject = GraphPin->DefaultObject;
+
+		// 枚举判断与显示名都要读 UEnum，在这里解析；之后的格式化只读引脚上的结果
+		if (const UEnum* PinEnum = Cast<UEnum>(PinCapture.PinSubCategoryObject))
+		{
+			PinCapture.bSubCategoryObjectIsEnum = true;
+			const FString EnumValue = GraphPin->DefaultValue.TrimStartAndEnd();
+			if (!EnumValue.IsEmpty() && !EnumValue.Equals(TEXT("None"), ESearchCase::IgnoreCase))
+			{
+				PinCapture.DefaultValueEnumDisplayName = MarkdownFormattingUtils::ConvertEnumInternalToDisplay(EnumValue, PinEnum);
+			}
+		}
+		PinCapture.bTerminalIsEnum = Cast<UEnum>(PinCapture.TerminalSubCategoryObject) != nullptr;
+
+		// --- Capture outgoing links (typed; resolved by FBlueprintDataExtractor::ResolveLinks) ---
+		if (GraphPin->Direction == EGPD_Output && GraphPin->LinkedTo.Num() > 0) {
+			PinCapture.LinkTargets.Reserve(GraphPin->LinkedTo.Num());
+			for (UEdGraphPin* LinkedPin : GraphPin->LinkedTo) {
+				if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+				PinCapture.LinkTargets.Add({ LinkedPin->GetOwningNode()->NodeGuid, LinkedPin->PinId });
 			}
 		}
+
+		if (GraphPin->PinName == TEXT("MyStringTestStructVar")) {
+			BlueprintNodeFactory_Private::LogStructPinDebug(GraphPin);
+		}
 	}
 
-	// --- Dispatch to Specific Property Extractor ---
-	
-	UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("FactoryDispatchDebug: Attempting to dispatch for Node Type (FName): '%s', Node Title: '%s', Node GUID: %s"), 
-		*ClassFName.ToString(), 
-		*GraphNode->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-		*GraphNode->NodeGuid.ToString());
+	BlueprintNodeFactory_Private::LogLinkInspection(GraphNode);
 
-	const FNodePropertyExtractorFunc* Handler = PropertyExtractors.Find(ClassFName);
-	if (Handler && *Handler != nullptr) // Also check if the TFunction itself is bound
+	// --- Dispatch to Specific Property Extractors (reads UObjects, stays in this phase) ---
+	for (const FNodePropertyExtractorFunc* Extractor : Resolved.Extractors)
 	{
-		UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  FactoryDispatchDebug: Found BOUND handler for FName: '%s'. Calling handler now."), *ClassFName.ToString());
-		(*Handler)(GraphNode, Node); 
+		(*Extractor)(GraphNode, Node);
 	}
-	else if (Handler && *Handler == nullptr)
+
+	if (!Resolved.bHasPrimary && Resolved.bIsK2Node)
 	{
-		UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  FactoryDispatchDebug: Found handler for FName: '%s', BUT THE TFunction IS UNBOUND/NULL. Handler will NOT be called."), *ClassFName.ToString());
+		UE_LOG(LogBlueprintNodeFactory, Verbose, TEXT("  FactoryDispatch: K2Node class '%s' has no specific handler beyond generic property extraction."), *NodeClass->GetName());
 	}
-	else
+	// --- End Dispatch ---
+
+	return true;
+}
+
+TSharedPtr<FBlueprintNode> FBlueprintNodeFactory::BuildNode(FBlueprintNodeCapture& Capture)
+{
+	using namespace BlueprintNodeFactory_Private;
+
+	TSharedPtr<FBlueprintNode> Node = Capture.Node;
+	if (!Node.IsValid() || !Capture.NodeClass)
+	{
+		return nullptr;
+	}
+
+	// --- Standard Property Assignment ---
+	const FString ClassPath = Capture.NodeClass->GetPathName();
+	Node->SetNodeType(GetNodeTypeName(ClassPath));
+	Node->UEClass = ClassPath;
+	Node->Position = FVector2D(Capture.PosX, Capture.PosY);
+	Node->NodeComment = MoveTemp(Capture.Comment);
+
+	// --- Pin Models ---
+	Node->Pins.Reserve(Capture.Pins.Num());
+	for (FBlueprintPinCapture& PinCapture : Capture.Pins)
 	{
-		UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  FactoryDispatchDebug: NO handler found in PropertyExtractors map for FName: '%s'."), *ClassFName.ToString());
-		// Optional: Log if a non-generic K2Node doesn't have a handler (already existing logic)
-		if (GraphNode->IsA(UK2Node::StaticClass())) 
+		TSharedPtr<FBlueprintPin> Pin = MakeShared<FBlueprintPin>(PinCapture.PinId.ToString(), Node->Guid);
+		Pin->GraphPinId = PinCapture.PinId;
+		Pin->GraphNodeGuid = Node->GraphNodeGuid;
+
+		Pin->Name = PinCapture.PinName.ToString();
+		Pin->FriendlyName = PinCapture.FriendlyName.IsEmpty() ? FString() : PinCapture.FriendlyName.ToString();
+		Pin->Direction = PinCapture.Direction;
+
+		Pin->Category = PinCapture.PinCategory.ToString();
+		Pin->SubCategory = PinCapture.PinSubCategory.ToString();
+		Pin->SubCategoryObject = PathNameOf(PinCapture.PinSubCategoryObject);
+		Pin->PinCategory = PinCapture.PinCategory;
+		Pin->PinSubCategory = PinCapture.PinSubCategory;
+		Pin->PinContainerType = PinCapture.ContainerType;
+		Pin->ContainerType = ContainerTypeToString(PinCapture.ContainerType);
+		Pin->bIsReference = PinCapture.bIsReference;
+		Pin->bIsConst = PinCapture.bIsConst;
+		Pin->bSubCategoryObjectIsEnum = PinCapture.bSubCategoryObjectIsEnum;
+		Pin->DefaultValueEnumDisplayName = MoveTemp(PinCapture.DefaultValueEnumDisplayName);
+
+		// Map pins: PinCategory/PinSubCategoryObject hold the key type, PinValueType the value type
+		if (Pin->PinContainerType == EPinContainerType::Map)
 		{
-			UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("  FactoryDispatchDebug: (Further Info) Node Type: %s (%s) is a K2Node but has no specific handler beyond generic property extraction."), *NodeType, *ClassPath);
+			Pin->MapValueTerminalCategory = PinCapture.TerminalCategory.ToString();
+			Pin->MapValueTerminalSubCategoryObjectPath = PathNameOf(PinCapture.TerminalSubCategoryObject);
+			Pin->bMapValueTerminalIsEnum = PinCapture.bTerminalIsEnum;
+			UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  Factory MAP VALUE TYPE for Pin '%s' on Node '%s': MapValueTermCategory='%s', MapValueTermSubCatObjPath='%s' (Derived from PinType.PinValueType)"),
+				*Pin->Name, *Node->GetLogName(), *Pin->MapValueTerminalCategory, *Pin->MapValueTerminalSubCategoryObjectPath);
+		}
+
+		if (Capture.bIsComposite)
+		{
+			UE_LOG(LogBlueprintNodeFactory, Warning, TEXT("CreateNode (Composite Pin LOG): Node '%s' (GUID:%s, Class:%s), PinName='%s', PinFriendlyName='%s', PinID='%s', Direction='%s', Category='%s', SubCategory='%s', SubCatObjPath='%s', ContainerType='%s'"),
+				*Node->GetLogName(),
+				*Node->Guid.Left(8),
+				*Node->NodeType,
+				*Pin->Name,
+				*Pin->FriendlyName,
+				*Pin->Id.Left(8),
+				(Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output")),
+				*Pin->Category,
+				*Pin->SubCategory,
+				Pin->SubCategoryObject.IsEmpty() ? TEXT("None") : *Pin->SubCategoryObject,
+				*Pin->ContainerType);
+		}
+
+		// FText literals are stored in DefaultTextValue, not the FString DefaultValue
+		Pin->DefaultValue = PinCapture.PinCategory == UEdGraphSchema_K2::PC_Text
+			? PinCapture.DefaultTextValue.ToString()
+			: PinCapture.DefaultValue;
+		Pin->DefaultObject = PathNameOf(PinCapture.DefaultObject);
+
+		if (PinCapture.PinCategory == UEdGraphSchema_K2::PC_Struct && Pin->DefaultValue.IsEmpty())
+		{
+			ReconstructStructDefault(Capture, *Pin);
 		}
+
+		Pin->bHidden = PinCapture.bHidden;
+		Pin->bAdvancedView = PinCapture.bAdvancedView;
+		Pin->RawProperties.Add(TEXT("bHidden"), PinCapture.bHidden ? TEXT("true") : TEXT("false"));
+		Pin->RawProperties.Add(TEXT("bAdvancedView"), PinCapture.bAdvancedView ? TEXT("true") : TEXT("false"));
+		Pin->RawProperties.Add(TEXT("AutogeneratedDefaultValue"), PinCapture.AutogeneratedDefaultValue);
+
+		Pin->LinkTargets = MoveTemp(PinCapture.LinkTargets);
+
+		Node->Pins.Add(Pin->GraphPinId, Pin);
 	}
-	// --- End Dispatch ---
 
 	// --- Final Logging ---
-	if (Node.IsValid()) {
-	   UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Factory EXIT Node %s (%s)"), *NodeGuid, *NodeType);
-		UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  PRESERVED Props: Comp='%s', Del='%s', OwnerPathWorkaround='%s'"), // Log the correct member
-			   *Node->PreservedCompPropName, *Node->PreservedDelPropName, *Node->BoundEventOwnerClassPath);
-	   UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  FINAL RawProperties Count: %d"), Node->RawProperties.Num());
-	}
+	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("Factory EXIT Node %s (%s)"), *Node->Guid, *Node->NodeType);
+	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  PRESERVED Props: Comp='%s', Del='%s', OwnerPathWorkaround='%s'"),
+		   *Node->PreservedCompPropName, *Node->PreservedDelPropName, *Node->BoundEventOwnerClassPath);
+	UE_LOG(LogBlueprintNodeFactory, Log, TEXT("  FINAL RawProperties Count: %d"), Node->RawProperties.Num());
 
 	return Node;
 }
-// --- End of refactored CreateNode ---
 
 
 // --- CreateNodeFromClassPath and GetNodeTypeName (Remain Unchanged) ---
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Models/BlueprintNodeKind.cpp
+
+#include "Models/BlueprintNodeKind.h"
+
+namespace
+{
+	TMap<FString, EBlueprintNodeKind> BuildNodeKindMap()
+	{
+		TMap<FString, EBlueprintNodeKind> Map;
+		Map.Reserve(static_cast<int32>(EBlueprintNodeKind::Count));
+
+		Map.Add(TEXT("Knot"), EBlueprintNodeKind::Knot);
+		Map.Add(TEXT("NiagaraReroute"), EBlueprintNodeKind::NiagaraReroute);
+
+		Map.Add(TEXT("VariableGet"), EBlueprintNodeKind::VariableGet);
+		Map.Add(TEXT("VariableSet"), EBlueprintNodeKind::VariableSet);
+		Map.Add(TEXT("Literal"), EBlueprintNodeKind::Literal);
+		Map.Add(TEXT("Self"), EBlueprintNodeKind::Self);
+		Map.Add(TEXT("Tunnel"), EBlueprintNodeKind::Tunnel);
+		Map.Add(TEXT("FunctionEntry"), EBlueprintNodeKind::FunctionEntry);
+		Map.Add(TEXT("FunctionResult"), EBlueprintNodeKind::FunctionResult);
+		Map.Add(TEXT("Composite"), EBlueprintNodeKind::Composite);
+
+		Map.Add(TEXT("PromotableOperator"), EBlueprintNodeKind::PromotableOperator);
+		Map.Add(TEXT("CommutativeAssociativeBinaryOperator"), EBlueprintNodeKind::CommutativeAssociativeBinaryOperator);
+		Map.Add(TEXT("BooleanNot"), EBlueprintNodeKind::BooleanNot);
+
+		Map.Add(TEXT("BreakStruct"), EBlueprintNodeKind::BreakStruct);
+		Map.Add(TEXT("MakeStruct"), EBlueprintNodeKind::MakeStruct);
+		Map.Add(TEXT("SetFieldsInStruct"), EBlueprintNodeKind::SetFieldsInStruct);
+
+		Map.Add(TEXT("CallFunction"), EBlueprintNodeKind::CallFunction);
+		Map.Add(TEXT("CallParentFunction"), EBlueprintNodeKind::CallParentFunction);
+		Map.Add(TEXT("MacroInstance"), EBlueprintNodeKind::MacroInstance);
+
+		Map.Add(TEXT("MakeArray"), EBlueprintNodeKind::MakeArray);
+		Map.Add(TEXT("GetArrayItem"), EBlueprintNodeKind::GetArrayItem);
+		Map.Add(TEXT("CallArrayFunction"), EBlueprintNodeKind::CallArrayFunction);
+		Map.Add(TEXT("MakeMap"), EBlueprintNodeKind::MakeMap);
+		Map.Add(TEXT("MakeSet"), EBlueprintNodeKind::MakeSet);
+
+		Map.Add(TEXT("CreateDelegate"), EBlueprintNodeKind::CreateDelegate);
+		Map.Add(TEXT("Select"), EBlueprintNodeKind::Select);
+
+		Map.Add(TEXT("SpawnActorFromClass"), EBlueprintNodeKind::SpawnActorFromClass);
+		Map.Add(TEXT("AddComponent"), EBlueprintNodeKind::AddComponent);
+		Map.Add(TEXT("CreateWidget"), EBlueprintNodeKind::CreateWidget);
+		Map.Add(TEXT("DynamicCast"), EBlueprintNodeKind::DynamicCast);
+		Map.Add(TEXT("GetClassDefaults"), EBlueprintNodeKind::GetClassDefaults);
+		Map.Add(TEXT("GetSubsystem"), EBlueprintNodeKind::GetSubsystem);
+		Map.Add(TEXT("GetEngineSubsystem"), EBlueprintNodeKind::GetEngineSubsystem);
+		Map.Add(TEXT("GetSubsystemFromPC"), EBlueprintNodeKind::GetSubsystemFromPC);
+
+		Map.Add(TEXT("Timeline"), EBlueprintNodeKind::Timeline);
+		Map.Add(TEXT("Delay"), EBlueprintNodeKind::Delay);
+		Map.Add(TEXT("MoveComponentTo"), EBlueprintNodeKind::MoveComponentTo);
+		Map.Add(TEXT("AIMoveTo"), EBlueprintNodeKind::AIMoveTo);
+
+		Map.Add(TEXT("EnumEquality"), EBlueprintNodeKind::EnumEquality);
+		Map.Add(TEXT("EnumInequality"), EBlueprintNodeKind::EnumInequality);
+		Map.Add(TEXT("CastByteToEnum"), EBlueprintNodeKind::CastByteToEnum);
+		Map.Add(TEXT("EnumLiteral"), EBlueprintNodeKind::EnumLiteral);
+
+		Map.Add(TEXT("FormatText"), EBlueprintNodeKind::FormatText);
+		Map.Add(TEXT("GetDataTableRow"), EBlueprintNodeKind::GetDataTableRow);
+
+		Map.Add(TEXT("Event"), EBlueprintNodeKind::Event);
+		Map.Add(TEXT("CustomEvent"), EBlueprintNodeKind::CustomEvent);
+		Map.Add(TEXT("ComponentBoundEvent"), EBlueprintNodeKind::ComponentBoundEvent);
+		Map.Add(TEXT("ActorBoundEvent"), EBlueprintNodeKind::ActorBoundEvent);
+		Map.Add(TEXT("InputAxisEvent"), EBlueprintNodeKind::InputAxisEvent);
+		Map.Add(TEXT("EnhancedInputAction"), EBlueprintNodeKind::EnhancedInputAction);
+		Map.Add(TEXT("InputAction"), EBlueprintNodeKind::InputAction);
+		Map.Add(TEXT("InputKey"), EBlueprintNodeKind::InputKey);
+
+		return Map;
+	}
+}
+
+EBlueprintNodeKind BlueprintNodeKind::FromNodeType(const FString& NodeType)
+{
+	if (NodeType.IsEmpty())
+	{
+		return EBlueprintNodeKind::Unknown;
+	}
+
+	static const TMap<FString, EBlueprintNodeKind> NodeKinds = BuildNodeKindMap();
+	const EBlueprintNodeKind* Kind = NodeKinds.Find(NodeType);
+	return Kind ? *Kind : EBlueprintNodeKind::Unknown;
+}
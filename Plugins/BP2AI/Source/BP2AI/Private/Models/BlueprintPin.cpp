@@ -12,6 +12,7 @@
 #include "Logging/BP2AILog.h" // Include for LogModels (or a new LogBlueprintPin)
 #include "UObject/UObjectGlobals.h"
 #include "UObject/EnumProperty.h"
+#include "EdGraphSchema_K2.h"
 
 
 // Define NAME_* constants manually if needed and not accessible otherwise
@@ -77,53 +78,45 @@ FBlueprintPin::FBlueprintPin(const FString& InId, const FString& InNodeGuid)
 
 bool FBlueprintPin::IsOutput() const
 {
-	return Direction == TEXT("EGPD_Output");
+	return Direction == EGPD_Output;
 }
 
 bool FBlueprintPin::IsInput() const
 {
 	// Any direction that is not Output is considered Input for simplicity here.
-	// Could also be `return Direction == TEXT("EGPD_Input");` if strictly adhering.
-	return Direction != TEXT("EGPD_Output");
+	return Direction != EGPD_Output;
 }
 
 bool FBlueprintPin::IsExecution() const
 {
-	return Category == TEXT("exec");
+	return PinCategory == UEdGraphSchema_K2::PC_Exec;
 }
 
 bool FBlueprintPin::IsHidden() const
 {
-	const FString* HiddenValue = RawProperties.Find(TEXT("bHidden"));
-	if (HiddenValue)
-	{
-		return *HiddenValue == TEXT("true") || *HiddenValue == TEXT("True") || *HiddenValue == TEXT("TRUE");
-	}
-	return false; // Default to not hidden if property not found
+	return bHidden;
 }
 
 bool FBlueprintPin::IsAdvancedView() const
 {
-	const FString* AdvancedValue = RawProperties.Find(TEXT("bAdvancedView"));
-	if (AdvancedValue)
-	{
-		return *AdvancedValue == TEXT("true") || *AdvancedValue == TEXT("True") || *AdvancedValue == TEXT("TRUE");
-	}
-	return false; // Default to not advanced if property not found
+	return bAdvancedView;
+}
+
+const TCHAR* FBlueprintPin::GetDirectionString() const
+{
+	return Direction == EGPD_Output ? TEXT("EGPD_Output") : TEXT("EGPD_Input");
 }
 
 
 
 FString FBlueprintPin::GetTypeSignature() const
 {
-    const FName CategoryFName(*Category);
+    const FName CategoryFName = PinCategory;
     FString MainTypeComponent = Category; 
 
     if (!SubCategoryObject.IsEmpty()) {
-     
-        UObject* EnumCheckObject = FindObject<UObject>(nullptr, *SubCategoryObject);
-        bool bIsEnum = EnumCheckObject && EnumCheckObject->IsA(UEnum::StaticClass());
- 
+        // 是否为枚举由工厂捕获引脚时从 PinType 判断，这里不按路径查找 UEnum
+        const bool bIsEnum = bSubCategoryObjectIsEnum;
 
         // Check if the category itself indicates it needs SubCategoryObject for the specific type name
         if (CategoryFName == NAME_Struct || 
@@ -169,15 +162,12 @@ FString FBlueprintPin::GetTypeSignature() const
 
     FString Result;
    
-    if (ContainerType == TEXT("Map")) {
+    if (PinContainerType == EPinContainerType::Map) {
         FString ValueTypeStr = MapValueTerminalCategory; 
         const FName MapValueTerminalCategoryFName(*MapValueTerminalCategory);
 
         if (!MapValueTerminalSubCategoryObjectPath.IsEmpty()) {
-            // ? --- NEW, ROBUST ENUM CHECK FOR MAP VALUE ---
-            UObject* MapValueEnumCheckObject = FindObject<UObject>(nullptr, *MapValueTerminalSubCategoryObjectPath);
-            bool bIsMapValueEnum = MapValueEnumCheckObject && MapValueEnumCheckObject->IsA(UEnum::StaticClass());
-            // ? --- END NEW CHECK ---
+            const bool bIsMapValueEnum = bMapValueTerminalIsEnum;
 
             if (MapValueTerminalCategoryFName == NAME_Struct ||
                 MapValueTerminalCategoryFName == NAME_Object ||
@@ -225,7 +215,7 @@ FString FBlueprintPin::GetTypeSignature() const
         
         Result += ContainerType + TEXT("<") + MainTypeComponent + TEXT(", ") + ValueTypeStr + TEXT(">");
 
-    } else if (!ContainerType.IsEmpty() && ContainerType != TEXT("None")) { 
+    } else if (PinContainerType != EPinContainerType::None) { 
         Result += ContainerType + TEXT("<") + MainTypeComponent + TEXT(">"); 
     } else { 
         Result += MainTypeComponent;
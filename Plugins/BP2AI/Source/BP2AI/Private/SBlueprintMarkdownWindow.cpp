@@ -139,14 +139,14 @@ void SBlueprintMarkdownWindow::UpdateFromSelection()
     }
 
     UE_LOG(LogUI, Log, TEXT("SBlueprintMarkdownWindow: Extracting data from %d selected nodes..."), SelectedNodes.Num());
-    TMap<FString, TSharedPtr<FBlueprintNode>> ExtractedNodes = DataExtractor.ExtractFromSelectedNodes(SelectedNodes, bIncludeNestedFunctions); // const call ok
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> ExtractedNodes = DataExtractor.ExtractFromSelectedNodes(SelectedNodes, bIncludeNestedFunctions); // const call ok
     UE_LOG(LogUI, Log, TEXT("SBlueprintMarkdownWindow: Extracted %d nodes into map."), ExtractedNodes.Num());
 
     // --- BEGIN DEBUG LOGGING for specific node types ---
     const FString DivideNodeGUID = TEXT("67BBB35F423615EE58814495C76DEFAA"); // From your sample output
     const FString GetNodeGUID = TEXT("1115F1404B8DB49BD602F18AEACF7531"); // From your sample output
 
-    if (const TSharedPtr<FBlueprintNode>* FoundDivideNode = ExtractedNodes.Find(DivideNodeGUID))
+    if (const TSharedPtr<FBlueprintNode>* FoundDivideNode = ExtractedNodes.Find(FGuid(DivideNodeGUID)))
     {
         if (FoundDivideNode->IsValid())
         {
@@ -158,7 +158,7 @@ void SBlueprintMarkdownWindow::UpdateFromSelection()
          UE_LOG(LogUI, Warning, TEXT("SBlueprintMarkdownWindow: DEBUG - Divide Node (%s) NOT FOUND in ExtractedNodes map."), *DivideNodeGUID.Left(8));
     }
 
-    if (const TSharedPtr<FBlueprintNode>* FoundGetNode = ExtractedNodes.Find(GetNodeGUID))
+    if (const TSharedPtr<FBlueprintNode>* FoundGetNode = ExtractedNodes.Find(FGuid(GetNodeGUID)))
     {
          if (FoundGetNode->IsValid())
         {
@@ -293,7 +293,7 @@ TArray<UEdGraphNode*> SBlueprintMarkdownWindow::GetSelectedBlueprintNodes() cons
 
 
 // GenerateMarkdown - Definition Removed const
-FString SBlueprintMarkdownWindow::GenerateMarkdown(const TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes)
+FString SBlueprintMarkdownWindow::GenerateMarkdown(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes)
 // Removed const
 {
     if (Nodes.Num() == 0) {
@@ -335,7 +335,7 @@ FString SBlueprintMarkdownWindow::GenerateMarkdown(const TMap<FString, TSharedPt
 }
 
 // FormatNode - Definition Removed const
-FString SBlueprintMarkdownWindow::FormatNode(const TSharedPtr<FBlueprintNode>& Node, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes)
+FString SBlueprintMarkdownWindow::FormatNode(const TSharedPtr<FBlueprintNode>& Node, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes)
 // Removed const
 {
     if (!Node.IsValid()) {
@@ -346,9 +346,9 @@ FString SBlueprintMarkdownWindow::FormatNode(const TSharedPtr<FBlueprintNode>& N
     FString Result;
     Result += FString::Printf(TEXT("## %s\n"), *Node->NodeType); // NodeType is FString
 
-    // Node->Name is FString, use IsEmpty() and no ToString()
-    if (!Node->Name.IsEmpty() && Node->Name != Node->NodeType) {
-        Result += FString::Printf(TEXT("**Name:** `%s`\n"), *Node->Name);
+    // GetName() returns FString, use IsEmpty() and no ToString()
+    if (!Node->GetName().IsEmpty() && Node->GetName() != Node->NodeType) {
+        Result += FString::Printf(TEXT("**Name:** `%s`\n"), *Node->GetName());
     }
 
     Result += FString::Printf(TEXT("**GUID:** `%s`\n"), *Node->Guid); // Guid is FString
@@ -395,7 +395,7 @@ FString SBlueprintMarkdownWindow::FormatNode(const TSharedPtr<FBlueprintNode>& N
 
 
 // FormatPin - Definition Removed const
-FString SBlueprintMarkdownWindow::FormatPin(const TSharedPtr<FBlueprintPin>& Pin, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes)
+FString SBlueprintMarkdownWindow::FormatPin(const TSharedPtr<FBlueprintPin>& Pin, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes)
 {
     if (!Pin.IsValid()) {
         UE_LOG(LogUI, Error, TEXT("SBlueprintMarkdownWindow::FormatPin - Received invalid pin pointer."));
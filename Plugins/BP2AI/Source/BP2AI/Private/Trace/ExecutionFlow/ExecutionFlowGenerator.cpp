@@ -10,6 +10,7 @@
 #include "Trace/Generation/Markdown/MarkdownDocumentBuilder.h"
 #include "Trace/Generation/HTML/HTMLDocumentBuilder.h"
 #include "Extractors/BlueprintDataExtractor.h"
+#include "Extractors/BlueprintGraphPreloader.h"
 #include "Trace/MarkdownDataTracer.h"
 #include "Trace/FMarkdownPathTracer.h"
 #include "Models/BlueprintNode.h"
@@ -20,6 +21,7 @@
 #include "Engine/Blueprint.h"
 #include "Misc/CoreMisc.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
+#include "Trace/Utils/MarkdownSpanSystem.h"
 
 #include "UObject/UObjectIterator.h"
 #include "Engine/Blueprint.h"
@@ -34,6 +36,22 @@
 #include "FlowHelpers/DefinitionGenerationHelper.h"
 #include "FlowHelpers/FlowValidationHelper.h"
 
+namespace
+{
+    // 起点已在之前的追踪中展开：唯一的非空行是 "Previously detailed" 跳转
+    bool IsRedundantTrace(const TArray<FString>& PathLines)
+    {
+        const FString* OnlyLine = nullptr;
+        for (const FString& Line : PathLines)
+        {
+            if (Line.TrimStartAndEnd().IsEmpty()) { continue; }
+            if (OnlyLine) { return false; }
+            OnlyLine = &Line;
+        }
+        return OnlyLine && OnlyLine->Contains(TEXT("Previously detailed"));
+    }
+}
+
 FExecutionFlowGenerator::FExecutionFlowGenerator()
     : RootBlueprintNameForTrace(TEXT("")), CachedResults(nullptr)
 {
@@ -225,6 +243,43 @@ FTracingResults FExecutionFlowGenerator::PerformTracing(
     const TArray<UEdGraphNode*>& InSelectedEditorNodes,
     const FGenerationSettings& InSettings,
     const FMarkdownGenerationContext& InContext)  // ← NEW: Context parameter
+{
+    // Extract Blueprint name + node data (UObject reads, game thread)
+    const FString BlueprintName = ExtractBlueprintName(InSelectedEditorNodes);
+    FBlueprintDataExtractor SelectionExtractor;
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> SelectedNodesMap = ExtractNodeData(InSelectedEditorNodes, SelectionExtractor);
+
+    // 追踪开始前批量加载被引用的图表（同步），避免追踪途中逐个 LoadPackage
+    FBlueprintGraphPreloader Preloader;
+    Preloader.AddReferencesFrom(SelectedNodesMap);
+    Preloader.Load();
+
+    return PerformTracingOnExtractedNodes(SelectedNodesMap, BlueprintName, InSettings, InContext);
+}
+
+FString FExecutionFlowGenerator::GenerateDocumentForExtractedNodes(
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InNodesMap,
+    const FString& InRootBlueprintName,
+    const FGenerationSettings& InSettings,
+    const FMarkdownGenerationContext& InContext)
+{
+    FTracingResults TracingResults = PerformTracingOnExtractedNodes(InNodesMap, InRootBlueprintName, InSettings, InContext);
+
+    TUniquePtr<IDocumentBuilder> DocumentBuilder = CreateDocumentBuilder(InContext);
+    if (!DocumentBuilder.IsValid())
+    {
+        UE_LOG(LogPathTracer, Error, TEXT("Failed to create a valid DocumentBuilder for the given context."));
+        return TEXT("Error: Could not create document builder.");
+    }
+
+    return DocumentBuilder->BuildDocument(TracingResults, InSettings);
+}
+
+FTracingResults FExecutionFlowGenerator::PerformTracingOnExtractedNodes(
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InNodesMap,
+    const FString& InRootBlueprintName,
+    const FGenerationSettings& InSettings,
+    const FMarkdownGenerationContext& InContext)
 {
     UE_LOG(LogPathTracer, Warning, TEXT("=== PerformTracing START (Context: %s) ==="), 
         InContext.IsHTML() ? TEXT("HTML") : TEXT("MARKDOWN"));
@@ -236,25 +291,25 @@ FTracingResults FExecutionFlowGenerator::PerformTracing(
     
     FTracingResults Results;
     Results.Clear();
-    TSet<FString> ProcessedGlobally;
+    TSet<FGuid> ProcessedGlobally;
     TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>> GraphsToDefineSeparately;
     TSet<FString> ProcessedSeparateGraphPaths;
 
     CachedResults = &Results;
 
-    // Extract Blueprint name
-    this->RootBlueprintNameForTrace = ExtractBlueprintName(InSelectedEditorNodes);
+    this->RootBlueprintNameForTrace = InRootBlueprintName;
     Results.RootBlueprintName = RootBlueprintNameForTrace;
 
     // Initialize tracers
     FBlueprintDataExtractor DataExtractor;
     FMarkdownDataTracer DataTracer(DataExtractor);
     FMarkdownPathTracer PathTracer(DataTracer, DataExtractor);
+    PathTracer.SetAnnotateCallTargets(InSettings.bAnnotateCallTargets);
     
+    // 只清空本次追踪的本地缓存；跨追踪复用的结果由 FResolvedPinValueCache 按编辑纪元失效
     DataTracer.ClearCache();
     DataTracer.StartTraceSession(&GraphsToDefineSeparately, &ProcessedSeparateGraphPaths, InSettings.bShowTrivialDefaultParams, &InSettings);
-    // Extract node data
-    TMap<FString, TSharedPtr<FBlueprintNode>> SelectedNodesMap = ExtractNodeData(InSelectedEditorNodes, DataExtractor);
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& SelectedNodesMap = InNodesMap;
     
     if (SelectedNodesMap.IsEmpty()) {
         DataTracer.EndTraceSession();
@@ -296,12 +351,12 @@ FTracingResults FExecutionFlowGenerator::PerformTracing(
 
 
 
-TMap<FString, TSharedPtr<FBlueprintNode>> FExecutionFlowGenerator::ExtractNodeData(
+TMap<FGuid, TSharedPtr<FBlueprintNode>> FExecutionFlowGenerator::ExtractNodeData(
     const TArray<UEdGraphNode*>& InSelectedEditorNodes,
     FBlueprintDataExtractor& InDataExtractor)
 {
     UE_LOG(LogPathTracer, Log, TEXT("FExecutionFlowGenerator: Extracting node data for %d selected nodes..."), InSelectedEditorNodes.Num());
-    TMap<FString, TSharedPtr<FBlueprintNode>> ExtractedNodesMap = InDataExtractor.ExtractFromSelectedNodes(InSelectedEditorNodes, false);
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> ExtractedNodesMap = InDataExtractor.ExtractFromSelectedNodes(InSelectedEditorNodes, false);
     UE_LOG(LogPathTracer, Log, TEXT("FExecutionFlowGenerator: Extraction complete. Map contains %d nodes."), ExtractedNodesMap.Num());
     return ExtractedNodesMap;
 }
@@ -309,7 +364,7 @@ TMap<FString, TSharedPtr<FBlueprintNode>> FExecutionFlowGenerator::ExtractNodeDa
 
 // ✅ DELEGATED TO HELPER - REMOVED MONOLITHIC IMPLEMENTATION
 void FExecutionFlowGenerator::PrescanForPureUserGraphs(
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
     FMarkdownPathTracer& InPathTracer,
     TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& OutGraphsToDefineSeparately,
     TSet<FString>& InOutProcessedSeparateGraphPaths)
@@ -320,7 +375,7 @@ void FExecutionFlowGenerator::PrescanForPureUserGraphs(
 
 TTuple<TArray<TSharedPtr<const FBlueprintNode>>, TArray<TSharedPtr<const FBlueprintNode>>>
 FExecutionFlowGenerator::FindExecutionStartNodesInternal(
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& NodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& NodesMap,
     bool bInTraceAllSelected) const
 {
     TArray<TSharedPtr<const FBlueprintNode>> StandardStartNodes;
@@ -358,7 +413,7 @@ FExecutionFlowGenerator::FindExecutionStartNodesInternal(
                     for (const TWeakPtr<FBlueprintPin>& SourcePinPtr : InputExecPin->SourcePinFor)
                     {
                         TSharedPtr<FBlueprintPin> StrongSourcePin = SourcePinPtr.Pin();
-                        if (StrongSourcePin.IsValid() && NodesMap.Contains(StrongSourcePin->NodeGuid))
+                        if (StrongSourcePin.IsValid() && NodesMap.Contains(StrongSourcePin->GraphNodeGuid))
                         {
                             bHasInternalSource = true;
                             break;
@@ -412,8 +467,8 @@ FExecutionFlowGenerator::FindExecutionStartNodesInternal(
 void FExecutionFlowGenerator::PerformMainExecutionTraces(
     FMarkdownPathTracer& InPathTracer,
     FMarkdownDataTracer& InDataTracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
-    TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+    TSet<FGuid>& InOutProcessedGlobally,
     FTracingResults& InOutResults,
     const FGenerationSettings& InSettings,
     const FString& CurrentBlueprintContextName,
@@ -443,7 +498,7 @@ void FExecutionFlowGenerator::PerformMainExecutionTraces(
                 CapturedData.Emplace(StartNodeModel);
             }
             
-            FString NodeNameForHeader = StartNodeModel->Name.IsEmpty() ? StartNodeModel->NodeType : StartNodeModel->Name;
+            FString NodeNameForHeader = StartNodeModel->GetName().IsEmpty() ? StartNodeModel->NodeType : StartNodeModel->GetName();
             FString NodeTypeForDisplay = StartNodeModel->NodeType;
 
             FString CleanHeaderText;
@@ -483,6 +538,7 @@ void FExecutionFlowGenerator::PerformMainExecutionTraces(
                 CurrentBlueprintContextName);
             
             FTraceEntry TraceEntry(CleanHeaderText, NodeTypeForDisplay, PathLines);
+            TraceEntry.bIsRedundant = IsRedundantTrace(PathLines);
             InOutResults.ExecutionTraces.Add(TraceEntry);
             CollectTraceHeader(CleanHeaderText, InOutResults); 
         }
@@ -500,8 +556,8 @@ void FExecutionFlowGenerator::DefineReferencedGraphs(
     FMarkdownPathTracer& InPathTracer,
     FMarkdownDataTracer& InDataTracer,
     FBlueprintDataExtractor& InDataExtractor,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& InSharedNodesMap,
-    TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSharedNodesMap,
+    TSet<FGuid>& InOutProcessedGlobally,
     FTracingResults& Results,
     const FGenerationSettings& InSettings,
     TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& InOutGraphsToDefineSeparately,
@@ -743,7 +799,7 @@ void FExecutionFlowGenerator::ProcessSingleGraphForDiscovery(
 // ✅ DELEGATED TO HELPER - REMOVED MONOLITHIC IMPLEMENTATION
 FString FExecutionFlowGenerator::CategorizeGraphByType(
     const TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>& GraphInfo,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes)
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes)
 {
     // ✅ PURE DELEGATION - ZERO FUNCTIONALITY CHANGE
     return CategoryHelper->CategorizeGraphByType(GraphInfo, GraphNodes);
@@ -937,19 +993,19 @@ FString FExecutionFlowGenerator::GenerateHTMLWithEmbeddedMarkdown(
 {
     UE_LOG(LogPathTracer, Warning, TEXT("--- GenerateHTMLWithEmbeddedMarkdown START ---"));
 
-    // Step 1: Generate the results needed for the rich HTML view.
+    // Step 1: Trace once into the format-neutral IR.
+    FMarkdownGenerationContext NeutralContext(FMarkdownGenerationContext::EOutputFormat::Neutral);
+    const FTracingResults NeutralResults = PerformTracing(InSelectedEditorNodes, InSettings, NeutralContext);
+
+    UE_LOG(LogPathTracer, Log, TEXT("Neutral Tracing complete: %d traces, %d definitions"), 
+        NeutralResults.ExecutionTraces.Num(), NeutralResults.GraphDefinitions.Num());
+
+    // Step 2: Render the same trace for the rich HTML view and for the copy-paste functionality.
     FMarkdownGenerationContext HTMLContext(FMarkdownGenerationContext::EOutputFormat::StyledHTML);
-    FTracingResults HTMLResults = PerformTracing(InSelectedEditorNodes, InSettings, HTMLContext);
-    
-    UE_LOG(LogPathTracer, Log, TEXT("HTML Tracing complete: %d traces, %d definitions"), 
-        HTMLResults.ExecutionTraces.Num(), HTMLResults.GraphDefinitions.Num());
+    FTracingResults HTMLResults = FMarkdownSpanSystem::RenderTracingResults(NeutralResults, HTMLContext);
 
-    // Step 2: Generate the results needed for the copy-paste functionality.
     FMarkdownGenerationContext MarkdownContext(FMarkdownGenerationContext::EOutputFormat::RawMarkdown);
-    FTracingResults MarkdownResults = PerformTracing(InSelectedEditorNodes, InSettings, MarkdownContext);
-    
-    UE_LOG(LogPathTracer, Log, TEXT("Markdown Tracing complete: %d traces, %d definitions"), 
-        MarkdownResults.ExecutionTraces.Num(), MarkdownResults.GraphDefinitions.Num());
+    FTracingResults MarkdownResults = FMarkdownSpanSystem::RenderTracingResults(NeutralResults, MarkdownContext);
 
     // Step 3: Create the HTML builder and pass BOTH sets of results to it.
     // Using TUniquePtr for safe, automatic memory management, compliant with UE5 standards.
@@ -966,6 +1022,34 @@ FString FExecutionFlowGenerator::GenerateHTMLWithEmbeddedMarkdown(
     return FinalDocument;
 }
 
+void FExecutionFlowGenerator::GenerateMarkdownAndHTMLForNodes(
+    const TArray<UEdGraphNode*>& InSelectedEditorNodes,
+    const FGenerationSettings& InSettings,
+    FString& OutMarkdown,
+    FString& OutHTML)
+{
+    UE_LOG(LogPathTracer, Warning, TEXT("--- GenerateMarkdownAndHTMLForNodes START ---"));
+
+    FMarkdownGenerationContext NeutralContext(FMarkdownGenerationContext::EOutputFormat::Neutral);
+    const FTracingResults NeutralResults = PerformTracing(InSelectedEditorNodes, InSettings, NeutralContext);
+
+    FMarkdownGenerationContext MarkdownContext(FMarkdownGenerationContext::EOutputFormat::RawMarkdown);
+    const FTracingResults MarkdownResults = FMarkdownSpanSystem::RenderTracingResults(NeutralResults, MarkdownContext);
+
+    FMarkdownGenerationContext HTMLContext(FMarkdownGenerationContext::EOutputFormat::StyledHTML);
+    const FTracingResults HTMLResults = FMarkdownSpanSystem::RenderTracingResults(NeutralResults, HTMLContext);
+
+    TUniquePtr<IDocumentBuilder> MarkdownBuilder = CreateDocumentBuilder(MarkdownContext);
+    OutMarkdown = MarkdownBuilder.IsValid()
+        ? MarkdownBuilder->BuildDocument(MarkdownResults, InSettings)
+        : FString(TEXT("Error: Could not create document builder."));
+
+    TUniquePtr<FHTMLDocumentBuilder> HTMLBuilder = MakeUnique<FHTMLDocumentBuilder>();
+    OutHTML = HTMLBuilder->BuildDocumentWithCopyData(HTMLResults, MarkdownResults, InSettings);
+
+    UE_LOG(LogPathTracer, Warning, TEXT("--- GenerateMarkdownAndHTMLForNodes END (Markdown: %d chars, HTML: %d chars) ---"), OutMarkdown.Len(), OutHTML.Len());
+}
+
 
 
 // ============================================================================
@@ -97,11 +97,38 @@ public:
         const FMarkdownGenerationContext& InContext
     );
 
+    // ✅ PIPELINE ENTRY: trace + build from an already extracted node map.
+    // Extraction (UObject reads) happens on the game thread; this part can run on a worker.
+    FString GenerateDocumentForExtractedNodes(
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InNodesMap,
+        const FString& InRootBlueprintName,
+        const FGenerationSettings& InSettings,
+        const FMarkdownGenerationContext& InContext = FMarkdownGenerationContext()
+    );
+
+    FTracingResults PerformTracingOnExtractedNodes(
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InNodesMap,
+        const FString& InRootBlueprintName,
+        const FGenerationSettings& InSettings,
+        const FMarkdownGenerationContext& InContext
+    );
+
+    // Blueprint name used as trace context for a set of editor nodes (game thread)
+    static FString ExtractBlueprintName(const TArray<UEdGraphNode*>& InSelectedEditorNodes);
+
     
     FString GenerateHTMLWithEmbeddedMarkdown(
 const TArray<UEdGraphNode*>& InSelectedEditorNodes,
 const FGenerationSettings& InSettings);
 
+    // ✅ Trace once (format-neutral), render both the raw Markdown and the interactive HTML document
+    void GenerateMarkdownAndHTMLForNodes(
+        const TArray<UEdGraphNode*>& InSelectedEditorNodes,
+        const FGenerationSettings& InSettings,
+        FString& OutMarkdown,
+        FString& OutHTML
+    );
+
 private:
     // ✅ HELPER COMPOSITION (UE 5.5.4 Compliant)
     TUniquePtr<FGraphDiscoveryHelper> DiscoveryHelper;
@@ -141,7 +168,7 @@ private:
     bool DoesContextMatch(const FMarkdownGenerationContext& ContextA, const FMarkdownGenerationContext& ContextB) const;
     
     // ✅ PURE DATA EXTRACTION AND COORDINATION
-    TMap<FString, TSharedPtr<FBlueprintNode>> ExtractNodeData(
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> ExtractNodeData(
         const TArray<UEdGraphNode*>& InSelectedEditorNodes,
         FBlueprintDataExtractor& InDataExtractor
     );
@@ -149,15 +176,15 @@ private:
     // ✅ CORE ORCHESTRATION METHODS (PRESERVED)
     TTuple<TArray<TSharedPtr<const FBlueprintNode>>, TArray<TSharedPtr<const FBlueprintNode>>> 
     FindExecutionStartNodesInternal(
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& NodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& NodesMap,
         bool bInTraceAllSelected
     ) const;
 
     void PerformMainExecutionTraces(
         FMarkdownPathTracer& InPathTracer,
         FMarkdownDataTracer& InDataTracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+        TSet<FGuid>& InOutProcessedGlobally,
         FTracingResults& InOutResults,
         const FGenerationSettings& InSettings,
         const FString& BlueprintContextName,
@@ -169,8 +196,8 @@ private:
         FMarkdownPathTracer& InPathTracer,
         FMarkdownDataTracer& InDataTracer,
         FBlueprintDataExtractor& InDataExtractor,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& InSharedNodesMap,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSharedNodesMap,
+        TSet<FGuid>& InOutProcessedGlobally,
         FTracingResults& Results,
         const FGenerationSettings& InSettings,
         TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& InOutGraphsToDefineSeparately,  
@@ -192,7 +219,7 @@ private:
     // ✅ HELPER DELEGATION WRAPPERS (PRIVATE)
     // These maintain compatibility with existing internal calls but delegate to helpers
     void PrescanForPureUserGraphs(
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
         FMarkdownPathTracer& InPathTracer,
         TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& OutGraphsToDefineSeparately,
         TSet<FString>& InOutProcessedSeparateGraphPaths
@@ -217,7 +244,7 @@ private:
 
     FString CategorizeGraphByType(
         const TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>& GraphInfo,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes
     );
 
     FGraphDefinitionEntry CreateGraphDefinition(
@@ -234,9 +261,6 @@ private:
 
     void ValidatePhase1Fixes(const FTracingResults& Results);
 
-    // ✅ UTILITY METHODS (PRESERVED)
-    FString ExtractBlueprintName(const TArray<UEdGraphNode*>& InSelectedEditorNodes);
-    
     // ✅ COLLECTION METHODS FOR TOC (legacy compatibility)
     void CollectTraceHeader(const FString& TraceName, FTracingResults& Results);
     void CollectGraphDefinition(const FString& GraphName, const FString& Category, FTracingResults& Results);
@@ -31,7 +31,7 @@ FCategoryAnalysisHelper::~FCategoryAnalysisHelper()
 
 FString FCategoryAnalysisHelper::CategorizeGraphByType(
     const TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>& GraphInfo,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes)
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes)
 {
     FMarkdownPathTracer::EUserGraphType GraphType = GraphInfo.Get<2>();
     const FString& GraphNameHint = GraphInfo.Get<0>();
@@ -65,7 +65,7 @@ FString FCategoryAnalysisHelper::CategorizeGraphByType(
                     } else {
                         // If property not found, try to infer. If it has exec output, it's not pure.
                         for(const auto& PinPair : FunctionEntryNode->Pins) {
-                            if(PinPair.Value.IsValid() && PinPair.Value->IsExecution() && PinPair.Value->Direction == TEXT("EGPD_Output")) {
+                            if(PinPair.Value.IsValid() && PinPair.Value->IsExecution() && PinPair.Value->Direction == EGPD_Output) {
                                 bFunctionIsActuallyPure = false;
                                 break;
                             }
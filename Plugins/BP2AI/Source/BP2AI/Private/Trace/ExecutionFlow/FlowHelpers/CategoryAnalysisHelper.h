@@ -28,7 +28,7 @@ public:
 	 */
 	FString CategorizeGraphByType(
 		const TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>& GraphInfo,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes
 	);
 
 private:
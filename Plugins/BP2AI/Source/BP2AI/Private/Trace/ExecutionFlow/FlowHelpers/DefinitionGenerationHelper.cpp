@@ -16,6 +16,7 @@
 #include "Logging/BP2AILog.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Settings/BP2AIExportConfig.h"
+#include "Extractors/BlueprintReferencedGraphs.h"
 
 #include "UObject/UObjectIterator.h"
 #include "Engine/Blueprint.h"
@@ -78,7 +79,7 @@ FGraphDefinitionEntry FDefinitionGenerationHelper::CreateGraphDefinition(
         *Definition.GraphName, *DefKey, *Definition.Category);
 
     // Extract node data for this specific graph
-    TMap<FString, TSharedPtr<FBlueprintNode>> GraphNodes;
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> GraphNodes;
     bool bExtracted = InDataExtractor.ExtractNodesFromGraph(GraphPath, GraphNodes);
     
     if (!bExtracted || GraphNodes.IsEmpty())
@@ -147,7 +148,7 @@ void FDefinitionGenerationHelper::CollectInputSpecs(TSharedPtr<const FBlueprintN
         for (const auto& PinPair : EntryNode->Pins) 
         {
             const TSharedPtr<FBlueprintPin>& Pin = PinPair.Value;
-            if (Pin.IsValid() && Pin->Direction == TEXT("EGPD_Output") && !Pin->IsExecution())
+            if (Pin.IsValid() && Pin->Direction == EGPD_Output && !Pin->IsExecution())
             {
                 OutInputSpecs.Add(FString::Printf(TEXT("`%s` (%s)"), *Pin->Name, *Pin->GetTypeSignature()));
             }
@@ -165,7 +166,7 @@ void FDefinitionGenerationHelper::CollectExecutionFlow(
     FMarkdownPathTracer& InPathTracer,
     FMarkdownDataTracer& InDataTracer,
     TSharedPtr<const FBlueprintNode> EntryNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
     const FString& AssetContext,
     const FGenerationSettings& InSettings,
     TArray<FString>& OutExecutionFlow,
@@ -187,7 +188,7 @@ void FDefinitionGenerationHelper::CollectExecutionFlow(
     {
         if (PinPair.Value.IsValid() && 
             PinPair.Value->IsExecution() && 
-            PinPair.Value->Direction == TEXT("EGPD_Output"))
+            PinPair.Value->Direction == EGPD_Output)
         {
             StartExecPin = PinPair.Value;
             break;
@@ -196,17 +197,17 @@ void FDefinitionGenerationHelper::CollectExecutionFlow(
 
     if (!StartExecPin.IsValid())
     {
-        UE_LOG(LogPathTracer, Warning, TEXT("CollectExecutionFlow: No output execution pin found on entry node '%s'"), *EntryNode->Name);
+        UE_LOG(LogPathTracer, Warning, TEXT("CollectExecutionFlow: No output execution pin found on entry node '%s'"), *EntryNode->GetLogName());
         OutExecutionFlow.Add(TEXT("No output execution pin found on entry node"));
         return;
     }
 
     // Create local processed nodes set for this graph's execution trace
     // This is separate from the global processed set to allow proper tracing within the graph
-    TSet<FString> ProcessedNodesInThisGraph;
+    TSet<FGuid> ProcessedNodesInThisGraph;
     
     UE_LOG(LogPathTracer, Log, TEXT("CollectExecutionFlow: Tracing execution from entry node '%s' in context '%s'"), 
-           *EntryNode->Name, *AssetContext);
+           *EntryNode->GetLogName(), *AssetContext);
 
     // Call TraceExecutionPath with the same parameters as the legacy implementation
     TArray<FString> ExecutionLines = InPathTracer.TraceExecutionPath(
@@ -231,7 +232,7 @@ void FDefinitionGenerationHelper::CollectExecutionFlow(
 
 void FDefinitionGenerationHelper::CollectOutputSpecs(
     TSharedPtr<const FBlueprintNode> ExitNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
     FMarkdownPathTracer::EUserGraphType GraphType,
     const FString& GraphNameHint,
     const FString& DefiningGraphAssetContext,
@@ -254,7 +255,7 @@ void FDefinitionGenerationHelper::CollectOutputSpecs(
         {
             if (Pin.IsValid() && !Pin->IsExecution())
             {
-                TSet<FString> VisitedNodesForPinValue;
+                TSet<FResolvedPinKey> VisitedNodesForPinValue;
                 auto PreviousCallsiteArgs = InDataTracer.GetCurrentCallsiteArguments();
                 InDataTracer.SetCurrentCallsiteArguments(nullptr);
                 
@@ -284,6 +285,39 @@ void FDefinitionGenerationHelper::ExtractInterfaceSignature(
     TArray<FString>& OutInputSpecs,
     TArray<FString>& OutOutputSpecs)
 {
+    // 批量导出：签名已在捕获快照时解析，构建阶段不查找 UObject
+    if (const FBlueprintInterfaceSignatureMap* CapturedSignatures = FBlueprintReferencedGraphScope::GetActiveInterfaceSignatures())
+    {
+        if (const FBlueprintInterfaceSignature* Signature = CapturedSignatures->Find(GraphNameHint))
+        {
+            OutInputSpecs = Signature->InputSpecs;
+            OutOutputSpecs = Signature->OutputSpecs;
+            return;
+        }
+        UE_LOG(LogPathTracer, Warning, TEXT("ExtractInterfaceSignature: No captured signature for '%s'"), *GraphNameHint);
+        OutInputSpecs.Add(TEXT("*Interface signature not captured*"));
+        OutOutputSpecs.Add(TEXT("*Interface signature not captured*"));
+        return;
+    }
+
+    if (!IsInGameThread())
+    {
+        UE_LOG(LogPathTracer, Warning, TEXT("ExtractInterfaceSignature: '%s' has no captured signature and cannot be resolved off the game thread"), *GraphNameHint);
+        OutInputSpecs.Add(TEXT("*Interface signature not captured*"));
+        OutOutputSpecs.Add(TEXT("*Interface signature not captured*"));
+        return;
+    }
+
+    ResolveInterfaceSignature(GraphNameHint, OutInputSpecs, OutOutputSpecs);
+}
+
+void FDefinitionGenerationHelper::ResolveInterfaceSignature(
+    const FString& GraphNameHint,
+    TArray<FString>& OutInputSpecs,
+    TArray<FString>& OutOutputSpecs)
+{
+    check(IsInGameThread());
+
     UE_LOG(LogPathTracer, Warning, TEXT("ExtractInterfaceSignature: Attempting to extract signature for '%s'"), *GraphNameHint);
     
     // Parse interface name and function name from hint
@@ -398,7 +432,7 @@ void FDefinitionGenerationHelper::ExtractInterfaceSignature(
     }
 }
 
-FString FDefinitionGenerationHelper::GetPropertyTypeDescription(FProperty* Property) const
+FString FDefinitionGenerationHelper::GetPropertyTypeDescription(FProperty* Property)
 {
     if (!Property) return TEXT("unknown");
     
@@ -487,7 +521,7 @@ FString FDefinitionGenerationHelper::GetPropertyTypeDescription(FProperty* Prope
 }
 
 TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindEntryNodeForInputs(
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
     FMarkdownPathTracer::EUserGraphType GraphType,
     const FString& SimpleNameFromHint) // Simple name, e.g., "MyFunction", "MyEvent"
 {
@@ -511,7 +545,7 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindEntryNodeForIn
                     if (FuncNameProp && FuncNameProp->Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
                     // Fallback to node name (though FunctionEntry nodes are often just "Function Entry")
                     // Or if the SimpleNameFromHint is what UEdGraph::GetFName() would return for the UFunction
-                    if (Pair.Value->Name.Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value; 
+                    if (Pair.Value->GetName().Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value; 
                 }
             }
             // If specific name match fails, return first FunctionEntry found (less ideal)
@@ -525,7 +559,7 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindEntryNodeForIn
                 {
                     const FString* EventNameProp = Pair.Value->RawProperties.Find(TEXT("CustomFunctionName")); // K2Node_CustomEvent
                     if (EventNameProp && EventNameProp->Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
-                    if (Pair.Value->Name.Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
+                    if (Pair.Value->GetName().Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
                 }
             }
             // Fallback to first CustomEvent node
@@ -543,14 +577,14 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindEntryNodeForIn
                     // Heuristic: input tunnels usually have output data pins, no input exec.
                     bool bHasOutputData = false; bool bHasInputExec = false;
                     for(const auto& PinPair : Pair.Value->Pins) {
-                        if(PinPair.Value->IsExecution() && PinPair.Value->Direction == TEXT("EGPD_Input")) bHasInputExec = true;
-                        if(!PinPair.Value->IsExecution() && PinPair.Value->Direction == TEXT("EGPD_Output")) bHasOutputData = true;
+                        if(PinPair.Value->IsExecution() && PinPair.Value->Direction == EGPD_Input) bHasInputExec = true;
+                        if(!PinPair.Value->IsExecution() && PinPair.Value->Direction == EGPD_Output) bHasOutputData = true;
                     }
 
                     if(bHasOutputData && !bHasInputExec) return Pair.Value; // Good candidate for input tunnel
 
                     // Fallback name check (less reliable)
-                    if (Pair.Value->Name.Contains(TEXT("Inputs")) || Pair.Value->Name.Contains(TEXT("Input"))) return Pair.Value;
+                    if (Pair.Value->GetName().Contains(TEXT("Inputs")) || Pair.Value->GetName().Contains(TEXT("Input"))) return Pair.Value;
                 }
             }
             break;
@@ -562,7 +596,7 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindEntryNodeForIn
 }
 
 TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindExitNodeForOutputs(
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
     FMarkdownPathTracer::EUserGraphType GraphType,
     const FString& SimpleNameFromHint)
 {
@@ -591,7 +625,7 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindExitNodeForOut
                 {
                     const FString* EventNameProp = Pair.Value->RawProperties.Find(TEXT("CustomFunctionName"));
                     if (EventNameProp && EventNameProp->Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
-                     if (Pair.Value->Name.Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
+                     if (Pair.Value->GetName().Equals(SimpleNameFromHint, ESearchCase::IgnoreCase)) return Pair.Value;
                 }
             }
             for (const auto& Pair : GraphNodes) if (Pair.Value.IsValid() && Pair.Value->NodeType == TEXT("CustomEvent")) return Pair.Value; // Fallback
@@ -612,7 +646,7 @@ TSharedPtr<const FBlueprintNode> FDefinitionGenerationHelper::FindExitNodeForOut
                     if(bHasInputData && bHasOutputExec) return Pair.Value; // Good candidate for output tunnel
 
                     // Fallback name check
-                    if (Pair.Value->Name.Contains(TEXT("Outputs")) || Pair.Value->Name.Contains(TEXT("Output"))) return Pair.Value;
+                    if (Pair.Value->GetName().Contains(TEXT("Outputs")) || Pair.Value->GetName().Contains(TEXT("Output"))) return Pair.Value;
                 }
             }
             break;
@@ -46,13 +46,23 @@ public:
         const FString& RootBlueprintNameForTrace
     );
 
+    /**
+     * Resolve an interface function signature from the loaded BPI asset (game thread only).
+     * Batch export calls this while capturing; tracing reads the captured result.
+     */
+    static void ResolveInterfaceSignature(
+        const FString& GraphNameHint,
+        TArray<FString>& OutInputSpecs,
+        TArray<FString>& OutOutputSpecs
+    );
+
 private:
     // Definition creation methods will be moved here
     void CollectInputSpecs(TSharedPtr<const FBlueprintNode> EntryNode, TArray<FString>& OutInputSpecs);
     
     void CollectOutputSpecs(
         TSharedPtr<const FBlueprintNode> ExitNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
         FMarkdownPathTracer::EUserGraphType GraphType,
         const FString& GraphNameHint,
         const FString& DefiningGraphAssetContext,
@@ -64,7 +74,7 @@ private:
         FMarkdownPathTracer& InPathTracer,
         FMarkdownDataTracer& InDataTracer,
         TSharedPtr<const FBlueprintNode> EntryNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
         const FString& AssetContext,
         const FGenerationSettings& InSettings,
         TArray<FString>& OutExecutionFlow,
@@ -79,17 +89,17 @@ private:
         TArray<FString>& OutOutputSpecs
     );
 
-    FString GetPropertyTypeDescription(FProperty* Property) const;
+    static FString GetPropertyTypeDescription(FProperty* Property);
 
     // Node finding methods
     TSharedPtr<const FBlueprintNode> FindEntryNodeForInputs(
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
         FMarkdownPathTracer::EUserGraphType GraphType,
         const FString& SimpleNameFromHint
     );
 
     TSharedPtr<const FBlueprintNode> FindExitNodeForOutputs(
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& GraphNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& GraphNodes,
         FMarkdownPathTracer::EUserGraphType GraphType,
         const FString& SimpleNameFromHint
     );
@@ -36,7 +36,7 @@ FGraphDiscoveryHelper::~FGraphDiscoveryHelper()
 }
 
 void FGraphDiscoveryHelper::PrescanForPureUserGraphs(
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
     FMarkdownPathTracer& InPathTracer,
     TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& OutGraphsToDefineSeparately,
     TSet<FString>& InOutProcessedSeparateGraphPaths)
@@ -71,7 +71,7 @@ void FGraphDiscoveryHelper::PrescanForPureUserGraphs(
             }
             
             UE_LOG(LogPathTracer, Log, TEXT("  PRESCAN: Node '%s' (%s) - Type: %d, Pure: %s, Reason: %s"), 
-                *Node->Name, *Node->Guid.Left(8), static_cast<int32>(DetectedType), 
+                *Node->GetLogName(), *Node->Guid.Left(8), static_cast<int32>(DetectedType), 
                 bIsNodePure ? TEXT("YES") : TEXT("NO"), *PurityReason);
             
             if (bIsNodePure) {
@@ -175,7 +175,7 @@ void FGraphDiscoveryHelper::ProcessSingleGraphForDiscovery(
     // InOutProcessedSeparateGraphPaths.Add(GraphPath); // This was in original prompt, but might be too aggressive if it prevents future definition if discovery fails once.
                                                  // Let's rely on _DEF key for printing. Discovery should be able to retry.
 
-    TMap<FString, TSharedPtr<FBlueprintNode>> GraphNodes;
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> GraphNodes;
     if (!InDataExtractor.ExtractNodesFromGraph(GraphPath, GraphNodes) || GraphNodes.IsEmpty())
     {
         UE_LOG(LogPathTracer, Warning, TEXT("    Could not extract nodes for graph '%s' (Path: %s). Categorizing as Unknown."), *GraphNameHint, *GraphPath);
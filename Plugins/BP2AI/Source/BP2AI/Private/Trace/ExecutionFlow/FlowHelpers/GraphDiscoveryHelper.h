@@ -33,7 +33,7 @@ public:
      * Discover pure user graphs from initially selected nodes
      */
     void PrescanForPureUserGraphs(
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& InSelectedNodesMap,
         FMarkdownPathTracer& InPathTracer,
         TArray<TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>>& OutGraphsToDefineSeparately,
         TSet<FString>& InOutProcessedSeparateGraphPaths
@@ -177,6 +177,34 @@ FString FMarkdownPathTracer::GenerateMarkdownLine(const FString& Content, const
 {
     return IndentPrefix + ExecPrefix + Content; // ExecPrefix is a member, accessible now
 }
+
+void FMarkdownPathTracer::AddStepLine(TArray<FString>& OutLines, const FString& Content, const FString& IndentPrefix)
+{
+    TArray<FString> BindingLines;
+    DataTracerRef.TakePendingSharedBindings(BindingLines);
+    for (const FString& BindingLine : BindingLines)
+    {
+        OutLines.Add(GenerateMarkdownLine(BindingLine, IndentPrefix));
+    }
+    OutLines.Add(GenerateMarkdownLine(Content, IndentPrefix));
+}
+
+void FMarkdownPathTracer::AppendCallTargetAnnotation(TSharedPtr<const FBlueprintNode> Node, FString& InOutDescription) const
+{
+    const FString* TargetClassPtr = Node->RawProperties.Find(TEXT("CallTargetClass"));
+    const FString* FuncNamePtr = Node->RawProperties.Find(TEXT("FunctionName"));
+    if (!TargetClassPtr || !FuncNamePtr || InOutDescription.Contains(TEXT("(Target:")))
+    {
+        return;
+    }
+
+    // 只标注没有显式 Target 前缀的调用（self / 静态函数库），带前缀的调用已说明目标对象
+    const FString UnqualifiedCall = FMarkdownSpan::FunctionName(*FuncNamePtr) + TEXT("(");
+    if (InOutDescription.StartsWith(UnqualifiedCall))
+    {
+        InOutDescription.Appendf(TEXT(" (Target: %s)"), **TargetClassPtr);
+    }
+}
 // --- End Helper Implementations ---
 
 
@@ -199,7 +227,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckMacroInstanceType_
             if (MacroGraph) {
                 OutGraphPath = MacroGraph->GetPathName();
                 UBlueprint* MacroOwningBP = FBlueprintEditorUtils::FindBlueprintForGraph(MacroGraph);
-                FString MacroSimpleName = Node->Name; 
+                FString MacroSimpleName = Node->GetName(); 
                 if (MacroSimpleName.IsEmpty() || MacroSimpleName == Node->NodeType) { 
                     MacroSimpleName = FPaths::GetCleanFilename(OutGraphPath);
                     if (MacroSimpleName.EndsWith(TEXT("_Graph"))) MacroSimpleName.LeftChopInline(6);
@@ -223,7 +251,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckMacroInstanceType_
             UE_LOG(LogPathTracer, Log, TEXT("    Helper_CheckMacroInstanceType: Standard Engine Macro. Path: '%s'. Not queued for definition."), **MacroGraphReferencePathPtr);
         }
     } else {
-            UE_LOG(LogPathTracer, Warning, TEXT("  Helper_CheckMacroInstanceType: Node '%s' missing MacroGraphReference property."), *Node->Name);
+            UE_LOG(LogPathTracer, Warning, TEXT("  Helper_CheckMacroInstanceType: Node '%s' missing MacroGraphReference property."), *Node->GetLogName());
     }
     return FMarkdownPathTracer::EUserGraphType::Unknown;
 }
@@ -241,7 +269,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckCompositeNodeType_
         UEdGraph* BoundGraph = FindObject<UEdGraph>(nullptr, **BoundGraphPathPtr);
         if (BoundGraph) {
             OutGraphPath = BoundGraph->GetPathName();
-            FString CompositeInstanceName = Node->Name.Replace(TEXT("\n"), TEXT(" "));
+            FString CompositeInstanceName = Node->GetName().Replace(TEXT("\n"), TEXT(" "));
             if (CompositeInstanceName.IsEmpty() || CompositeInstanceName == Node->NodeType.Replace(TEXT("\n"), TEXT(" "))) {
                     CompositeInstanceName = FPaths::GetBaseFilename(OutGraphPath);
                     if (CompositeInstanceName.EndsWith(TEXT("_Graph"))) CompositeInstanceName.LeftChopInline(6);
@@ -264,7 +292,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckCompositeNodeType_
             UE_LOG(LogPathTracer, Warning, TEXT("    Helper_CheckCompositeNodeType: BoundGraph object NOT FOUND via path: '%s'."), **BoundGraphPathPtr);
         }
     } else {
-        UE_LOG(LogPathTracer, Warning, TEXT("  Helper_CheckCompositeNodeType: Node '%s' missing BoundGraphName property."), *Node->Name);
+        UE_LOG(LogPathTracer, Warning, TEXT("  Helper_CheckCompositeNodeType: Node '%s' missing BoundGraphName property."), *Node->GetLogName());
     }
     return FMarkdownPathTracer::EUserGraphType::Unknown;
 }
@@ -279,7 +307,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckCallFunctionType_H
     UEdGraphNode* EdGraphNode = Node->GetEdGraphNode(); 
     UK2Node_CallFunction* K2CallFuncNode = Cast<UK2Node_CallFunction>(EdGraphNode);
     if (!K2CallFuncNode) {
-        UE_LOG(LogPathTracer, Error, TEXT("  Helper_CheckCallFunctionType: Cast to UK2Node_CallFunction failed for Node '%s' (Type: %s)."), *Node->Name, *Node->NodeType);
+        UE_LOG(LogPathTracer, Error, TEXT("  Helper_CheckCallFunctionType: Cast to UK2Node_CallFunction failed for Node '%s' (Type: %s)."), *Node->GetLogName(), *Node->NodeType);
         return FMarkdownPathTracer::EUserGraphType::Unknown;
     }
 
@@ -291,7 +319,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckCallFunctionType_H
     UE_LOG(LogPathTracer, Log, TEXT("  Helper_CheckCallFunctionType: Node Title='%s', TargetFunctionName='%s'."), *K2CallFuncNode->GetNodeTitle(ENodeTitleType::ListView).ToString(), *TargetFunctionName.ToString());
 
     if (TargetFunctionName == NAME_None) {
-        UE_LOG(LogPathTracer, Warning, TEXT("    Helper_CheckCallFunctionType: TargetFunctionName is NAME_None for node '%s'. Returning Unknown."), *Node->Name);
+        UE_LOG(LogPathTracer, Warning, TEXT("    Helper_CheckCallFunctionType: TargetFunctionName is NAME_None for node '%s'. Returning Unknown."), *Node->GetLogName());
         return FMarkdownPathTracer::EUserGraphType::Unknown;
     }
     if (!TargetFunctionOwnerClass) {
@@ -301,7 +329,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::CheckCallFunctionType_H
             UE_LOG(LogPathTracer, Log, TEXT("    Helper_CheckCallFunctionType: Resolved TargetFunctionOwnerClass from RawProperty 'FunctionParentClassPath' ('%s') to: %s"), **ParentClassPathFromProp, TargetFunctionOwnerClass ? *TargetFunctionOwnerClass->GetPathName() : TEXT("NULL"));
         }
         if (!TargetFunctionOwnerClass) {
-                UE_LOG(LogPathTracer, Warning, TEXT("    Helper_CheckCallFunctionType: TargetFunctionOwnerClass is NULL (even after checking RawProperties) for node '%s', TargetFunc '%s'. Returning Unknown."), *Node->Name, *TargetFunctionName.ToString());
+                UE_LOG(LogPathTracer, Warning, TEXT("    Helper_CheckCallFunctionType: TargetFunctionOwnerClass is NULL (even after checking RawProperties) for node '%s', TargetFunc '%s'. Returning Unknown."), *Node->GetLogName(), *TargetFunctionName.ToString());
                 return FMarkdownPathTracer::EUserGraphType::Unknown;
         }
     }
@@ -466,7 +494,7 @@ bool FMarkdownPathTracer::ProcessUserFunctionCall_Helper(
     FMarkdownPathTracer* Self,
     TSharedPtr<const FBlueprintNode> ExecutableNode, const FString& ActualGraphPath, const FString& UniqueGraphNameHint,
     const FString& DisplayTargetPrefix, const FString& FinalLinkTextForDisplay, const FString& ArgsStr,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FGuid>& InOutProcessedGlobally,
     const FString& CurrentIndentPrefix, bool bIsLastSegment, TArray<FString>& OutLines,
     bool bWasAlreadyGloballyProcessed, TSharedPtr<const FBlueprintNode>& OutNextNodeToTrace)
 {
@@ -477,10 +505,10 @@ bool FMarkdownPathTracer::ProcessUserFunctionCall_Helper(
     FString LineContent;
     
     // Check if we can determine HTML context (simple heuristic)
-    bool bIsHTMLMode = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&"))) || 
-                       FMarkdownSpanSystem::GetCurrentContext().IsHTML();
+    const bool bHTMLPrefix = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&")));
     
-    if (bIsHTMLMode) {
+    FString HTMLLineContent;
+    {
         // Generate HTML format with proper CSS classes and anchor links
         FString CallTypeClass = (ExecutableNode->NodeType == TEXT("CallParentFunction")) ? 
             TEXT("bp-call-parent-function") : TEXT("bp-call-function");
@@ -492,25 +520,29 @@ bool FMarkdownPathTracer::ProcessUserFunctionCall_Helper(
         FString LinkHtml = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link %s\">%s</a>"), 
             *AnchorName, *LinkClass, *FMarkdownSpanSystem::EscapeHtml(FinalLinkTextForDisplay));
         
-        LineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
+        HTMLLineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
+            HTMLLineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
         }
-    } else {
+    }
+    FString MarkdownLineContent;
+    {
         // Generate Markdown format (original logic)
         FString NodeTypeKeywordDisplay = (ExecutableNode->NodeType == TEXT("CallParentFunction")) ? 
             TEXT("Call Parent") : TEXT("Call Function");
         FString BaseLinkText = FString::Printf(TEXT("%s%s: [%s](#%s)"), 
             *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *AnchorName);
-        LineContent = BaseLinkText + ArgsStr;
+        MarkdownLineContent = BaseLinkText + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" (Call site repeat or graph already defined/queued)");
+            MarkdownLineContent += TEXT(" (Call site repeat or graph already defined/queued)");
         }
     }
+    // Both variants are kept in the neutral trace IR; concrete contexts get their own variant
+    LineContent = bHTMLPrefix ? HTMLLineContent : FMarkdownSpanSystem::FormatSwitch(HTMLLineContent, MarkdownLineContent);
 
-    OutLines.Add(Self->GenerateMarkdownLine(LineContent, CurrentIndentPrefix));
+    Self->AddStepLine(OutLines, LineContent, CurrentIndentPrefix);
     
     if (!bWasAlreadyGloballyProcessed && Self->bCurrentDefineUserGraphsSeparately && Self->CurrentGraphsToDefineSeparatelyPtr && Self->CurrentProcessedSeparateGraphPathsPtr) {
         if (!Self->CurrentProcessedSeparateGraphPathsPtr->Contains(ActualGraphPath)) {
@@ -522,7 +554,7 @@ bool FMarkdownPathTracer::ProcessUserFunctionCall_Helper(
     TSharedPtr<FBlueprintPin> OutputExecPin = ExecutableNode->GetExecutionOutputPin();
     if (OutputExecPin && OutputExecPin->LinkedPins.Num() > 0 && OutputExecPin->LinkedPins[0].IsValid()) {
         TSharedPtr<FBlueprintPin> TargetPinOnNext = OutputExecPin->LinkedPins[0];
-        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->NodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->GraphNodeGuid);
         if (NextNodeInCallerGraphPtr && NextNodeInCallerGraphPtr->IsValid()) {
             OutNextNodeToTrace = *NextNodeInCallerGraphPtr;
         } else { 
@@ -544,7 +576,7 @@ bool FMarkdownPathTracer::ProcessMacroCall_Helper(
     FMarkdownPathTracer* Self,
     TSharedPtr<const FBlueprintNode> ExecutableNode, const FString& ActualGraphPath, const FString& UniqueGraphNameHint,
     const FString& DisplayTargetPrefix, const FString& FinalLinkTextForDisplay, const FString& ArgsStr,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FGuid>& InOutProcessedGlobally,
     const FString& CurrentIndentPrefix, bool bIsLastSegment, TArray<FString>& OutLines,
     bool bWasAlreadyGloballyProcessed, TSharedPtr<const FBlueprintNode>& OutNextNodeToTrace)
 {
@@ -554,10 +586,10 @@ bool FMarkdownPathTracer::ProcessMacroCall_Helper(
     // CRITICAL FIX: Generate format based on current context
     FString LineContent;
     
-    bool bIsHTMLMode = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&"))) || 
-                       FMarkdownSpanSystem::GetCurrentContext().IsHTML();
+    const bool bHTMLPrefix = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&")));
     
-    if (bIsHTMLMode) {
+    FString HTMLLineContent;
+    {
         // Generate HTML format with proper CSS classes and anchor links
         FString CallTypeClass = TEXT("bp-call-macro");
         FString LinkClass = TEXT("macro-link");
@@ -566,24 +598,28 @@ bool FMarkdownPathTracer::ProcessMacroCall_Helper(
         FString LinkHtml = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link %s\">%s</a>"), 
             *AnchorName, *LinkClass, *FMarkdownSpanSystem::EscapeHtml(FinalLinkTextForDisplay));
         
-        LineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
+        HTMLLineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
+            HTMLLineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
         }
-    } else {
+    }
+    FString MarkdownLineContent;
+    {
         // Generate Markdown format (original logic)
         FString NodeTypeKeywordDisplay = TEXT("Macro");
         FString BaseLinkText = FString::Printf(TEXT("%s%s: [%s](#%s)"), 
             *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *AnchorName);
-        LineContent = BaseLinkText + ArgsStr;
+        MarkdownLineContent = BaseLinkText + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" (Call site repeat or graph already defined/queued)");
+            MarkdownLineContent += TEXT(" (Call site repeat or graph already defined/queued)");
         }
     }
+    // Both variants are kept in the neutral trace IR; concrete contexts get their own variant
+    LineContent = bHTMLPrefix ? HTMLLineContent : FMarkdownSpanSystem::FormatSwitch(HTMLLineContent, MarkdownLineContent);
 
-    OutLines.Add(Self->GenerateMarkdownLine(LineContent, CurrentIndentPrefix));
+    Self->AddStepLine(OutLines, LineContent, CurrentIndentPrefix);
 
     if (!bWasAlreadyGloballyProcessed && Self->bCurrentDefineUserGraphsSeparately && Self->CurrentGraphsToDefineSeparatelyPtr && Self->CurrentProcessedSeparateGraphPathsPtr) {
         if (!Self->CurrentProcessedSeparateGraphPathsPtr->Contains(ActualGraphPath)) {
@@ -594,7 +630,7 @@ bool FMarkdownPathTracer::ProcessMacroCall_Helper(
     TSharedPtr<FBlueprintPin> OutputExecPin = ExecutableNode->GetExecutionOutputPin();
     if (OutputExecPin && OutputExecPin->LinkedPins.Num() > 0 && OutputExecPin->LinkedPins[0].IsValid()) {
         TSharedPtr<FBlueprintPin> TargetPinOnNext = OutputExecPin->LinkedPins[0];
-        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->NodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->GraphNodeGuid);
         if (NextNodeInCallerGraphPtr && NextNodeInCallerGraphPtr->IsValid()) {
             OutNextNodeToTrace = *NextNodeInCallerGraphPtr;
         } else {
@@ -616,7 +652,7 @@ bool FMarkdownPathTracer::ProcessCustomEventCall_Helper(
     FMarkdownPathTracer* Self,
     TSharedPtr<const FBlueprintNode> ExecutableNode, const FString& ActualGraphPath, const FString& UniqueGraphNameHint,
     const FString& DisplayTargetPrefix, const FString& FinalLinkTextForDisplay, const FString& ArgsStr,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FGuid>& InOutProcessedGlobally,
     const FString& CurrentIndentPrefix, bool bIsLastSegment, TArray<FString>& OutLines,
     bool bWasAlreadyGloballyProcessed, TSharedPtr<const FBlueprintNode>& OutNextNodeToTrace)
 {
@@ -626,10 +662,10 @@ bool FMarkdownPathTracer::ProcessCustomEventCall_Helper(
     // CRITICAL FIX: Generate format based on current context
     FString LineContent;
     
-    bool bIsHTMLMode = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&"))) || 
-                       FMarkdownSpanSystem::GetCurrentContext().IsHTML();
+    const bool bHTMLPrefix = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&")));
     
-    if (bIsHTMLMode) {
+    FString HTMLLineContent;
+    {
         // Generate HTML format with proper CSS classes and anchor links
         FString CallTypeClass = TEXT("bp-call-custom-event");
         FString LinkClass = TEXT("custom-event-link");
@@ -638,24 +674,28 @@ bool FMarkdownPathTracer::ProcessCustomEventCall_Helper(
         FString LinkHtml = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link %s\">%s</a>"), 
             *AnchorName, *LinkClass, *FMarkdownSpanSystem::EscapeHtml(FinalLinkTextForDisplay));
         
-        LineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
+        HTMLLineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
+            HTMLLineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
         }
-    } else {
+    }
+    FString MarkdownLineContent;
+    {
         // Generate Markdown format (original logic)
         FString NodeTypeKeywordDisplay = TEXT("Call Custom Event");
         FString BaseLinkText = FString::Printf(TEXT("%s%s: [%s](#%s)"), 
             *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *AnchorName);
-        LineContent = BaseLinkText + ArgsStr;
+        MarkdownLineContent = BaseLinkText + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" (Call site repeat or graph already defined/queued)");
+            MarkdownLineContent += TEXT(" (Call site repeat or graph already defined/queued)");
         }
     }
+    // Both variants are kept in the neutral trace IR; concrete contexts get their own variant
+    LineContent = bHTMLPrefix ? HTMLLineContent : FMarkdownSpanSystem::FormatSwitch(HTMLLineContent, MarkdownLineContent);
 
-    OutLines.Add(Self->GenerateMarkdownLine(LineContent, CurrentIndentPrefix));
+    Self->AddStepLine(OutLines, LineContent, CurrentIndentPrefix);
 
     if (!bWasAlreadyGloballyProcessed && Self->bCurrentDefineUserGraphsSeparately && Self->CurrentGraphsToDefineSeparatelyPtr && Self->CurrentProcessedSeparateGraphPathsPtr) {
         if (!Self->CurrentProcessedSeparateGraphPathsPtr->Contains(ActualGraphPath)) {
@@ -666,7 +706,7 @@ bool FMarkdownPathTracer::ProcessCustomEventCall_Helper(
     TSharedPtr<FBlueprintPin> OutputExecPin = ExecutableNode->GetExecutionOutputPin();
     if (OutputExecPin && OutputExecPin->LinkedPins.Num() > 0 && OutputExecPin->LinkedPins[0].IsValid()) {
         TSharedPtr<FBlueprintPin> TargetPinOnNext = OutputExecPin->LinkedPins[0];
-        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->NodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->GraphNodeGuid);
         if (NextNodeInCallerGraphPtr && NextNodeInCallerGraphPtr->IsValid()) {
             OutNextNodeToTrace = *NextNodeInCallerGraphPtr;
         } else {
@@ -692,8 +732,8 @@ bool FMarkdownPathTracer::ProcessInterfaceCall_Helper(
     const FString& DisplayTargetPrefix, 
     const FString& FinalLinkTextForDisplay, 
     const FString& ArgsStr,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, 
-    TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, 
+    TSet<FGuid>& InOutProcessedGlobally,
     const FString& CurrentIndentPrefix, 
     bool bIsLastSegment, 
     TArray<FString>& OutLines,
@@ -706,10 +746,10 @@ bool FMarkdownPathTracer::ProcessInterfaceCall_Helper(
     // Generate interface call format
     FString LineContent;
     
-    bool bIsHTMLMode = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&"))) || 
-                       FMarkdownSpanSystem::GetCurrentContext().IsHTML();
+    const bool bHTMLPrefix = (Self->ExecPrefix.Contains(TEXT("<")) || Self->ExecPrefix.Contains(TEXT("&")));
     
-    if (bIsHTMLMode) {
+    FString HTMLLineContent;
+    {
         // Generate HTML format for interface calls
         FString CallTypeClass = TEXT("bp-call-interface");
         FString LinkClass = TEXT("interface-link");
@@ -718,24 +758,28 @@ bool FMarkdownPathTracer::ProcessInterfaceCall_Helper(
         FString LinkHtml = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link %s\">%s</a>"), 
             *AnchorName, *LinkClass, *FMarkdownSpanSystem::EscapeHtml(FinalLinkTextForDisplay));
         
-        LineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
+        HTMLLineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" <span class=\"repeat-indicator\">(Interface call repeat or already defined)</span>");
+            HTMLLineContent += TEXT(" <span class=\"repeat-indicator\">(Interface call repeat or already defined)</span>");
         }
-    } else {
+    }
+    FString MarkdownLineContent;
+    {
         // Generate Markdown format for interface calls
         FString NodeTypeKeywordDisplay = TEXT("Call Interface");
         FString BaseLinkText = FString::Printf(TEXT("%s%s: [%s](#%s)"), 
             *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *AnchorName);
-        LineContent = BaseLinkText + ArgsStr;
+        MarkdownLineContent = BaseLinkText + ArgsStr;
         
         if (bWasAlreadyGloballyProcessed) {
-            LineContent += TEXT(" (Interface call repeat or already defined)");
+            MarkdownLineContent += TEXT(" (Interface call repeat or already defined)");
         }
     }
+    // Both variants are kept in the neutral trace IR; concrete contexts get their own variant
+    LineContent = bHTMLPrefix ? HTMLLineContent : FMarkdownSpanSystem::FormatSwitch(HTMLLineContent, MarkdownLineContent);
 
-    OutLines.Add(Self->GenerateMarkdownLine(LineContent, CurrentIndentPrefix));
+    Self->AddStepLine(OutLines, LineContent, CurrentIndentPrefix);
     
     // Queue interface for definition if needed
     if (!bWasAlreadyGloballyProcessed && Self->bCurrentDefineUserGraphsSeparately && 
@@ -751,7 +795,7 @@ bool FMarkdownPathTracer::ProcessInterfaceCall_Helper(
     TSharedPtr<FBlueprintPin> OutputExecPin = ExecutableNode->GetExecutionOutputPin();
     if (OutputExecPin && OutputExecPin->LinkedPins.Num() > 0 && OutputExecPin->LinkedPins[0].IsValid()) {
         TSharedPtr<FBlueprintPin> TargetPinOnNext = OutputExecPin->LinkedPins[0];
-        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->NodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNext->GraphNodeGuid);
         if (NextNodeInCallerGraphPtr && NextNodeInCallerGraphPtr->IsValid()) {
             OutNextNodeToTrace = *NextNodeInCallerGraphPtr;
         } else { 
@@ -776,7 +820,7 @@ bool FMarkdownPathTracer::ProcessCollapsedGraph_Helper(
     FMarkdownPathTracer* Self,
     TSharedPtr<const FBlueprintNode> ExecutableNode, const FString& ActualGraphPath, const FString& UniqueGraphNameHint,
     const FString& DisplayTargetPrefix, const FString& FinalLinkTextForDisplay, const FString& ArgsStr,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FString>& InOutProcessedGlobally, TSet<FString>& ProcessedInCurrentPath,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes, TSet<FGuid>& InOutProcessedGlobally, TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix, bool bIsLastSegment, TArray<FString>& OutLines,
     bool bWasAlreadyGloballyProcessed, TSharedPtr<const FBlueprintNode>& OutNextNodeToTrace,
     const FString& PathTracerCurrentBlueprintContextForArgs) 
@@ -796,37 +840,38 @@ bool FMarkdownPathTracer::ProcessCollapsedGraph_Helper(
         
         FString LineContent;
         
-        // NEW: Check the global context to determine which format to generate
-        bool bIsHTMLMode = FMarkdownSpanSystem::GetCurrentContext().IsHTML();
-
-        if (bIsHTMLMode)
+        // Generate proper HTML with CSS classes and an <a> tag
+        FString HTMLLineContent;
         {
-            // Generate proper HTML with CSS classes and an <a> tag
             FString CallTypeClass = TEXT("bp-call-collapsed-graph");
             FString LinkClass = TEXT("collapsed-graph-link");
             
             FString CallKeywordHtml = FString::Printf(TEXT("<span class=\"%s\">Collapsed Graph</span>"), *CallTypeClass);
             FString LinkHtml = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link %s\">%s</a>"), *AnchorName, *LinkClass, *FMarkdownSpanSystem::EscapeHtml(FinalLinkTextForDisplay));
             
-            LineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
+            HTMLLineContent = DisplayTargetPrefix + CallKeywordHtml + TEXT(": ") + LinkHtml + ArgsStr;
             
             if (bWasAlreadyGloballyProcessed) {
-                LineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
+                HTMLLineContent += TEXT(" <span class=\"repeat-indicator\">(Call site repeat or graph already defined/queued)</span>");
             }
         }
-        else // Fallback to original Markdown generation
+
+        // Reconstruct the original Markdown link for the Markdown context
+        FString MarkdownLineContent;
         {
-            // Reconstruct the original Markdown link for the Markdown context
             FString BaseLinkText_MD = FString::Printf(TEXT("%s%s: [%s](#%s)"), *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *AnchorName);
-            LineContent = BaseLinkText_MD + ArgsStr;
+            MarkdownLineContent = BaseLinkText_MD + ArgsStr;
 
             if (bWasAlreadyGloballyProcessed) {
-                LineContent += TEXT(" (Call site repeat or graph already defined/queued)");
+                MarkdownLineContent += TEXT(" (Call site repeat or graph already defined/queued)");
             }
         }
 
+        // 中立模式下记录两种变体，渲染时按目标格式选择
+        LineContent = FMarkdownSpanSystem::FormatSwitch(HTMLLineContent, MarkdownLineContent);
+
         // Add the fully constructed line to the output
-        OutLines.Add(Self->GenerateMarkdownLine(LineContent, CurrentIndentPrefix));
+        Self->AddStepLine(OutLines, LineContent, CurrentIndentPrefix);
 
         if (!bWasAlreadyGloballyProcessed && Self->CurrentGraphsToDefineSeparatelyPtr && Self->CurrentProcessedSeparateGraphPathsPtr) {
             if (!Self->CurrentProcessedSeparateGraphPathsPtr->Contains(ActualGraphPath)) {
@@ -841,16 +886,16 @@ bool FMarkdownPathTracer::ProcessCollapsedGraph_Helper(
             FString InlineHeader = FString::Printf(TEXT("%s[Expanding %s%s: %s]%s"), *Self->ExecPrefix, *DisplayTargetPrefix, *NodeTypeKeywordDisplay, *FinalLinkTextForDisplay, *ArgsStr);
             OutLines.Add(CurrentIndentPrefix + InlineHeader);
 
-            TMap<FString, TSharedPtr<FBlueprintNode>> CompositeNodesMap;
+            TMap<FGuid, TSharedPtr<FBlueprintNode>> CompositeNodesMap;
             if (Self->DataExtractorRef.ExtractNodesFromGraph(ActualGraphPath, CompositeNodesMap) && !CompositeNodesMap.IsEmpty()) {
                 TSharedPtr<const FBlueprintNode> InternalStartNode = nullptr;
                 TSharedPtr<const FBlueprintPin> ActualInputPinForInternalStart = nullptr;
                 for (const auto& Pair : CompositeNodesMap) {
-                    if (Pair.Value.IsValid() && (Pair.Value->NodeType == TEXT("Tunnel")) && (Pair.Value->Name.Contains(TEXT("Inputs")) || Pair.Value->Name.Contains(TEXT("Input")) )) {
+                    if (Pair.Value.IsValid() && (Pair.Value->NodeType == TEXT("Tunnel")) && (Pair.Value->GetName().Contains(TEXT("Inputs")) || Pair.Value->GetName().Contains(TEXT("Input")) )) {
                         TSharedPtr<FBlueprintPin> EntryExecOut = Pair.Value->GetExecutionOutputPin(TEXT(""));
                         if (EntryExecOut.IsValid() && EntryExecOut->LinkedPins.Num() > 0 && EntryExecOut->LinkedPins[0].IsValid()) {
                             TSharedPtr<const FBlueprintPin> FirstPinInsideGraph = EntryExecOut->LinkedPins[0];
-                            const TSharedPtr<FBlueprintNode>* StartNodePtr = CompositeNodesMap.Find(FirstPinInsideGraph->NodeGuid);
+                            const TSharedPtr<FBlueprintNode>* StartNodePtr = CompositeNodesMap.Find(FirstPinInsideGraph->GraphNodeGuid);
                             if (StartNodePtr && StartNodePtr->IsValid()) {
                                 InternalStartNode = *StartNodePtr;
                                 ActualInputPinForInternalStart = FirstPinInsideGraph;
@@ -869,8 +914,8 @@ bool FMarkdownPathTracer::ProcessCollapsedGraph_Helper(
                     TMap<FName, FString> CallSiteArgsForInlineTrace;
                     for (const auto& CompInputPinPair : ExecutableNode->Pins) {
                         const TSharedPtr<FBlueprintPin>& CompInputPin = CompInputPinPair.Value;
-                        if (CompInputPin.IsValid() && CompInputPin->IsInput() && CompInputPin->Category != TEXT("exec")) {
-                            TSet<FString> TempVisitedForArgResolve;
+                        if (CompInputPin.IsValid() && CompInputPin->IsInput() && !CompInputPin->IsExecution()) {
+                            TSet<FResolvedPinKey> TempVisitedForArgResolve;
                             int32 ArgumentResolutionDepth = (CurrentIndentPrefix.Len() / Self->IndentSpace.Len()) + 1;
                             FString ArgValue = Self->DataTracerRef.ResolvePinValueRecursive(
                                 CompInputPin, AllNodes, ArgumentResolutionDepth, TempVisitedForArgResolve,
@@ -910,7 +955,7 @@ bool FMarkdownPathTracer::ProcessCollapsedGraph_Helper(
     TSharedPtr<FBlueprintPin> OutputExecPin = ExecutableNode->GetExecutionOutputPin(TEXT(""));
     if (OutputExecPin && OutputExecPin->LinkedPins.Num() > 0 && OutputExecPin->LinkedPins[0].IsValid()) {
         TSharedPtr<FBlueprintPin> TargetPinOnNextNode = OutputExecPin->LinkedPins[0];
-        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNextNode->NodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInCallerGraphPtr = AllNodes.Find(TargetPinOnNextNode->GraphNodeGuid);
         if (NextNodeInCallerGraphPtr && NextNodeInCallerGraphPtr->IsValid()) {
             OutNextNodeToTrace = *NextNodeInCallerGraphPtr;
         } else {
@@ -958,8 +1003,8 @@ FMarkdownPathTracer::FMarkdownPathTracer(FMarkdownDataTracer& InDataTracer, FBlu
 TArray<FString> FMarkdownPathTracer::TraceExecutionPath(
     TSharedPtr<const FBlueprintNode> StartNode,
     const TOptional<FCapturedEventData>& CapturedData,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-    TSet<FString>& InOutProcessedGlobally,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+    TSet<FGuid>& InOutProcessedGlobally,
     bool bInShouldTraceSymbolicallyForData,
     bool bInDefineUserGraphsSeparately,
     bool bInExpandCompositesInline,
@@ -969,7 +1014,7 @@ TArray<FString> FMarkdownPathTracer::TraceExecutionPath(
 )
 {
     TArray<FString> OutputLines;
-    TSet<FString> ProcessedInCurrentPath;
+    TSet<FGuid> ProcessedInCurrentPath;
     
     if (!StartNode.IsValid())
     {
@@ -990,11 +1035,12 @@ TArray<FString> FMarkdownPathTracer::TraceExecutionPath(
     PathTracerCurrentBlueprintContext = CurrentBlueprintContext;
 
     UE_LOG(LogPathTracer, Log, TEXT("Starting Execution Trace from Node: %s (%s) in Context: '%s'. DataSymbolic=%d, DefineSep=%d, ExpandInline=%d"),
-        StartNode->Name.IsEmpty() ? *StartNode->NodeType : *StartNode->Name, *StartNode->Guid.Left(8),
+        StartNode->GetLogName().IsEmpty() ? *StartNode->NodeType : *StartNode->GetLogName(), *StartNode->Guid.Left(8),
         *PathTracerCurrentBlueprintContext,
         bCurrentTraceDataSymbolically, bCurrentDefineUserGraphsSeparately, bCurrentExpandCompositesInline);
 
     FTraceStepContext InitialStepContext;
+    DataTracerRef.BeginSharedExpressionScope(*StartNode, AllNodes);
     
     TracePathRecursive(
         StartNode,
@@ -1009,6 +1055,7 @@ TArray<FString> FMarkdownPathTracer::TraceExecutionPath(
         InitialStepContext 
     );
 
+    DataTracerRef.EndSharedExpressionScope();
     CurrentGraphsToDefineSeparatelyPtr = nullptr; 
     CurrentProcessedSeparateGraphPathsPtr = nullptr;
 
@@ -1026,6 +1073,106 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::IsInternalUserGraph(
         return EUserGraphType::Unknown;
     }
 
+    // 捕获阶段（游戏线程）已解析：直接使用，不访问 UObject
+    if (Node->CapturedRefs.bResolved)
+    {
+        OutGraphPath = Node->CapturedRefs.UserGraphPath;
+        OutGraphNameHint = Node->CapturedRefs.UserGraphNameHint;
+        return static_cast<EUserGraphType>(Node->CapturedRefs.UserGraphType);
+    }
+
+    OutGraphPath = TEXT("");
+    OutGraphNameHint = TEXT("");
+    if (!IsInGameThread())
+    {
+        UE_LOG(LogPathTracer, Warning, TEXT("IsInternalUserGraph: Node '%s' (GUID:%s) has no captured references and cannot be resolved off the game thread."),
+            *Node->GetLogName(), *Node->Guid.Left(8));
+        return EUserGraphType::Unknown;
+    }
+    return ResolveInternalUserGraph_Helper(Node, OutGraphPath, OutGraphNameHint);
+}
+
+void FMarkdownPathTracer::CaptureNodeReferences(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes)
+{
+    check(IsInGameThread());
+
+    for (const TPair<FGuid, TSharedPtr<FBlueprintNode>>& NodePair : Nodes)
+    {
+        const TSharedPtr<FBlueprintNode>& Node = NodePair.Value;
+        if (!Node.IsValid() || Node->CapturedRefs.bResolved)
+        {
+            continue;
+        }
+
+        // 只有宏/折叠/函数调用节点会指向其他图表，其余节点直接记为 Unknown
+        FBlueprintNodeCapturedRefs Refs;
+        const bool bIsFunctionCall = Node->NodeType == TEXT("CallFunction") || Node->NodeType == TEXT("CallParentFunction");
+        if (bIsFunctionCall || Node->NodeType == TEXT("MacroInstance") || Node->NodeType == TEXT("Composite"))
+        {
+            Refs.UserGraphType = static_cast<uint8>(ResolveInternalUserGraph_Helper(Node, Refs.UserGraphPath, Refs.UserGraphNameHint));
+        }
+        if (bIsFunctionCall)
+        {
+            Refs.UserFunctionAssetPath = ResolveUserFunctionAssetPath(*Node);
+        }
+        Refs.bResolved = true;
+        Node->CapturedRefs = MoveTemp(Refs);
+    }
+}
+
+FString FMarkdownPathTracer::ResolveUserFunctionAssetPath(const FBlueprintNode& Node)
+{
+    if (Node.CapturedRefs.bResolved)
+    {
+        return Node.CapturedRefs.UserFunctionAssetPath;
+    }
+    if (!IsInGameThread())
+    {
+        return FString();
+    }
+
+    const FString* FuncNamePtr = Node.RawProperties.Find(TEXT("FunctionName"));
+    if (!FuncNamePtr && Node.NodeType == TEXT("CallParentFunction")) {
+        FuncNamePtr = Node.RawProperties.Find(TEXT("SuperFunctionName"));
+    }
+    const FString* ParentClassPath = Node.RawProperties.Find(TEXT("FunctionParentClassPath"));
+    if (!FuncNamePtr || !ParentClassPath || ParentClassPath->IsEmpty()
+        || ParentClassPath->StartsWith(TEXT("/Script/")) || ParentClassPath->StartsWith(TEXT("/Engine/")))
+    {
+        return FString();
+    }
+
+    UClass* OwnerClass = FindObject<UClass>(nullptr, **ParentClassPath);
+    UFunction* Function = OwnerClass ? OwnerClass->FindFunctionByName(FName(**FuncNamePtr)) : nullptr;
+    if (!Function)
+    {
+        return FString();
+    }
+
+    // 与 CheckCallFunctionType_Helper 相同的归属判断：没有蓝图定义该函数即为原生函数
+    UObject* FunctionActualOuter = Function->GetOuter();
+    UBlueprint* FunctionDefiningBP = Cast<UBlueprint>(FunctionActualOuter);
+    if (!FunctionDefiningBP && FunctionActualOuter && FunctionActualOuter->IsA<UBlueprintGeneratedClass>()) {
+        FunctionDefiningBP = Cast<UBlueprint>(Cast<UBlueprintGeneratedClass>(FunctionActualOuter)->ClassGeneratedBy);
+    }
+    if (!FunctionDefiningBP)
+    {
+        return FString();
+    }
+
+    // 链接锚点按调用所指的类命名（继承来的函数指向子类蓝图）
+    if (OwnerClass->ClassGeneratedBy && OwnerClass->ClassGeneratedBy->IsA<UBlueprint>())
+    {
+        return OwnerClass->ClassGeneratedBy->GetPathName();
+    }
+    return *ParentClassPath;
+}
+
+FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::ResolveInternalUserGraph_Helper(
+    TSharedPtr<const FBlueprintNode> Node,
+    FString& OutGraphPath,
+    FString& OutGraphNameHint)
+{
     OutGraphPath = TEXT("");
     OutGraphNameHint = TEXT("");
     EUserGraphType DetectedType = EUserGraphType::Unknown;
@@ -1034,7 +1181,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::IsInternalUserGraph(
     if (!EdGraphNode)
     {
         UE_LOG(LogPathTracer, Warning, TEXT("IsInternalUserGraph: Node '%s' (GUID:%s, Type:%s) has no valid OriginalEdGraphNode. Cannot determine graph type."),
-            *Node->Name, *Node->Guid.Left(8), *Node->NodeType);
+            *Node->GetLogName(), *Node->Guid.Left(8), *Node->NodeType);
         return EUserGraphType::Unknown;
     }
 
@@ -1044,7 +1191,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::IsInternalUserGraph(
     if (CallingBlueprintName.EndsWith(TEXT("_C"))) CallingBlueprintName.LeftChopInline(2);
 
     UE_LOG(LogPathTracer, Log, TEXT("IsInternalUserGraph: Processing Node '%s' (Title: '%s', OriginalType: %s, CallerBP: %s) for user graph identification."),
-        *Node->Guid.Left(8), *Node->Name, *Node->NodeType, *CallingBlueprintName);
+        *Node->Guid.Left(8), *Node->GetLogName(), *Node->NodeType, *CallingBlueprintName);
 
     if (Node->NodeType == TEXT("MacroInstance"))
     {
@@ -1060,7 +1207,7 @@ FMarkdownPathTracer::EUserGraphType FMarkdownPathTracer::IsInternalUserGraph(
     }
 
     UE_LOG(LogPathTracer, Log, TEXT("IsInternalUserGraph FINAL RESULT for Node '%s' (Title: '%s'): DetectedType=%d, OutGraphPath='%s', OutGraphNameHint='%s'"),
-        *Node->Guid.Left(8), *Node->Name, static_cast<int>(DetectedType), *OutGraphPath, *OutGraphNameHint);
+        *Node->Guid.Left(8), *Node->GetLogName(), static_cast<int>(DetectedType), *OutGraphPath, *OutGraphNameHint);
     return DetectedType;
 }
 
@@ -1071,9 +1218,9 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
     const FString& ActualGraphPath,
     const FString& UniqueGraphNameHint,
     bool bIsInternalGraphCall,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-    TSet<FString>& InOutProcessedGlobally,
-    TSet<FString>& ProcessedInCurrentPath,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+    TSet<FGuid>& InOutProcessedGlobally,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefixMarkdown,
     bool bIsLastSegmentMarkdown,
     TArray<FString>& OutLines,
@@ -1137,7 +1284,7 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
     }
 
     if (InternalGraphNodeType == EUserGraphType::CollapsedGraph) {
-        ItemNamePart = ExecutableNode->Name.Replace(TEXT("\n"), TEXT(" "));
+        ItemNamePart = ExecutableNode->GetName().Replace(TEXT("\n"), TEXT(" "));
         if (ItemNamePart.IsEmpty() || ItemNamePart == ExecutableNode->NodeType.Replace(TEXT("\n"), TEXT(" "))) {
             ItemNamePart = UniqueGraphNameHint.Mid(SeparatorPos != INDEX_NONE ? SeparatorPos + 1 : 0);
             ItemNamePart.ReplaceInline(TEXT("\n"), TEXT(" "), ESearchCase::CaseSensitive);
@@ -1154,7 +1301,7 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
     }
 
     if (TargetPin.IsValid()) {
-        TSet<FString> VisitedPinsForTargetTrace;
+        TSet<FResolvedPinKey> VisitedPinsForTargetTrace;
         TargetDisplayStringForPrefix = DataTracerRef.TraceTargetPin(
             TargetPin, AllNodes, CurrentIndentPrefixMarkdown.Len() / IndentSpace.Len() + 1, 
             VisitedPinsForTargetTrace, PathTracerCurrentBlueprintContext); 
@@ -1182,7 +1329,7 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
     FString ArgsStr = TEXT("()");
     if (InternalGraphNodeType != EUserGraphType::Unknown)
     {
-        TSet<FString> VisitedPinsForLinkArgs;
+        TSet<FResolvedPinKey> VisitedPinsForLinkArgs;
         TSet<FName> ExclusionsForArgs;
         if (TargetPin.IsValid()) ExclusionsForArgs.Add(TargetPin->PinName);
 
@@ -1209,7 +1356,7 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
    
         
         default: // EUserGraphType::Unknown
-             UE_LOG(LogPathTracer, Warning, TEXT("HandleUserGraphNode: Called with EUserGraphType::Unknown for Node %s. This should not happen if bIsInternalGraphCall was true."), *ExecutableNode->Name);
+             UE_LOG(LogPathTracer, Warning, TEXT("HandleUserGraphNode: Called with EUserGraphType::Unknown for Node %s. This should not happen if bIsInternalGraphCall was true."), *ExecutableNode->GetLogName());
             return false;
     }
 }
@@ -1219,9 +1366,9 @@ bool FMarkdownPathTracer::HandleUserGraphNode(
 void FMarkdownPathTracer::TracePathRecursive(
     TSharedPtr<const FBlueprintNode> CurrentNode,
     const TOptional<FCapturedEventData>& CurrentCapturedData,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-    TSet<FString>& InOutProcessedGlobally,
-    TSet<FString>& ProcessedInCurrentPath,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+    TSet<FGuid>& InOutProcessedGlobally,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix,
     bool bIsLastSegment,
     TArray<FString>& OutLines,
@@ -1229,7 +1376,7 @@ void FMarkdownPathTracer::TracePathRecursive(
     const FTraceStepContext& StepContext        
 )
 {
-    const TCHAR* CurrentNodeNameForLog = CurrentNode.IsValid() ? *(CurrentNode->Name) : TEXT("NULL_NODE");
+    const TCHAR* CurrentNodeNameForLog = CurrentNode.IsValid() ? *(CurrentNode->GetName()) : TEXT("NULL_NODE");
     const TCHAR* CurrentNodeGuidForLog = CurrentNode.IsValid() ? *(CurrentNode->Guid.Left(8)) : TEXT("NULL_GUID");
     int32 CurrentDepthValue = CurrentIndentPrefix.Len() / IndentSpace.Len();
 
@@ -1270,15 +1417,16 @@ void FMarkdownPathTracer::TracePathRecursive(
         return;
     }
     
-    const FString ExecutableGuid = ExecutableNode->Guid;
+    const FString ExecutableGuid = ExecutableNode->Guid;          // 仅用于输出
+    const FGuid& ExecutableNodeId = ExecutableNode->GraphNodeGuid;  // 集合键
 
     bool bWasAlreadyGloballyProcessed = false;
     bool bAddedToCurrentPathThisCall = false; 
-    if (HandleGloballyProcessedNode(ExecutableNode, TargetPinForExecutable, ExecutableGuid, InOutProcessedGlobally, ProcessedInCurrentPath, CurrentIndentPrefix, OutLines, bWasAlreadyGloballyProcessed, CurrentNode.IsValid() ? CurrentNode->Guid : FString(), bAddedToCurrentPathThisCall, AllNodes)) {  // ADD , AllNodes
+    if (HandleGloballyProcessedNode(ExecutableNode, TargetPinForExecutable, ExecutableGuid, InOutProcessedGlobally, ProcessedInCurrentPath, CurrentIndentPrefix, OutLines, bWasAlreadyGloballyProcessed, CurrentNode.IsValid() ? CurrentNode->GraphNodeGuid : FGuid(), bAddedToCurrentPathThisCall, AllNodes)) {  // ADD , AllNodes
         return; 
     }
-    if (!ProcessedInCurrentPath.Contains(ExecutableGuid)) { ProcessedInCurrentPath.Add(ExecutableGuid); bAddedToCurrentPathThisCall = true; }
-    InOutProcessedGlobally.Add(ExecutableGuid);
+    if (!ProcessedInCurrentPath.Contains(ExecutableNodeId)) { ProcessedInCurrentPath.Add(ExecutableNodeId); bAddedToCurrentPathThisCall = true; }
+    InOutProcessedGlobally.Add(ExecutableNodeId);
 
     // REMOVED: All HTML prefix type calculation - Markdown-only now
 
@@ -1288,18 +1436,25 @@ void FMarkdownPathTracer::TracePathRecursive(
 
     // Only add generic formatted description if NOT handled by user graph logic
     if (!bIsInternalGraphCall) {
-        TSet<FString> VisitedDataPinsForNode; 
+        TSet<FResolvedPinKey> VisitedDataPinsForNode; 
         const TOptional<FCapturedEventData>& DataToPass = (CurrentCapturedData.IsSet() && CurrentCapturedData->BoundEventOwnerClassPath.Contains(ExecutableGuid)) ? CurrentCapturedData : TOptional<FCapturedEventData>();
         FString FormattedDesc = FMarkdownNodeFormatter::FormatNodeDescription(ExecutableNode, DataToPass, DataTracerRef, AllNodes, VisitedDataPinsForNode, false, bCurrentTraceDataSymbolically, CurrentBlueprintContext);
     
         UE_LOG(LogPathTracer, Log, TEXT("TracePathRecursive: Adding generic FormattedDesc for Node: %s (%s), Content: [%s]"), 
-               *(ExecutableNode->Name), *(ExecutableNode->Guid.Left(8)), *FormattedDesc);
+               *(ExecutableNode->GetLogName()), *(ExecutableNode->Guid.Left(8)), *FormattedDesc);
     
         if (!FormattedDesc.IsEmpty()) {
-            OutLines.Add(GenerateMarkdownLine(FormattedDesc, CurrentIndentPrefix));
+            if (bAnnotateCallTargets) {
+                AppendCallTargetAnnotation(ExecutableNode, FormattedDesc);
+            }
+            AddStepLine(OutLines, FormattedDesc, CurrentIndentPrefix);
         }
-        else if (ExecutableNode.IsValid() && !ExecutableNode->IsPure() && ExecutableNode->NodeType != TEXT("Knot") && ExecutableNode->NodeType != TEXT("Comment")) {
-            UE_LOG(LogPathTracer, Warning, TEXT("%sExecutable Node %s (%s) formatted as empty."), *CurrentIndentPrefix, *ExecutableGuid, *(ExecutableNode->NodeType));
+        else {
+            // 没有写出步骤行，格式化时首次引用的绑定留到下次引用时再写
+            DataTracerRef.DiscardPendingSharedBindings();
+            if (ExecutableNode.IsValid() && !ExecutableNode->IsPure() && ExecutableNode->NodeType != TEXT("Knot") && ExecutableNode->NodeType != TEXT("Comment")) {
+                UE_LOG(LogPathTracer, Warning, TEXT("%sExecutable Node %s (%s) formatted as empty."), *CurrentIndentPrefix, *ExecutableGuid, *(ExecutableNode->NodeType));
+            }
         }
     }
 
@@ -1326,7 +1481,7 @@ void FMarkdownPathTracer::TracePathRecursive(
         ProcessNodeFormattingAndBranching(ExecutableNode, ExecutableGuid, CurrentCapturedData, AllNodes, InOutProcessedGlobally, ProcessedInCurrentPath, CurrentIndentPrefix, bIsLastSegment, OutLines, CurrentBlueprintContext, StepContext);
     }
 
-    if (bAddedToCurrentPathThisCall) { ProcessedInCurrentPath.Remove(ExecutableGuid); }
+    if (bAddedToCurrentPathThisCall) { ProcessedInCurrentPath.Remove(ExecutableNodeId); }
     UE_LOG(LogPathTracer, Verbose, TEXT("%sTracePathRecursive EXIT for Node %s"), *CurrentIndentPrefix, *ExecutableGuid);
 }
 
@@ -1334,7 +1489,7 @@ void FMarkdownPathTracer::TracePathRecursive(
 
 TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkdownPathTracer::_find_next_executable_node(
 	TSharedPtr<const FBlueprintNode> FromNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
 	TArray<FString>& OutLines,
 	const FString& SearchIndentPrefix
 )
@@ -1365,9 +1520,9 @@ TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkd
     const int MaxSearchDepthInternal = 20;
     int CurrentSearchDepth = 0;
     TSharedPtr<const FBlueprintNode> CurrentSearchNode = FromNode;
-    TSet<FString> VisitedInSearch;
+    TSet<FGuid> VisitedInSearch;
 
-    VisitedInSearch.Add(CurrentSearchNode->Guid);
+    VisitedInSearch.Add(CurrentSearchNode->GraphNodeGuid);
     UE_LOG(LogPathTracer, Verbose, TEXT("%s  _find_next: Added initial Knot node %s to VisitedInSearch."), *SearchIndentPrefix, *(CurrentSearchNode->Guid.Left(8)));
 
     while (CurrentSearchNode.IsValid() && CurrentSearchDepth < MaxSearchDepthInternal)
@@ -1389,7 +1544,7 @@ TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkd
         TSharedPtr<const FBlueprintPin> TargetPinOnNextNode = ExecPinToFollow->LinkedPins[0];
         const FString NextNodeGuid = TargetPinOnNextNode->NodeGuid;
 
-        const TSharedPtr<FBlueprintNode>* NextNodeInChainPtr = AllNodes.Find(NextNodeGuid);
+        const TSharedPtr<FBlueprintNode>* NextNodeInChainPtr = AllNodes.Find(TargetPinOnNextNode->GraphNodeGuid);
 
         if (!NextNodeInChainPtr || !NextNodeInChainPtr->IsValid())
         {
@@ -1402,13 +1557,13 @@ TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkd
 
         TSharedPtr<const FBlueprintNode> NextNodeInChain = *NextNodeInChainPtr;
 
-        if (VisitedInSearch.Contains(NextNodeGuid))
+        if (VisitedInSearch.Contains(NextNodeInChain->GraphNodeGuid))
         {
              UE_LOG(LogPathTracer, Warning, TEXT("%s  _find_next: Loop detected during skip search. Next node %s (%s) is already in VisitedInSearch. Stopping."), *SearchIndentPrefix, *(NextNodeInChain->NodeType), *(NextNodeGuid.Left(8)));
-             OutLines.Add(GenerateMarkdownLine(FString::Printf(TEXT("[Execution loop during skip to `%s` (%s)]"), *(NextNodeInChain->Name), *(NextNodeGuid.Left(8))), SearchIndentPrefix));
+             OutLines.Add(GenerateMarkdownLine(FString::Printf(TEXT("[Execution loop during skip to `%s` (%s)]"), *(NextNodeInChain->GetName()), *(NextNodeGuid.Left(8))), SearchIndentPrefix));
              return TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>>();
         }
-        VisitedInSearch.Add(NextNodeGuid);
+        VisitedInSearch.Add(NextNodeInChain->GraphNodeGuid);
         UE_LOG(LogPathTracer, Verbose, TEXT("%s  _find_next: Moved to node %s. Added to VisitedInSearch."), *SearchIndentPrefix, *(NextNodeGuid.Left(8)));
         CurrentSearchDepth++;
 
@@ -1430,7 +1585,7 @@ TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkd
         {
             UE_LOG(LogPathTracer, Log, TEXT("%s<<< _find_next EXIT: Path ended at Pure/Comment node %s (%s) while skipping."), *SearchIndentPrefix, *(NextNodeGuid.Left(8)), *(NextNodeInChain->NodeType));
             if (CurrentSearchDepth > 0) {
-                OutLines.Add(GenerateMarkdownLine(FString::Printf(TEXT("[Skipped nodes ended on non-executable node `%s`]"), *(NextNodeInChain->Name)), SearchIndentPrefix));
+                OutLines.Add(GenerateMarkdownLine(FString::Printf(TEXT("[Skipped nodes ended on non-executable node `%s`]"), *(NextNodeInChain->GetName())), SearchIndentPrefix));
             }
             return TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>>();
         }
@@ -1457,7 +1612,7 @@ FString FMarkdownPathTracer::CalculateNextPrefix(
 
 TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkdownPathTracer::HandleInitialChecksAndFindExecutable(
     TSharedPtr<const FBlueprintNode> CurrentNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
     int32 CurrentDepth,
     const FString& CurrentIndentPrefix,
     TArray<FString>& OutLines
@@ -1479,15 +1634,15 @@ TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> FMarkd
 
 bool FMarkdownPathTracer::HandlePathLoop(
     TSharedPtr<const FBlueprintNode> NodeToCheck,
-    TSet<FString>& ProcessedInCurrentPath,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix,
     TArray<FString>& OutLines
 ) {
     if (!NodeToCheck.IsValid()) return false;
 
     const FString NodeGuid = NodeToCheck->Guid;
-    if (ProcessedInCurrentPath.Contains(NodeGuid)) {
-        FString NodeName = NodeToCheck->Name.IsEmpty() ? NodeToCheck->NodeType : NodeToCheck->Name;
+    if (ProcessedInCurrentPath.Contains(NodeToCheck->GraphNodeGuid)) {
+        FString NodeName = NodeToCheck->GetName().IsEmpty() ? NodeToCheck->NodeType : NodeToCheck->GetName();
         
         // CLEANED: Only Markdown output - this is critical loop detection!
         OutLines.Add(GenerateMarkdownLine(FString::Printf(TEXT("[Execution loop back to: `%s` (%s)]"), 
@@ -1498,7 +1653,7 @@ bool FMarkdownPathTracer::HandlePathLoop(
         return true;
     }
     
-    ProcessedInCurrentPath.Add(NodeGuid);
+    ProcessedInCurrentPath.Add(NodeToCheck->GraphNodeGuid);
     UE_LOG(LogPathTracer, Verbose, TEXT("%sAdded %s to ProcessedInCurrentPath (within HandlePathLoop)."), 
         *CurrentIndentPrefix, *NodeGuid);
     return false;
@@ -1508,18 +1663,18 @@ bool FMarkdownPathTracer::HandleGloballyProcessedNode(
     TSharedPtr<const FBlueprintNode> ExecutableNode,
     TSharedPtr<const FBlueprintPin> TargetPinForExecutable,
     const FString& ExecutableGuid,
-    TSet<FString>& InOutProcessedGlobally,
-    TSet<FString>& ProcessedInCurrentPath,
+    TSet<FGuid>& InOutProcessedGlobally,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix,
     TArray<FString>& OutLines,
     bool& bWasAlreadyGloballyProcessed,
-    const FString& CurrentGuid,
+    const FGuid& CurrentGuid,
     bool bAddedExecutableToPath,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes 
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes 
 ) {
-    bWasAlreadyGloballyProcessed = InOutProcessedGlobally.Contains(ExecutableGuid);
+    bWasAlreadyGloballyProcessed = InOutProcessedGlobally.Contains(ExecutableNode->GraphNodeGuid);
     if (bWasAlreadyGloballyProcessed) {
-        FString NodeName = ExecutableNode->Name.IsEmpty() ? ExecutableNode->NodeType : ExecutableNode->Name;
+        FString NodeName = ExecutableNode->GetName().IsEmpty() ? ExecutableNode->NodeType : ExecutableNode->GetName();
         FString NodeGuidShort = ExecutableGuid.Left(8);
         FString Message = "";
 
@@ -1607,7 +1762,9 @@ bool FMarkdownPathTracer::HandleGloballyProcessedNode(
             FString OperationDescription = TEXT("Unknown Operation");
     
             if (ExecutableNode.IsValid()) {
-                TSet<FString> TempVisitedSet;
+                TSet<FResolvedPinKey> TempVisitedSet;
+                // 摘要行后面不跟 let 行，这里照常内联
+                TGuardValue<bool> SuspendSharedExpressions(DataTracerRef.bSuspendSharedExpressions, true);
                 OperationDescription = FMarkdownNodeFormatter::FormatNodeDescription(
                     ExecutableNode,
                     TOptional<FCapturedEventData>(),
@@ -1619,13 +1776,8 @@ bool FMarkdownPathTracer::HandleGloballyProcessedNode(
                     PathTracerCurrentBlueprintContext
                 );
         
-                // Clean up formatting
-                OperationDescription.ReplaceInline(TEXT("**"), TEXT(""));
-                OperationDescription.ReplaceInline(TEXT("`"), TEXT(""));
-                OperationDescription = OperationDescription.TrimStartAndEnd();
-                if (OperationDescription.StartsWith(TEXT("* "))) {
-                    OperationDescription.RightChopInline(2);
-                }
+                // Clean up formatting (deferred to render time in neutral mode)
+                OperationDescription = FMarkdownSpanSystem::PlainDescription(OperationDescription);
             }
     
             Message = FString::Printf(TEXT("[Continue execution at: %s → Previously detailed]"), 
@@ -1646,8 +1798,8 @@ bool FMarkdownPathTracer::HandleGloballyProcessedNode(
             if (OutLines.IsEmpty() || OutLines.Last() != LineToAdd) { OutLines.Add(LineToAdd); }
         }
         
-        if (ProcessedInCurrentPath.Contains(CurrentGuid)) ProcessedInCurrentPath.Remove(CurrentGuid);
-        if (bAddedExecutableToPath && ProcessedInCurrentPath.Contains(ExecutableGuid)) ProcessedInCurrentPath.Remove(ExecutableGuid);
+        ProcessedInCurrentPath.Remove(CurrentGuid);
+        if (bAddedExecutableToPath) ProcessedInCurrentPath.Remove(ExecutableNode->GraphNodeGuid);
         return true; 
     }
     return false; 
@@ -1659,9 +1811,9 @@ void FMarkdownPathTracer::ProcessNodeFormattingAndBranching(
     TSharedPtr<const FBlueprintNode> ExecutableNode,
     const FString& ExecutableGuid,
     const TOptional<FCapturedEventData>& CurrentCapturedData,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-    TSet<FString>& InOutProcessedGlobally,
-    TSet<FString>& ProcessedInCurrentPath,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+    TSet<FGuid>& InOutProcessedGlobally,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix,
     bool bIsLastSegment,
     TArray<FString>& OutLines,
@@ -1709,11 +1861,12 @@ void FMarkdownPathTracer::ProcessNodeFormattingAndBranching(
                     TSharedPtr<const FBlueprintPin> EntryPinOnTargetNode = nullptr;
                     if (BranchPinToFollow->LinkedPins.Num() > 0 && BranchPinToFollow->LinkedPins[0].IsValid()) {
                         EntryPinOnTargetNode = BranchPinToFollow->LinkedPins[0];
-                        TargetNode = AllNodes.FindRef(EntryPinOnTargetNode->NodeGuid);
+                        TargetNode = AllNodes.FindRef(EntryPinOnTargetNode->GraphNodeGuid);
                     }
 
                     if (TargetNode) {
-                        TSet<FString> FreshBranchPath = ProcessedInCurrentPath;
+                        TSet<FGuid> FreshBranchPath = ProcessedInCurrentPath;
+                        FMarkdownDataTracer::FSharedBindingBranchScope BindingScope(DataTracerRef);
                         TracePathRecursive(TargetNode, TOptional<FCapturedEventData>(), AllNodes, InOutProcessedGlobally, FreshBranchPath,
                                            ChildIndentBase + (bIsThisBranchLast ? IndentSpace : LineCont),
                                            bIsThisBranchLast,
@@ -1832,14 +1985,19 @@ void FMarkdownPathTracer::ProcessNodeFormattingAndBranching(
             if (PinToFollow->LinkedPins.Num() > 0 && PinToFollow->LinkedPins[0].IsValid()) {
                 EntryPinOnTargetNodeForBranch = PinToFollow->LinkedPins[0]; 
                 if(EntryPinOnTargetNodeForBranch) { 
-                    const TSharedPtr<FBlueprintNode>* TargetNodePtr = AllNodes.Find(EntryPinOnTargetNodeForBranch->NodeGuid);
+                    const TSharedPtr<FBlueprintNode>* TargetNodePtr = AllNodes.Find(EntryPinOnTargetNodeForBranch->GraphNodeGuid);
                     if (TargetNodePtr && TargetNodePtr->IsValid()) { TargetNodeForBranch = *TargetNodePtr; }
                     else { bLinkGoesOutside = true; OutsideLinkGuid = EntryPinOnTargetNodeForBranch->NodeGuid; } 
                 }
             }
 
             if (TargetNodeForBranch) {
-                TSet<FString> PathSetToUse = ProcessedInCurrentPath; 
+                TSet<FGuid> PathSetToUse = ProcessedInCurrentPath; 
+                // 单一后继是线性延续，与当前步骤同作用域，不必复制已声明集合
+                TOptional<FMarkdownDataTracer::FSharedBindingBranchScope> BindingScope;
+                if (NumBranches > 1) {
+                    BindingScope.Emplace(DataTracerRef);
+                }
                 
                 TracePathRecursive(
                     TargetNodeForBranch, 
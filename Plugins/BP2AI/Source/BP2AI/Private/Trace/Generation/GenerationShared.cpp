@@ -8,6 +8,7 @@
 
 #include "GenerationShared.h"
 #include "Logging/BP2AILog.h"
+#include "Exporters/BP2AIDocumentWriter.h"
 
 namespace CategoryUtils
 {
@@ -223,5 +224,7 @@ void FBlueprintTypeInfo::GenerateDisplayInfo()
         *BaseType, *ContainerType, *DisplayName, *CSSClasses);
 }
 
-
-
+void IDocumentBuilder::WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink)
+{
+    Sink.Append(BuildDocument(TracingData, Settings));
+}
@@ -8,12 +8,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Settings/BP2AIExportConfig.h"
 #include "Trace/MarkdownGenerationContext.h"
 #include "Trace/SemanticData.h"
 
 // Forward declarations
 class FBlueprintNode;
 class UEdGraphNode;
+class FBP2AIDocumentSink;
 
 // ✅ NEW: Category enumeration for user-configurable visibility
 enum class BP2AI_API EDocumentationGraphCategory : uint8
@@ -34,6 +36,7 @@ struct BP2AI_API FTraceEntry
     FString NodeType;         
     TArray<FString> ExecutionLines;  // ⚠️ KEPT - For backward compatibility during migration
     FString TraceId;          
+    bool bIsRedundant = false;       // 仅包含一行 "Previously detailed" 的追踪（起点已在之前的追踪中展开）
     
     // ✅ ADDED: New semantic data (DO NOT REMOVE ExecutionLines yet!)
     TArray<FSemanticExecutionStep> ExecutionSteps; // NEW - Clean semantic data
@@ -132,6 +135,16 @@ struct BP2AI_API FGenerationSettings
     bool bEnableSemanticValidation = true;      // Dual-output validation during migration
     bool bDebugSemanticMigration = false;
 
+    // 批量导出：在调用步骤上标注 Target 类；构建文档时省略冗余追踪
+    bool bAnnotateCallTargets = false;
+    bool bSuppressRedundantTraces = false;
+
+    // 数据引脚追踪的深度上限（FMarkdownDataTracer::StartTraceSession 读取）
+    int32 MaxDataTraceDepth = BP2AIExportConfig::DataTraceMaxDepth;
+
+    // 纯节点输出在一次执行追踪内被引用至少该次数（>=）时绑定为 let 行（< 2 关闭；FMarkdownDataTracer::BeginSharedExpressionScope 读取）
+    int32 SharedExpressionMinUses = BP2AIExportConfig::SharedExpressionMinUses;
+
     
     // Category visibility control
     TMap<EDocumentationGraphCategory, bool> CategoryVisibility;
@@ -237,6 +250,8 @@ class BP2AI_API IDocumentBuilder
 public:
     virtual ~IDocumentBuilder() = default;
     virtual FString BuildDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings) = 0;
+    // Streams the document into Sink; the default falls back to BuildDocument
+    virtual void WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink);
     virtual FString GetFileExtension() const = 0;
     virtual FString GetDisplayName() const = 0;
 };
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include "Interfaces/IPluginManager.h"
 #include "Trace/SemanticFormatter.h"
 #include "Trace/Utils/MarkdownFormattingUtils.h"  // For FBlueprintTypeInfo
+#include "Exporters/BP2AIDocumentWriter.h"
 #include "Internationalization/Regex.h"
 
 
@@ -45,6 +46,23 @@ FString FHTMLDocumentBuilder::BuildDocumentWithCopyData(
     const FTracingResults& HTMLResults,
     const FTracingResults& MarkdownResults,
     const FGenerationSettings& Settings)
+{
+    FString HTMLDocument;
+    FBP2AIStringDocumentSink Sink(HTMLDocument);
+    WriteDocumentWithCopyData(HTMLResults, MarkdownResults, Settings, Sink);
+    return HTMLDocument;
+}
+
+void FHTMLDocumentBuilder::WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink)
+{
+    WriteDocumentWithCopyData(TracingData, TracingData, Settings, Sink);
+}
+
+void FHTMLDocumentBuilder::WriteDocumentWithCopyData(
+    const FTracingResults& HTMLResults,
+    const FTracingResults& MarkdownResults,
+    const FGenerationSettings& Settings,
+    FBP2AIDocumentSink& Sink)
 {
     FMarkdownGenerationContext HTMLContext(FMarkdownGenerationContext::EOutputFormat::StyledHTML);
     FMarkdownContextManager ContextManager(HTMLContext);
@@ -59,7 +77,7 @@ FString FHTMLDocumentBuilder::BuildDocumentWithCopyData(
     
     UE_LOG(LogBP2AI, Log, TEXT("HTMLDocumentBuilder: Generated document with %d HTML lines"), AllOutputLines.Num());
     
-    return WrapInCompleteHTMLDocument(FString::Join(AllOutputLines, TEXT("\n")));
+    WriteCompleteHTMLDocument(AllOutputLines, Sink);
 }
 
 // ✅ CORE PROCESSING: Handle all content with copy data embedding
@@ -458,43 +476,41 @@ void FHTMLDocumentBuilder::AddListItem(TArray<FString>& OutLines, const FString&
     OutLines.Add(FString::Printf(TEXT("<li>%s</li>"), *ItemContent));
 }
 
-FString FHTMLDocumentBuilder::WrapInCompleteHTMLDocument(const FString& BodyContent) const
+void FHTMLDocumentBuilder::WriteCompleteHTMLDocument(const TArray<FString>& BodyLines, FBP2AIDocumentSink& Sink) const
 {
-    FString HTMLDocument = TEXT(R"(<!DOCTYPE html>
+    Sink.Append(TEXT(R"(<!DOCTYPE html>
 <html lang="en">
 <head>
     <meta charset="UTF-8">
     <meta name="viewport" content="width=device-width, initial-scale=1.0">
     <title>Flow Inspector</title>
     <style>
-)");
+)"));
 
     // ✅ FIX: Only use modern CSS, remove legacy interactive features
-    HTMLDocument += FBlueprintMarkdownCSS::GetModernThemeCSS();
+    Sink.Append(FBlueprintMarkdownCSS::GetModernThemeCSS());
     
-    HTMLDocument += TEXT(R"(
+    Sink.Append(TEXT(R"(
     </style>
 </head>
 <body>
-)");
+)"));
 
     // ✅ FIX: Remove .blueprint-content wrapper that breaks grid layout
-    HTMLDocument += BodyContent;
+    Sink.AppendLines(BodyLines);
     
-    HTMLDocument += TEXT(R"(
+    Sink.Append(TEXT(R"(
     
     <script>
-)");
+)"));
 
     // ✅ FIX: Load only modern JavaScript, no legacy search overlay
-    HTMLDocument += GetModernInteractiveJavaScript();
+    Sink.Append(GetModernInteractiveJavaScript());
     
-    HTMLDocument += TEXT(R"(
+    Sink.Append(TEXT(R"(
     </script>
 </body>
-</html>)");
-
-    return HTMLDocument;
+</html>)"));
 }
 
 
@@ -18,6 +18,7 @@ public:
 
     // IDocumentBuilder interface
     virtual FString BuildDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings) override;
+    virtual void WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink) override;
     virtual FString GetFileExtension() const override { return TEXT("html"); }
     virtual FString GetDisplayName() const override { return TEXT("HTML"); }
 
@@ -27,6 +28,13 @@ public:
         const FTracingResults& MarkdownResults,
         const FGenerationSettings& Settings);
 
+    // Streaming variant: writes the complete HTML page into Sink
+    void WriteDocumentWithCopyData(
+        const FTracingResults& HTMLResults,
+        const FTracingResults& MarkdownResults,
+        const FGenerationSettings& Settings,
+        FBP2AIDocumentSink& Sink);
+
     // External JS loading for testing
     FString LoadExternalJS() const;
 
@@ -79,7 +87,7 @@ private:
     void AddListItem(TArray<FString>& OutLines, const FString& ItemContent) const;
     
     // Complete HTML document generation
-    FString WrapInCompleteHTMLDocument(const FString& BodyContent) const;
+    void WriteCompleteHTMLDocument(const TArray<FString>& BodyLines, FBP2AIDocumentSink& Sink) const;
     FString GetInteractiveFeaturesJavaScript() const;
     void GenerateAndPrependTOC(TArray<FString>& AllOutputLines, const FTracingResults& TracingData) const;
     
@@ -12,6 +12,7 @@
 #include "Logging/BP2AILog.h"
 #include "Trace/Generation/GenerationShared.h"
 #include "Settings/BP2AIExportConfig.h"
+#include "Exporters/BP2AIDocumentWriter.h"
 
 FMarkdownDocumentBuilder::FMarkdownDocumentBuilder()
 {
@@ -20,6 +21,21 @@ FMarkdownDocumentBuilder::FMarkdownDocumentBuilder()
     StyledContentFormatter = MakeUnique<FStyledMarkdownSemanticFormatter>();
 }
 FString FMarkdownDocumentBuilder::BuildDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings)
+{
+    TArray<FString> AllOutputLines;
+    CollectDocumentLines(TracingData, Settings, AllOutputLines);
+    return FString::Join(AllOutputLines, TEXT("\n"));
+}
+
+void FMarkdownDocumentBuilder::WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink)
+{
+    // Lines go straight to the sink instead of being joined into one more full-size copy
+    TArray<FString> AllOutputLines;
+    CollectDocumentLines(TracingData, Settings, AllOutputLines);
+    Sink.AppendLines(AllOutputLines);
+}
+
+void FMarkdownDocumentBuilder::CollectDocumentLines(const FTracingResults& TracingData, const FGenerationSettings& Settings, TArray<FString>& AllOutputLines)
 {
     // ✅ SET MARKDOWN CONTEXT for consistent formatting
     FMarkdownGenerationContext MarkdownContext(FMarkdownGenerationContext::EOutputFormat::RawMarkdown);
@@ -28,8 +44,6 @@ FString FMarkdownDocumentBuilder::BuildDocument(const FTracingResults& TracingDa
     
     CurrentSettings = &Settings; // Store settings reference
     
-    TArray<FString> AllOutputLines;
-    
     if (BP2AIExportConfig::bDetailedBlueprintLog)
     {
         UE_LOG(LogBP2AI, Log, TEXT("MarkdownDocumentBuilder (!!!MARKDOWN!!!): Processing %d execution traces. UseSemanticData: %s"), TracingData.ExecutionTraces.Num(), Settings.bUseSemanticData ? TEXT("TRUE") : TEXT("FALSE"));
@@ -38,6 +52,11 @@ FString FMarkdownDocumentBuilder::BuildDocument(const FTracingResults& TracingDa
     // Process execution traces  
     for (const FTraceEntry& TraceEntry : TracingData.ExecutionTraces)
     {
+        if (Settings.bSuppressRedundantTraces && TraceEntry.bIsRedundant)
+        {
+            continue;
+        }
+
         // ZONE 3: Rich formatting for trace headers  
         AddTraceStartHeader(AllOutputLines, TraceEntry.TraceName, TraceEntry.NodeType);
     
@@ -60,8 +79,6 @@ FString FMarkdownDocumentBuilder::BuildDocument(const FTracingResults& TracingDa
     {
         UE_LOG(LogBP2AI, Log, TEXT("MarkdownDocumentBuilder (!!!MARKDOWN!!!): Generated document with %d lines"), AllOutputLines.Num());
     }
-    
-    return FString::Join(AllOutputLines, TEXT("\n"));
 }
 
 void FMarkdownDocumentBuilder::ProcessStructuredContent(const FTracingResults& TracingData, TArray<FString>& OutLines)
@@ -19,6 +19,7 @@ public:
 
 	// IDocumentBuilder interface
 	virtual FString BuildDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings) override;
+	virtual void WriteDocument(const FTracingResults& TracingData, const FGenerationSettings& Settings, FBP2AIDocumentSink& Sink) override;
 	virtual FString GetFileExtension() const override { return TEXT("md"); }
 	virtual FString GetDisplayName() const override { return TEXT("Markdown"); }
 
@@ -56,6 +57,9 @@ private:
 	void EndUnorderedList(TArray<FString>& OutLines) const;
 	void AddListItem(TArray<FString>& OutLines, const FString& ItemContent) const;
 
+	// Builds every output line of the document (shared by BuildDocument and WriteDocument)
+	void CollectDocumentLines(const FTracingResults& TracingData, const FGenerationSettings& Settings, TArray<FString>& AllOutputLines);
+
 	// Structured content processing
 	void ProcessStructuredContent(const FTracingResults& TracingData, TArray<FString>& OutLines);
 	void AddGraphDefinition(TArray<FString>& OutLines, const FGraphDefinitionEntry& GraphDef, const FGenerationSettings& Settings);
@@ -23,17 +23,11 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Arrays::HandleMakeArray(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 
 {
@@ -53,7 +47,7 @@ FString FNodeTraceHandlers_Arrays::HandleMakeArray(
             break; // No more numbered pins
         }
         // Trace each item pin's value recursively
-        FString ElementValue = Tracer->ResolvePinValueRecursive(ItemPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace);
+        FString ElementValue = Tracer->ResolvePinValueRecursive(ItemPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
         ItemStrings.Add(ElementValue);
         Index++;
     }
@@ -66,17 +60,11 @@ FString FNodeTraceHandlers_Arrays::HandleMakeArray(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Arrays::HandleGetArrayItem(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // This is the output item pin
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("GetArrayItem"));
@@ -92,7 +80,7 @@ FString FNodeTraceHandlers_Arrays::HandleGetArrayItem(
     {
         if(Pair.Value.IsValid() && Pair.Value->IsInput())
         {
-            if(Pair.Value->ContainerType == TEXT("Array")) // Simplified check
+            if(Pair.Value->PinContainerType == EPinContainerType::Array) // Simplified check
             {
                 ArrayPin = Pair.Value;
             }
@@ -109,8 +97,8 @@ FString FNodeTraceHandlers_Arrays::HandleGetArrayItem(
     if (!IndexPin.IsValid()) { UE_LOG(LogDataTracer, Warning, TEXT("  HandleGetArrayItem: Cannot find Index input pin")); return FMarkdownSpan::Error(TEXT("[GetArrayItem Index Input Missing]")); }
 
     // Resolve values for the array and index pins recursively
-    FString ArrayStr = Tracer->ResolvePinValueRecursive(ArrayPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace);
-    FString IndexStr = Tracer->ResolvePinValueRecursive(IndexPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace);
+    FString ArrayStr = Tracer->ResolvePinValueRecursive(ArrayPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
+    FString IndexStr = Tracer->ResolvePinValueRecursive(IndexPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
 
     // Check if array string is a simple variable or needs wrapping for clarity
     static const FRegexPattern SimpleVarPattern(TEXT("^<span class=\"bp-var\">`[a-zAOL-Z_][a-zA-Z0-9_ ]*`</span>$")); // Corrected regex for variable names
@@ -135,17 +123,11 @@ FString FNodeTraceHandlers_Arrays::HandleGetArrayItem(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Arrays::HandleCallArrayFunction(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("CallArrayFunction")); check(Tracer); check(OutputPin.IsValid());
@@ -156,8 +138,8 @@ FString FNodeTraceHandlers_Arrays::HandleCallArrayFunction(
 
     // Find Target Array pin
     TSharedPtr<const FBlueprintPin> ArrayPin;
-    for(const auto& Pair : Node->Pins){ if(Pair.Value.IsValid() && Pair.Value->IsInput() && Pair.Value->ContainerType == TEXT("Array")){ ArrayPin = Pair.Value; break; }}
-    FString ArrayStr = ArrayPin.IsValid() ? Tracer->ResolvePinValueRecursive(ArrayPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Array?]"));
+    for(const auto& Pair : Node->Pins){ if(Pair.Value.IsValid() && Pair.Value->IsInput() && Pair.Value->PinContainerType == EPinContainerType::Array){ ArrayPin = Pair.Value; break; }}
+    FString ArrayStr = ArrayPin.IsValid() ? Tracer->ResolvePinValueRecursive(ArrayPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Array?]"));
     
     FString ArrayStrFmt = ArrayStr;
     static const FRegexPattern SimpleVarPattern(TEXT("^<span class=\"bp-var\">`[a-zA-Z_][a-zA-Z0-9_ ]*`</span>$"));
@@ -171,21 +153,21 @@ FString FNodeTraceHandlers_Arrays::HandleCallArrayFunction(
         if (FuncName == TEXT("IsValidIndex")) {
             // --- FIX: Declare and trace IndexStr here ---
             TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Index"));
-            FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Index?]"));
+            FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Index?]"));
             // --- End FIX ---
             return FString::Printf(TEXT("%s.%s(%s)"), *ArrayStrFmt, *FMarkdownSpan::FunctionName(TEXT("IsValidIndex")), *IndexStr);
         }
         if (FuncName == TEXT("Contains")) {
             // --- FIX: Declare and trace ItemStr here ---
             TSharedPtr<const FBlueprintPin> ItemPin = Node->GetPin(TEXT("ItemToFind"));
-            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
+            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
              // --- End FIX ---
             return FString::Printf(TEXT("%s.%s(%s)"), *ArrayStrFmt, *FMarkdownSpan::FunctionName(TEXT("Contains")), *ItemStr);
         }
         if (FuncName == TEXT("Find")) {
             // --- FIX: Declare and trace ItemStr here ---
             TSharedPtr<const FBlueprintPin> ItemPin = Node->GetPin(TEXT("ItemToFind"));
-            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
+            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
             // --- End FIX ---
             return FString::Printf(TEXT("%s.%s(%s)"), *ArrayStrFmt, *FMarkdownSpan::FunctionName(TEXT("Find")), *ItemStr);
         }
@@ -194,7 +176,7 @@ FString FNodeTraceHandlers_Arrays::HandleCallArrayFunction(
         // Fallback for other ReturnValue outputs
         UE_LOG(LogDataTracer, Warning, TEXT("  HandleCallArrayFunction: Using generic ResultOf format for QUERYING function '%s'."), *FuncName);
         TSet<FName> Exclusions; if(ArrayPin.IsValid()) Exclusions.Add(FName(*ArrayPin->Name)); // Exclude Array itself
-        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace);
+        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
         return FMarkdownSpan::Info(TEXT("ResultOf")) + FString::Printf(TEXT("(%s.%s(%s))"), *ArrayStrFmt, *FMarkdownSpan::FunctionName(FString::Printf(TEXT("%s"), *FuncName)), *ArgsStr);
     }
     // --- Handle common MUTATING functions symbolically (when tracing output array) ---
@@ -204,15 +186,15 @@ FString FNodeTraceHandlers_Arrays::HandleCallArrayFunction(
         // Symbolic representation of the *result* of the mutation
         TSet<FName> Exclusions; if(ArrayPin.IsValid()) Exclusions.Add(FName(*ArrayPin->Name));
         Exclusions.Add(FName(*OutputPin->Name)); // Exclude the output pin itself
-        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace);
+        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
         FString FuncNameSpan = FMarkdownSpan::FunctionName(FString::Printf(TEXT("%s"), *FuncName));
 
         // Use more generic "Modified" or "ResultOf" for common mutations
         if (FuncName == TEXT("SetArrayElem")) {
              TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Index"));
              TSharedPtr<const FBlueprintPin> ItemPin = Node->GetPin(TEXT("Item"));
-            FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Idx?]")); // Pass bSymbolicTrace
-            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
+            FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Idx?]")); // Pass bSymbolicTrace
+            FString ItemStr = ItemPin.IsValid() ? Tracer->ResolvePinValueRecursive(ItemPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace) : FMarkdownSpan::Error(TEXT("[?Item?]"));
             return FMarkdownSpan::Info(FString::Printf(TEXT("ResultOf(%s[%s] = %s)"), *ArrayStrFmt, *IndexStr, *ItemStr));
         } else {
             // Generic representation for Add, Remove, Insert, Clear, Resize etc.
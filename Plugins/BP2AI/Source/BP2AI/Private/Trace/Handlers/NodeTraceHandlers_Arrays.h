@@ -25,79 +25,49 @@ struct BP2AI_API FNodeTraceHandlers_Arrays
 {
     /** Handles K2Node_MakeArray */
     static FString HandleMakeArray(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     /** Handles K2Node_GetArrayItem */
     static FString HandleGetArrayItem(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The item output pin
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     // --- ADDED DECLARATION ---
     /** Handles K2Node_CallArrayFunction (general handler) */
     static FString HandleCallArrayFunction(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The specific output pin being traced
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     // --- END ADDED DECLARATION ---
 
 
     /** Handles K2Node_CallArrayFunction (specifically for "Get" which is pure) */
     static FString HandleArrayGet(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     /** Handles K2Node_CallArrayFunction (specifically for "Length" which is pure) */
     static FString HandleArrayLength(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 };
\ No newline at end of file
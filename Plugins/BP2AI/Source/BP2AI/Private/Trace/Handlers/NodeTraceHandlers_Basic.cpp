@@ -15,23 +15,18 @@
 #include "Trace/Utils/MarkdownFormattingUtils.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Logging/BP2AILog.h"
+#include "EdGraphSchema_K2.h"
 
 
 //----------------------------------------------------------------//
 // Basic Handlers
 //----------------------------------------------------------------//
 FString FNodeTraceHandlers_Basic::HandleVariableGet(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("VariableGet"));
@@ -47,7 +42,7 @@ FString FNodeTraceHandlers_Basic::HandleVariableGet(
     if (TargetPin.IsValid() && TargetPin->IsInput() && TargetPin->SourcePinFor.Num() > 0) {
         TSharedPtr<const FBlueprintPin> SourcePin = TargetPin->SourcePinFor[0];
         if (SourcePin.IsValid()) {
-            TSharedPtr<const FBlueprintNode> SourceNode = CurrentNodesMap.FindRef(SourcePin->NodeGuid);
+            TSharedPtr<const FBlueprintNode> SourceNode = TraceContext.CurrentNodesMap.FindRef(SourcePin->GraphNodeGuid);
             // 🆕 ONLY apply our logic to actual variable nodes
             if (SourceNode.IsValid() && SourceNode->NodeType == TEXT("VariableGet")) {
                 const FString* SourceVarNamePtr = SourceNode->RawProperties.Find(TEXT("VariableName"));
@@ -124,7 +119,7 @@ FString FNodeTraceHandlers_Basic::HandleVariableGet(
     // Look for the output pin to get struct type information
     TSharedPtr<const FBlueprintPin> OutputPin_ForStructCheck = Node->GetPin(VarName);
     if (OutputPin_ForStructCheck.IsValid() && 
-        OutputPin_ForStructCheck->Category == TEXT("struct") && 
+        OutputPin_ForStructCheck->PinCategory == UEdGraphSchema_K2::PC_Struct && 
         !OutputPin_ForStructCheck->SubCategoryObject.IsEmpty())
     {
         // Extract clean struct type name from the path
@@ -159,17 +154,11 @@ FString FNodeTraceHandlers_Basic::HandleVariableGet(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Basic::HandleLiteral(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("Literal"));
@@ -187,17 +176,11 @@ FString FNodeTraceHandlers_Basic::HandleLiteral(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Basic::HandleSelf(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
      // Check both NodeType and UEClass as factory might use either
@@ -212,17 +195,11 @@ FString FNodeTraceHandlers_Basic::HandleSelf(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Basic::HandleVariableSet(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // The pin being traced (e.g., Output_Get)
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("VariableSet"));
@@ -249,7 +226,7 @@ FString FNodeTraceHandlers_Basic::HandleVariableSet(
         {
             UE_LOG(LogDataTracer, Verbose, TEXT("  HandleVariableSet: Found input pin %s. Tracing recursively."), *InputValuePin->Name);
             // Call the PUBLIC recursive helper on the tracer instance
-            return Tracer->ResolvePinValueRecursive(InputValuePin, CurrentNodesMap, Depth + 1, VisitedPins);
+            return Tracer->ResolvePinValueRecursive(InputValuePin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
         }
         else
         {
@@ -274,17 +251,11 @@ FString FNodeTraceHandlers_Basic::HandleVariableSet(
 // Function: FNodeTraceHandlers_Basic::HandleTunnel
 
 FString FNodeTraceHandlers_Basic::HandleTunnel(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> PinBeingTraced,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& PinBeingTraced,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode, // Node instance in the *outer* graph that called the graph containing this tunnel
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap, // Node map of the *outer* graph
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext // Context of the graph where THIS tunnel node exists
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("Tunnel"));
@@ -292,11 +263,11 @@ FString FNodeTraceHandlers_Basic::HandleTunnel(
     check(PinBeingTraced.IsValid());
 
     UE_LOG(LogDataTracer, Log, TEXT("  HandleTunnel: Node='%s' (%s), PinBeingTraced='%s' (%s), Direction='%s'. CurrentContext='%s', Symbolic=%d. CallingNode='%s', OuterMapPresent=%s"),
-        *Node->Name, *Node->Guid.Left(8), 
-        *PinBeingTraced->Name, *PinBeingTraced->Id.Left(8), *PinBeingTraced->Direction,
-        *CurrentBlueprintContext, bSymbolicTrace,
-        CallingNode.IsValid() ? *CallingNode->Name : TEXT("None"),
-        OuterNodesMap ? TEXT("Yes") : TEXT("No"));
+        *Node->GetLogName(), *Node->Guid.Left(8), 
+        *PinBeingTraced->Name, *PinBeingTraced->Id.Left(8), PinBeingTraced->GetDirectionString(),
+        *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace,
+        TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->GetLogName() : TEXT("None"),
+        TraceContext.OuterNodesMap ? TEXT("Yes") : TEXT("No"));
 
     if (PinBeingTraced->IsOutput()) // Pin being traced is an OUTPUT pin of THIS tunnel node (i.e., an INPUT tunnel)
     {
@@ -317,7 +288,7 @@ FString FNodeTraceHandlers_Basic::HandleTunnel(
         else
         {
             UE_LOG(LogDataTracer, Log, TEXT("    HandleTunnel (InputTunnel.OutputPin): Pin '%s' NOT in CallSiteArgs. Context: '%s'. Returning symbolic 'ValueFrom(Tunnel.PinName)'."),
-                *PinBeingTraced->Name, *CurrentBlueprintContext);
+                *PinBeingTraced->Name, *TraceContext.CurrentBlueprintContext);
             return FMarkdownSpan::Info(TEXT("ValueFrom")) + FString::Printf(TEXT("(Tunnel.%s)"), *FMarkdownSpan::PinName(FString::Printf(TEXT("%s"), *PinBeingTraced->Name)));
         }
     }
@@ -325,14 +296,14 @@ FString FNodeTraceHandlers_Basic::HandleTunnel(
     {
         // This means we are trying to resolve what value flows INTO an OUTPUT tunnel pin from within its own graph.
         UE_LOG(LogDataTracer, Log, TEXT("    HandleTunnel (OutputTunnel.InputPin): Tracing INPUT pin '%s' on Tunnel '%s'. Looking backwards inside current graph ('%s')."), 
-            *PinBeingTraced->Name, *Node->Name, *CurrentBlueprintContext);
+            *PinBeingTraced->Name, *Node->GetLogName(), *TraceContext.CurrentBlueprintContext);
         if (PinBeingTraced->SourcePinFor.Num() > 0 && PinBeingTraced->SourcePinFor[0].IsValid())
         {
             TSharedPtr<const FBlueprintPin> SourcePinWithinGraph = PinBeingTraced->SourcePinFor[0];
             UE_LOG(LogDataTracer, Log, TEXT("      HandleTunnel: Found internal source pin '%s' on node '%s'. Tracing recursively. Context for RVR: '%s'."),
-                *SourcePinWithinGraph->Name, *SourcePinWithinGraph->NodeGuid.Left(8), *CurrentBlueprintContext);
+                *SourcePinWithinGraph->Name, *SourcePinWithinGraph->NodeGuid.Left(8), *TraceContext.CurrentBlueprintContext);
             // Trace backwards within the current graph (CurrentNodesMap)
-            return Tracer->ResolvePinValueRecursive(SourcePinWithinGraph, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            return Tracer->ResolvePinValueRecursive(SourcePinWithinGraph, Depth + 1, TraceContext);
         }
         else
         {
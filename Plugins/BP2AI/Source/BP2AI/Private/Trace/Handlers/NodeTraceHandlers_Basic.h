@@ -24,49 +24,29 @@ struct BP2AI_API FNodeTraceHandlers_Basic // Using API macro for potential futur
 {
 	/** Handles K2Node_VariableGet. */
 	static FString HandleVariableGet(
-	   TSharedPtr<const FBlueprintNode> Node,
-	   TSharedPtr<const FBlueprintPin> OutputPin,
+	   const TSharedPtr<const FBlueprintNode>& Node,
+	   const TSharedPtr<const FBlueprintPin>& OutputPin,
 	   FMarkdownDataTracer* Tracer,
-	   const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes, // This is CurrentNodesMap
 	   int32 Depth,
-	   TSet<FString>& VisitedPins,
-	   const FBlueprintDataExtractor& DataExtractor,
-	   // --- ADDED MISSING PARAMETERS ---
-	   TSharedPtr<const FBlueprintNode> CallingNode,
-	   const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	   bool bSymbolicTrace,
-	   const FString& CurrentBlueprintContext
-	   // --- END ADDED ---
+	   const FNodeTraceContext& TraceContext
    );
 
 	/** Handles K2Node_Literal. */
 	static FString HandleLiteral(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	/** Handles K2Node_Self. */
 	static FString HandleSelf(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 			/**
@@ -78,34 +58,22 @@ struct BP2AI_API FNodeTraceHandlers_Basic // Using API macro for potential futur
 		
 	/** Handles K2Node_VariableSet (specifically for tracing the Output_Get passthrough). */
 	static FString HandleVariableSet(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin, // The pin being traced (e.g., Output_Get)
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	static FString HandleTunnel(
-		TSharedPtr<const FBlueprintNode> Node,            // The Tunnel node itself
-		TSharedPtr<const FBlueprintPin> PinBeingTraced, // The specific pin on the Tunnel node we are tracing
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& PinBeingTraced,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, // The map for the *current* graph context (could be main graph or sub-graph)
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	// ADDED HANDLERS FOR KNOT AND COMMENT
-	static FString HandleKnot(TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> PinBeingTraced, FMarkdownDataTracer* Tracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins, const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode, const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap, bool bSymbolicTrace);
-	static FString HandleComment(TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> PinBeingTraced, FMarkdownDataTracer* Tracer, const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins, const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode, const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap, bool bSymbolicTrace);
+	static FString HandleKnot(TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> PinBeingTraced, FMarkdownDataTracer* Tracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FResolvedPinKey>& VisitedPins, const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode, const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap, bool bSymbolicTrace);
+	static FString HandleComment(TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> PinBeingTraced, FMarkdownDataTracer* Tracer, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FResolvedPinKey>& VisitedPins, const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode, const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap, bool bSymbolicTrace);
 };
\ No newline at end of file
@@ -15,17 +15,11 @@
 #include "Logging/BP2AILog.h"
 
 FString FNodeTraceHandlers_Composite::HandleCompositeOutputPinValue(
-    TSharedPtr<const FBlueprintNode> Node, // The Composite node
-    TSharedPtr<const FBlueprintPin> OutputPinFromComposite,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPinFromComposite,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& OuterGraphNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractorRef,
-    TSharedPtr<const FBlueprintNode> CallingNodeForOuterArgs,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMapForOuterArgs,
-    bool bSymbolicTrace, // This flag will now more directly control if we do this symbolic representation
-    const FString& OuterGraphContext
+    const FNodeTraceContext& TraceContext
 ) {
     check(Node.IsValid() && Node->NodeType == TEXT("Composite"));
     check(OutputPinFromComposite.IsValid() && OutputPinFromComposite->IsOutput());
@@ -36,14 +30,14 @@ FString FNodeTraceHandlers_Composite::HandleCompositeOutputPinValue(
     // Let's assume for now this handler *always* produces the symbolic output.
     // If conditional deep-tracing is ever needed for Composite outputs, bSymbolicTrace could be used.
 
-    const FString CompositeDisplayName = Node->Name.IsEmpty() ? Node->NodeType : Node->Name.Replace(TEXT("\n"), TEXT(" ")); // Use node name, clean newlines
+    const FString CompositeDisplayName = Node->GetName().IsEmpty() ? Node->NodeType : Node->GetName().Replace(TEXT("\n"), TEXT(" ")); // Use node name, clean newlines
 
     UE_LOG(LogDataTracer, Error, TEXT("HandleCompositeOutputPinValue (SYMBOLIC): Tracing output '%s' of Composite '%s'. OuterContext: '%s'"),
-        *OutputPinFromComposite->Name, *CompositeDisplayName, *OuterGraphContext);
+        *OutputPinFromComposite->Name, *CompositeDisplayName, *TraceContext.CurrentBlueprintContext);
 
     // 1. Resolve Input Arguments of THIS Composite Node itself in the OuterGraphContext
     //    This uses MarkdownFormattingUtils::FormatArgumentsForTrace which internally calls RVR for each arg.
-    TSet<FString> VisitedPinsForArgs; // Fresh set for formatting arguments
+    TSet<FResolvedPinKey> VisitedPinsForArgs; // Fresh set for formatting arguments
     TSet<FName> ExcludePinsForArgs;   // Typically empty or just "self" if relevant for composite node itself
 
     // Call FormatArgumentsForTrace to get a string like "Pin1=Val1, Pin2=Val2"
@@ -55,14 +49,14 @@ FString FNodeTraceHandlers_Composite::HandleCompositeOutputPinValue(
     FString FormattedArgs = MarkdownFormattingUtils::FormatArgumentsForTrace(
         Node,                       // The Composite Node whose inputs we are formatting
         Tracer,
-        OuterGraphNodesMap,         // The map where 'Node' (the Composite) exists
+        TraceContext.CurrentNodesMap,         // The map where 'Node' (the Composite) exists
         Depth + 1,                  // Depth for resolving arguments
         VisitedPinsForArgs,
         ExcludePinsForArgs,
         Node,                       // The "calling node" for its own inputs
         nullptr,                    // No "outer-outer" map for these argument resolutions
-        bSymbolicTrace,             // How to trace the arguments themselves
-        OuterGraphContext
+        TraceContext.bSymbolicTrace,             // How to trace the arguments themselves
+        TraceContext.CurrentBlueprintContext
     );
     
     FString ArgsParenthesized = FString::Printf(TEXT("(%s)"), *FormattedArgs);
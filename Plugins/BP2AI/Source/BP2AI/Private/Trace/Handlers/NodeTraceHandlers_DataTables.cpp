@@ -15,19 +15,14 @@
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Engine/DataTable.h"
 #include "Logging/BP2AILog.h"
+#include "EdGraphSchema_K2.h"
 
 FString FNodeTraceHandlers_DataTables::HandleGetDataTableRow(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("GetDataTableRow"));
@@ -35,18 +30,18 @@ FString FNodeTraceHandlers_DataTables::HandleGetDataTableRow(
     check(OutputPin.IsValid());
 
     UE_LOG(LogDataTracer, Error, TEXT("  HandleGetDataTableRow: Node='%s' (GUID:%s), OutputPin='%s' (ID:%s). CtxRecv:'%s', Symbolic:%d, Depth:%d"),
-        *Node->Name, *Node->Guid.Left(8),
+        *Node->GetLogName(), *Node->Guid.Left(8),
         *OutputPin->Name, *OutputPin->Id.Left(8),
-        *CurrentBlueprintContext, bSymbolicTrace, Depth);
+        *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace, Depth);
 
     // 1. Find and trace the 'DataTable' input pin
-    TSharedPtr<const FBlueprintPin> DataTableInputPin = Node->GetPin(TEXT("DataTable"), TEXT("EGPD_Input"));
+    TSharedPtr<const FBlueprintPin> DataTableInputPin = Node->GetPin(TEXT("DataTable"), EGPD_Input);
     FString DataTableNameStr = FMarkdownSpan::Error(TEXT("?DataTable?"));
     if (DataTableInputPin.IsValid())
     {
         UE_LOG(LogDataTracer, Warning, TEXT("    HandleGetDataTableRow: Tracing DataTableInputPin '%s' (ID:%s). DefObj:'%s', Links:%d. CtxToPass:'%s'"),
-            *DataTableInputPin->Name, *DataTableInputPin->Id.Left(8), *DataTableInputPin->DefaultObject, DataTableInputPin->SourcePinFor.Num(), *CurrentBlueprintContext);
-        DataTableNameStr = Tracer->ResolvePinValueRecursive(DataTableInputPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, false, CurrentBlueprintContext);
+            *DataTableInputPin->Name, *DataTableInputPin->Id.Left(8), *DataTableInputPin->DefaultObject, DataTableInputPin->SourcePinFor.Num(), *TraceContext.CurrentBlueprintContext);
+        DataTableNameStr = Tracer->ResolvePinValueRecursive(DataTableInputPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, false, TraceContext.CurrentBlueprintContext);
         UE_LOG(LogDataTracer, Warning, TEXT("    HandleGetDataTableRow: DataTableInputPin resolved to: '%s'"), *DataTableNameStr);
     }
     else
@@ -55,13 +50,13 @@ FString FNodeTraceHandlers_DataTables::HandleGetDataTableRow(
     }
 
     // 2. Find and trace the 'RowName' input pin
-    TSharedPtr<const FBlueprintPin> RowNameInputPin = Node->GetPin(TEXT("RowName"), TEXT("EGPD_Input"));
+    TSharedPtr<const FBlueprintPin> RowNameInputPin = Node->GetPin(TEXT("RowName"), EGPD_Input);
     FString RowNameStr = FMarkdownSpan::Error(TEXT("?RowName?"));
     if (RowNameInputPin.IsValid())
     {
         UE_LOG(LogDataTracer, Warning, TEXT("    HandleGetDataTableRow: Tracing RowNameInputPin '%s' (ID:%s). DefVal:'%s', Links:%d. CtxToPass:'%s', SymbolicForThisTrace:%d"),
-            *RowNameInputPin->Name, *RowNameInputPin->Id.Left(8), *RowNameInputPin->DefaultValue, RowNameInputPin->SourcePinFor.Num(), *CurrentBlueprintContext, bSymbolicTrace);
-        RowNameStr = Tracer->ResolvePinValueRecursive(RowNameInputPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            *RowNameInputPin->Name, *RowNameInputPin->Id.Left(8), *RowNameInputPin->DefaultValue, RowNameInputPin->SourcePinFor.Num(), *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace);
+        RowNameStr = Tracer->ResolvePinValueRecursive(RowNameInputPin, Depth + 1, TraceContext);
         UE_LOG(LogDataTracer, Warning, TEXT("    HandleGetDataTableRow: RowNameInputPin resolved to: '%s'"), *RowNameStr);
     }
     else
@@ -73,12 +68,12 @@ FString FNodeTraceHandlers_DataTables::HandleGetDataTableRow(
     UE_LOG(LogDataTracer, Log, TEXT("    HandleGetDataTableRow: BaseSymbolicRepresentation created: '%s'"), *BaseSymbolicRepresentation);
 
     bool bIsMainStructOutputPin = (OutputPin->Name == TEXT("Out Row"));
-    if (!bIsMainStructOutputPin && OutputPin->Category == TEXT("struct") && !OutputPin->SubCategoryObject.IsEmpty())
+    if (!bIsMainStructOutputPin && OutputPin->PinCategory == UEdGraphSchema_K2::PC_Struct && !OutputPin->SubCategoryObject.IsEmpty())
     {
         bIsMainStructOutputPin = true; // Assuming if it's a struct type output, it's the main one
     }
     
-    if (OutputPin->Category == TEXT("exec")) {
+    if (OutputPin->IsExecution()) {
          UE_LOG(LogDataTracer, Error, TEXT("  HandleGetDataTableRow: Attempting to trace an EXEC pin '%s'. This handler is for DATA pins."), *OutputPin->Name);
          return FMarkdownSpan::Error(TEXT("[Tracing Exec Pin on GetDataTableRow]"));
     }
@@ -23,17 +23,11 @@ struct BP2AI_API FNodeTraceHandlers_DataTables
 {
 	/** Handles K2Node_GetDataTableRow */
 	static FString HandleGetDataTableRow(
-		TSharedPtr<const FBlueprintNode> Node,      // The GetDataTableRow node
-		TSharedPtr<const FBlueprintPin> OutputPin, // The specific pin on this node whose value we want
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	// Add other data-related handlers here in the future (e.g., CurveTable)
@@ -23,17 +23,12 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Delegates::HandleDelegate(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext)
+	const FNodeTraceContext& TraceContext
+)
 {
     check(Node.IsValid() && Node->NodeType == TEXT("CreateDelegate"));
     check(Tracer);
@@ -48,7 +43,7 @@ FString FNodeTraceHandlers_Delegates::HandleDelegate(
     FString FunctionNameStr;
     if (FuncNamePin.IsValid() && FuncNamePin->SourcePinFor.Num() > 0)
     {
-        FunctionNameStr = Tracer->ResolvePinValueRecursive(FuncNamePin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+        FunctionNameStr = Tracer->ResolvePinValueRecursive(FuncNamePin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
     }
     else
     {
@@ -57,7 +52,7 @@ FString FNodeTraceHandlers_Delegates::HandleDelegate(
     }
 
     // Trace the target object pin
-    FString TargetObjectStr = Tracer->ResolvePinValueRecursive(ObjectPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+    FString TargetObjectStr = Tracer->ResolvePinValueRecursive(ObjectPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
 
     FString Result = FMarkdownSpan::Keyword(TEXT("Delegate")) + FString::Printf(TEXT("(%s %s %s)"),
         *FunctionNameStr,
@@ -71,17 +66,11 @@ FString FNodeTraceHandlers_Delegates::HandleDelegate(
 
 
 FString FNodeTraceHandlers_Delegates::HandleCreateDelegate(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, // Added parameter
-    TSharedPtr<const FBlueprintNode> CallingNode,   // Added parameter
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap // Added parameter
-    , bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("CreateDelegate"));
@@ -98,7 +87,7 @@ FString FNodeTraceHandlers_Delegates::HandleCreateDelegate(
     if (FuncNameInputPin.IsValid() && FuncNameInputPin->SourcePinFor.Num() > 0)
     {
         // Pass the context when resolving
-        FunctionNameStr = Tracer->ResolvePinValueRecursive(FuncNameInputPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+        FunctionNameStr = Tracer->ResolvePinValueRecursive(FuncNameInputPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
     }
     else
     {
@@ -108,7 +97,7 @@ FString FNodeTraceHandlers_Delegates::HandleCreateDelegate(
     }
 
     // Trace the target object pin using the current context
-    FString TargetStr = ObjectPin.IsValid() ? Tracer->ResolvePinValueRecursive(ObjectPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Variable(TEXT("self"));
+    FString TargetStr = ObjectPin.IsValid() ? Tracer->ResolvePinValueRecursive(ObjectPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Variable(TEXT("self"));
 
     FString Result = FMarkdownSpan::Keyword(TEXT("Delegate")) + FString::Printf(TEXT("(%s %s %s)"),
         *FunctionNameStr,
@@ -23,30 +23,18 @@ struct BP2AI_API FNodeTraceHandlers_Delegates
 {
 	/** Handles K2Node_CreateDelegate */
 	static FString HandleDelegate(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 	static FString HandleCreateDelegate(
-		   TSharedPtr<const FBlueprintNode> Node,
-		   TSharedPtr<const FBlueprintPin> OutputPin, // The delegate output pin
+		   const TSharedPtr<const FBlueprintNode>& Node,
+		   const TSharedPtr<const FBlueprintPin>& OutputPin,
 		   FMarkdownDataTracer* Tracer,
-		   const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		   int32 Depth,
-		   TSet<FString>& VisitedPins,
-		   const FBlueprintDataExtractor& DataExtractor,
-		   TSharedPtr<const FBlueprintNode> CallingNode,
-		   const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		   bool bSymbolicTrace,
-		   const FString& CurrentBlueprintContext
+		   const FNodeTraceContext& TraceContext
 	   );
 
 	
@@ -15,6 +15,7 @@
 #include "Trace/Utils/MarkdownFormattingUtils.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Logging/BP2AILog.h"
+#include "EdGraphSchema_K2.h"
 
 
 //----------------------------------------------------------------//
@@ -22,17 +23,11 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Enums::HandleEnumComparison(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid()); check(Tracer); check(OutputPin.IsValid());
@@ -47,7 +42,7 @@ FString FNodeTraceHandlers_Enums::HandleEnumComparison(
         if(Pair.Value.IsValid() && Pair.Value->IsInput() && !Pair.Value->IsHidden())
         {
              // Check category is byte or subcategory looks like enum
-             if (Pair.Value->Category == TEXT("byte") || (!Pair.Value->SubCategoryObject.IsEmpty() && Pair.Value->SubCategoryObject.Contains(TEXT("Enum"))))
+             if (Pair.Value->PinCategory == UEdGraphSchema_K2::PC_Byte || (!Pair.Value->SubCategoryObject.IsEmpty() && Pair.Value->SubCategoryObject.Contains(TEXT("Enum"))))
              {
                  if (FoundPins == 0) PinA = Pair.Value;
                  else if (FoundPins == 1) PinB = Pair.Value;
@@ -62,8 +57,8 @@ FString FNodeTraceHandlers_Enums::HandleEnumComparison(
         return FMarkdownSpan::Error(TEXT("[Enum Comp Inputs Missing]"));
     }
 
-    FString ValueA = Tracer->ResolvePinValueRecursive(PinA, CurrentNodesMap, Depth + 1, VisitedPins);
-    FString ValueB = Tracer->ResolvePinValueRecursive(PinB, CurrentNodesMap, Depth + 1, VisitedPins);
+    FString ValueA = Tracer->ResolvePinValueRecursive(PinA, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
+    FString ValueB = Tracer->ResolvePinValueRecursive(PinB, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
 
     FString OpSymbol = (Node->NodeType == TEXT("EnumEquality")) ? TEXT("==") : TEXT("!=");
     FString Result = FString::Printf(TEXT("(%s %s %s)"), *ValueA, *FMarkdownSpan::Operator(OpSymbol), *ValueB);
@@ -75,17 +70,11 @@ FString FNodeTraceHandlers_Enums::HandleEnumComparison(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Enums::HandleCastByteToEnum(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("CastByteToEnum")); check(Tracer); check(OutputPin.IsValid());
@@ -94,7 +83,7 @@ FString FNodeTraceHandlers_Enums::HandleCastByteToEnum(
     TSharedPtr<const FBlueprintPin> BytePin = Node->GetPin(TEXT("Byte"));
     if (!BytePin.IsValid()) { UE_LOG(LogDataTracer, Warning, TEXT("  HandleCastByteToEnum: Missing Byte input pin.")); return FMarkdownSpan::Error(TEXT("[CastByteToEnum Input Missing]")); }
 
-    FString ByteValue = Tracer->ResolvePinValueRecursive(BytePin, CurrentNodesMap, Depth + 1, VisitedPins);
+    FString ByteValue = Tracer->ResolvePinValueRecursive(BytePin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
 
     FString EnumTypeName = MarkdownTracerUtils::ExtractSimpleNameFromPath(OutputPin->SubCategoryObject);
     if (EnumTypeName.IsEmpty()) EnumTypeName = TEXT("Enum?");
@@ -106,17 +95,11 @@ FString FNodeTraceHandlers_Enums::HandleCastByteToEnum(
 
 
 FString FNodeTraceHandlers_Enums::HandleEnumLiteral(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("EnumLiteral")); check(Tracer); check(OutputPin.IsValid());
@@ -134,17 +117,11 @@ FString FNodeTraceHandlers_Enums::HandleEnumLiteral(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Enums::HandleSwitchEnum(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     // Implementation of HandleSwitchEnum function
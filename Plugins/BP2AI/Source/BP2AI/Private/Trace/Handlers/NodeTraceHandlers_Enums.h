@@ -24,63 +24,37 @@ struct BP2AI_API FNodeTraceHandlers_Enums
 {
 	/** Handles K2Node_EnumEquality and K2Node_EnumInequality */
 	static FString HandleEnumComparison(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin, // ReturnValue (bool)
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
-
+		const FNodeTraceContext& TraceContext
 	);
 
 	/** Handles K2Node_CastByteToEnum */
 	static FString HandleCastByteToEnum(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin, // Enum output pin
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
-
+		const FNodeTraceContext& TraceContext
 	);
 
 	/** Handles K2Node_EnumLiteral */
 	static FString HandleEnumLiteral(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	/** Handles K2Node_SwitchEnum */
 	static FString HandleSwitchEnum(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 };
\ No newline at end of file
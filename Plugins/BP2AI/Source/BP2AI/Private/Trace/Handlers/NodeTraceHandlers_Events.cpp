@@ -21,18 +21,12 @@
 // Event Handlers
 //----------------------------------------------------------------//
 
-FString FNodeTraceHandlers_Events::HandleEventOutputParam( // Renamed from HandleEvent
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+FString FNodeTraceHandlers_Events::HandleEventOutputParam(
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 	)
 {
     check(Node.IsValid());
@@ -53,24 +47,24 @@ FString FNodeTraceHandlers_Events::HandleEventOutputParam( // Renamed from Handl
         FString OwnerClassName = OwnerClassPathPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(*OwnerClassPathPtr) : TEXT("Owner");
         
         FString DelegateSignatureName = TEXT("UnknownDelegate");
-        if (!Node->Name.IsEmpty())
+        if (!Node->GetName().IsEmpty())
         {
-             int32 ParenPos = Node->Name.Find(TEXT("("));
+             int32 ParenPos = Node->GetName().Find(TEXT("("));
              if (ParenPos != INDEX_NONE)
              {
-                 DelegateSignatureName = Node->Name.Left(ParenPos).TrimEnd();
+                 DelegateSignatureName = Node->GetName().Left(ParenPos).TrimEnd();
                  if (DelegateSignatureName.Equals(TEXT("ComponentBeginOverlapSignature__DelegateSignature"), ESearchCase::IgnoreCase)) { DelegateSignatureName = TEXT("OnComponentBeginOverlap"); }
                  else if (DelegateSignatureName.Equals(TEXT("ComponentEndOverlapSignature__DelegateSignature"), ESearchCase::IgnoreCase)) { DelegateSignatureName = TEXT("OnComponentEndOverlap"); }
                  else if (DelegateSignatureName.Equals(TEXT("ComponentHitSignature__DelegateSignature"), ESearchCase::IgnoreCase)) { DelegateSignatureName = TEXT("OnComponentHit"); }
                  else if (DelegateSignatureName.Equals(TEXT("ComponentEndTouchOverSignature__DelegateSignature"), ESearchCase::IgnoreCase)) { DelegateSignatureName = TEXT("OnInputTouchLeave"); }
              }
-             else { DelegateSignatureName = Node->Name; }
-             UE_LOG(LogDataTracer, Log, TEXT("  HandleEventOutputParam (CompBound): Parsed DelegateSignatureName='%s' from Node->Name='%s'"), *DelegateSignatureName, *Node->Name);
+             else { DelegateSignatureName = Node->GetName(); }
+             UE_LOG(LogDataTracer, Log, TEXT("  HandleEventOutputParam (CompBound): Parsed DelegateSignatureName='%s' from Node->Name='%s'"), *DelegateSignatureName, *Node->GetLogName());
         }
          else {
               const FString* DelegateNamePropPtr = Node->RawProperties.Find(TEXT("DelegatePropertyName"));
               DelegateSignatureName = DelegateNamePropPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(**DelegateNamePropPtr) : TEXT("UnknownDelegate");
-              UE_LOG(LogDataTracer, Warning, TEXT("  HandleEventOutputParam (CompBound): Node->Name is empty, falling back to DelegatePropertyName: '%s'"), *DelegateSignatureName);
+              UE_LOG(LogDataTracer, Warning, TEXT("  HandleEventOutputParam (CompBound): Node->GetLogName() is empty, falling back to DelegatePropertyName: '%s'"), *DelegateSignatureName);
          }
         
         EventQualifier = FString::Printf(TEXT(" (%s on %s)"),
@@ -82,17 +76,17 @@ FString FNodeTraceHandlers_Events::HandleEventOutputParam( // Renamed from Handl
     else if (Node->NodeType == TEXT("ActorBoundEvent"))
     {
          FString DelegateSignatureName = TEXT("UnknownDelegate");
-         if (!Node->Name.IsEmpty())
+         if (!Node->GetName().IsEmpty())
          {
-              int32 ParenPos = Node->Name.Find(TEXT("("));
-              if (ParenPos != INDEX_NONE) { DelegateSignatureName = Node->Name.Left(ParenPos).TrimEnd(); }
-              else { DelegateSignatureName = Node->Name; }
-              UE_LOG(LogDataTracer, Log, TEXT("  HandleEventOutputParam (ActorBound): Parsed DelegateSignatureName='%s' from Node->Name='%s'"), *DelegateSignatureName, *Node->Name);
+              int32 ParenPos = Node->GetName().Find(TEXT("("));
+              if (ParenPos != INDEX_NONE) { DelegateSignatureName = Node->GetName().Left(ParenPos).TrimEnd(); }
+              else { DelegateSignatureName = Node->GetName(); }
+              UE_LOG(LogDataTracer, Log, TEXT("  HandleEventOutputParam (ActorBound): Parsed DelegateSignatureName='%s' from Node->Name='%s'"), *DelegateSignatureName, *Node->GetLogName());
          }
           else {
               const FString* DelegateNamePropPtr = Node->RawProperties.Find(TEXT("DelegatePropertyName"));
               DelegateSignatureName = DelegateNamePropPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(**DelegateNamePropPtr) : TEXT("UnknownDelegate");
-              UE_LOG(LogDataTracer, Warning, TEXT("  HandleEventOutputParam (ActorBound): Node->Name is empty, falling back to DelegatePropertyName: '%s'"), *DelegateSignatureName);
+              UE_LOG(LogDataTracer, Warning, TEXT("  HandleEventOutputParam (ActorBound): Node->GetLogName() is empty, falling back to DelegatePropertyName: '%s'"), *DelegateSignatureName);
          }
          EventQualifier = TEXT(" (Actor Bound)");
          EventName = FMarkdownSpan::DelegateName(FString::Printf(TEXT("%s"), *DelegateSignatureName));
@@ -113,7 +107,7 @@ FString FNodeTraceHandlers_Events::HandleEventOutputParam( // Renamed from Handl
         }
         else if (AxisNamePtr && !AxisNamePtr->IsEmpty()) { EventName = *AxisNamePtr; }
         else if (KeyNamePtr && !KeyNamePtr->IsEmpty()) { EventName = MarkdownTracerUtils::ExtractSimpleNameFromPath(*KeyNamePtr); }
-        else if (!Node->Name.IsEmpty()) { EventName = Node->Name; }
+        else if (!Node->GetName().IsEmpty()) { EventName = Node->GetName(); }
         else { EventName = Node->NodeType; }
 
         if(EventName == TEXT("ReceiveBeginPlay")) EventName = TEXT("BeginPlay");
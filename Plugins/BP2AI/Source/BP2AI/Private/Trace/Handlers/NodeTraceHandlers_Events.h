@@ -28,16 +28,10 @@ struct BP2AI_API FNodeTraceHandlers_Events
 	 * This is the function registered in FMarkdownDataTracer.
 	 */
 	static FString HandleEventOutputParam(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin,
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 };
@@ -21,17 +21,11 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_FlowControl::HandleSelect(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 	)
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("Select"));
@@ -43,7 +37,7 @@ FString FNodeTraceHandlers_FlowControl::HandleSelect(
 	TSharedPtr<const FBlueprintPin> IndexPin = Node->GetPin(TEXT("Index"));
 	if (!IndexPin.IsValid()) { IndexPin = Node->GetPin(TEXT("Condition")); } // Fallback for boolean select
 
-	FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Index?]"));
+	FString IndexStr = IndexPin.IsValid() ? Tracer->ResolvePinValueRecursive(IndexPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Index?]"));
 
 	// Collect all non-trivial option input pins (e.g., "Option 0", "Option 1", or named pins like "True", "False").
 	TArray<FString> OptionStrings;
@@ -57,7 +51,7 @@ FString FNodeTraceHandlers_FlowControl::HandleSelect(
 			 FoundNumberedOptions = true;
 			 // --- Use namespaced utility function ---
 			 if(OptionPin->SourcePinFor.Num() > 0 || !MarkdownTracerUtils::IsTrivialDefault(OptionPin)) {
-				 FString OptionValue = Tracer->ResolvePinValueRecursive(OptionPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+				 FString OptionValue = Tracer->ResolvePinValueRecursive(OptionPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
 				 OptionStrings.Add(FString::Printf(TEXT("%s=%s"), *FMarkdownSpan::ParamName(FString::Printf(TEXT("%s"), *OptionPin->Name)), *OptionValue));
 			 }
 			 OptionIndex++;
@@ -73,7 +67,7 @@ FString FNodeTraceHandlers_FlowControl::HandleSelect(
 				// --- Use namespaced utility function ---
 				if(Pin->SourcePinFor.Num() > 0 || !MarkdownTracerUtils::IsTrivialDefault(Pin)) {
 					// --- CORRECTED: Use CurrentNodesMap and pass context ---
-					FString OptionValue = Tracer->ResolvePinValueRecursive(Pin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+					FString OptionValue = Tracer->ResolvePinValueRecursive(Pin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
 					// --- END CORRECTION ---
 					// Use pin name directly for boolean/enum cases (e.g., True=..., False=..., Forward=...)
 					OptionStrings.Add(FString::Printf(TEXT("%s=%s"), *FMarkdownSpan::ParamName(FString::Printf(TEXT("%s"), *Pin->Name)), *OptionValue));
@@ -24,17 +24,11 @@ struct BP2AI_API FNodeTraceHandlers_FlowControl
 {
 	/** Handles K2Node_Select */
 	static FString HandleSelect(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> OutputPin, // The ReturnValue pin
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& OutputPin,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
+		const FNodeTraceContext& TraceContext
 	);
 
 	// Handlers for Switch, IfThenElse, etc., typically don't produce traceable values
@@ -19,17 +19,11 @@
 
 
 FString FNodeTraceHandlers_FunctionResult::HandleFunctionResult(
-	TSharedPtr<const FBlueprintNode> Node,      // The FunctionResult node
-	TSharedPtr<const FBlueprintPin> OutputPin, // The specific output pin on the Result node being traced
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 	)
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("FunctionResult"));
@@ -39,7 +33,7 @@ FString FNodeTraceHandlers_FunctionResult::HandleFunctionResult(
 
 	// Find the corresponding INPUT pin on this SAME FunctionResult node
 	// (Input pins on the Result node receive data from within the function)
-	TSharedPtr<const FBlueprintPin> CorrespondingInputPin = Node->GetPin(OutputPin->Name, TEXT("EGPD_Input")); // Look for input pin with same name
+	TSharedPtr<const FBlueprintPin> CorrespondingInputPin = Node->GetPin(OutputPin->Name, EGPD_Input); // Look for input pin with same name
 
 	if (!CorrespondingInputPin.IsValid())
 	{
@@ -51,5 +45,5 @@ FString FNodeTraceHandlers_FunctionResult::HandleFunctionResult(
 	UE_LOG(LogDataTracer, Verbose, TEXT("  HandleFunctionResult: Tracing corresponding input pin '%s' (%s) recursively."), *CorrespondingInputPin->Name, *CorrespondingInputPin->Id);
 	// Use the current 'CurrentNodesMap' map (which is the function's graph context)
 	// Increment depth as we trace backwards from the input pin
-	return Tracer->ResolvePinValueRecursive(CorrespondingInputPin, CurrentNodesMap, Depth + 1, VisitedPins);
+	return Tracer->ResolvePinValueRecursive(CorrespondingInputPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
 }
\ No newline at end of file
@@ -40,32 +40,6 @@ namespace { // Anonymous namespace for local helper
         return FString::Printf(TEXT("(%s).%s"), *BaseCall, *FMarkdownSpan::PinName(FString::Printf(TEXT("%s"), *OutputPin->Name)));
     }
 
-    bool IsUserDefinedFunction(const FString& ClassPath, const FString& FunctionName)
-    {
-        UClass* OwnerClass = FindObject<UClass>(nullptr, *ClassPath);
-        if (!OwnerClass) 
-        {
-            return false; // Fallback to existing path-based logic
-        }
-        
-        UFunction* Function = OwnerClass->FindFunctionByName(FName(*FunctionName));
-        if (!Function) 
-        {
-            return false; // Fallback to existing path-based logic
-        }
-        
-        // Same Blueprint ownership logic as Helper_CheckCallFunctionType
-        UObject* FunctionActualOuter = Function->GetOuter();
-        UBlueprint* FunctionDefiningBP = Cast<UBlueprint>(FunctionActualOuter);
-        if (!FunctionDefiningBP && FunctionActualOuter && FunctionActualOuter->IsA<UBlueprintGeneratedClass>()) 
-        {
-            FunctionDefiningBP = Cast<UBlueprint>(Cast<UBlueprintGeneratedClass>(FunctionActualOuter)->ClassGeneratedBy);
-        }
-        
-        // If a Blueprint defines this function, it's user-defined
-        return FunctionDefiningBP != nullptr;
-    }
-
     
 }
 //----------------------------------------------------------------//
@@ -74,24 +48,18 @@ namespace { // Anonymous namespace for local helper
 
 // Located in Private/Trace/Handlers/NodeTraceHandlers_Functions.cpp
 FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
-    TSharedPtr<const FBlueprintNode> Node, 
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, 
-    TSharedPtr<const FBlueprintNode> CurrentCallingNode, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* CurrentOuterNodesMap, 
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Tracer);
     check(Node.IsValid() && (Node->NodeType == TEXT("CallFunction") || Node->NodeType == TEXT("CallParentFunction")));
     check(OutputPin.IsValid());
 
-    UE_LOG(LogDataTracer, Verbose, TEXT("    FormatPureFunctionCall_Internal: Node %s (%s), Pin %s, Symbolic=%d, Context='%s'"), *Node->Name, *Node->Guid, *OutputPin->Name, bSymbolicTrace, *CurrentBlueprintContext);
+    UE_LOG(LogDataTracer, Verbose, TEXT("    FormatPureFunctionCall_Internal: Node %s (%s), Pin %s, Symbolic=%d, Context='%s'"), *Node->GetLogName(), *Node->Guid, *OutputPin->Name, TraceContext.bSymbolicTrace, *TraceContext.CurrentBlueprintContext);
 
     const FString* FuncNamePtr = Node->RawProperties.Find(TEXT("FunctionName"));
     if (!FuncNamePtr && Node->NodeType == TEXT("CallParentFunction")) { 
@@ -103,7 +71,7 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
     for(const auto& Pair : Node->Pins) { if(Pair.Value.IsValid() && Pair.Value->IsInput() && (Pair.Value->Name == TEXT("self") || Pair.Value->Name == TEXT("Target"))) { TargetPin = Pair.Value; break; } }
     
     // TraceTargetPin now returns TEXT("") if the prefix should be omitted.
-    FString TargetStr = Tracer->TraceTargetPin(TargetPin, CurrentNodesMap, 0, VisitedPins, CurrentBlueprintContext); 
+    FString TargetStr = Tracer->TraceTargetPin(TargetPin, TraceContext.CurrentNodesMap, 0, TraceContext.VisitedPins, TraceContext.CurrentBlueprintContext); 
 
     FString CallPrefix = TEXT("");
     // If TargetStr is not empty and not 'self', it's a target that needs to be prefixed (and is already formatted).
@@ -119,7 +87,7 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
     
     TSet<FName> Exclusions; if (TargetPin.IsValid()) { Exclusions.Add(FName(*TargetPin->Name)); }
     
-    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext); 
+    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext); 
 
     FString FuncNameSpan = FMarkdownSpan::FunctionName(FString::Printf(TEXT("%s"), *FuncName));
     FString BaseCall = FString::Printf(TEXT("%s%s(%s)"), *CallPrefix, *FuncNameSpan, *ArgsStr);
@@ -129,7 +97,7 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
     {
         TSharedPtr<const FBlueprintPin> ValuePin = Node->GetPin(TEXT("Value")); 
         if (ValuePin.IsValid()) {
-            FString ContainerValueStr = Tracer->ResolvePinValueRecursive(ValuePin, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            FString ContainerValueStr = Tracer->ResolvePinValueRecursive(ValuePin, Depth + 1, TraceContext);
             UE_LOG(LogDataTracer, Log, TEXT("      FormatPureFunctionCall_Internal (MakeLiteralGameplayTagContainer): Returning directly traced input 'Value' pin string: '%s'"), *ContainerValueStr);
             return ContainerValueStr; 
         } else { 
@@ -137,20 +105,20 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
             return BaseCall; 
         }
     }
-    if (FuncName == TEXT("Concat_StrStr") || Node->Name == TEXT("Append"))
+    if (FuncName == TEXT("Concat_StrStr") || Node->GetName() == TEXT("Append"))
     {
         TArray<FString> InputValues; TArray<TSharedPtr<const FBlueprintPin>> InputPinsForConcat;
         for (const auto& Pair : Node->Pins) { if (Pair.Value.IsValid() && Pair.Value->IsInput() && !Pair.Value->IsExecution() && !Pair.Value->IsHidden()) { InputPinsForConcat.Add(Pair.Value); } }
         InputPinsForConcat.Sort([](const auto& PinA, const auto& PinB) { return PinA->Name < PinB->Name; });
         for (const auto& Pin : InputPinsForConcat) {
-            InputValues.Add(Tracer->ResolvePinValueRecursive(Pin, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext));
+            InputValues.Add(Tracer->ResolvePinValueRecursive(Pin, Depth + 1, TraceContext));
         }
         if (InputValues.Num() > 0) { FString PlusOperator = FMarkdownSpan::Operator(Tracer->GetMathOperatorMap().FindRef(TEXT("Add"))); FString JoinedValues = FString::Join(InputValues, *FString::Printf(TEXT(" %s "), *PlusOperator)); return (InputValues.Num() > 1) ? FString::Printf(TEXT("(%s)"), *JoinedValues) : InputValues[0]; }
         else { return FMarkdownSpan::FunctionName(TEXT("Concat")) + TEXT("()"); }
     }
     if (FuncName == TEXT("Len")) {
         TSharedPtr<const FBlueprintPin> StrPin = Node->GetPin(TEXT("S")); if(!StrPin.IsValid()) StrPin = Node->GetPin(TEXT("SourceString"));
-        FString StrValue = StrPin.IsValid() ? Tracer->ResolvePinValueRecursive(StrPin, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext) : FMarkdownSpan::Error(TEXT("?String?"));
+        FString StrValue = StrPin.IsValid() ? Tracer->ResolvePinValueRecursive(StrPin, Depth + 1, TraceContext) : FMarkdownSpan::Error(TEXT("?String?"));
         return FMarkdownSpan::FunctionName(TEXT("Len")) + FString::Printf(TEXT("(%s)"), *StrValue);
     }
     if (FuncName.StartsWith(TEXT("Select")) &&
@@ -169,9 +137,9 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
         if (!PinCond.IsValid()) { PinCond = Node->GetPin(TEXT("Index")); } 
 
         if (PinA.IsValid() && PinB.IsValid() && PinCond.IsValid()) {
-           FString ValueA = Tracer->ResolvePinValueRecursive(PinA, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
-           FString ValueB = Tracer->ResolvePinValueRecursive(PinB, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
-           FString ValueCond = Tracer->ResolvePinValueRecursive(PinCond, CurrentNodesMap, Depth + 1, VisitedPins, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+           FString ValueA = Tracer->ResolvePinValueRecursive(PinA, Depth + 1, TraceContext);
+           FString ValueB = Tracer->ResolvePinValueRecursive(PinB, Depth + 1, TraceContext);
+           FString ValueCond = Tracer->ResolvePinValueRecursive(PinCond, Depth + 1, TraceContext);
            FString TernaryResult = FString::Printf(TEXT("(%s %s %s %s %s)"), *ValueCond, *FMarkdownSpan::Operator(TEXT("?")), *ValueA, *FMarkdownSpan::Operator(TEXT(":")), *ValueB);
            return TernaryResult;
        } 
@@ -183,32 +151,26 @@ FString FNodeTraceHandlers_Functions::FormatPureFunctionCall_Internal(
 }
 
 FString FNodeTraceHandlers_Functions::FormatPureMacroCall_Internal(
-    TSharedPtr<const FBlueprintNode> Node, 
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CurrentCallingNode, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* CurrentOuterNodesMap, 
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext 
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Tracer);
     check(Node.IsValid() && Node->NodeType == TEXT("MacroInstance"));
     check(OutputPin.IsValid());
 
-    UE_LOG(LogDataTracer, Verbose, TEXT("    FormatPureMacroCall_Internal: Node %s (%s), Pin %s, Symbolic=%d, Context='%s'"), *Node->Name, *Node->Guid, *OutputPin->Name, bSymbolicTrace, *CurrentBlueprintContext);
+    UE_LOG(LogDataTracer, Verbose, TEXT("    FormatPureMacroCall_Internal: Node %s (%s), Pin %s, Symbolic=%d, Context='%s'"), *Node->GetLogName(), *Node->Guid, *OutputPin->Name, TraceContext.bSymbolicTrace, *TraceContext.CurrentBlueprintContext);
 
     const FString* MacroPathPtr = Node->RawProperties.Find(TEXT("MacroGraphReference"));
-    FString SimpleMacroName = MacroPathPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(**MacroPathPtr, CurrentBlueprintContext) : TEXT("PureMacro"); 
+    FString SimpleMacroName = MacroPathPtr ? MarkdownTracerUtils::ExtractSimpleNameFromPath(**MacroPathPtr, TraceContext.CurrentBlueprintContext) : TEXT("PureMacro"); 
     if (SimpleMacroName.IsEmpty()) SimpleMacroName = TEXT("PureMacro");
 
-    UE_LOG(LogDataTracer, Verbose, TEXT("      FormatPureMacroCall_Internal: Default formatting for pure macro %s. Context: '%s'"), *SimpleMacroName, *CurrentBlueprintContext);
+    UE_LOG(LogDataTracer, Verbose, TEXT("      FormatPureMacroCall_Internal: Default formatting for pure macro %s. Context: '%s'"), *SimpleMacroName, *TraceContext.CurrentBlueprintContext);
     TSet<FName> Exclusions; 
-    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CurrentCallingNode, CurrentOuterNodesMap, bSymbolicTrace, CurrentBlueprintContext); 
+    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext); 
 
     FString MacroNameSpan = FMarkdownSpan::MacroName(FString::Printf(TEXT("`%s"), *SimpleMacroName));
     FString BaseCall = FString::Printf(TEXT("%s(%s)"), *MacroNameSpan, *ArgsStr);
@@ -231,17 +193,11 @@ FString FNodeTraceHandlers_Functions::FormatPureMacroCall_Internal(
 
 
 FString FNodeTraceHandlers_Functions::HandleCallFunction(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && (Node->NodeType == TEXT("CallFunction") || Node->NodeType == TEXT("CallParentFunction")));
@@ -260,7 +216,7 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
     // --- 2. Handle Type Conversions → Function Formatting ---
     if (FuncName.StartsWith(TEXT("Conv_")) || FuncName.StartsWith(TEXT("To")))
     {
-        return FormatPureFunctionCall_Internal(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, DataExtractor, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+        return FormatPureFunctionCall_Internal(Node, OutputPin, Tracer, Depth, TraceContext);
     }
 
     // --- 3. Handle Math/String/Text Operators → Operator Formatting ---
@@ -272,11 +228,11 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
         // *** ADD THIS: Check if it's a unary operator ***
         if (FuncName == TEXT("Not_PreBool") || BaseOperationName == TEXT("Not"))
         {
-            return MarkdownFormattingUtils::FormatUnaryOperator(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            return MarkdownFormattingUtils::FormatUnaryOperator(Node, OutputPin, Tracer, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
         }
     
         // Otherwise use binary operator formatting
-        return MarkdownFormattingUtils::FormatOperator(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+        return MarkdownFormattingUtils::FormatOperator(Node, OutputPin, Tracer, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
     }
     
     // --- 3. Determine if it's a linkable user function ---
@@ -291,18 +247,12 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
         if (!ParentClassPathFromProps->StartsWith(TEXT("/Script/")) && 
             !ParentClassPathFromProps->StartsWith(TEXT("/Engine/")))
         {
-            // Add new: Blueprint ownership check
-            if (IsUserDefinedFunction(*ParentClassPathFromProps, FuncName))
+            // Blueprint ownership check（批量导出时已在捕获阶段解析，见 FMarkdownPathTracer::CaptureNodeReferences）
+            const FString DefiningAssetPath = FMarkdownPathTracer::ResolveUserFunctionAssetPath(*Node);
+            if (!DefiningAssetPath.IsEmpty())
             {
                 bShouldGenerateSymbolicLink = true;
             
-                // ... rest of existing anchor generation code stays the same
-                FString DefiningAssetPath = **ParentClassPathFromProps;
-                UClass* TempClass = FindObject<UClass>(nullptr, *DefiningAssetPath);
-                if (TempClass && TempClass->ClassGeneratedBy && TempClass->ClassGeneratedBy->IsA<UBlueprint>())
-                {
-                    DefiningAssetPath = TempClass->ClassGeneratedBy->GetPathName();
-                }
                 FString BlueprintNameForHint = FPaths::GetBaseFilename(DefiningAssetPath);
                 if (BlueprintNameForHint.EndsWith(TEXT("_C")))
                 {
@@ -313,7 +263,7 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
                 AnchorKey = FMarkdownPathTracer::SanitizeAnchorName(ReconstructedUniqueHint);
                 LinkDisplayName = FuncName;
             }
-            // If IsUserDefinedFunction returns false, bShouldGenerateSymbolicLink stays false
+            // Native functions resolve to an empty path: bShouldGenerateSymbolicLink stays false
         }
         // If path starts with /Script/ or /Engine/, bShouldGenerateSymbolicLink stays false
     }
@@ -326,11 +276,11 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
             break;
         }
     }
-    FString TargetStr = Tracer->TraceTargetPin(TargetPin, CurrentNodesMap, Depth + 1, VisitedPins, CurrentBlueprintContext);
+    FString TargetStr = Tracer->TraceTargetPin(TargetPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CurrentBlueprintContext);
     
     TSet<FName> Exclusions;
     if (TargetPin.IsValid()) Exclusions.Add(FName(*TargetPin->Name));
-    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
     
     // --- 5. Construct the Base Call (Name + Arguments) ---
     FString CallableName;
@@ -339,18 +289,12 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
         // First, format the text that will go inside the link using the established FMarkdownSpan wrapper.
         FString FormattedLinkText = FMarkdownSpan::FunctionName(LinkDisplayName);
 
-        // Now, check the context and build the link tag manually, just like the working code in FMarkdownPathTracer.
-        if (FMarkdownSpanSystem::GetCurrentContext().IsHTML())
-        {
-            // In HTML mode, build the <a> tag.
-            // Note: The text inside the tag is already formatted by FMarkdownSpan, so it might contain spans. We don't escape it again.
-            CallableName = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link function-link\">%s</a>"), *AnchorKey, *FormattedLinkText);
-        }
-        else // RawMarkdown or CleanText
-        {
-            // In Markdown mode, build the [](#) link.
-            CallableName = FString::Printf(TEXT("[%s](#%s)"), *FormattedLinkText, *AnchorKey);
-        }
+        // Now build the link for each format, just like the working code in FMarkdownPathTracer.
+        // HTML: <a> tag. The text inside the tag is already formatted by FMarkdownSpan, so it might contain spans. We don't escape it again.
+        // RawMarkdown or CleanText: [](#) link.
+        CallableName = FMarkdownSpanSystem::FormatSwitch(
+            FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link function-link\">%s</a>"), *AnchorKey, *FormattedLinkText),
+            FString::Printf(TEXT("[%s](#%s)"), *FormattedLinkText, *AnchorKey));
     }
     else
     {
@@ -378,17 +322,11 @@ FString FNodeTraceHandlers_Functions::HandleCallFunction(
 
 // PROVIDE FULL FUNCTION
 FString FNodeTraceHandlers_Functions::HandleCallMacro(
-    TSharedPtr<const FBlueprintNode> Node, 
-    TSharedPtr<const FBlueprintPin> OutputPin, 
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap, 
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext 
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("MacroInstance"));
@@ -400,64 +338,38 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
     const FString* MacroPathPtr = Node->RawProperties.Find(TEXT("MacroGraphReference"));
     FString FullMacroPath = MacroPathPtr ? **MacroPathPtr : FString(TEXT(""));
     
-    FString SimpleMacroName = MarkdownTracerUtils::ExtractSimpleNameFromPath(FullMacroPath, CurrentBlueprintContext);
-    if (SimpleMacroName.IsEmpty()) SimpleMacroName = Node->Name; 
+    FString SimpleMacroName = MarkdownTracerUtils::ExtractSimpleNameFromPath(FullMacroPath, TraceContext.CurrentBlueprintContext);
+    if (SimpleMacroName.IsEmpty()) SimpleMacroName = Node->GetName(); 
     if (SimpleMacroName.IsEmpty()) SimpleMacroName = TEXT("MacroInstance");
 
     UE_LOG(LogDataTracer, Log, TEXT("HandleCallMacro ENTRY: NodeName='%s', SimpleMacroName='%s', OutputPinName='%s', SymbolicTrace=%d, IsPureMacro=%d, FullMacroPath='%s', Context='%s'"), 
-        *Node->Name, *SimpleMacroName, *OutputPin->Name, bSymbolicTrace, bIsPureMacro, *FullMacroPath, *CurrentBlueprintContext);
+        *Node->GetLogName(), *SimpleMacroName, *OutputPin->Name, TraceContext.bSymbolicTrace, bIsPureMacro, *FullMacroPath, *TraceContext.CurrentBlueprintContext);
                                    
     bool bIsStandardEngineMacro = !FullMacroPath.IsEmpty() && 
                                   FullMacroPath.Contains(TEXT("/StandardMacros.StandardMacros"));
 
     bool bIsUserGraph = !FullMacroPath.IsEmpty() && !bIsStandardEngineMacro;
     UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro DETAIL: Node='%s', MacroPath='%s', IsUserGraph=%s, IsPureNode=%s. QueuePtr=%p, ProcessedPathsPtr=%p"),
-    *Node->Name, *FullMacroPath, bIsUserGraph ? TEXT("true") : TEXT("false"), Node->IsPure() ? TEXT("true") : TEXT("false"),
+    *Node->GetLogName(), *FullMacroPath, bIsUserGraph ? TEXT("true") : TEXT("false"), Node->IsPure() ? TEXT("true") : TEXT("false"),
     Tracer->CurrentGraphsToDefineSeparatelyPtr, Tracer->CurrentProcessedSeparateGraphPathsPtr);
 
     
-    if (bIsUserGraph && Tracer->CurrentGraphsToDefineSeparatelyPtr && Tracer->CurrentProcessedSeparateGraphPathsPtr) {
-    UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: Condition (bIsUserGraph && QueuePtr && ProcessedPathsPtr) MET. FullMacroPath for check: '%s'"), *FullMacroPath);
-
-    bool bAlreadyProcessedPath = Tracer->CurrentProcessedSeparateGraphPathsPtr->Contains(FullMacroPath);
-    UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: Check 1: AlreadyProcessedPath ('%s' in ProcessedPathsSet) = %s"), *FullMacroPath, bAlreadyProcessedPath ? TEXT("true") : TEXT("false"));
-
-    if (!bAlreadyProcessedPath) {
-        FString NameForQueueHead = MarkdownTracerUtils::ExtractSimpleNameFromPath(FullMacroPath, TEXT(""));
-        TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType> TupleToAdd(NameForQueueHead, FullMacroPath, FMarkdownPathTracer::EUserGraphType::Macro);
-        
-        bool bTupleAlreadyInQueue = Tracer->CurrentGraphsToDefineSeparatelyPtr->Contains(TupleToAdd);
-        UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: Check 2: TupleAlreadyInQueue ('%s':'%s' in Queue) = %s"), *NameForQueueHead, *FullMacroPath, bTupleAlreadyInQueue ? TEXT("true") : TEXT("false"));
-
-        if (!bTupleAlreadyInQueue)
-        {
-            UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: >>> ADDING TO QUEUE (via DataTracer): Hint='%s', Path='%s', Type=Macro. Current Queue Size BEFORE add: %d"),
-                *NameForQueueHead, *FullMacroPath, Tracer->CurrentGraphsToDefineSeparatelyPtr->Num());
-            Tracer->CurrentGraphsToDefineSeparatelyPtr->Add(TupleToAdd); // AddUnique not needed if checking Contains
-            UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: <<< ADDED TO QUEUE. Current Queue Size AFTER add: %d"), Tracer->CurrentGraphsToDefineSeparatelyPtr->Num());
-        } else {
-            UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: SKIPPED ADDING tuple to queue because it was already present."));
-        }
+    if (bIsUserGraph) {
+        // 经由追踪器登记：跨追踪缓存命中时可以重放同样的登记
+        const FString NameForQueueHead = MarkdownTracerUtils::ExtractSimpleNameFromPath(FullMacroPath, TEXT(""));
+        Tracer->QueueGraphForSeparateDefinition(NameForQueueHead, FullMacroPath, FMarkdownPathTracer::EUserGraphType::Macro);
     } else {
-        UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: SKIPPED ADDING to queue because path was already processed in ProcessedPathsSet."));
+        UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: Main condition for queuing FAILED. Reason: bIsUserGraph=false"));
     }
-} else {
-    FString Reason = FString::Printf(TEXT("bIsUserGraph=%s, QueuePtr Valid=%s, ProcessedPathsPtr Valid=%s"),
-        bIsUserGraph ? TEXT("true") : TEXT("false"),
-        Tracer->CurrentGraphsToDefineSeparatelyPtr ? TEXT("YES") : TEXT("NO (NULL)"),
-        Tracer->CurrentProcessedSeparateGraphPathsPtr ? TEXT("YES") : TEXT("NO (NULL)")
-    );
-    UE_LOG(LogDataTracer, Error, TEXT("HandleCallMacro: Main condition for queuing FAILED. Reason: %s"), *Reason);
-}
     
-    if (bSymbolicTrace && bIsUserGraph) 
+    if (TraceContext.bSymbolicTrace && bIsUserGraph) 
     {
         FString MacroDisplayNameStr = SimpleMacroName; 
-        if (MacroDisplayNameStr.IsEmpty() || MacroDisplayNameStr == TEXT("MacroInstance")) MacroDisplayNameStr = Node->Name;
+        if (MacroDisplayNameStr.IsEmpty() || MacroDisplayNameStr == TEXT("MacroInstance")) MacroDisplayNameStr = Node->GetName();
         if (MacroDisplayNameStr.IsEmpty()) MacroDisplayNameStr = Node->NodeType;
         
         TSet<FName> Exclusions; 
-        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+        FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
 
         FString OutputPinNameStr = OutputPin->Name.IsEmpty() ? TEXT("ReturnValue") : OutputPin->Name;
         FString CallableNameSpan = FMarkdownSpan::MacroName(FString::Printf(TEXT("%s"), *MacroDisplayNameStr));
@@ -476,7 +388,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
         {
             // It's a standard pure macro (e.g., IsValid). Use the original, simple formatting helper.
             UE_LOG(LogDataTracer, Log, TEXT("HandleCallMacro: Detected as PURE STANDARD macro '%s'. Using original formatter."), *SimpleMacroName);
-            return FormatPureMacroCall_Internal(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, DataExtractor, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            return FormatPureMacroCall_Internal(Node, OutputPin, Tracer, Depth, TraceContext);
         }
         else // This is a PURE USER-DEFINED macro. It needs a hyperlink.
         {
@@ -486,7 +398,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
             // This guarantees the anchor name will match the one used for the definition.
             FString UniqueGraphNameHint;
             FString DiscoveredGraphPath;
-            FMarkdownPathTracer PathTracerForHint(*Tracer, const_cast<FBlueprintDataExtractor&>(DataExtractor));
+            FMarkdownPathTracer PathTracerForHint(*Tracer, const_cast<FBlueprintDataExtractor&>(TraceContext.DataExtractor));
             PathTracerForHint.IsInternalUserGraph(Node, DiscoveredGraphPath, UniqueGraphNameHint);
             if (UniqueGraphNameHint.IsEmpty()) UniqueGraphNameHint = SimpleMacroName; // Fallback
 
@@ -498,7 +410,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
 
             // If the macro's context is different from the current graph's context, show the full qualified name.
             // Otherwise, just show the simple name.
-            if (!CurrentBlueprintContext.IsEmpty() && !ContextName.IsEmpty() && !ContextName.Equals(CurrentBlueprintContext, ESearchCase::IgnoreCase))
+            if (!TraceContext.CurrentBlueprintContext.IsEmpty() && !ContextName.IsEmpty() && !ContextName.Equals(TraceContext.CurrentBlueprintContext, ESearchCase::IgnoreCase))
             {
                 // It's from an external library, show the full hint.
                 LinkDisplayName = UniqueGraphNameHint;
@@ -511,20 +423,13 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
             // --- END OF SURGICAL FIX ---
 
             TSet<FName> Exclusions;
-            FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+            FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
 
             // Build the link in a context-aware way.
-            FString CallableName;
-            if (FMarkdownSpanSystem::GetCurrentContext().IsHTML())
-            {
-                FString FormattedLinkText = FMarkdownSpan::MacroName(LinkDisplayName);
-                CallableName = FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link macro-link\">%s</a>"), *AnchorKey, *FormattedLinkText);
-            }
-            else // RawMarkdown or CleanText
-            {
-                FString FormattedLinkText = FMarkdownSpan::MacroName(LinkDisplayName);
-                CallableName = FString::Printf(TEXT("[%s](#%s)"), *FormattedLinkText, *AnchorKey);
-            }
+            FString FormattedLinkText = FMarkdownSpan::MacroName(LinkDisplayName);
+            FString CallableName = FMarkdownSpanSystem::FormatSwitch(
+                FString::Printf(TEXT("<a href=\"#%s\" class=\"graph-link macro-link\">%s</a>"), *AnchorKey, *FormattedLinkText),
+                FString::Printf(TEXT("[%s](#%s)"), *FormattedLinkText, *AnchorKey)); // RawMarkdown or CleanText
             
             FString BaseCall = CallableName + FString::Printf(TEXT("(%s)"), *ArgsStr);
             return ConstructFinalSymbolicString(BaseCall, Node, OutputPin);
@@ -564,7 +469,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
                 // For their symbolic representation, we show MacroName(TracedInput).
                 TSharedPtr<const FBlueprintPin> MainInputPinToTrace = Node->GetPin(TEXT("Value")); 
                 if (MainInputPinToTrace.IsValid()) {
-                     FString TracedInput = Tracer->ResolvePinValueRecursive(MainInputPinToTrace, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, true /*bSymbolicTrace for input*/, CurrentBlueprintContext);
+                     FString TracedInput = Tracer->ResolvePinValueRecursive(MainInputPinToTrace, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, true /*bSymbolicTrace for input*/, TraceContext.CurrentBlueprintContext);
                      ResultStringForStandardMacro = FString::Printf(TEXT("%s(%s)"), *MacroDisplayNameSpan, *TracedInput);
                 } else {
                     ResultStringForStandardMacro = FString::Printf(TEXT("%s(?)"), *MacroDisplayNameSpan); // Input pin not found
@@ -574,7 +479,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
             {
                 TSharedPtr<const FBlueprintPin> MainInputPinToTrace = Node->GetPin(TEXT("Value"));
                 if (MainInputPinToTrace.IsValid()) {
-                    FString TracedInput = Tracer->ResolvePinValueRecursive(MainInputPinToTrace, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, true, CurrentBlueprintContext);
+                    FString TracedInput = Tracer->ResolvePinValueRecursive(MainInputPinToTrace, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, true, TraceContext.CurrentBlueprintContext);
                     ResultStringForStandardMacro = FString::Printf(TEXT("%s(%s)"), *MacroDisplayNameSpan, *TracedInput);
                 } else {
                     ResultStringForStandardMacro = FString::Printf(TEXT("%s(?)"), *MacroDisplayNameSpan);
@@ -590,8 +495,8 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
                     if (!ValuePin.IsValid()) ValuePin = Node->GetPin(TEXT("Amount"));
 
                     if (RefPin.IsValid() && ValuePin.IsValid()) {
-                        FString TracedRef = Tracer->ResolvePinValueRecursive(RefPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, true, CurrentBlueprintContext);
-                        FString TracedValue = Tracer->ResolvePinValueRecursive(ValuePin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, true, CurrentBlueprintContext);
+                        FString TracedRef = Tracer->ResolvePinValueRecursive(RefPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, true, TraceContext.CurrentBlueprintContext);
+                        FString TracedValue = Tracer->ResolvePinValueRecursive(ValuePin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, true, TraceContext.CurrentBlueprintContext);
                         ResultStringForStandardMacro = FString::Printf(TEXT("%s(%s=%s, %s=%s)"), 
                             *MacroDisplayNameSpan, 
                             *FMarkdownSpan::ParamName(FString::Printf(TEXT("%s"),*RefPin->Name)), *TracedRef,
@@ -621,20 +526,20 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
                 return ResultStringForStandardMacro;
             } else {
                  UE_LOG(LogDataTracer, Warning, TEXT("  HandleCallMacro: Standard Exec Macro '%s' (Node: %s) has traceable output pin '%s' but no specific symbolic representation defined above. Falling back to deep trace for value."), 
-                    *SimpleMacroName, *Node->Name, *OutputPin->Name);
+                    *SimpleMacroName, *Node->GetLogName(), *OutputPin->Name);
             }
         }
         
         // Fallback for Non-Pure User Macros OR Unhandled Standard Exec Macros: Deep Trace into definition for actual value
         UE_LOG(LogDataTracer, Log, TEXT("  HandleCallMacro: Fallback for NON-PURE macro '%s' (Node: %s). Attempting deep trace for output pin '%s'. Context: '%s'"), 
-            *SimpleMacroName, *Node->Name, *OutputPin->Name, *CurrentBlueprintContext);
+            *SimpleMacroName, *Node->GetLogName(), *OutputPin->Name, *TraceContext.CurrentBlueprintContext);
 
         if (FullMacroPath.IsEmpty()) { 
             UE_LOG(LogDataTracer, Error, TEXT("  HandleCallMacro (Deep Trace): Macro Path Missing for '%s'"), *SimpleMacroName);
             return FMarkdownSpan::Error(TEXT("[Macro Path Missing]")); 
         }
 
-        TMap<FString, TSharedPtr<FBlueprintNode>> MacroGraphNodes;
+        TMap<FGuid, TSharedPtr<FBlueprintNode>> MacroGraphNodes;
         if (!Tracer->GetDataExtractorRef().ExtractNodesFromGraph(FullMacroPath, MacroGraphNodes)) 
         { 
             UE_LOG(LogDataTracer, Error, TEXT("  HandleCallMacro (Deep Trace): Macro Graph Extraction Failed for '%s' (Path: %s)"), *SimpleMacroName, *FullMacroPath);
@@ -649,7 +554,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
         TSharedPtr<const FBlueprintNode> OutputTunnelNode = nullptr;
         for (const auto& Pair : MacroGraphNodes) {
             if (Pair.Value.IsValid() && Pair.Value->NodeType == TEXT("Tunnel")) {
-                TSharedPtr<FBlueprintPin> TunnelInputPinCheck = Pair.Value->GetPin(OutputPin->Name, TEXT("EGPD_Input")); 
+                TSharedPtr<FBlueprintPin> TunnelInputPinCheck = Pair.Value->GetPin(OutputPin->Name, EGPD_Input); 
                 if (TunnelInputPinCheck != nullptr) { 
                     OutputTunnelNode = Pair.Value;
                     break;
@@ -662,7 +567,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
             return FMarkdownSpan::Error(FString::Printf(TEXT("[Macro Output Tunnel for '%s' Not Found in %s]"), *OutputPin->Name, *SimpleMacroName)); 
         }
         
-        TSharedPtr<const FBlueprintPin> TunnelInputPinToTrace = OutputTunnelNode->GetPin(OutputPin->Name, TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> TunnelInputPinToTrace = OutputTunnelNode->GetPin(OutputPin->Name, EGPD_Input);
 
         if (!TunnelInputPinToTrace.IsValid()) {
              UE_LOG(LogDataTracer, Error, TEXT("  HandleCallMacro (Deep Trace): Tunnel node '%s' found for output '%s', but could not find its corresponding INPUT pin named '%s' in '%s'"), 
@@ -670,7 +575,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
              return FMarkdownSpan::Error(FString::Printf(TEXT("[Macro Tunnel Input '%s' Invalid in %s]"), *OutputPin->Name, *SimpleMacroName));
          }
 
-        TSet<FString> MacroVisitedPins; 
+        TSet<FResolvedPinKey> MacroVisitedPins; 
         FString MacroAssetContext = MarkdownTracerUtils::ExtractSimpleNameFromPath(FullMacroPath, TEXT("")); 
 		if(MacroAssetContext.Contains(TEXT(":"))) MacroAssetContext = MacroAssetContext.Left(MacroAssetContext.Find(TEXT(":")));
         if(MacroAssetContext.IsEmpty()) MacroAssetContext = SimpleMacroName;
@@ -678,7 +583,7 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
         UE_LOG(LogDataTracer, Log, TEXT("    HandleCallMacro (Deep Trace): Tracing into definition of '%s'. TunnelInputPin: '%s'. MacroAssetContext for this trace: '%s'"), 
             *SimpleMacroName, *TunnelInputPinToTrace->Name, *MacroAssetContext);
             
-        return Tracer->ResolvePinValueRecursive(TunnelInputPinToTrace, MacroGraphNodes, Depth + 1, MacroVisitedPins, Node, &CurrentNodesMap, false, MacroAssetContext); 
+        return Tracer->ResolvePinValueRecursive(TunnelInputPinToTrace, MacroGraphNodes, Depth + 1, MacroVisitedPins, Node, &TraceContext.CurrentNodesMap, false, MacroAssetContext); 
     }
 }
 
@@ -686,17 +591,11 @@ FString FNodeTraceHandlers_Functions::HandleCallMacro(
 
 
 FString FNodeTraceHandlers_Functions::HandleFunctionEntryPin(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPinFromEntry,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPinFromEntry,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode, // Expected to be null
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap, // Expected to be null
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext // Context of this function's graph
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("FunctionEntry"));
@@ -704,7 +603,7 @@ FString FNodeTraceHandlers_Functions::HandleFunctionEntryPin(
     check(Tracer);
 
     UE_LOG(LogDataTracer, Log, TEXT("  HandleFunctionEntryPin: Node='%s', OutputPin='%s'. CurrentContext='%s', Symbolic=%d."),
-        *Node->Name, *OutputPinFromEntry->Name, *CurrentBlueprintContext, bSymbolicTrace);
+        *Node->GetLogName(), *OutputPinFromEntry->Name, *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace);
 
     const TMap<FName, FString>* CallSiteArgs = Tracer->GetCurrentCallsiteArguments();
     FName PinNameFName(*OutputPinFromEntry->Name);
@@ -720,7 +619,7 @@ FString FNodeTraceHandlers_Functions::HandleFunctionEntryPin(
     {
         // Fallback: If not in call-site args (e.g., tracing function definition directly),
         // represent as a parameter of the function.
-        FString FunctionNameForDisplay = Node->Name; // FunctionEntry node's name is usually the function name
+        FString FunctionNameForDisplay = Node->GetName(); // FunctionEntry node's name is usually the function name
         if (FunctionNameForDisplay.IsEmpty())
         {
             FunctionNameForDisplay = Node->RawProperties.FindRef(TEXT("FunctionReference_MemberName")); // Fallback
@@ -729,7 +628,7 @@ FString FNodeTraceHandlers_Functions::HandleFunctionEntryPin(
 
 
         UE_LOG(LogDataTracer, Log, TEXT("    HandleFunctionEntryPin: Pin '%s' NOT in CallSiteArgs. Context: '%s'. Returning symbolic 'ValueFrom(FunctionEntry.PinName)' style."),
-            *OutputPinFromEntry->Name, *CurrentBlueprintContext);
+            *OutputPinFromEntry->Name, *TraceContext.CurrentBlueprintContext);
         
         return FMarkdownSpan::Info(TEXT("ValueFrom")) + 
                FString::Printf(TEXT("(%s.%s)"), 
@@ -740,22 +639,4 @@ FString FNodeTraceHandlers_Functions::HandleFunctionEntryPin(
 }
 
 
-// Add this to NodeTraceHandlers_Functions.cpp
-bool IsNativeEngineFunction(const FString& ClassPath, const FString& FunctionName)
-{
-    UClass* OwnerClass = FindObject<UClass>(nullptr, *ClassPath);
-    if (!OwnerClass) return false; // Fall back to existing path logic
-    
-    UFunction* Function = OwnerClass->FindFunctionByName(FName(*FunctionName));
-    if (!Function) return false; // Fall back to existing path logic
-    
-    // Same pattern as your existing code - if no Blueprint owns it, it's native
-    UObject* FunctionOuter = Function->GetOuter();
-    UBlueprint* FunctionDefiningBP = Cast<UBlueprint>(FunctionOuter);
-    if (!FunctionDefiningBP && FunctionOuter && FunctionOuter->IsA<UBlueprintGeneratedClass>()) {
-        FunctionDefiningBP = Cast<UBlueprint>(Cast<UBlueprintGeneratedClass>(FunctionOuter)->ClassGeneratedBy);
-    }
-    
-    return !FunctionDefiningBP; // If no Blueprint defines it, it's native
-}
 //----------------------------------------------------------------//
\ No newline at end of file
@@ -21,17 +21,11 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Latent::HandleLatentAction(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid()); // Node type might vary (Delay, MoveTo, etc.)
@@ -56,7 +50,7 @@ FString FNodeTraceHandlers_Latent::HandleLatentAction(
         TSharedPtr<const FBlueprintPin> DurationPin = Node->GetPin(TEXT("Duration"));
         if (DurationPin.IsValid())
         {
-            FString DurationVal = Tracer->ResolvePinValueRecursive(DurationPin, AllNodes, Depth + 1, VisitedPins);
+            FString DurationVal = Tracer->ResolvePinValueRecursive(DurationPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
             ParamsStr = FString::Printf(TEXT("(Duration=%s)"), *DurationVal);
         }
     }
@@ -75,17 +69,11 @@ FString FNodeTraceHandlers_Latent::HandleLatentAction(
 }
 
 FString FNodeTraceHandlers_Latent::HandleDelay(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 	)
 {
 	check(Node.IsValid());
@@ -97,7 +85,7 @@ FString FNodeTraceHandlers_Latent::HandleDelay(
 	TSharedPtr<const FBlueprintPin> DurationPin = Node->GetPin(TEXT("Duration"));
 	// --- END ADDED ---
 
-	FString DurationValue = DurationPin.IsValid() ? Tracer->ResolvePinValueRecursive(DurationPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Duration?]"));
+	FString DurationValue = DurationPin.IsValid() ? Tracer->ResolvePinValueRecursive(DurationPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Duration?]"));
 
 	FString Result = FMarkdownSpan::Info(TEXT("DelayResult"))
 					 + FString::Printf(TEXT("(Duration=%s).%s"),
@@ -14,17 +14,11 @@
 #include "Logging/BP2AILog.h"
 
 FString FNodeTraceHandlers_Maps::HandleMakeMap(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 )
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("MakeMap"));
@@ -61,8 +55,8 @@ FString FNodeTraceHandlers_Maps::HandleMakeMap(
 		}
 
 		// Trace key and value recursively
-		FString KeyStr = Tracer->ResolvePinValueRecursive(KeyPin, AllNodes, Depth + 1, VisitedPins);
-		FString ValueStr = Tracer->ResolvePinValueRecursive(ValuePin, AllNodes, Depth + 1, VisitedPins);
+		FString KeyStr = Tracer->ResolvePinValueRecursive(KeyPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
+		FString ValueStr = Tracer->ResolvePinValueRecursive(ValuePin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins);
 
 		PairStrings.Add(FString::Printf(TEXT("%s%s%s"), *KeyStr, *FMarkdownSpan::Operator(TEXT(":")), *ValueStr));
 		Index++;
@@ -78,17 +72,11 @@ FString FNodeTraceHandlers_Maps::HandleMakeMap(
 }
 
 FString FNodeTraceHandlers_Maps::HandleMapFind(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 	)
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("MapFind"));
@@ -105,8 +93,8 @@ FString FNodeTraceHandlers_Maps::HandleMapFind(
 		return FString();
 	}
 
-	FString MapTargetValue = Tracer->ResolvePinValueRecursive(MapInputPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
-	FString KeyValue = Tracer->ResolvePinValueRecursive(KeyInputPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+	FString MapTargetValue = Tracer->ResolvePinValueRecursive(MapInputPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
+	FString KeyValue = Tracer->ResolvePinValueRecursive(KeyInputPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
 
 	// Format as Map[Key]
 	FString Result = FString::Printf(TEXT("%s%s%s"), *MapTargetValue, *FMarkdownSpan::Operator(TEXT("[")), *KeyValue);
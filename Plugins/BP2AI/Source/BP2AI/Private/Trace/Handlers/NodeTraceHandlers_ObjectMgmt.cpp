@@ -14,14 +14,14 @@
 #include "Trace/Utils/MarkdownFormattingUtils.h"
 #include "Trace/Utils/MarkdownTracerUtils.h"
 #include "Logging/BP2AILog.h"
+#include "EdGraphSchema_K2.h"
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleSpawnActor(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
     )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("SpawnActorFromClass")); check(Tracer); check(OutputPin.IsValid());
@@ -33,7 +33,7 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleSpawnActor(
         FString ClassNameStr = FMarkdownSpan::Error(TEXT("?Class?"));
         if (ClassPin.IsValid())
         {
-            ClassNameStr = Tracer->ResolvePinValueRecursive(ClassPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+            ClassNameStr = Tracer->ResolvePinValueRecursive(ClassPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
         }
         else
         {
@@ -46,12 +46,11 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleSpawnActor(
 }
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleAddComponent(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
     )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("AddComponent")); check(Tracer); check(OutputPin.IsValid());
@@ -76,7 +75,7 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleAddComponent(
              {
                 // If pin is linked, trace it; otherwise, try its default or subcategory object
                 if (ClassPin->SourcePinFor.Num() > 0) {
-                     CompNameStr = Tracer->ResolvePinValueRecursive(ClassPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+                     CompNameStr = Tracer->ResolvePinValueRecursive(ClassPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
                 } else if (!ClassPin->DefaultObject.IsEmpty()) {
                     CompNameStr = MarkdownFormattingUtils::FormatLiteralValue(ClassPin, ClassPin->DefaultObject, Tracer);
                 } else if (!ClassPin->SubCategoryObject.IsEmpty()){
@@ -90,12 +89,11 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleAddComponent(
 }
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleCreateWidget(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
     )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("CreateWidget")); check(Tracer); check(OutputPin.IsValid());
@@ -106,7 +104,7 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleCreateWidget(
         TSharedPtr<const FBlueprintPin> ClassPin = Node->GetPin(TEXT("Class"));
         FString ClassNameStr = FMarkdownSpan::Error(TEXT("?Widget?"));
         if (ClassPin.IsValid()) {
-            ClassNameStr = Tracer->ResolvePinValueRecursive(ClassPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+            ClassNameStr = Tracer->ResolvePinValueRecursive(ClassPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
         }
         else {
             const FString* ClassPath = Node->RawProperties.Find(TEXT("WidgetClass"));
@@ -118,12 +116,12 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleCreateWidget(
 }
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleDynamicCast(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext)
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
+)
 {
     check(Node.IsValid() && Node->NodeType == TEXT("DynamicCast")); check(Tracer); check(OutputPin.IsValid());
     UE_LOG(LogDataTracer, Verbose, TEXT("  HandleDynamicCast: Processing node %s for pin %s"), *Node->Guid, *OutputPin->Name);
@@ -131,10 +129,10 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleDynamicCast(
     TSharedPtr<const FBlueprintPin> ObjectPin = Node->GetPin(TEXT("ObjectToCast"));
     if (!ObjectPin.IsValid()) { ObjectPin = Node->GetPin(TEXT("Object")); }
 
-    FString ObjectStr = ObjectPin.IsValid() ? Tracer->ResolvePinValueRecursive(ObjectPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("?Object?"));
+    FString ObjectStr = ObjectPin.IsValid() ? Tracer->ResolvePinValueRecursive(ObjectPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("?Object?"));
 
     TSharedPtr<const FBlueprintPin> AsPin; // Find the 'As ...' pin
-    for(const auto& Pair : Node->Pins) { if(Pair.Value.IsValid() && Pair.Value->IsOutput() && Pair.Value->Category == TEXT("object")) { AsPin = Pair.Value; break; } }
+    for(const auto& Pair : Node->Pins) { if(Pair.Value.IsValid() && Pair.Value->IsOutput() && Pair.Value->PinCategory == UEdGraphSchema_K2::PC_Object) { AsPin = Pair.Value; break; } }
 
     if (OutputPin == AsPin)
     {
@@ -154,12 +152,12 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleDynamicCast(
 }
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleGetClassDefaults(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext)
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
+)
 {
     check(Node.IsValid() && Node->NodeType == TEXT("GetClassDefaults")); check(Tracer); check(OutputPin.IsValid());
     UE_LOG(LogDataTracer, Verbose, TEXT("  HandleGetClassDefaults: Processing node %s for pin %s"), *Node->Guid, *OutputPin->Name);
@@ -191,12 +189,11 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleGetClassDefaults(
 }
 
 FString FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem(
-    TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin, FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, int32 Depth, TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor, TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
+    FMarkdownDataTracer* Tracer,
+    int32 Depth,
+    const FNodeTraceContext& TraceContext
     )
 {
     check(Node.IsValid()); check(Tracer); check(OutputPin.IsValid());
@@ -232,7 +229,7 @@ FString FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem(
 
         if (TargetPin.IsValid())
         {
-            FString TargetValue = Tracer->ResolvePinValueRecursive(TargetPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap);
+            FString TargetValue = Tracer->ResolvePinValueRecursive(TargetPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap);
             // Only show context if it's not implicit self or None
             if (TargetValue != FMarkdownSpan::Variable(TEXT("`self`")) && TargetValue != FMarkdownSpan::LiteralObject(TEXT("`None`")) && !TargetValue.Contains(TEXT("Default__")))
             {
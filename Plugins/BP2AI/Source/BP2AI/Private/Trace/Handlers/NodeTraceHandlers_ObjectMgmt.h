@@ -24,114 +24,66 @@ struct BP2AI_API FNodeTraceHandlers_ObjectMgmt
 {
     /** Handles K2Node_SpawnActorFromClass */
     static FString HandleSpawnActor(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     /** Handles K2Node_AddComponent */
     static FString HandleAddComponent(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     /** Handles K2Node_CreateWidget */
     static FString HandleCreateWidget(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     /** Handles K2Node_DynamicCast */
     static FString HandleDynamicCast(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     /** Handles K2Node_GetClassDefaults */
     static FString HandleGetClassDefaults(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
     /** Handles K2Node_GetSubsystem and derived */
     static FString HandleGetSubsystem(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     static FString HandleIsValid(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     static FString HandleCreateObject(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 };
\ No newline at end of file
@@ -21,28 +21,22 @@
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Operators::HandleOperator(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     UE_LOG(LogDataTracer, Error, TEXT("HandleOperator (OperatorHandler) ENTERED: Node=%s (%s), NodeType=%s. Context RECEIVED: '%s'. CallingNode=%s (%s), OuterMap=%p, Symbolic=%d"),
-        *Node->Name,
+        *Node->GetLogName(),
         *Node->Guid.Left(8),
         *Node->NodeType, 
-        *CurrentBlueprintContext, // Log received context
-        CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL_NODE_NAME"),
-        CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
-        OuterNodesMap,
-        bSymbolicTrace);
+        *TraceContext.CurrentBlueprintContext, // Log received context
+        TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->GetLogName() : TEXT("NULL_NODE_NAME"),
+        TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
+        TraceContext.OuterNodesMap,
+        TraceContext.bSymbolicTrace);
     
     check(Node.IsValid() && Tracer && OutputPin.IsValid());
     check(Node->NodeType == TEXT("PromotableOperator") || Node->NodeType == TEXT("CommutativeAssociativeBinaryOperator"));
@@ -61,56 +55,50 @@ FString FNodeTraceHandlers_Operators::HandleOperator(
     const FString NormalizedFuncName = MarkdownTracerUtils::NormalizeConversionName(FuncName, Tracer->GetTypeConversionMap());
     if (Tracer->GetTypeConversionMap().Contains(NormalizedFuncName))
     {
-        UE_LOG(LogDataTracer, Verbose, TEXT("  HandleOperator: Detected as TYPE CONVERSION (%s). Context to pass to FormatConversion: '%s'."), *FuncName, *CurrentBlueprintContext);
+        UE_LOG(LogDataTracer, Verbose, TEXT("  HandleOperator: Detected as TYPE CONVERSION (%s). Context to pass to FormatConversion: '%s'."), *FuncName, *TraceContext.CurrentBlueprintContext);
         // Pass context to FormatConversion
-        return MarkdownFormattingUtils::FormatConversion(Node, Tracer, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+        return MarkdownFormattingUtils::FormatConversion(Node, Tracer, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
     }
     else
     {
-        UE_LOG(LogDataTracer, Verbose, TEXT("  HandleOperator: Detected as MATH/LOGIC OP (%s). Context to pass to FormatOperator: '%s'."), *FuncName, *CurrentBlueprintContext);
+        UE_LOG(LogDataTracer, Verbose, TEXT("  HandleOperator: Detected as MATH/LOGIC OP (%s). Context to pass to FormatOperator: '%s'."), *FuncName, *TraceContext.CurrentBlueprintContext);
 
         UE_LOG(LogDataTracer, Error, TEXT("HandleOperator (OperatorHandler) PRE-CALL FormatOperator: Node=%s (%s). Context about to be passed: '%s'. CallingNode=%s (%s), OuterMap=%p"),
-            *Node->Name,
+            *Node->GetLogName(),
             *Node->Guid.Left(8),
-            *CurrentBlueprintContext, // Log context to be passed
-            CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL_NODE_NAME"),
-            CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
-            OuterNodesMap);
+            *TraceContext.CurrentBlueprintContext, // Log context to be passed
+            TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->GetLogName() : TEXT("NULL_NODE_NAME"),
+            TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
+            TraceContext.OuterNodesMap);
 
         // Pass context to FormatOperator utility
-        return MarkdownFormattingUtils::FormatOperator(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+        return MarkdownFormattingUtils::FormatOperator(Node, OutputPin, Tracer, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
     }
 }
 
 
 FString FNodeTraceHandlers_Operators::HandleUnaryOperator(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin,
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     UE_LOG(LogDataTracer, Error, TEXT("HandleUnaryOperator (OperatorHandler) ENTERED: Node=%s (%s), NodeType=%s. Context RECEIVED: '%s'. CallingNode=%s (%s), OuterMap=%p, Symbolic=%d"),
-        *Node->Name,
+        *Node->GetLogName(),
         *Node->Guid.Left(8),
         *Node->NodeType,
-        *CurrentBlueprintContext, // Log received context
-        CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL_NODE_NAME"),
-        CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
-        OuterNodesMap,
-        bSymbolicTrace);
+        *TraceContext.CurrentBlueprintContext, // Log received context
+        TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->GetLogName() : TEXT("NULL_NODE_NAME"),
+        TraceContext.CallingNode.IsValid() ? *TraceContext.CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
+        TraceContext.OuterNodesMap,
+        TraceContext.bSymbolicTrace);
     check(Node.IsValid());
     check(Tracer);
     check(OutputPin.IsValid());
     UE_LOG(LogDataTracer, Verbose, TEXT("  HandleUnaryOperator: Processing node %s (%s)"), *Node->NodeType, *Node->Guid);
 
-    UE_LOG(LogDataTracer, Log, TEXT("  HandleUnaryOperator: Context to pass to FormatUnaryOperator utility: '%s'"), *CurrentBlueprintContext);
-    return MarkdownFormattingUtils::FormatUnaryOperator(Node, OutputPin, Tracer, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+    UE_LOG(LogDataTracer, Log, TEXT("  HandleUnaryOperator: Context to pass to FormatUnaryOperator utility: '%s'"), *TraceContext.CurrentBlueprintContext);
+    return MarkdownFormattingUtils::FormatUnaryOperator(Node, OutputPin, Tracer, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
 }
@@ -24,31 +24,19 @@ struct BP2AI_API FNodeTraceHandlers_Operators
 {
     /** Handles binary operators (Promotable, Commutative) and dispatches conversions. */
     static FString HandleOperator(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext // Ensure context is here
+        const FNodeTraceContext& TraceContext
     );
 
     /** Handles common unary operators (like NOT, potentially others). */
     static FString HandleUnaryOperator(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin,
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, // Changed AllNodes to CurrentNodesMap for consistency
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext // Ensure context is here
+        const FNodeTraceContext& TraceContext
     );
 };
\ No newline at end of file
@@ -14,17 +14,12 @@
 #include "Trace/Utils/MarkdownFormattingUtils.h" // For FMarkdownSpan
 
 FString FNodeTraceHandlers_Sets::HandleMakeSet(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // The set output pin
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext)
+    const FNodeTraceContext& TraceContext
+)
 {
     // Essential checks for valid input parameters and node type
     check(Node.IsValid() && Node->NodeType == TEXT("MakeSet")); 
@@ -33,17 +28,17 @@ FString FNodeTraceHandlers_Sets::HandleMakeSet(
 
     // Corrected Check: The OutputPin for a "Make Set" node should have its ContainerType as "Set".
     // The OutputPin->Category will reflect the type of elements in the set (e.g., "int", "struct").
-    check(OutputPin->ContainerType == TEXT("Set")); 
+    check(OutputPin->PinContainerType == EPinContainerType::Set); 
 
     UE_LOG(LogDataTracer, Verbose, TEXT("  HandleMakeSet: Processing node '%s' (GUID: %s) for output pin '%s' (PinCategory: '%s', PinContainerType: '%s'). Context: '%s'"), 
-        *Node->Name, *Node->Guid, *OutputPin->Name, *OutputPin->Category, *OutputPin->ContainerType, *CurrentBlueprintContext);
+        *Node->GetLogName(), *Node->Guid, *OutputPin->Name, *OutputPin->Category, *OutputPin->ContainerType, *TraceContext.CurrentBlueprintContext);
 
     TArray<FString> ElementStrings;
     int32 ElementIndex = 0;
     while (true)
     {
         FString ElementPinName = FString::Printf(TEXT("[%d]"), ElementIndex);
-        TSharedPtr<const FBlueprintPin> ElementPin = Node->GetPin(ElementPinName, TEXT("EGPD_Input"));
+        TSharedPtr<const FBlueprintPin> ElementPin = Node->GetPin(ElementPinName, EGPD_Input);
 
         if (!ElementPin.IsValid())
         {
@@ -74,16 +69,7 @@ FString FNodeTraceHandlers_Sets::HandleMakeSet(
         }
 
         UE_LOG(LogDataTracer, Verbose, TEXT("  HandleMakeSet: Tracing element pin '%s'."), *ElementPin->Name);
-        FString ElementValue = Tracer->ResolvePinValueRecursive(
-            ElementPin,
-            CurrentNodesMap,
-            Depth + 1, 
-            VisitedPins,
-            CallingNode,
-            OuterNodesMap,
-            bSymbolicTrace,
-            CurrentBlueprintContext
-        );
+        FString ElementValue = Tracer->ResolvePinValueRecursive(ElementPin, Depth + 1, TraceContext);
         ElementStrings.Add(ElementValue);
 
         if (ElementIndex == -1) { // Break if we processed a single non-standard named pin
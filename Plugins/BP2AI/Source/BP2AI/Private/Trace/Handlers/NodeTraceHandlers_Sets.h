@@ -21,17 +21,11 @@ struct BP2AI_API FNodeTraceHandlers_Sets
 {
     /** Handles K2Node_MakeSet */
     static FString HandleMakeSet(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The set output pin
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     // Add other set-related handlers here in the future if needed
@@ -24,28 +24,23 @@
 #include "NodeTraceHandlers_Structs.h"
 // ... other includes ...
 #include "Logging/BP2AILog.h"
+#include "EdGraphSchema_K2.h"
 
 FString FNodeTraceHandlers_Structs::HandleBreakStruct(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // This is the struct member pin we are resolving
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("BreakStruct"));
     check(Tracer); check(OutputPin.IsValid());
 
     UE_LOG(LogDataTracer, Error, TEXT("  HandleBreakStruct: Node='%s' (GUID:%s), MemberOutputPin='%s' (ID:%s). CtxRecv:'%s', Symbolic:%d, Depth:%d"),
-        *Node->Name, *Node->Guid.Left(8),
+        *Node->GetLogName(), *Node->Guid.Left(8),
         *OutputPin->Name, *OutputPin->Id.Left(8),
-        *CurrentBlueprintContext, bSymbolicTrace, Depth);
+        *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace, Depth);
     // 🔧 NEW DEBUG: Show what's connected to ALL input pins of Break node
     UE_LOG(LogDataTracer, Error, TEXT("🔧 BREAK NODE ALL INPUTS:"));
     for (const auto& PinPair : Node->Pins)
@@ -59,8 +54,8 @@ FString FNodeTraceHandlers_Structs::HandleBreakStruct(
                 if (Pin->SourcePinFor[i].IsValid())
                 {
                     FString SourceNodeGuid = Pin->SourcePinFor[i]->NodeGuid;
-                    TSharedPtr<FBlueprintNode> SourceNode = CurrentNodesMap.FindRef(SourceNodeGuid);
-                    FString SourceNodeName = SourceNode.IsValid() ? SourceNode->Name : TEXT("UNKNOWN");
+                    TSharedPtr<FBlueprintNode> SourceNode = TraceContext.CurrentNodesMap.FindRef(Pin->SourcePinFor[i]->GraphNodeGuid);
+                    FString SourceNodeName = SourceNode.IsValid() ? SourceNode->GetName() : TEXT("UNKNOWN");
                     UE_LOG(LogDataTracer, Error, TEXT("🔧     Connected to: NodeGUID='%s', NodeName='%s', PinName='%s'"), 
                         *SourceNodeGuid.Left(8), *SourceNodeName, *Pin->SourcePinFor[i]->Name);
                 }
@@ -73,7 +68,7 @@ FString FNodeTraceHandlers_Structs::HandleBreakStruct(
     for (const auto& Pair : Node->Pins) {
         const TSharedPtr<const FBlueprintPin>& Pin = Pair.Value;
         // Heuristic: The input struct pin is an input, category "struct", and not an execution pin.
-        if (Pin.IsValid() && Pin->IsInput() && Pin->Category == TEXT("struct") && !Pin->IsExecution()) {
+        if (Pin.IsValid() && Pin->IsInput() && Pin->PinCategory == UEdGraphSchema_K2::PC_Struct && !Pin->IsExecution()) {
             InputStructPin = Pin;
             break;
         }
@@ -85,10 +80,10 @@ FString FNodeTraceHandlers_Structs::HandleBreakStruct(
     }
 
     UE_LOG(LogDataTracer, Warning, TEXT("    HandleBreakStruct: Tracing InputStructPin '%s' (ID:%s). DefObj:'%s', Links:%d. CtxToPass:'%s', SymbolicForThisTrace:%d"),
-        *InputStructPin->Name, *InputStructPin->Id.Left(8), *InputStructPin->DefaultObject, InputStructPin->SourcePinFor.Num(), *CurrentBlueprintContext, bSymbolicTrace);
+        *InputStructPin->Name, *InputStructPin->Id.Left(8), *InputStructPin->DefaultObject, InputStructPin->SourcePinFor.Num(), *TraceContext.CurrentBlueprintContext, TraceContext.bSymbolicTrace);
 
     // When tracing the input struct, we want its symbolic representation, so use the passed 'bSymbolicTrace'
-    FString InputStructValue = Tracer->ResolvePinValueRecursive(InputStructPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+    FString InputStructValue = Tracer->ResolvePinValueRecursive(InputStructPin, Depth + 1, TraceContext);
     UE_LOG(LogDataTracer, Warning, TEXT("    HandleBreakStruct: InputStructPin '%s' resolved to: %s"), *InputStructPin->Name, *InputStructValue);
 
     FString DisplayMemberName = (!OutputPin->FriendlyName.IsEmpty() && OutputPin->FriendlyName != OutputPin->Name) ? OutputPin->FriendlyName : OutputPin->Name;
@@ -120,17 +115,11 @@ FString FNodeTraceHandlers_Structs::HandleBreakStruct(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Structs::HandleMakeStruct(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // The struct output pin
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("MakeStruct"));
@@ -145,7 +134,7 @@ FString FNodeTraceHandlers_Structs::HandleMakeStruct(
     // Exclude the output pin itself if it somehow appears in inputs
     TSet<FName> Exclusions;
     if (OutputPin.IsValid()) Exclusions.Add(FName(*OutputPin->Name));
-    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap,bSymbolicTrace);
+    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap,TraceContext.bSymbolicTrace);
 
     FString Result = FString::Printf(TEXT("Make<%s>(%s)"), *FMarkdownSpan::DataType(FString::Printf(TEXT("%s"), *StructTypeName)), *ArgsStr); 
     UE_LOG(LogDataTracer, Verbose, TEXT("  HandleMakeStruct: Returning %s"), *Result);
@@ -155,17 +144,11 @@ FString FNodeTraceHandlers_Structs::HandleMakeStruct(
 //----------------------------------------------------------------//
 
 FString FNodeTraceHandlers_Structs::HandleSetFieldsInStruct(
-    TSharedPtr<const FBlueprintNode> Node,
-    TSharedPtr<const FBlueprintPin> OutputPin, // The struct output pin
+    const TSharedPtr<const FBlueprintNode>& Node,
+    const TSharedPtr<const FBlueprintPin>& OutputPin,
     FMarkdownDataTracer* Tracer,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
-    const FBlueprintDataExtractor& DataExtractor,
-    TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-    bool bSymbolicTrace,
-    const FString& CurrentBlueprintContext
+    const FNodeTraceContext& TraceContext
 )
 {
     check(Node.IsValid() && Node->NodeType == TEXT("SetFieldsInStruct"));
@@ -176,7 +159,7 @@ FString FNodeTraceHandlers_Structs::HandleSetFieldsInStruct(
     TSharedPtr<const FBlueprintPin> InputStructPin = Node->GetPin(TEXT("StructRef"));
     if (!InputStructPin.IsValid()) InputStructPin = Node->GetPin(TEXT("Struct In")); // Fallback name
 
-    FString InputStructValue = InputStructPin.IsValid() ? Tracer->ResolvePinValueRecursive(InputStructPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Struct?]"));
+    FString InputStructValue = InputStructPin.IsValid() ? Tracer->ResolvePinValueRecursive(InputStructPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Struct?]"));
 
     // Get the struct type name from the output pin (usually most reliable)
     FString StructTypeName = MarkdownTracerUtils::ExtractSimpleNameFromPath(OutputPin->SubCategoryObject);
@@ -188,7 +171,7 @@ FString FNodeTraceHandlers_Structs::HandleSetFieldsInStruct(
     // Also exclude the output pin itself
     if(OutputPin.IsValid()) Exclusions.Add(FName(*OutputPin->Name));
 
-    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, CurrentNodesMap, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace);
+    FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
 
     // Return a representation showing modification
     FString Result = FMarkdownSpan::Info(TEXT("Modified"))
@@ -24,48 +24,29 @@ struct BP2AI_API FNodeTraceHandlers_Structs
 {
     /** Handles K2Node_BreakStruct. */
     static FString HandleBreakStruct(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The specific member pin being traced
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
 
     /** Handles K2Node_MakeStruct. */
     static FString HandleMakeStruct(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The struct output pin
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-        bool bSymbolicTrace,
-        const FString& CurrentBlueprintContext
+        const FNodeTraceContext& TraceContext
     );
 
     /** Handles K2Node_SetFieldsInStruct. */
     static FString HandleSetFieldsInStruct(
-        TSharedPtr<const FBlueprintNode> Node,
-        TSharedPtr<const FBlueprintPin> OutputPin, // The struct output pin
+        const TSharedPtr<const FBlueprintNode>& Node,
+        const TSharedPtr<const FBlueprintPin>& OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
         int32 Depth,
-        TSet<FString>& VisitedPins,
-        const FBlueprintDataExtractor& DataExtractor,
-        TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
-
+        const FNodeTraceContext& TraceContext
     );
 };
\ No newline at end of file
@@ -14,17 +14,11 @@
 #include "Logging/BP2AILog.h"
 
 FString FNodeTraceHandlers_Text::HandleFormatText(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin, // The 'Result' output pin
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-  const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-  bool bSymbolicTrace,
-  const FString& CurrentBlueprintContext
+	const FNodeTraceContext& TraceContext
 )
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("FormatText"));
@@ -34,7 +28,7 @@ FString FNodeTraceHandlers_Text::HandleFormatText(
 
 	// Find the 'Format' input pin
 	TSharedPtr<const FBlueprintPin> FormatPin = Node->GetPin(TEXT("Format"));
-	FString FormatStringValue = FormatPin.IsValid() ? Tracer->ResolvePinValueRecursive(FormatPin, AllNodes, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Format?]"));
+	FString FormatStringValue = FormatPin.IsValid() ? Tracer->ResolvePinValueRecursive(FormatPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Format?]"));
 
 	// Format the arguments using the utility function, excluding the 'Format' pin
 	TSet<FName> Exclusions;
@@ -42,7 +36,7 @@ FString FNodeTraceHandlers_Text::HandleFormatText(
 	{
 		Exclusions.Add(FName(*FormatPin->Name));
 	}
-	FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, AllNodes, Depth + 1, VisitedPins, Exclusions, CallingNode, OuterNodesMap, bSymbolicTrace);
+	FString ArgsStr = MarkdownFormattingUtils::FormatArgumentsForTrace(Node, Tracer, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, Exclusions, TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace);
 
 	// Format the output symbolically
 	FString Result = FMarkdownSpan::FunctionName(TEXT("FormatText"))
@@ -53,17 +47,12 @@ FString FNodeTraceHandlers_Text::HandleFormatText(
 }
 
 FString FNodeTraceHandlers_Text::HandleTextLiteral(
-	TSharedPtr<const FBlueprintNode> Node,
-	TSharedPtr<const FBlueprintPin> OutputPin,
+	const TSharedPtr<const FBlueprintNode>& Node,
+	const TSharedPtr<const FBlueprintPin>& OutputPin,
 	FMarkdownDataTracer* Tracer,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 	int32 Depth,
-	TSet<FString>& VisitedPins,
-	const FBlueprintDataExtractor& DataExtractor,
-	TSharedPtr<const FBlueprintNode> CallingNode,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-	bool bSymbolicTrace,
-	const FString& CurrentBlueprintContext)
+	const FNodeTraceContext& TraceContext
+)
 {
 	check(Node.IsValid() && Node->NodeType == TEXT("TextLiteral"));
 	check(Tracer);
@@ -72,7 +61,7 @@ FString FNodeTraceHandlers_Text::HandleTextLiteral(
 
 	// Find the 'Text' input pin
 	TSharedPtr<const FBlueprintPin> TextPin = Node->GetPin(TEXT("Text"));
-	FString TextStringValue = TextPin.IsValid() ? Tracer->ResolvePinValueRecursive(TextPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Text?]"));
+	FString TextStringValue = TextPin.IsValid() ? Tracer->ResolvePinValueRecursive(TextPin, TraceContext.CurrentNodesMap, Depth + 1, TraceContext.VisitedPins, TraceContext.CallingNode, TraceContext.OuterNodesMap) : FMarkdownSpan::Error(TEXT("[?Text?]"));
 
 	// Format the output symbolically
 	FString Result = FMarkdownSpan::Keyword(TEXT("TextLiteral"))
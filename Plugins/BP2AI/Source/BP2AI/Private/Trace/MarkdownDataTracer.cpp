@@ -17,6 +17,9 @@
 #include "Internationalization/Regex.h"
 #include "Logging/LogMacros.h"
 #include "Misc/DefaultValueHelper.h"
+#include "Misc/MemStack.h"
+#include "Algo/Reverse.h"
+#include "Settings/BP2AIExportConfig.h"
 #include "Math/UnrealMathUtility.h"
 #include "Logging/BP2AILog.h"
 
@@ -47,6 +50,8 @@
 // --- Include Utility Headers ---
 #include "Utils/MarkdownFormattingUtils.h" // <<<<< Include Formatting Utils
 #include "Utils/MarkdownTracerUtils.h"     // <<<<< Include Tracer Utils
+#include "Utils/MarkdownSpanSystem.h"
+#include "Trace/ResolvedPinValueCache.h"
 
 
 // Define NAME_ constants manually as a workaround if not defined elsewhere
@@ -93,174 +98,219 @@
 #endif
 
 
-// Constructor - Registering all handlers
-FMarkdownDataTracer::FMarkdownDataTracer(const FBlueprintDataExtractor& InDataExtractor) : DataExtractorRef(InDataExtractor), MaxTraceDepth(15)
+namespace
 {
-	// --- Map initializations ---
-	// Map node function names (or base names) to their symbolic representation
-	MathOperatorMap.Add(TEXT("Divide"), TEXT("/"));
-	MathOperatorMap.Add(TEXT("Add"), TEXT("+"));
-	MathOperatorMap.Add(TEXT("Subtract"), TEXT("-"));
-	MathOperatorMap.Add(TEXT("Multiply"), TEXT("*"));
-	MathOperatorMap.Add(TEXT("Less"), TEXT("<"));
-	MathOperatorMap.Add(TEXT("Greater"), TEXT(">"));
-	MathOperatorMap.Add(TEXT("LessEqual"), TEXT("<="));
-	MathOperatorMap.Add(TEXT("GreaterEqual"), TEXT(">="));
-	MathOperatorMap.Add(TEXT("EqualEqual"), TEXT("=="));
-	MathOperatorMap.Add(TEXT("NotEqual"), TEXT("!="));
-	// MathOperatorMap.Add(TEXT("BooleanAND"), TEXT("AND")); // Using text for boolean ops
-	// MathOperatorMap.Add(TEXT("BooleanOR"), TEXT("OR"));   // Using text for boolean ops
-	// MathOperatorMap.Add(TEXT("BooleanXOR"), TEXT("XOR")); // Using text for boolean ops
-	// MathOperatorMap.Add(TEXT("BooleanNAND"), TEXT("NAND")); // Using text for boolean ops
-	// MathOperatorMap.Add(TEXT("Max"), TEXT("MAX")); // Using text for Max/Min
-	// MathOperatorMap.Add(TEXT("Min"), TEXT("MIN")); // Using text for Max/Min
-	// MathOperatorMap.Add(TEXT("FMax"), TEXT("MAX")); // Using text for Max/Min
-	// MathOperatorMap.Add(TEXT("FMin"), TEXT("MIN")); // Using text for Max/Min
-	MathOperatorMap.Add(TEXT("Percent"), TEXT("%")); // Use base name for modulo
-	MathOperatorMap.Add(TEXT("BooleanNot"), TEXT("!")); // Keep '!' symbol for BooleanNot
-	MathOperatorMap.Add(TEXT("Concat"), TEXT("+")); // Added for FormatOperator, using '+' for string concat
-	MathOperatorMap.Add(TEXT("Not"), TEXT("!"));
-	MathOperatorMap.Add(TEXT("Percent_FloatFloat"), TEXT("%"));
-	MathOperatorMap.Add(TEXT("Not_PreBool"), TEXT("!"));
-	
+	// 进程级只读注册表：首次使用时构建一次（函数内静态变量的初始化是线程安全的），之后所有追踪器实例共享，
+	// 构建完成后不再修改，多个追踪器可在不同线程上并发查找
+	struct FDataTracerRegistry
+	{
+		TMap<FString, FString> MathOperators;
+		TMap<FString, FString> TypeConversions;
+		// 以 EBlueprintNodeKind 为下标的跳转表，未注册的种类为 nullptr
+		FMarkdownDataTracer::FNodeTraceHandlerFunc NodeHandlers[static_cast<int32>(EBlueprintNodeKind::Count)] = {};
+		int32 NumHandlers = 0;
 
-	// === STRING COMPARISON OPERATORS ===
-	// Case Sensitive
-	MathOperatorMap.Add(TEXT("EqualEqual_StrStr"), TEXT("==="));
-	MathOperatorMap.Add(TEXT("NotEqual_StrStr"), TEXT("!=="));
+		FDataTracerRegistry();
 
-	// Case Insensitive (StriStri = String Insensitive)
-	MathOperatorMap.Add(TEXT("EqualEqual_StriStri"), TEXT("==")); 
-	MathOperatorMap.Add(TEXT("NotEqual_StriStri"), TEXT("!="));
+		void Register(EBlueprintNodeKind Kind, FMarkdownDataTracer::FNodeTraceHandlerFunc Handler)
+		{
+			check(Kind != EBlueprintNodeKind::Unknown && Kind < EBlueprintNodeKind::Count);
+			if (!NodeHandlers[static_cast<int32>(Kind)])
+			{
+				++NumHandlers;
+			}
+			NodeHandlers[static_cast<int32>(Kind)] = Handler;
+		}
 
-	// === TEXT COMPARISON OPERATORS ===
-	// Case Sensitive  
-	MathOperatorMap.Add(TEXT("EqualEqual_TextText"), TEXT("==="));
-	MathOperatorMap.Add(TEXT("NotEqual_TextText"), TEXT("!=="));
+		FMarkdownDataTracer::FNodeTraceHandlerFunc GetHandler(EBlueprintNodeKind Kind) const
+		{
+			return NodeHandlers[static_cast<int32>(Kind)];
+		}
+	};
 
-	// Case Insensitive
-	MathOperatorMap.Add(TEXT("EqualEqual_IgnoreCase_TextText"), TEXT("=="));
-	MathOperatorMap.Add(TEXT("NotEqual_IgnoreCase_TextText"), TEXT("!="));
+	FDataTracerRegistry::FDataTracerRegistry()
+	{
+		// --- Map initializations ---
+		// Map node function names (or base names) to their symbolic representation
+		MathOperators.Add(TEXT("Divide"), TEXT("/"));
+		MathOperators.Add(TEXT("Add"), TEXT("+"));
+		MathOperators.Add(TEXT("Subtract"), TEXT("-"));
+		MathOperators.Add(TEXT("Multiply"), TEXT("*"));
+		MathOperators.Add(TEXT("Less"), TEXT("<"));
+		MathOperators.Add(TEXT("Greater"), TEXT(">"));
+		MathOperators.Add(TEXT("LessEqual"), TEXT("<="));
+		MathOperators.Add(TEXT("GreaterEqual"), TEXT(">="));
+		MathOperators.Add(TEXT("EqualEqual"), TEXT("=="));
+		MathOperators.Add(TEXT("NotEqual"), TEXT("!="));
+		// MathOperators.Add(TEXT("BooleanAND"), TEXT("AND")); // Using text for boolean ops
+		// MathOperators.Add(TEXT("BooleanOR"), TEXT("OR"));   // Using text for boolean ops
+		// MathOperators.Add(TEXT("BooleanXOR"), TEXT("XOR")); // Using text for boolean ops
+		// MathOperators.Add(TEXT("BooleanNAND"), TEXT("NAND")); // Using text for boolean ops
+		// MathOperators.Add(TEXT("Max"), TEXT("MAX")); // Using text for Max/Min
+		// MathOperators.Add(TEXT("Min"), TEXT("MIN")); // Using text for Max/Min
+		// MathOperators.Add(TEXT("FMax"), TEXT("MAX")); // Using text for Max/Min
+		// MathOperators.Add(TEXT("FMin"), TEXT("MIN")); // Using text for Max/Min
+		MathOperators.Add(TEXT("Percent"), TEXT("%")); // Use base name for modulo
+		MathOperators.Add(TEXT("BooleanNot"), TEXT("!")); // Keep '!' symbol for BooleanNot
+		MathOperators.Add(TEXT("Concat"), TEXT("+")); // Added for FormatOperator, using '+' for string concat
+		MathOperators.Add(TEXT("Not"), TEXT("!"));
+		MathOperators.Add(TEXT("Percent_FloatFloat"), TEXT("%"));
+		MathOperators.Add(TEXT("Not_PreBool"), TEXT("!"));
 
-	
-	// Type Conversion Map
-	// Maps conversion node function names to a simplified target type name
-	TypeConversionMap.Add(TEXT("Conv_BoolToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_BoolToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_BoolToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_ByteToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_ByteToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_IntToByte"), TEXT("byte"));
-	TypeConversionMap.Add(TEXT("Conv_IntToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_IntToDouble"), TEXT("double"));
-	TypeConversionMap.Add(TEXT("Conv_IntToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_IntToInt64"), TEXT("int64"));
-	TypeConversionMap.Add(TEXT("Conv_Int64ToByte"), TEXT("byte"));
-	TypeConversionMap.Add(TEXT("Conv_Int64ToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_Int64ToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_FloatToBool"), TEXT("bool"));
-	TypeConversionMap.Add(TEXT("Conv_FloatToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_FloatToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_FloatToDouble"), TEXT("double"));
-	TypeConversionMap.Add(TEXT("Conv_DoubleToBool"), TEXT("bool"));
-	TypeConversionMap.Add(TEXT("Conv_DoubleToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_DoubleToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_DoubleToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_StringToBool"), TEXT("bool"));
-	TypeConversionMap.Add(TEXT("Conv_StringToInt"), TEXT("int"));
-	TypeConversionMap.Add(TEXT("Conv_StringToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_StringToName"), TEXT("name"));
-	TypeConversionMap.Add(TEXT("Conv_NameToBool"), TEXT("bool"));
-	TypeConversionMap.Add(TEXT("Conv_NameToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_ObjectToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_VectorToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_IntToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_FloatToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_StringToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_NameToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_ByteToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_BoolToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_VectorToStringNormalized"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_RotatorToStringNormalized"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_ObjectToStringNormalized"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_ObjectToText"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("Conv_TextToString"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("Conv_TextToName"), TEXT("name"));
-	TypeConversionMap.Add(TEXT("Conv_TextToFloat"), TEXT("float"));
-	TypeConversionMap.Add(TEXT("Conv_TextToInt"), TEXT("int"));
-
-	// Common function names that act as conversions (e.g., "ToString (Vector)")
-	TypeConversionMap.Add(TEXT("ToString (Vector)"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("ToString (Rotator)"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("ToString (Object)"), TEXT("string"));
-	TypeConversionMap.Add(TEXT("ToText (int)"), TEXT("Text"));
-	TypeConversionMap.Add(TEXT("ToText (float)"), TEXT("Text"));
-
-	// --- Register All Handlers ---
-	NodeHandlers.Add(TEXT("VariableGet"), &FNodeTraceHandlers_Basic::HandleVariableGet);
-	NodeHandlers.Add(TEXT("Literal"), &FNodeTraceHandlers_Basic::HandleLiteral);
-	NodeHandlers.Add(TEXT("Self"), &FNodeTraceHandlers_Basic::HandleSelf);
-	NodeHandlers.Add(TEXT("VariableSet"), &FNodeTraceHandlers_Basic::HandleVariableSet);
-	NodeHandlers.Add(TEXT("PromotableOperator"), &FNodeTraceHandlers_Operators::HandleOperator);
-	NodeHandlers.Add(TEXT("CommutativeAssociativeBinaryOperator"), &FNodeTraceHandlers_Operators::HandleOperator);
-	NodeHandlers.Add(TEXT("BooleanNot"), &FNodeTraceHandlers_Operators::HandleUnaryOperator); // Assumes BooleanNot NodeType
-	NodeHandlers.Add(TEXT("BreakStruct"), &FNodeTraceHandlers_Structs::HandleBreakStruct);
-	NodeHandlers.Add(TEXT("MakeStruct"), &FNodeTraceHandlers_Structs::HandleMakeStruct);
-	NodeHandlers.Add(TEXT("SetFieldsInStruct"), &FNodeTraceHandlers_Structs::HandleSetFieldsInStruct);
-	NodeHandlers.Add(TEXT("CallFunction"), &FNodeTraceHandlers_Functions::HandleCallFunction);
-	NodeHandlers.Add(TEXT("CallParentFunction"), &FNodeTraceHandlers_Functions::HandleCallFunction);
-	NodeHandlers.Add(TEXT("MacroInstance"), &FNodeTraceHandlers_Functions::HandleCallMacro);
-	NodeHandlers.Add(TEXT("MakeArray"), &FNodeTraceHandlers_Arrays::HandleMakeArray);
-	NodeHandlers.Add(TEXT("GetArrayItem"), &FNodeTraceHandlers_Arrays::HandleGetArrayItem);
-	NodeHandlers.Add(TEXT("CallArrayFunction"), &FNodeTraceHandlers_Arrays::HandleCallArrayFunction);
-	NodeHandlers.Add(TEXT("CreateDelegate"), &FNodeTraceHandlers_Delegates::HandleCreateDelegate);
-	NodeHandlers.Add(TEXT("Select"), &FNodeTraceHandlers_FlowControl::HandleSelect);
-	NodeHandlers.Add(TEXT("SpawnActorFromClass"), &FNodeTraceHandlers_ObjectMgmt::HandleSpawnActor);
-	NodeHandlers.Add(TEXT("AddComponent"), &FNodeTraceHandlers_ObjectMgmt::HandleAddComponent);
-	NodeHandlers.Add(TEXT("CreateWidget"), &FNodeTraceHandlers_ObjectMgmt::HandleCreateWidget);
-	NodeHandlers.Add(TEXT("DynamicCast"), &FNodeTraceHandlers_ObjectMgmt::HandleDynamicCast);
-	NodeHandlers.Add(TEXT("GetClassDefaults"), &FNodeTraceHandlers_ObjectMgmt::HandleGetClassDefaults);
-	NodeHandlers.Add(TEXT("GetSubsystem"), &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
-	NodeHandlers.Add(TEXT("GetEngineSubsystem"), &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
-	NodeHandlers.Add(TEXT("GetSubsystemFromPC"), &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
-	NodeHandlers.Add(TEXT("Timeline"), &FNodeTraceHandlers_Timeline::HandleTimeline);
-	NodeHandlers.Add(TEXT("Delay"), &FNodeTraceHandlers_Latent::HandleLatentAction);
-	NodeHandlers.Add(TEXT("MoveComponentTo"), &FNodeTraceHandlers_Latent::HandleLatentAction);
-	NodeHandlers.Add(TEXT("AIMoveTo"), &FNodeTraceHandlers_Latent::HandleLatentAction);
-	NodeHandlers.Add(TEXT("EnumEquality"), &FNodeTraceHandlers_Enums::HandleEnumComparison);
-	NodeHandlers.Add(TEXT("EnumInequality"), &FNodeTraceHandlers_Enums::HandleEnumComparison);
-	NodeHandlers.Add(TEXT("CastByteToEnum"), &FNodeTraceHandlers_Enums::HandleCastByteToEnum);
-	NodeHandlers.Add(TEXT("EnumLiteral"), &FNodeTraceHandlers_Enums::HandleEnumLiteral);
-    NodeHandlers.Add(TEXT("FunctionResult"), &FNodeTraceHandlers_FunctionResult::HandleFunctionResult); // Added FunctionResult
-    NodeHandlers.Add(TEXT("MakeMap"), &FNodeTraceHandlers_Maps::HandleMakeMap);
-	NodeHandlers.Add(TEXT("MakeSet"), &FNodeTraceHandlers_Sets::HandleMakeSet); 
-    NodeHandlers.Add(TEXT("FormatText"), &FNodeTraceHandlers_Text::HandleFormatText); // Added FormatText
-
-    // --- CORRECTED Event Handler Registration ---
-    // Directly register common event types and the bound event types to the SAME handler.
-	NodeHandlers.Add(TEXT("Tunnel"), &FNodeTraceHandlers_Basic::HandleTunnel);
-    NodeHandlers.Add(TEXT("Event"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-    NodeHandlers.Add(TEXT("CustomEvent"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-    NodeHandlers.Add(TEXT("ComponentBoundEvent"), &FNodeTraceHandlers_Events::HandleEventOutputParam); // ADDED
-    NodeHandlers.Add(TEXT("ActorBoundEvent"), &FNodeTraceHandlers_Events::HandleEventOutputParam);     // ADDED
-    // Add other specific event node types if needed (e.g., InputAxisEvent, EnhancedInputAction)
-    NodeHandlers.Add(TEXT("InputAxisEvent"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-    NodeHandlers.Add(TEXT("EnhancedInputAction"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-    NodeHandlers.Add(TEXT("InputAction"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-    NodeHandlers.Add(TEXT("InputKey"), &FNodeTraceHandlers_Events::HandleEventOutputParam);
-
-	NodeHandlers.Add(TEXT("GetDataTableRow"), &FNodeTraceHandlers_DataTables::HandleGetDataTableRow);
-	NodeHandlers.Add(TEXT("Composite"), &FNodeTraceHandlers_Composite::HandleCompositeOutputPinValue);
-	NodeHandlers.Add(TEXT("FunctionEntry"), &FNodeTraceHandlers_Functions::HandleFunctionEntryPin);
-
-	// ... add others as identified ...
-	
 
+		// === STRING COMPARISON OPERATORS ===
+		// Case Sensitive
+		MathOperators.Add(TEXT("EqualEqual_StrStr"), TEXT("==="));
+		MathOperators.Add(TEXT("NotEqual_StrStr"), TEXT("!=="));
+
+		// Case Insensitive (StriStri = String Insensitive)
+		MathOperators.Add(TEXT("EqualEqual_StriStri"), TEXT("==")); 
+		MathOperators.Add(TEXT("NotEqual_StriStri"), TEXT("!="));
+
+		// === TEXT COMPARISON OPERATORS ===
+		// Case Sensitive  
+		MathOperators.Add(TEXT("EqualEqual_TextText"), TEXT("==="));
+		MathOperators.Add(TEXT("NotEqual_TextText"), TEXT("!=="));
+
+		// Case Insensitive
+		MathOperators.Add(TEXT("EqualEqual_IgnoreCase_TextText"), TEXT("=="));
+		MathOperators.Add(TEXT("NotEqual_IgnoreCase_TextText"), TEXT("!="));
+
+
+		// Type Conversion Map
+		// Maps conversion node function names to a simplified target type name
+		TypeConversions.Add(TEXT("Conv_BoolToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_BoolToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_BoolToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_ByteToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_ByteToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_IntToByte"), TEXT("byte"));
+		TypeConversions.Add(TEXT("Conv_IntToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_IntToDouble"), TEXT("double"));
+		TypeConversions.Add(TEXT("Conv_IntToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_IntToInt64"), TEXT("int64"));
+		TypeConversions.Add(TEXT("Conv_Int64ToByte"), TEXT("byte"));
+		TypeConversions.Add(TEXT("Conv_Int64ToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_Int64ToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_FloatToBool"), TEXT("bool"));
+		TypeConversions.Add(TEXT("Conv_FloatToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_FloatToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_FloatToDouble"), TEXT("double"));
+		TypeConversions.Add(TEXT("Conv_DoubleToBool"), TEXT("bool"));
+		TypeConversions.Add(TEXT("Conv_DoubleToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_DoubleToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_DoubleToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_StringToBool"), TEXT("bool"));
+		TypeConversions.Add(TEXT("Conv_StringToInt"), TEXT("int"));
+		TypeConversions.Add(TEXT("Conv_StringToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_StringToName"), TEXT("name"));
+		TypeConversions.Add(TEXT("Conv_NameToBool"), TEXT("bool"));
+		TypeConversions.Add(TEXT("Conv_NameToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_ObjectToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_VectorToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_IntToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_FloatToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_StringToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_NameToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_ByteToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_BoolToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_VectorToStringNormalized"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_RotatorToStringNormalized"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_ObjectToStringNormalized"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_ObjectToText"), TEXT("Text"));
+		TypeConversions.Add(TEXT("Conv_TextToString"), TEXT("string"));
+		TypeConversions.Add(TEXT("Conv_TextToName"), TEXT("name"));
+		TypeConversions.Add(TEXT("Conv_TextToFloat"), TEXT("float"));
+		TypeConversions.Add(TEXT("Conv_TextToInt"), TEXT("int"));
+
+		// Common function names that act as conversions (e.g., "ToString (Vector)")
+		TypeConversions.Add(TEXT("ToString (Vector)"), TEXT("string"));
+		TypeConversions.Add(TEXT("ToString (Rotator)"), TEXT("string"));
+		TypeConversions.Add(TEXT("ToString (Object)"), TEXT("string"));
+		TypeConversions.Add(TEXT("ToText (int)"), TEXT("Text"));
+		TypeConversions.Add(TEXT("ToText (float)"), TEXT("Text"));
 
-	// --- END CORRECTION ---
+		// --- Register All Handlers ---
+		Register(EBlueprintNodeKind::VariableGet, &FNodeTraceHandlers_Basic::HandleVariableGet);
+		Register(EBlueprintNodeKind::Literal, &FNodeTraceHandlers_Basic::HandleLiteral);
+		Register(EBlueprintNodeKind::Self, &FNodeTraceHandlers_Basic::HandleSelf);
+		Register(EBlueprintNodeKind::VariableSet, &FNodeTraceHandlers_Basic::HandleVariableSet);
+		Register(EBlueprintNodeKind::PromotableOperator, &FNodeTraceHandlers_Operators::HandleOperator);
+		Register(EBlueprintNodeKind::CommutativeAssociativeBinaryOperator, &FNodeTraceHandlers_Operators::HandleOperator);
+		Register(EBlueprintNodeKind::BooleanNot, &FNodeTraceHandlers_Operators::HandleUnaryOperator); // Assumes BooleanNot NodeType
+		Register(EBlueprintNodeKind::BreakStruct, &FNodeTraceHandlers_Structs::HandleBreakStruct);
+		Register(EBlueprintNodeKind::MakeStruct, &FNodeTraceHandlers_Structs::HandleMakeStruct);
+		Register(EBlueprintNodeKind::SetFieldsInStruct, &FNodeTraceHandlers_Structs::HandleSetFieldsInStruct);
+		Register(EBlueprintNodeKind::CallFunction, &FNodeTraceHandlers_Functions::HandleCallFunction);
+		Register(EBlueprintNodeKind::CallParentFunction, &FNodeTraceHandlers_Functions::HandleCallFunction);
+		Register(EBlueprintNodeKind::MacroInstance, &FNodeTraceHandlers_Functions::HandleCallMacro);
+		Register(EBlueprintNodeKind::MakeArray, &FNodeTraceHandlers_Arrays::HandleMakeArray);
+		Register(EBlueprintNodeKind::GetArrayItem, &FNodeTraceHandlers_Arrays::HandleGetArrayItem);
+		Register(EBlueprintNodeKind::CallArrayFunction, &FNodeTraceHandlers_Arrays::HandleCallArrayFunction);
+		Register(EBlueprintNodeKind::CreateDelegate, &FNodeTraceHandlers_Delegates::HandleCreateDelegate);
+		Register(EBlueprintNodeKind::Select, &FNodeTraceHandlers_FlowControl::HandleSelect);
+		Register(EBlueprintNodeKind::SpawnActorFromClass, &FNodeTraceHandlers_ObjectMgmt::HandleSpawnActor);
+		Register(EBlueprintNodeKind::AddComponent, &FNodeTraceHandlers_ObjectMgmt::HandleAddComponent);
+		Register(EBlueprintNodeKind::CreateWidget, &FNodeTraceHandlers_ObjectMgmt::HandleCreateWidget);
+		Register(EBlueprintNodeKind::DynamicCast, &FNodeTraceHandlers_ObjectMgmt::HandleDynamicCast);
+		Register(EBlueprintNodeKind::GetClassDefaults, &FNodeTraceHandlers_ObjectMgmt::HandleGetClassDefaults);
+		Register(EBlueprintNodeKind::GetSubsystem, &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
+		Register(EBlueprintNodeKind::GetEngineSubsystem, &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
+		Register(EBlueprintNodeKind::GetSubsystemFromPC, &FNodeTraceHandlers_ObjectMgmt::HandleGetSubsystem);
+		Register(EBlueprintNodeKind::Timeline, &FNodeTraceHandlers_Timeline::HandleTimeline);
+		Register(EBlueprintNodeKind::Delay, &FNodeTraceHandlers_Latent::HandleLatentAction);
+		Register(EBlueprintNodeKind::MoveComponentTo, &FNodeTraceHandlers_Latent::HandleLatentAction);
+		Register(EBlueprintNodeKind::AIMoveTo, &FNodeTraceHandlers_Latent::HandleLatentAction);
+		Register(EBlueprintNodeKind::EnumEquality, &FNodeTraceHandlers_Enums::HandleEnumComparison);
+		Register(EBlueprintNodeKind::EnumInequality, &FNodeTraceHandlers_Enums::HandleEnumComparison);
+		Register(EBlueprintNodeKind::CastByteToEnum, &FNodeTraceHandlers_Enums::HandleCastByteToEnum);
+		Register(EBlueprintNodeKind::EnumLiteral, &FNodeTraceHandlers_Enums::HandleEnumLiteral);
+		Register(EBlueprintNodeKind::FunctionResult, &FNodeTraceHandlers_FunctionResult::HandleFunctionResult); // Added FunctionResult
+		Register(EBlueprintNodeKind::MakeMap, &FNodeTraceHandlers_Maps::HandleMakeMap);
+		Register(EBlueprintNodeKind::MakeSet, &FNodeTraceHandlers_Sets::HandleMakeSet); 
+		Register(EBlueprintNodeKind::FormatText, &FNodeTraceHandlers_Text::HandleFormatText); // Added FormatText
 
+		// --- CORRECTED Event Handler Registration ---
+		// Directly register common event types and the bound event types to the SAME handler.
+		Register(EBlueprintNodeKind::Tunnel, &FNodeTraceHandlers_Basic::HandleTunnel);
+		Register(EBlueprintNodeKind::Event, &FNodeTraceHandlers_Events::HandleEventOutputParam);
+		Register(EBlueprintNodeKind::CustomEvent, &FNodeTraceHandlers_Events::HandleEventOutputParam);
+		Register(EBlueprintNodeKind::ComponentBoundEvent, &FNodeTraceHandlers_Events::HandleEventOutputParam); // ADDED
+		Register(EBlueprintNodeKind::ActorBoundEvent, &FNodeTraceHandlers_Events::HandleEventOutputParam);     // ADDED
+		// Add other specific event node types if needed (e.g., InputAxisEvent, EnhancedInputAction)
+		Register(EBlueprintNodeKind::InputAxisEvent, &FNodeTraceHandlers_Events::HandleEventOutputParam);
+		Register(EBlueprintNodeKind::EnhancedInputAction, &FNodeTraceHandlers_Events::HandleEventOutputParam);
+		Register(EBlueprintNodeKind::InputAction, &FNodeTraceHandlers_Events::HandleEventOutputParam);
+		Register(EBlueprintNodeKind::InputKey, &FNodeTraceHandlers_Events::HandleEventOutputParam);
 
-	UE_LOG(LogDataTracer, Log, TEXT("FMarkdownDataTracer initialized. Registered %d handlers."), NodeHandlers.Num());
+		Register(EBlueprintNodeKind::GetDataTableRow, &FNodeTraceHandlers_DataTables::HandleGetDataTableRow);
+		Register(EBlueprintNodeKind::Composite, &FNodeTraceHandlers_Composite::HandleCompositeOutputPinValue);
+		Register(EBlueprintNodeKind::FunctionEntry, &FNodeTraceHandlers_Functions::HandleFunctionEntryPin);
+
+		// ... add others as identified ...
+
+		UE_LOG(LogDataTracer, Log, TEXT("FMarkdownDataTracer registry initialized. Registered %d handlers."), NumHandlers);
+	}
+
+	const FDataTracerRegistry& GetRegistry()
+	{
+		static const FDataTracerRegistry Registry;
+		return Registry;
+	}
+}
+
+FMarkdownDataTracer::FMarkdownDataTracer(const FBlueprintDataExtractor& InDataExtractor) : DataExtractorRef(InDataExtractor), MaxTraceDepth(BP2AIExportConfig::DataTraceMaxDepth)
+{
+}
+
+const TMap<FString, FString>& FMarkdownDataTracer::GetMathOperatorMap()
+{
+	return GetRegistry().MathOperators;
+}
+
+const TMap<FString, FString>& FMarkdownDataTracer::GetTypeConversionMap()
+{
+	return GetRegistry().TypeConversions;
 }
 
 
@@ -269,7 +319,7 @@ FMarkdownDataTracer::FMarkdownDataTracer(const FBlueprintDataExtractor& InDataEx
 // Entry point for tracing a specific pin's value
 FString FMarkdownDataTracer::TracePinValue(
 	TSharedPtr<const FBlueprintPin> PinToResolve,
-	const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
 	bool bSymbolicTrace,
 	const FString& CurrentBlueprintContext
 )
@@ -288,7 +338,7 @@ FString FMarkdownDataTracer::TracePinValue(
 		return FMarkdownSpan::Error(TEXT("[Pin missing ID or Node GUID]")); 
 	}
     
-	TSet<FString> VisitedPins; // Set to track visited pins during recursion to detect cycles
+	TSet<FResolvedPinKey> VisitedPins; // Set to track visited pins during recursion to detect cycles
     
 	// Pass the bSymbolicTrace flag AND the CurrentBlueprintContext to the recursive helper
 	return ResolvePinValueRecursive(
@@ -308,49 +358,78 @@ FString FMarkdownDataTracer::TracePinValue(
 void FMarkdownDataTracer::ClearCache()
 {
 	ResolvedPinCache.Empty();
+	ResolvedPinGraphRequests.Empty();
+	ResolvedPinBindingUses.Empty();
+	SharedBindings.Empty();
+	SharedBindingIndices.Empty();
+	SharedBindingNames.Empty();
+	PinCacheStats = FResolvedPinCacheStats();
+}
+
+int32 FMarkdownDataTracer::InternBlueprintContext(const FString& BlueprintContext)
+{
+	if (BlueprintContext.IsEmpty())
+	{
+		return 0;
+	}
+	if (const int32* ExistingId = BlueprintContextIds.Find(BlueprintContext))
+	{
+		return *ExistingId;
+	}
+	return BlueprintContextIds.Add(BlueprintContext, BlueprintContextIds.Num() + 1);
+}
+
+int32 FMarkdownDataTracer::GetPinKeyContextId(const FString& BlueprintContext)
+{
+	const int32 ContextId = InternBlueprintContext(BlueprintContext);
+	return AreSharedExpressionsActive() ? (ContextId | SharedExpressionContextFlag) : ContextId;
 }
 
 // --- Core Recursive Logic ---
 FString FMarkdownDataTracer::ResolvePinValueRecursive(
     TSharedPtr<const FBlueprintPin> PinToResolve,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
+    TSet<FResolvedPinKey>& VisitedPins,
     TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
     bool bSymbolicTrace,
     const FString& CurrentBlueprintContext
 )
 {
     check(PinToResolve.IsValid());
 
-    const TSharedPtr<FBlueprintNode>* OwningNodeForLogPtr = CurrentNodesMap.Find(PinToResolve->NodeGuid);
+    const TSharedPtr<FBlueprintNode>* OwningNodeForLogPtr = CurrentNodesMap.Find(PinToResolve->GraphNodeGuid);
     FString OwningNodeNameForLog = TEXT("UnknownNodeInCurrentMap");
     FString OwningNodeTypeForLog = TEXT("UnknownTypeInCurrentMap");
 
 	
     if (OwningNodeForLogPtr && OwningNodeForLogPtr->IsValid())
     {
-        OwningNodeNameForLog = (*OwningNodeForLogPtr)->Name.IsEmpty() ? (*OwningNodeForLogPtr)->NodeType : (*OwningNodeForLogPtr)->Name;
+        OwningNodeNameForLog = (*OwningNodeForLogPtr)->GetLogName();
         OwningNodeTypeForLog = (*OwningNodeForLogPtr)->NodeType;
     }
     else if (OuterNodesMap) 
     {
-        OwningNodeForLogPtr = OuterNodesMap->Find(PinToResolve->NodeGuid);
+        OwningNodeForLogPtr = OuterNodesMap->Find(PinToResolve->GraphNodeGuid);
         if (OwningNodeForLogPtr && OwningNodeForLogPtr->IsValid())
         {
-            OwningNodeNameForLog = ((*OwningNodeForLogPtr)->Name.IsEmpty() ? (*OwningNodeForLogPtr)->NodeType : (*OwningNodeForLogPtr)->Name) + TEXT(" (From OuterMap)");
+            OwningNodeNameForLog = (*OwningNodeForLogPtr)->GetLogName() + TEXT(" (From OuterMap)");
             OwningNodeTypeForLog = (*OwningNodeForLogPtr)->NodeType + TEXT(" (From OuterMap)");
         }
     }
     
-    const FString CacheKey = FString::Printf(TEXT("%s_%s_Ctx%s_Sym%d"), 
-        *PinToResolve->NodeGuid, 
-        *PinToResolve->Id, 
-        *CurrentBlueprintContext,
-        bSymbolicTrace);
+    const FResolvedPinKey CacheKey(*PinToResolve, GetPinKeyContextId(CurrentBlueprintContext), bSymbolicTrace);
 
-    UE_LOG(LogDataTracer, Error, TEXT("RVR Enter: Pin='%s' (ID:%s) on Node='%s' (GUID:%s, Type:%s), Depth:%d, Symbolic:%d. CtxRecv:'%s'. CacheKey:'%s'. CallingNode: %s (%s), OuterMap: %p, LinksIn:%d, DefVal:'%s', DefObj:'%s'"),
+    // 公共子表达式：来源是共享的纯节点输出时只返回绑定名，表达式由步骤前的 let 行给出
+    if (AreSharedExpressionsActive() && &CurrentNodesMap == SharedExpressionNodesMap && !CallingNode.IsValid() && !OuterNodesMap
+        && PinToResolve->IsInput() && PinToResolve->SourcePinFor.Num() > 0
+        && SharedExpressionSources.Contains(PinToResolve->SourcePinFor[0].Get()))
+    {
+        return ResolveSharedExpression(PinToResolve->SourcePinFor[0], CurrentNodesMap, Depth, VisitedPins, bSymbolicTrace, CurrentBlueprintContext);
+    }
+
+    UE_LOG(LogDataTracer, Error, TEXT("RVR Enter: Pin='%s' (ID:%s) on Node='%s' (GUID:%s, Type:%s), Depth:%d, Symbolic:%d. CtxRecv:'%s'. CallingNode: %s (%s), OuterMap: %p, LinksIn:%d, DefVal:'%s', DefObj:'%s'"),
         *PinToResolve->Name,
         *PinToResolve->Id.Left(8),
         *OwningNodeNameForLog,
@@ -359,8 +438,7 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
         Depth,
         bSymbolicTrace,
         *CurrentBlueprintContext,
-        *CacheKey,
-        CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL_Node"),
+        CallingNode.IsValid() ? *CallingNode->GetLogName() : TEXT("NULL_Node"),
         CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
         OuterNodesMap,
         PinToResolve->SourcePinFor.Num(),
@@ -368,42 +446,58 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
         *PinToResolve->DefaultObject
     );
 
-	// 🔧 NEW DEBUG: Show ALL possible source pins
-	UE_LOG(LogDataTracer, Error, TEXT("🔧 PIN RECURSION DEBUG: Pin='%s' has %d source connections:"), *PinToResolve->Name, PinToResolve->SourcePinFor.Num());
-	for (int32 i = 0; i < PinToResolve->SourcePinFor.Num(); ++i)
-	{
-		if (PinToResolve->SourcePinFor[i].IsValid())
-		{
-			// Get the source node info
-			FString SourceNodeGuid = PinToResolve->SourcePinFor[i]->NodeGuid;
-			TSharedPtr<FBlueprintNode> SourceNode = CurrentNodesMap.FindRef(SourceNodeGuid);
-			FString SourceNodeName = SourceNode.IsValid() ? SourceNode->Name : TEXT("UNKNOWN_NODE");
-			FString SourceNodeType = SourceNode.IsValid() ? SourceNode->NodeType : TEXT("UNKNOWN_TYPE");
-        
-			UE_LOG(LogDataTracer, Error, TEXT("🔧   Source[%d]: NodeGUID='%s', NodeName='%s', NodeType='%s', PinName='%s' (ID:%s)"), 
-				i, *SourceNodeGuid.Left(8), *SourceNodeName, *SourceNodeType, 
-				*PinToResolve->SourcePinFor[i]->Name, *PinToResolve->SourcePinFor[i]->Id.Left(8));
-		}
-		else
-		{
-			UE_LOG(LogDataTracer, Error, TEXT("🔧   Source[%d]: INVALID"), i);
-		}
-	}
-	
-
-	
     if (const FString* CachedValue = ResolvedPinCache.Find(CacheKey)) {
-        UE_LOG(LogDataTracer, Log, TEXT("RVR Cache Hit: Pin=%s (%s), CacheKey='%s' -> Result='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey, **CachedValue);
+        ++PinCacheStats.Hits;
+        if (const TArray<FTraceGraphDefinitionRequest>* GraphRequests = ResolvedPinGraphRequests.Find(CacheKey)) {
+            ReplayGraphRequests(*GraphRequests);
+        }
+        if (const TArray<int32>* BindingUses = ResolvedPinBindingUses.Find(CacheKey)) {
+            for (const int32 BindingIndex : *BindingUses) {
+                NoteSharedBindingUse(BindingIndex);
+            }
+        }
+        UE_LOG(LogDataTracer, Log, TEXT("RVR Cache Hit: Pin=%s (%s), CacheKey='%s' -> Result='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString(), **CachedValue);
         return *CachedValue;
     }
+
+    // 跨追踪缓存：结果只取决于图表内容和追踪设置时才参与。
+    // 调用点实参、CallingNode、外层节点表都来自本次追踪的调用链，这些情况下的结果不复用。
+    // 公共子表达式替换生效时结果含有本次追踪的绑定名，同样不复用。
+    TOptional<FResolvedPinValueKey> ValueKey;
+    if (!CallingNode.IsValid() && !OuterNodesMap && !CurrentCallsiteArgumentsPtr && !AreSharedExpressionsActive()
+        && OwningNodeForLogPtr && OwningNodeForLogPtr->IsValid() && !(*OwningNodeForLogPtr)->OriginalEdGraphNode.IsExplicitlyNull())
+    {
+        ValueKey.Emplace((*OwningNodeForLogPtr)->OriginalEdGraphNode, PinToResolve->GraphPinId, CurrentBlueprintContext, (*OwningNodeForLogPtr)->NodeSetHash,
+            FResolvedPinValueCache::Get().GetEditEpoch(), bSymbolicTrace, bCurrentShowTrivialDefaultParams,
+            static_cast<uint8>(FMarkdownSpanSystem::GetCurrentContext().GetOutputFormat()), MaxTraceDepth);
+
+        FString SessionValue;
+        TArray<FTraceGraphDefinitionRequest> SessionGraphRequests;
+        if (FResolvedPinValueCache::Get().Find(*ValueKey, SessionValue, SessionGraphRequests)) {
+            ++PinCacheStats.SessionHits;
+            ReplayGraphRequests(SessionGraphRequests);
+            if (SessionGraphRequests.Num() > 0) {
+                ResolvedPinGraphRequests.Add(CacheKey, MoveTemp(SessionGraphRequests));
+            }
+            ResolvedPinCache.Add(CacheKey, SessionValue);
+            UE_LOG(LogDataTracer, Log, TEXT("RVR Session Cache Hit: Pin=%s (%s), CacheKey='%s' -> Result='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString(), *SessionValue);
+            return SessionValue;
+        }
+    }
+    ++PinCacheStats.Misses;
     if (Depth > MaxTraceDepth) { 
-        UE_LOG(LogDataTracer, Warning, TEXT("RVR Max Depth: Pin=%s (%s), CacheKey='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey);
+        UE_LOG(LogDataTracer, Warning, TEXT("RVR Max Depth: Pin=%s (%s), CacheKey='%s', Depth=%d, OpenFrames=%d"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString(), Depth, OpenResolveFrames);
         return FMarkdownSpan::Error(TEXT("[Trace Depth Limit]")); 
     }
+    // 栈保护与 MaxDataTraceDepth 无关：跨图表嵌套过深时即使逻辑深度未到上限也在此截断，单独标记以便区分
+    if (OpenResolveFrames >= MaxOpenResolveFrames) {
+        UE_LOG(LogDataTracer, Warning, TEXT("RVR Nesting Limit: Pin=%s (%s), CacheKey='%s', Depth=%d, OpenFrames=%d (limit %d)"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString(), Depth, OpenResolveFrames, MaxOpenResolveFrames);
+        return FMarkdownSpan::Error(TEXT("[Trace Nesting Limit]")); 
+    }
 
     if (VisitedPins.Contains(CacheKey)) {
-        UE_LOG(LogDataTracer, Warning, TEXT("RVR Cycle Detected: Pin=%s (%s), CacheKey='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey);
-        const TSharedPtr<FBlueprintNode>* OwningNodePtrCycle = CurrentNodesMap.Find(PinToResolve->NodeGuid); // Re-fetch with CurrentNodesMap
+        UE_LOG(LogDataTracer, Warning, TEXT("RVR Cycle Detected: Pin=%s (%s), CacheKey='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString());
+        const TSharedPtr<FBlueprintNode>* OwningNodePtrCycle = CurrentNodesMap.Find(PinToResolve->GraphNodeGuid); // Re-fetch with CurrentNodesMap
         if (OwningNodePtrCycle && OwningNodePtrCycle->IsValid() && (*OwningNodePtrCycle)->NodeType == TEXT("VariableGet")){
              const FString* VarName = (*OwningNodePtrCycle)->RawProperties.Find(TEXT("VariableName"));
              return FMarkdownSpan::Variable(FString::Printf(TEXT("%s"), VarName ? **VarName : TEXT("Var?")));
@@ -412,6 +506,10 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
     }
     VisitedPins.Add(CacheKey);
 
+    const int32 GraphRequestStart = RecordedGraphRequests.Num();
+    const int32 BindingUseStart = RecordedBindingUses.Num();
+    ++OpenResolveFrames;
+
     FString Result = FMarkdownSpan::Error(TEXT("[Failed Trace]"));
 
     try {
@@ -443,9 +541,9 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
         }
 
         if (SourceDataPin.IsValid() && !SourceDataPin->NodeGuid.IsEmpty()) {
-           const TSharedPtr<FBlueprintNode>* SourceNodePtr = CurrentNodesMap.Find(SourceDataPin->NodeGuid);
+           const TSharedPtr<FBlueprintNode>* SourceNodePtr = CurrentNodesMap.Find(SourceDataPin->GraphNodeGuid);
            if (!SourceNodePtr && OuterNodesMap) { // Try finding in outer map if not in current
-                SourceNodePtr = OuterNodesMap->Find(SourceDataPin->NodeGuid);
+                SourceNodePtr = OuterNodesMap->Find(SourceDataPin->GraphNodeGuid);
                 if(SourceNodePtr) { UE_LOG(LogDataTracer, Warning, TEXT("  RVR: SourceNode for SourceDataPin '%s' found in OuterNodesMap."), *SourceDataPin->Name); }
            }
 
@@ -453,8 +551,12 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
               UE_LOG(LogDataTracer, Error, TEXT("  RVR: Pin '%s' (ID:%s) has SourceDataPin '%s' (ID:%s) on Node '%s' (GUID:%s, Type:%s). Calling TraceSourceNode. CtxToPass:'%s'"),
                   *PinToResolve->Name, *PinToResolve->Id.Left(8),
                   *SourceDataPin->Name, *SourceDataPin->Id.Left(8),
-                  *(*SourceNodePtr)->Name, *(*SourceNodePtr)->Guid.Left(8), *(*SourceNodePtr)->NodeType,
+                  *(*SourceNodePtr)->GetLogName(), *(*SourceNodePtr)->Guid.Left(8), *(*SourceNodePtr)->NodeType,
                   *CurrentBlueprintContext);
+              // 先迭代解析同一图表内的上游，处理器里的递归随后只会命中缓存
+              if (CurrentNodesMap.Contains(SourceDataPin->GraphNodeGuid)) {
+                  PrimeUpstreamPins(**SourceNodePtr, Depth + 1, CurrentNodesMap, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+              }
               Result = TraceSourceNode(*SourceNodePtr, SourceDataPin, CurrentNodesMap, Depth + 1, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
            } else {
               UE_LOG(LogDataTracer, Error, TEXT("  RVR: Pin '%s' (ID:%s) - SourceNode for SourceDataPin '%s' (NodeGUID:%s) NOT FOUND in CurrentNodesMap or OuterNodesMap. Defaulting value."),
@@ -469,24 +571,180 @@ FString FMarkdownDataTracer::ResolvePinValueRecursive(
         }
     } 
     catch (...) {
-        UE_LOG(LogDataTracer, Error, TEXT("RVR Exception occurred for Pin: %s (%s), CacheKey='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey);
+        UE_LOG(LogDataTracer, Error, TEXT("RVR Exception occurred for Pin: %s (%s), CacheKey='%s'"), *PinToResolve->Name, *PinToResolve->Id.Left(8), *CacheKey.ToString());
         Result = FMarkdownSpan::Error(TEXT("[Trace Exception]"));
     }
 
     VisitedPins.Remove(CacheKey);
     ResolvedPinCache.Add(CacheKey, Result);
-    UE_LOG(LogDataTracer, Log, TEXT("RVR Exit : Pin=%s (ID:%s), Depth=%d, ContextIn='%s', CacheKey='%s' -> Result='%s'. Caching."), *PinToResolve->Name, *PinToResolve->Id.Left(8), Depth, *CurrentBlueprintContext, *CacheKey, *Result);
+
+    const TArrayView<const FTraceGraphDefinitionRequest> GraphRequests(
+        RecordedGraphRequests.GetData() + GraphRequestStart, RecordedGraphRequests.Num() - GraphRequestStart);
+    if (GraphRequests.Num() > 0) {
+        ResolvedPinGraphRequests.Add(CacheKey, TArray<FTraceGraphDefinitionRequest>(GraphRequests));
+    }
+    if (RecordedBindingUses.Num() > BindingUseStart) {
+        ResolvedPinBindingUses.Add(CacheKey, TArray<int32>(RecordedBindingUses.GetData() + BindingUseStart, RecordedBindingUses.Num() - BindingUseStart));
+    }
+    // 循环/深度截断的结果取决于本次调用链，不跨追踪复用
+    if (ValueKey.IsSet()
+        && !Result.Contains(TEXT("[Cycle->"), ESearchCase::CaseSensitive)
+        && !Result.Contains(TEXT("[Trace Depth Limit]"), ESearchCase::CaseSensitive)
+        && !Result.Contains(TEXT("[Trace Nesting Limit]"), ESearchCase::CaseSensitive)) {
+        FResolvedPinValueCache::Get().Add(*ValueKey, Result, GraphRequests);
+    }
+    if (--OpenResolveFrames == 0) {
+        RecordedGraphRequests.Reset();
+        RecordedBindingUses.Reset();
+    }
+    UE_LOG(LogDataTracer, Log, TEXT("RVR Exit : Pin=%s (ID:%s), Depth=%d, ContextIn='%s', CacheKey='%s' -> Result='%s'. Caching."), *PinToResolve->Name, *PinToResolve->Id.Left(8), Depth, *CurrentBlueprintContext, *CacheKey.ToString(), *Result);
     return Result;
 }
 
 
+namespace
+{
+	// 处理器会在相同的图表和调用上下文中解析其全部已连接数据输入的纯节点种类。
+	// 跨图表的节点（宏、折叠图、隧道、函数入口/结果）和事件只作为叶子，由处理器自行递归。
+	bool CanPrimeInputsOf(const FBlueprintNode& Node)
+	{
+		switch (Node.NodeKind)
+		{
+		case EBlueprintNodeKind::Knot:
+		case EBlueprintNodeKind::NiagaraReroute:
+		case EBlueprintNodeKind::PromotableOperator:
+		case EBlueprintNodeKind::CommutativeAssociativeBinaryOperator:
+		case EBlueprintNodeKind::BooleanNot:
+		case EBlueprintNodeKind::BreakStruct:
+		case EBlueprintNodeKind::MakeStruct:
+		case EBlueprintNodeKind::CallFunction:
+		case EBlueprintNodeKind::MakeArray:
+		case EBlueprintNodeKind::GetArrayItem:
+		case EBlueprintNodeKind::CallArrayFunction:
+		case EBlueprintNodeKind::MakeMap:
+		case EBlueprintNodeKind::MakeSet:
+		case EBlueprintNodeKind::Select:
+		case EBlueprintNodeKind::EnumEquality:
+		case EBlueprintNodeKind::EnumInequality:
+		case EBlueprintNodeKind::CastByteToEnum:
+		case EBlueprintNodeKind::FormatText:
+			// 带执行引脚的节点只输出符号名，不解析输入
+			return Node.IsPure();
+		default:
+			return false;
+		}
+	}
+
+	// 工作栈和状态表都分配在线程的 FMemStack 上，PrimeUpstreamPins 返回时整体释放
+	using FMemStackSetAllocator = TSetAllocator<TSparseArrayAllocator<TMemStackAllocator<>, TMemStackAllocator<>>, TMemStackAllocator<>>;
+}
+
+void FMarkdownDataTracer::PrimeUpstreamPins(
+	const FBlueprintNode& SourceNode,
+	int32 SourceDepth,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+	TSet<FResolvedPinKey>& VisitedPins,
+	const TSharedPtr<const FBlueprintNode>& CallingNode,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+	bool bSymbolicTrace,
+	const FString& CurrentBlueprintContext)
+{
+	if (!CanPrimeInputsOf(SourceNode))
+	{
+		return;
+	}
+
+	struct FPrimeItem
+	{
+		const TSharedPtr<FBlueprintPin>* Pin;
+		int32 Depth;
+		bool bExpanded;
+	};
+
+	FMemMark Mark(FMemStack::Get());
+	TArray<FPrimeItem, TMemStackAllocator<>> WorkStack;
+	// false = 已展开、仍在当前路径上（再次遇到即为环，交给递归解析报告）；true = 已解析
+	TMap<const FBlueprintPin*, bool, FMemStackSetAllocator> PinStates;
+	const int32 ContextId = GetPinKeyContextId(CurrentBlueprintContext);
+	int32 NumPrimed = 0;
+
+	// 输入引脚的深度与处理器路径一致：RVR(D) → TraceSourceNode(D+1) → 处理器 RVR(D+2)，即每层 +2，
+	// SourceNode 自身的输入为 SourceDepth+1。超出上限的不入栈，由处理器递归到该引脚时直接得到 [Trace Depth Limit]
+	auto PushInputsOf = [&](const FBlueprintNode& Node, int32 PinDepth)
+	{
+		if (PinDepth > MaxTraceDepth)
+		{
+			return;
+		}
+		const int32 FirstNew = WorkStack.Num();
+		for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& PinPair : Node.Pins)
+		{
+			const TSharedPtr<FBlueprintPin>& Pin = PinPair.Value;
+			if (!Pin.IsValid() || !Pin->IsInput() || Pin->IsExecution() || Pin->SourcePinFor.Num() == 0 || PinStates.Contains(Pin.Get()))
+			{
+				continue;
+			}
+			const FResolvedPinKey Key(*Pin, ContextId, bSymbolicTrace);
+			if (ResolvedPinCache.Contains(Key) || VisitedPins.Contains(Key))
+			{
+				continue;
+			}
+			WorkStack.Add({ &Pin, PinDepth, false });
+		}
+		// 反转新入栈的部分，使出栈顺序与处理器按引脚顺序解析时一致（影响图表定义的登记顺序）
+		TArrayView<FPrimeItem> NewItems(WorkStack.GetData() + FirstNew, WorkStack.Num() - FirstNew);
+		Algo::Reverse(NewItems);
+	};
+
+	PushInputsOf(SourceNode, SourceDepth + 1);
+
+	while (WorkStack.Num() > 0)
+	{
+		FPrimeItem& Top = WorkStack.Last();
+		const FBlueprintPin* TopPin = Top.Pin->Get();
+
+		if (Top.bExpanded)
+		{
+			const FPrimeItem Item = WorkStack.Pop(EAllowShrinking::No);
+			ResolvePinValueRecursive(*Item.Pin, CurrentNodesMap, Item.Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+			PinStates.Add(TopPin, true);
+			++NumPrimed;
+			continue;
+		}
+
+		// 同一引脚可能被多个下游重复入栈：已解析的直接丢弃，已在路径上的说明存在环
+		if (PinStates.Contains(TopPin))
+		{
+			WorkStack.Pop(EAllowShrinking::No);
+			continue;
+		}
+
+		Top.bExpanded = true;
+		PinStates.Add(TopPin, false);
+		const int32 NextDepth = Top.Depth + 2;
+
+		const TSharedPtr<FBlueprintPin>& SourcePin = TopPin->SourcePinFor[0];
+		const TSharedPtr<FBlueprintNode>* UpstreamNode = SourcePin.IsValid() ? CurrentNodesMap.Find(SourcePin->GraphNodeGuid) : nullptr;
+		if (UpstreamNode && UpstreamNode->IsValid() && CanPrimeInputsOf(**UpstreamNode))
+		{
+			// 可能重新分配 WorkStack，Top 此后失效
+			PushInputsOf(**UpstreamNode, NextDepth);
+		}
+	}
+
+	if (NumPrimed > 0)
+	{
+		UE_LOG(LogDataTracer, Verbose, TEXT("PrimeUpstreamPins: Resolved %d upstream pin(s) of '%s' iteratively (Depth %d)."), NumPrimed, *SourceNode.GetLogName(), SourceDepth);
+	}
+}
+
 // --- Helper to trace the Target pin of a function call ---
 // In Private\Trace\MarkdownDataTracer.cpp
 FString FMarkdownDataTracer::TraceTargetPin(
     TSharedPtr<const FBlueprintPin> TargetPin,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
     int32 Depth,
-    TSet<FString>& VisitedPins,
+    TSet<FResolvedPinKey>& VisitedPins,
     const FString& CurrentBlueprintContext)
 {
     if (!TargetPin.IsValid())
@@ -497,7 +755,7 @@ FString FMarkdownDataTracer::TraceTargetPin(
     }
 
     UE_LOG(LogDataTracer, Log, TEXT("  TraceTargetPin: Processing PinName='%s', NodeGuid='%s', Direction='%s', Category='%s', DefaultObject='%s', Context='%s'"),
-        *TargetPin->Name, *TargetPin->NodeGuid, *TargetPin->Direction, *TargetPin->Category, *TargetPin->DefaultObject, *CurrentBlueprintContext);
+        *TargetPin->Name, *TargetPin->NodeGuid, TargetPin->GetDirectionString(), *TargetPin->Category, *TargetPin->DefaultObject, *CurrentBlueprintContext);
 
     if (TargetPin->SourcePinFor.Num() == 0) // Unlinked pin
     {
@@ -548,11 +806,11 @@ FString FMarkdownDataTracer::TraceTargetPin(
 FString FMarkdownDataTracer::TraceSourceNode(
     TSharedPtr<const FBlueprintNode> SourceNode,
     TSharedPtr<const FBlueprintPin> SourcePin, 
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
     int32 Depth,
-    TSet<FString>& VisitedPins,
+    TSet<FResolvedPinKey>& VisitedPins,
     TSharedPtr<const FBlueprintNode> CallingNode,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
     bool bSymbolicTrace,
     const FString& CurrentBlueprintContext // New parameter received
 )
@@ -573,9 +831,16 @@ FString FMarkdownDataTracer::TraceSourceNode(
         bSymbolicTrace,
         *CurrentBlueprintContext); // Log context
 
-    if (NodeTypeToLookup == TEXT("Knot") || NodeTypeToLookup == TEXT("NiagaraReroute"))
+    // 种类在提取时已分类；只有绕过工厂直接构造的节点才需要在这里补算
+    EBlueprintNodeKind NodeKind = SourceNode->NodeKind;
+    if (NodeKind == EBlueprintNodeKind::Unknown)
     {
-        UE_LOG(LogDataTracer, Verbose, TEXT("  TraceSourceNode: Detected Reroute Node '%s'. Finding input pin to trace..."), *SourceNode->Name);
+        NodeKind = BlueprintNodeKind::FromNodeType(NodeTypeToLookup);
+    }
+
+    if (NodeKind == EBlueprintNodeKind::Knot || NodeKind == EBlueprintNodeKind::NiagaraReroute)
+    {
+        UE_LOG(LogDataTracer, Verbose, TEXT("  TraceSourceNode: Detected Reroute Node '%s'. Finding input pin to trace..."), *SourceNode->GetLogName());
         TSharedPtr<const FBlueprintPin> RerouteInputPin;
         for (const auto& Pair : SourceNode->Pins) {
             if (Pair.Value.IsValid() && Pair.Value->IsInput() && !Pair.Value->IsExecution()) {
@@ -596,26 +861,26 @@ FString FMarkdownDataTracer::TraceSourceNode(
     }
 
 	UE_LOG(LogDataTracer, Log, TEXT("    TraceSourceNode Dispatch: Trying Node='%s' (Type:'%s', GUID:%s), Pin='%s'. CtxRecv:'%s', Symbolic:%d"),
-		*SourceNode->Name,
+		*SourceNode->GetLogName(),
 		*NodeTypeToLookup,
 		*SourceNode->Guid.Left(8),
 		*SourcePin->Name,
 		*CurrentBlueprintContext,
 		bSymbolicTrace);
 
-	if (NodeHandlers.Contains(NodeTypeToLookup))
+	if (const FNodeTraceHandlerFunc Handler = GetRegistry().GetHandler(NodeKind))
 	{
-		FNodeTraceHandlerFunc* Handler = NodeHandlers.Find(NodeTypeToLookup);
 		UE_LOG(LogDataTracer, Log, TEXT("      TraceSourceNode: Found handler for '%s'. CtxToPass:'%s'. CallingNode: %s (%s)"),
 			*NodeTypeToLookup,
 			*CurrentBlueprintContext,
-			CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL"),
+			CallingNode.IsValid() ? *CallingNode->GetLogName() : TEXT("NULL"),
 			CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID")
 			);
-		return (*Handler)(SourceNode, SourcePin, this, CurrentNodesMap, Depth, VisitedPins, DataExtractorRef, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
+		const FNodeTraceContext TraceContext{ CurrentNodesMap, VisitedPins, DataExtractorRef, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext };
+		return Handler(SourceNode, SourcePin, this, Depth, TraceContext);
 	}
 
-    UE_LOG(LogDataTracer, Warning, TEXT("    TraceSourceNode: No handler registered for Node Type = '%s' (Node Name: '%s'). Using fallback format."), *NodeTypeToLookup, *SourceNode->Name);
+    UE_LOG(LogDataTracer, Warning, TEXT("    TraceSourceNode: No handler registered for Node Type = '%s' (Node Name: '%s'). Using fallback format."), *NodeTypeToLookup, *SourceNode->GetLogName());
     FString PinNameStr = SourcePin->Name;
     return FMarkdownSpan::Info(TEXT("ValueFrom")) + FString::Printf(TEXT("(%s.`%s`)"),
         *NodeTypeToLookup, 
@@ -635,6 +900,7 @@ void FMarkdownDataTracer::StartTraceSession(
 	CurrentProcessedSeparateGraphPathsPtr = ProcessedSeparateGraphPathsPtr;
 	this->bCurrentShowTrivialDefaultParams = bInShowTrivialDefaultParams;
 	this->CurrentSettings = InSettings; // Store the settings
+	MaxTraceDepth = InSettings ? FMath::Max(1, InSettings->MaxDataTraceDepth) : BP2AIExportConfig::DataTraceMaxDepth;
 
 	UE_LOG(LogDataTracer, Log, TEXT("DataTracer::StartTraceSession: Context pointers set. Queue: %p, ProcessedSet: %p, ShowTrivialDefaults: %s, Settings Ptr: %p"),
 		   CurrentGraphsToDefineSeparatelyPtr,
@@ -643,12 +909,373 @@ void FMarkdownDataTracer::StartTraceSession(
 		   CurrentSettings);
 }
 
+void FMarkdownDataTracer::QueueGraphForSeparateDefinition(const FString& NameHint, const FString& GraphPath, FMarkdownPathTracer::EUserGraphType GraphType)
+{
+	FTraceGraphDefinitionRequest Request(NameHint, GraphPath, GraphType);
+
+	// 无论是否真正入队都要记录：缓存的结果在其他追踪中重放时，队列状态可能不同
+	if (OpenResolveFrames > 0)
+	{
+		RecordedGraphRequests.Add(Request);
+	}
+
+	if (!CurrentGraphsToDefineSeparatelyPtr || !CurrentProcessedSeparateGraphPathsPtr)
+	{
+		UE_LOG(LogDataTracer, Log, TEXT("QueueGraphForSeparateDefinition: No trace session queue, skipping '%s'."), *GraphPath);
+		return;
+	}
+	if (CurrentProcessedSeparateGraphPathsPtr->Contains(GraphPath))
+	{
+		UE_LOG(LogDataTracer, Log, TEXT("QueueGraphForSeparateDefinition: '%s' already processed."), *GraphPath);
+		return;
+	}
+	if (CurrentGraphsToDefineSeparatelyPtr->Contains(Request))
+	{
+		UE_LOG(LogDataTracer, Log, TEXT("QueueGraphForSeparateDefinition: '%s' already queued."), *GraphPath);
+		return;
+	}
+
+	CurrentGraphsToDefineSeparatelyPtr->Add(MoveTemp(Request));
+	UE_LOG(LogDataTracer, Log, TEXT("QueueGraphForSeparateDefinition: Queued '%s' (Hint '%s'), queue size %d."),
+		*GraphPath, *NameHint, CurrentGraphsToDefineSeparatelyPtr->Num());
+}
+
+void FMarkdownDataTracer::ReplayGraphRequests(TArrayView<const FTraceGraphDefinitionRequest> GraphRequests)
+{
+	for (const FTraceGraphDefinitionRequest& Request : GraphRequests)
+	{
+		QueueGraphForSeparateDefinition(Request.Get<0>(), Request.Get<1>(), Request.Get<2>());
+	}
+}
+
+namespace
+{
+	bool IsRerouteNode(const FBlueprintNode& Node)
+	{
+		return Node.NodeKind == EBlueprintNodeKind::Knot || Node.NodeKind == EBlueprintNodeKind::NiagaraReroute;
+	}
+
+	// 本身就是简短符号的节点不值得绑定；跨图表的入口/隧道由各自的处理器展开
+	bool CanShareOutputOf(const FBlueprintNode& Node)
+	{
+		switch (Node.NodeKind)
+		{
+		case EBlueprintNodeKind::VariableGet:
+		case EBlueprintNodeKind::Self:
+		case EBlueprintNodeKind::Literal:
+		case EBlueprintNodeKind::EnumLiteral:
+		case EBlueprintNodeKind::Knot:
+		case EBlueprintNodeKind::NiagaraReroute:
+		case EBlueprintNodeKind::FunctionEntry:
+		case EBlueprintNodeKind::Tunnel:
+			return false;
+		default:
+			return Node.IsPure();
+		}
+	}
+
+	// 重路由链的跳数上限，防止异常数据中的环
+	constexpr int32 MaxRerouteHops = 64;
+
+	// 从 StartNode 出发本次追踪会渲染输入的节点：执行链可达的节点，以及它们数据上游的纯节点。
+	// 上游的非纯节点只以输出符号出现，不展开输入，也不沿它的执行输出继续
+	void CollectTracedConsumers(
+		const FBlueprintNode& StartNode,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+		TSet<const FBlueprintNode*>& OutConsumers)
+	{
+		TSet<const FBlueprintNode*> ExecNodes;
+		TSet<const FBlueprintNode*> DataNodes;
+		TArray<TPair<const FBlueprintNode*, bool>> WorkStack;	// 节点，是否经执行链到达
+
+		auto VisitNode = [&](const FGuid& NodeGuid, bool bViaExec)
+		{
+			const TSharedPtr<FBlueprintNode>* Found = AllNodes.Find(NodeGuid);
+			if (!Found || !Found->IsValid())
+			{
+				return;
+			}
+			const FBlueprintNode* Node = Found->Get();
+			if (ExecNodes.Contains(Node) || (!bViaExec && DataNodes.Contains(Node)))
+			{
+				return;
+			}
+			(bViaExec ? ExecNodes : DataNodes).Add(Node);
+			WorkStack.Emplace(Node, bViaExec);
+		};
+
+		ExecNodes.Add(&StartNode);
+		WorkStack.Emplace(&StartNode, true);
+		while (WorkStack.Num() > 0)
+		{
+			const TPair<const FBlueprintNode*, bool> Item = WorkStack.Pop(EAllowShrinking::No);
+			const FBlueprintNode& Node = *Item.Key;
+			const bool bViaExec = Item.Value;
+			if (!bViaExec && !Node.IsPure() && !IsRerouteNode(Node))
+			{
+				continue;
+			}
+			if (!IsRerouteNode(Node))
+			{
+				OutConsumers.Add(&Node);
+			}
+
+			for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& PinPair : Node.Pins)
+			{
+				const FBlueprintPin* Pin = PinPair.Value.Get();
+				if (!Pin)
+				{
+					continue;
+				}
+				if (Pin->IsExecution())
+				{
+					if (bViaExec && Pin->IsOutput())
+					{
+						for (const TSharedPtr<FBlueprintPin>& Linked : Pin->LinkedPins)
+						{
+							if (Linked.IsValid())
+							{
+								VisitNode(Linked->GraphNodeGuid, true);
+							}
+						}
+					}
+				}
+				else if (Pin->IsInput() && Pin->SourcePinFor.Num() > 0 && Pin->SourcePinFor[0].IsValid())
+				{
+					VisitNode(Pin->SourcePinFor[0]->GraphNodeGuid, false);
+				}
+			}
+		}
+	}
+}
+
+void FMarkdownDataTracer::BeginSharedExpressionScope(
+	const FBlueprintNode& StartNode,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes)
+{
+	EndSharedExpressionScope();
+
+	const int32 MinUses = CurrentSettings ? CurrentSettings->SharedExpressionMinUses : 0;
+	if (MinUses < 2)
+	{
+		return;
+	}
+
+	// 只统计本次追踪会渲染的消费者：图中其他事件链对同一输出的引用不会出现在这段输出里
+	TSet<const FBlueprintNode*> Consumers;
+	CollectTracedConsumers(StartNode, AllNodes, Consumers);
+
+	// 统计每个输出引脚被多少个（穿过重路由后的）数据输入引用
+	TMap<const FBlueprintPin*, int32> UseCounts;
+	for (const FBlueprintNode* Node : Consumers)
+	{
+		for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& PinPair : Node->Pins)
+		{
+			const FBlueprintPin* Pin = PinPair.Value.Get();
+			if (!Pin || !Pin->IsInput() || Pin->IsExecution() || Pin->SourcePinFor.Num() == 0)
+			{
+				continue;
+			}
+
+			const FBlueprintPin* Source = Pin->SourcePinFor[0].Get();
+			for (int32 Hop = 0; Source && Hop < MaxRerouteHops; ++Hop)
+			{
+				const TSharedPtr<FBlueprintNode>* SourceNode = AllNodes.Find(Source->GraphNodeGuid);
+				if (!SourceNode || !SourceNode->IsValid() || !IsRerouteNode(**SourceNode))
+				{
+					break;
+				}
+				const FBlueprintPin* RerouteInput = nullptr;
+				for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& ReroutePinPair : (*SourceNode)->Pins)
+				{
+					if (ReroutePinPair.Value.IsValid() && ReroutePinPair.Value->IsInput() && ReroutePinPair.Value->SourcePinFor.Num() > 0)
+					{
+						RerouteInput = ReroutePinPair.Value.Get();
+						break;
+					}
+				}
+				Source = RerouteInput ? RerouteInput->SourcePinFor[0].Get() : nullptr;
+			}
+			if (Source)
+			{
+				++UseCounts.FindOrAdd(Source);
+			}
+		}
+	}
+
+	for (const TPair<const FBlueprintPin*, int32>& UseCount : UseCounts)
+	{
+		if (UseCount.Value < MinUses)
+		{
+			continue;
+		}
+		const TSharedPtr<FBlueprintNode>* SourceNode = AllNodes.Find(UseCount.Key->GraphNodeGuid);
+		if (SourceNode && SourceNode->IsValid() && CanShareOutputOf(**SourceNode))
+		{
+			SharedExpressionSources.Add(UseCount.Key);
+		}
+	}
+
+	if (SharedExpressionSources.Num() > 0)
+	{
+		SharedExpressionNodesMap = &AllNodes;
+		UE_LOG(LogDataTracer, Log, TEXT("BeginSharedExpressionScope: %d pure output(s) referenced at least %d times will be bound once."),
+			SharedExpressionSources.Num(), MinUses);
+	}
+}
+
+void FMarkdownDataTracer::EndSharedExpressionScope()
+{
+	SharedExpressionNodesMap = nullptr;
+	SharedExpressionSources.Reset();
+	PendingSharedBindings.Reset();
+	DeclaredSharedBindings.Reset();
+}
+
+void FMarkdownDataTracer::TakePendingSharedBindings(TArray<FString>& OutBindingLines)
+{
+	for (const int32 BindingIndex : PendingSharedBindings)
+	{
+		const FSharedExpressionBinding& Binding = SharedBindings[BindingIndex];
+		OutBindingLines.Add(FString::Printf(TEXT("%s %s = %s"),
+			*FMarkdownSpan::Keyword(TEXT("let")), *FMarkdownSpan::Variable(Binding.Name), *Binding.Expression));
+	}
+	PendingSharedBindings.Reset();
+}
+
+void FMarkdownDataTracer::DiscardPendingSharedBindings()
+{
+	// 引用它们的行没有写出，下次引用时重新进入待写列表
+	for (const int32 BindingIndex : PendingSharedBindings)
+	{
+		DeclaredSharedBindings.Remove(BindingIndex);
+	}
+	PendingSharedBindings.Reset();
+}
+
+FString FMarkdownDataTracer::ResolveSharedExpression(
+	const TSharedPtr<const FBlueprintPin>& SourcePin,
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+	int32 Depth,
+	TSet<FResolvedPinKey>& VisitedPins,
+	bool bSymbolicTrace,
+	const FString& CurrentBlueprintContext)
+{
+	const FResolvedPinKey SourceKey(*SourcePin, GetPinKeyContextId(CurrentBlueprintContext), bSymbolicTrace);
+
+	int32 BindingIndex = INDEX_NONE;
+	if (const int32* ExistingIndex = SharedBindingIndices.Find(SourceKey))
+	{
+		BindingIndex = *ExistingIndex;
+	}
+	else
+	{
+		// 解析输出引脚本身；表达式中对其他共享输出的引用已替换为绑定名，并记录在该键下
+		FString Expression = ResolvePinValueRecursive(SourcePin, CurrentNodesMap, Depth, VisitedPins, nullptr, nullptr, bSymbolicTrace, CurrentBlueprintContext);
+
+		const TSharedPtr<FBlueprintNode>* SourceNode = CurrentNodesMap.Find(SourcePin->GraphNodeGuid);
+		FSharedExpressionBinding& Binding = SharedBindings.AddDefaulted_GetRef();
+		Binding.SourceKey = SourceKey;
+		Binding.Name = MakeSharedBindingName(*SourcePin, SourceNode ? SourceNode->Get() : nullptr);
+		Binding.Expression = MoveTemp(Expression);
+		Binding.Dependencies = ResolvedPinBindingUses.FindRef(SourceKey);
+
+		BindingIndex = SharedBindings.Num() - 1;
+		SharedBindingIndices.Add(SourceKey, BindingIndex);
+	}
+
+	NoteSharedBindingUse(BindingIndex);
+	return FMarkdownSpan::Variable(SharedBindings[BindingIndex].Name);
+}
+
+FString FMarkdownDataTracer::MakeSharedBindingName(const FBlueprintPin& SourcePin, const FBlueprintNode* SourceNode)
+{
+	auto Sanitize = [](const FString& Text)
+	{
+		FString Result;
+		Result.Reserve(Text.Len());
+		for (const TCHAR Char : Text)
+		{
+			if (FChar::IsAlnum(Char) || Char == TEXT('_'))
+			{
+				Result.AppendChar(Char);
+			}
+		}
+		return Result;
+	};
+
+	FString BaseName = SourceNode ? Sanitize(SourceNode->GetName()) : FString();
+	if (BaseName.IsEmpty() || FChar::IsDigit(BaseName[0]))
+	{
+		BaseName = TEXT("Expr") + BaseName;
+	}
+
+	// 多输出节点（Break Struct 等）用引脚名区分
+	if (SourceNode && SourcePin.Name != TEXT("ReturnValue"))
+	{
+		int32 NumDataOutputs = 0;
+		for (const TPair<FGuid, TSharedPtr<FBlueprintPin>>& PinPair : SourceNode->Pins)
+		{
+			if (PinPair.Value.IsValid() && PinPair.Value->IsOutput() && !PinPair.Value->IsExecution())
+			{
+				++NumDataOutputs;
+			}
+		}
+		const FString PinName = Sanitize(SourcePin.Name);
+		if (NumDataOutputs > 1 && !PinName.IsEmpty())
+		{
+			BaseName += TEXT("_") + PinName;
+		}
+	}
+
+	FString Name = BaseName;
+	for (int32 Suffix = 2; SharedBindingNames.Contains(Name); ++Suffix)
+	{
+		Name = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+	}
+	SharedBindingNames.Add(Name);
+	return Name;
+}
+
+void FMarkdownDataTracer::NoteSharedBindingUse(int32 BindingIndex)
+{
+	if (OpenResolveFrames > 0)
+	{
+		RecordedBindingUses.Add(BindingIndex);
+	}
+	DeclareSharedBinding(BindingIndex);
+}
+
+void FMarkdownDataTracer::DeclareSharedBinding(int32 BindingIndex)
+{
+	if (DeclaredSharedBindings.Contains(BindingIndex))
+	{
+		return;
+	}
+	DeclaredSharedBindings.Add(BindingIndex);
+
+	// 依赖先写出；表达式在之前的作用域解析过时，补登记当时的单独定义图表
+	const FSharedExpressionBinding& Binding = SharedBindings[BindingIndex];
+	for (const int32 Dependency : Binding.Dependencies)
+	{
+		DeclareSharedBinding(Dependency);
+	}
+	if (const TArray<FTraceGraphDefinitionRequest>* GraphRequests = ResolvedPinGraphRequests.Find(Binding.SourceKey))
+	{
+		ReplayGraphRequests(*GraphRequests);
+	}
+	PendingSharedBindings.Add(BindingIndex);
+}
+
 void FMarkdownDataTracer::EndTraceSession()
 {
 	CurrentGraphsToDefineSeparatelyPtr = nullptr;
 	CurrentProcessedSeparateGraphPathsPtr = nullptr;
 	CurrentSettings = nullptr; 
 	UE_LOG(LogDataTracer, Log, TEXT("DataTracer::EndTraceSession: Queue, ProcessedSet, and Settings context pointers cleared."));
+	UE_LOG(LogDataTracer, Log, TEXT("DataTracer::EndTraceSession: ResolvedPinCache %d hits / %d misses (%.1f%% hit rate), %d entries; %d served by session cache (%d entries)."),
+		PinCacheStats.Hits, PinCacheStats.Misses, PinCacheStats.GetHitRate() * 100.f, ResolvedPinCache.Num(),
+		PinCacheStats.SessionHits, FResolvedPinValueCache::Get().Num());
 }
 
 
@@ -23,7 +23,8 @@ public:
     {
         RawMarkdown,
         StyledHTML,
-        CleanText // NEW - for copy functionality
+        CleanText, // NEW - for copy functionality
+        Neutral    // Format-neutral trace IR: spans are recorded by kind and rendered later (see FMarkdownSpanSystem::RenderNeutral)
     };
 
 private:
@@ -42,6 +43,7 @@ public:
     bool IsHTML() const { return OutputFormat == EOutputFormat::StyledHTML; }
     bool IsMarkdown() const { return OutputFormat == EOutputFormat::RawMarkdown; }
     bool IsClean() const { return OutputFormat == EOutputFormat::CleanText; } // NEW
+    bool IsNeutral() const { return OutputFormat == EOutputFormat::Neutral; }
     
     // Comparison operators
     bool operator==(const FMarkdownGenerationContext& Other) const
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Private/Trace/ResolvedPinValueCache.cpp
+
+#include "Trace/ResolvedPinValueCache.h"
+#include "Logging/BP2AILog.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Engine/UserDefinedEnum.h"
+#include "Engine/UserDefinedStruct.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectThreadContext.h"
+
+FResolvedPinValueCache& FResolvedPinValueCache::Get()
+{
+    static FResolvedPinValueCache Instance;
+    return Instance;
+}
+
+FResolvedPinValueCache::~FResolvedPinValueCache()
+{
+    // 静态析构时委托所在的全局对象可能已销毁，只丢弃数据
+    Entries.Empty();
+}
+
+void FResolvedPinValueCache::Initialize()
+{
+    check(IsInGameThread());
+    if (ObjectModifiedHandle.IsValid())
+    {
+        return;
+    }
+
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FResolvedPinValueCache::HandleObjectModified);
+#if WITH_EDITOR
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FResolvedPinValueCache::HandleObjectTransacted);
+#endif
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FResolvedPinValueCache::HandlePostGarbageCollect);
+}
+
+void FResolvedPinValueCache::Shutdown()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+#endif
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+    ObjectModifiedHandle.Reset();
+    ObjectTransactedHandle.Reset();
+    PostGarbageCollectHandle.Reset();
+
+    Reset();
+}
+
+bool FResolvedPinValueCache::Find(const FResolvedPinValueKey& Key, FString& OutValue, TArray<FTraceGraphDefinitionRequest>& OutGraphRequests) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const FEntry* Entry = Entries.Find(Key);
+    if (!Entry)
+    {
+        return false;
+    }
+
+    OutValue = Entry->Value;
+    OutGraphRequests.Append(Entry->GraphRequests);
+    return true;
+}
+
+void FResolvedPinValueCache::Add(const FResolvedPinValueKey& Key, const FString& Value, TArrayView<const FTraceGraphDefinitionRequest> GraphRequests)
+{
+    FWriteScopeLock WriteLock(Lock);
+
+    // 键里的纪元已过期：结果可能基于编辑前的图表，直接丢弃
+    const uint32 CurrentEpoch = GetEditEpoch();
+    if (Key.EditEpoch != CurrentEpoch)
+    {
+        return;
+    }
+    if (EntriesEpoch != CurrentEpoch || Entries.Num() >= MaxEntries)
+    {
+        if (Entries.Num() > 0)
+        {
+            UE_LOG(LogDataTracer, Log, TEXT("ResolvedPinValueCache: Dropping %d entries (%s)."), Entries.Num(),
+                   EntriesEpoch != CurrentEpoch ? TEXT("graphs edited") : TEXT("size limit"));
+        }
+        Entries.Empty();
+        EntriesEpoch = CurrentEpoch;
+    }
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.Value = Value;
+    Entry.GraphRequests.Append(GraphRequests.GetData(), GraphRequests.Num());
+}
+
+void FResolvedPinValueCache::Reset()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Entries.Empty();
+}
+
+int32 FResolvedPinValueCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num();
+}
+
+void FResolvedPinValueCache::HandleObjectModified(UObject* Object)
+{
+    BumpEditEpoch(Object);
+}
+
+void FResolvedPinValueCache::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+    // 撤销/重做直接恢复对象状态，不经过 Modify
+    if (Event.GetEventType() == ETransactionObjectEventType::UndoRedo)
+    {
+        BumpEditEpoch(Object);
+    }
+}
+
+void FResolvedPinValueCache::HandlePostGarbageCollect()
+{
+    FWriteScopeLock WriteLock(Lock);
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().Node.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FResolvedPinValueCache::BumpEditEpoch(const UObject* Object)
+{
+    // 加载期间的修正不改变已缓存节点（那些节点还不存在）
+    if (!Object || FUObjectThreadContext::Get().IsRoutingPostLoad)
+    {
+        return;
+    }
+
+    if (Object->IsA<UEdGraphNode>() || Object->IsA<UEdGraph>() || Object->IsA<UBlueprint>()
+        || Object->IsA<UUserDefinedStruct>() || Object->IsA<UUserDefinedEnum>())
+    {
+        EditEpoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
@@ -19,6 +19,7 @@
 #include "Trace/Utils/SemanticDataHelper.h"
 #include "UObject/UObjectGlobals.h" // For FindObject
 #include "UObject/EnumProperty.h"
+#include "EdGraphSchema_K2.h"
 
 
 
@@ -128,19 +129,19 @@ namespace MarkdownFormattingUtils
     FString FormatOperator(
         TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
-        int32 Depth, TSet<FString>& VisitedPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
+        int32 Depth, TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext)
     {
         check(Node.IsValid() && OutputPin.IsValid() && Tracer);
         UE_LOG(LogFormatter, Error, TEXT("FormatOperator (Utils) RECV: Node=%s (%s). Context: '%s'. CallingNode=%s (%s), OuterMap=%p"),
-           *Node->Name,
+           *Node->GetLogName(),
            *Node->Guid.Left(8),
            *CurrentBlueprintContext,
-           CallingNode.IsValid() ? *CallingNode->Name : TEXT("NULL_NODE_NAME"),
+           CallingNode.IsValid() ? *CallingNode->GetLogName() : TEXT("NULL_NODE_NAME"),
            CallingNode.IsValid() ? *CallingNode->Guid.Left(8) : TEXT("NULL_GUID"),
            OuterNodesMap);
         
@@ -197,10 +198,10 @@ namespace MarkdownFormattingUtils
     FString FormatUnaryOperator(
         TSharedPtr<const FBlueprintNode> Node, TSharedPtr<const FBlueprintPin> OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
-        int32 Depth, TSet<FString>& VisitedPins,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
+        int32 Depth, TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext)
     {
@@ -237,11 +238,11 @@ namespace MarkdownFormattingUtils
     FString FormatConversion(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap, 
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext)
     {
@@ -323,7 +324,7 @@ FString FormatDefaultValue(
 
     // 🔧 NEW: Handle Blueprint variable defaults for struct pins
     const FString* BlueprintVariableDefault = Pin->RawProperties.Find(TEXT("BlueprintVariableDefault"));
-    if (Pin->Category == TEXT("struct") && BlueprintVariableDefault && !BlueprintVariableDefault->IsEmpty()) {
+    if (Pin->PinCategory == UEdGraphSchema_K2::PC_Struct && BlueprintVariableDefault && !BlueprintVariableDefault->IsEmpty()) {
         // Extract struct type name
         FString StructTypeName = TEXT("Struct");
         if (!Pin->SubCategoryObject.IsEmpty()) {
@@ -387,8 +388,8 @@ FString FormatDefaultValue(
     }
 
     // Handle primitive types
-    const FName Category = FName(*Pin->Category);
-    const FName Container = FName(*Pin->ContainerType);
+    const FName Category = Pin->PinCategory;
+    const EPinContainerType Container = Pin->PinContainerType;
 
     if (Category == NAME_Bool) return FMarkdownSpan::LiteralBoolean(TEXT("false"));
     if (Category == NAME_Byte || Category == NAME_Int || Category == NAME_Int64) return FMarkdownSpan::LiteralNumber(TEXT("0"));
@@ -403,11 +404,8 @@ FString FormatDefaultValue(
     }
 
     // Handle container types
-    if (Container == FName(TEXT("Array")) || Container == FName(TEXT("Set")) || Container == FName(TEXT("Map"))) {
-        if (Container == FName(TEXT("Array"))) return FMarkdownSpan::LiteralContainer(TEXT("[]"));
-        if (Container == FName(TEXT("Set"))) return FMarkdownSpan::LiteralContainer(TEXT("{}"));
-        if (Container == FName(TEXT("Map"))) return FMarkdownSpan::LiteralContainer(TEXT("{}"));
-    }
+    if (Container == EPinContainerType::Array) return FMarkdownSpan::LiteralContainer(TEXT("[]"));
+    if (Container == EPinContainerType::Set || Container == EPinContainerType::Map) return FMarkdownSpan::LiteralContainer(TEXT("{}"));
 
     // 🔧 ENHANCED: Handle struct types with proper type name
     if (Category == NAME_Struct) {
@@ -622,7 +620,7 @@ FString MarkdownFormattingUtils::FormatLiteralValue_Legacy(
 {
     check(Pin.IsValid());
     check(Tracer);
-    const FName Category = FName(*Pin->Category);
+    const FName Category = Pin->PinCategory;
     
     FString StructTypeName = (Category == NAME_Struct) ? MarkdownTracerUtils::ExtractSimpleNameFromPath(Pin->SubCategoryObject) : TEXT("");
     if(Category == NAME_Struct && StructTypeName.IsEmpty()) StructTypeName = TEXT("Struct");
@@ -643,20 +641,8 @@ FString MarkdownFormattingUtils::FormatLiteralValue_Legacy(
         }
     }
     
-    // ? --- CORRECTED ENUM DETECTION LOGIC ---
-    bool bIsEnumPin = false;
-    if (!Pin->SubCategoryObject.IsEmpty())
-    {
-        // Use reflection to robustly check if the SubCategoryObject is actually a UEnum.
-        UObject* EnumObject = FindObject<UObject>(nullptr, *Pin->SubCategoryObject);
-        if (EnumObject && EnumObject->IsA(UEnum::StaticClass()))
-        {
-            bIsEnumPin = true;
-        }
-    }
-    
-    if (bIsEnumPin) {
-    // --- END CORRECTION ---
+    // 枚举判断与显示名由工厂在捕获引脚时从 PinType 读取，这里不再查找 UEnum
+    if (Pin->bSubCategoryObjectIsEnum) {
         FString EnumType = MarkdownTracerUtils::ExtractSimpleNameFromPath(Pin->SubCategoryObject);
         if (EnumType.IsEmpty()) EnumType = TEXT("Enum?");
         
@@ -664,9 +650,9 @@ FString MarkdownFormattingUtils::FormatLiteralValue_Legacy(
         if (EnumValueStr.IsEmpty() || EnumValueStr.Equals(TEXT("None"), ESearchCase::IgnoreCase)) {
             EnumValueStr = TEXT("[Default Value]"); 
         }
-        else
+        else if (!Pin->DefaultValueEnumDisplayName.IsEmpty() && EnumValueStr == Pin->DefaultValue.TrimStartAndEnd())
         {
-            EnumValueStr = ConvertEnumInternalToDisplay(EnumValueStr, Pin->SubCategoryObject);
+            EnumValueStr = Pin->DefaultValueEnumDisplayName;
         }
     
         return FMarkdownSpan::EnumType(EnumType) + TEXT("::") + FMarkdownSpan::EnumValue(EnumValueStr);
@@ -998,19 +984,19 @@ FString MarkdownFormattingUtils::ParseStructDefaultValue_Legacy(const FString& V
     FString FormatArgumentsForTrace(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         const TSet<FName>& ExcludePinNames,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext)
     {
         if (Node.IsValid() && Node->NodeType == TEXT("Composite"))
         {
             UE_LOG(LogFormatter, Error, TEXT("FormatArgumentsForTrace (Utils): Entered for COMPOSITE Node '%s' (GUID: %s). Context: '%s'. Symbolic: %d, ShowTrivialGlobal: %s"),
-                *Node->Name, *Node->Guid.Left(8), *CurrentBlueprintContext, bSymbolicTrace, Tracer->bCurrentShowTrivialDefaultParams ? TEXT("true") : TEXT("false"));
+                *Node->GetLogName(), *Node->Guid.Left(8), *CurrentBlueprintContext, bSymbolicTrace, Tracer->bCurrentShowTrivialDefaultParams ? TEXT("true") : TEXT("false"));
             
             TArray<TSharedPtr<FBlueprintPin>> InputPinsForComposite = Node->GetInputPins(TEXT(""), true, true);
             UE_LOG(LogFormatter, Error, TEXT("  FormatArgumentsForTrace (Composite): Node->GetInputPins() found %d pins to iterate for arguments:"), InputPinsForComposite.Num());
@@ -1021,7 +1007,7 @@ FString MarkdownFormattingUtils::ParseStructDefaultValue_Legacy(const FString& V
                     UE_LOG(LogFormatter, Error, TEXT("    Composite Arg Candidate Pin: Name='%s', ID='%s', Direction='%s', Category='%s', TypeSig='%s', FriendlyName=%s"),
                         *CompPin->Name, 
                         *CompPin->Id.Left(8), 
-                        *CompPin->Direction, 
+                        CompPin->GetDirectionString(), 
                         *CompPin->Category,
                         *CompPin->GetTypeSignature(),
                         *CompPin->FriendlyName
@@ -1042,7 +1028,7 @@ FString MarkdownFormattingUtils::ParseStructDefaultValue_Legacy(const FString& V
         FinalExclusions.Append(ExcludePinNames);
 
         UE_LOG(LogFormatter, Log, TEXT("FormatArgumentsForTrace (Utils): Node '%s', Context '%s', Symbolic: %d, ShowTrivialGlobal: %s"), 
-            *Node->Name, *CurrentBlueprintContext, bSymbolicTrace, Tracer->bCurrentShowTrivialDefaultParams ? TEXT("true") : TEXT("false"));
+            *Node->GetLogName(), *CurrentBlueprintContext, bSymbolicTrace, Tracer->bCurrentShowTrivialDefaultParams ? TEXT("true") : TEXT("false"));
 
         for (const TSharedPtr<FBlueprintPin>& Pin : Node->GetInputPins(TEXT(""), true, true)) // Include hidden, exclude exec by default
         {
@@ -1071,7 +1057,7 @@ FString MarkdownFormattingUtils::ParseStructDefaultValue_Legacy(const FString& V
                 if (Tracer->bCurrentShowTrivialDefaultParams || bIsLinked || (bHasExplicitDefault && !bIsPinTrivialDefault))
                 {
                     UE_LOG(LogFormatter, Error, TEXT("    FormatArgumentsForTrace: Tracing arg pin '%s' (Node:'%s'). CtxToPass:'%s', Depth:%d, SymbolicForThisTrace:%d"),
-                                           *Pin->Name, *Node->Name, *CurrentBlueprintContext, Depth, bSymbolicTrace);
+                                           *Pin->Name, *Node->GetLogName(), *CurrentBlueprintContext, Depth, bSymbolicTrace);
 
                     FString PinValue = Tracer->ResolvePinValueRecursive(Pin, CurrentNodesMap, Depth, VisitedPins, CallingNode, OuterNodesMap, bSymbolicTrace, CurrentBlueprintContext);
                         
@@ -1089,7 +1075,7 @@ FString MarkdownFormattingUtils::ParseStructDefaultValue_Legacy(const FString& V
                 else
                 {
                     UE_LOG(LogFormatter, Verbose, TEXT("  FormatArgumentsForTrace (Utils): SKIPPED Pin '%s' on Node '%s'. Context: '%s'. TrivialGlobal=%d, Linked=%d, ExplicitDefault=%d, IsPinTrivial=%d"),
-                        *Pin->Name, *Node->Name, *CurrentBlueprintContext,
+                        *Pin->Name, *Node->GetLogName(), *CurrentBlueprintContext,
                         Tracer->bCurrentShowTrivialDefaultParams, bIsLinked, bHasExplicitDefault, bIsPinTrivialDefault);
                 }
             }
@@ -1202,7 +1188,7 @@ FBlueprintTypeInfo MarkdownFormattingUtils::ExtractTypeInformation(TSharedPtr<co
     TypeInfo.ContainerType = Pin->ContainerType;
     
     // Handle Map value types
-    if (Pin->ContainerType == TEXT("Map") && !Pin->MapValueTerminalCategory.IsEmpty())
+    if (Pin->PinContainerType == EPinContainerType::Map && !Pin->MapValueTerminalCategory.IsEmpty())
     {
         FString ValueCategory = Pin->MapValueTerminalCategory;
         
@@ -1311,54 +1297,19 @@ TArray<FBlueprintIOSpec> MarkdownFormattingUtils::ExtractPinSpecifications(
     });
     
     UE_LOG(LogFormatter, Log, TEXT("ExtractPinSpecifications: Node '%s' %s pins -> %d specifications"),
-        *Node->Name, bInputPins ? TEXT("input") : TEXT("output"), Specifications.Num());
+        *Node->GetLogName(), bInputPins ? TEXT("input") : TEXT("output"), Specifications.Num());
     
     return Specifications;
 }
 
-FString MarkdownFormattingUtils::ConvertEnumInternalToDisplay(const FString& InternalValue, const FString& EnumSubCategoryObject)
+FString MarkdownFormattingUtils::ConvertEnumInternalToDisplay(const FString& InternalValue, const UEnum* EnumClass)
 {
-    // Extract enum class name from SubCategoryObject path
-    FString EnumClassName = MarkdownTracerUtils::ExtractSimpleNameFromPath(EnumSubCategoryObject);
-    if (EnumClassName.IsEmpty())
-    {
-        UE_LOG(LogFormatter, Error, TEXT("ConvertEnumInternalToDisplay: Could not extract enum class name from '%s'"), *EnumSubCategoryObject);
-        return InternalValue; // Fallback to original
-    }
-    
-    // Find the UEnum object using UE's reflection system
-    UEnum* EnumClass = nullptr;
-    
-    // Method 1: Try to find by name directly
-    EnumClass = FindFirstObject<UEnum>(*EnumClassName, EFindFirstObjectOptions::None, ELogVerbosity::NoLogging);
-    
-    // Method 2: If not found, try with package path
-    if (!EnumClass)
-    {
-        // Try to load from the full path
-        FString FullPath = EnumSubCategoryObject;
-        EnumClass = LoadObject<UEnum>(nullptr, *FullPath);
-    }
-    
-    // Method 3: Search through all loaded enums as fallback
-    if (!EnumClass)
-    {
-        for (TObjectIterator<UEnum> EnumIt; EnumIt; ++EnumIt)
-        {
-            UEnum* CurrentEnum = *EnumIt;
-            if (CurrentEnum && CurrentEnum->GetName() == EnumClassName)
-            {
-                EnumClass = CurrentEnum;
-                break;
-            }
-        }
-    }
-    
     if (!EnumClass)
     {
-        UE_LOG(LogFormatter, Error, TEXT("ConvertEnumInternalToDisplay: Could not find UEnum for '%s'"), *EnumClassName);
+        UE_LOG(LogFormatter, Error, TEXT("ConvertEnumInternalToDisplay: No UEnum given for '%s'"), *InternalValue);
         return InternalValue; // Fallback to original
     }
+    const FString EnumClassName = EnumClass->GetName();
     
     // Convert internal name to enum value
     int64 EnumValue = EnumClass->GetValueByName(*InternalValue);
@@ -1374,7 +1325,7 @@ FString MarkdownFormattingUtils::ConvertEnumInternalToDisplay(const FString& Int
     if (!DisplayNameText.IsEmpty())
     {
         FString DisplayName = DisplayNameText.ToString();
-        UE_LOG(LogFormatter, Error, TEXT("ConvertEnumInternalToDisplay: Converted '%s' to DISPLAY NAME '%s' for enum '%s'"), *InternalValue, *DisplayName, *EnumClassName);
+        UE_LOG(LogFormatter, Verbose, TEXT("ConvertEnumInternalToDisplay: Converted '%s' to DISPLAY NAME '%s' for enum '%s'"), *InternalValue, *DisplayName, *EnumClassName);
         return DisplayName;
     }
     
@@ -1389,7 +1340,7 @@ FString MarkdownFormattingUtils::ConvertEnumInternalToDisplay(const FString& Int
             FriendlyName = FriendlyName.RightChop(ColonIndex + 2);
         }
         
-        UE_LOG(LogFormatter, Error, TEXT("ConvertEnumInternalToDisplay: Using FRIENDLY NAME '%s' for '%s'"), *FriendlyName, *InternalValue);
+        UE_LOG(LogFormatter, Verbose, TEXT("ConvertEnumInternalToDisplay: Using FRIENDLY NAME '%s' for '%s'"), *FriendlyName, *InternalValue);
         return FriendlyName;
     }
     
@@ -14,6 +14,8 @@
 class FBlueprintPin;
 class FBlueprintNode;
 class FMarkdownDataTracer;
+class UEnum;
+struct FResolvedPinKey;
 
 /**
  * Helper struct for consistently formatting output strings.
@@ -69,11 +71,11 @@ namespace MarkdownFormattingUtils
         TSharedPtr<const FBlueprintNode> Node,
         TSharedPtr<const FBlueprintPin> OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext);
 
@@ -81,22 +83,22 @@ namespace MarkdownFormattingUtils
         TSharedPtr<const FBlueprintNode> Node,
         TSharedPtr<const FBlueprintPin> OutputPin,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext);
 
     BP2AI_API FString FormatConversion(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace,
         const FString& CurrentBlueprintContext);
 
@@ -134,12 +136,12 @@ namespace MarkdownFormattingUtils
     BP2AI_API FString FormatArgumentsForTrace(
         TSharedPtr<const FBlueprintNode> Node,
         FMarkdownDataTracer* Tracer,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
         int32 Depth,
-        TSet<FString>& VisitedPins,
+        TSet<FResolvedPinKey>& VisitedPins,
         const TSet<FName>& ExcludePinNames,
         TSharedPtr<const FBlueprintNode> CallingNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
         bool bSymbolicTrace = false,
         const FString& CurrentBlueprintContext = TEXT(""));
 
@@ -163,9 +165,10 @@ namespace MarkdownFormattingUtils
         bool bInputPins = true);
 
         
+    // 读取 UEnum，只在捕获引脚时调用（游戏线程）；格式化使用 FBlueprintPin::DefaultValueEnumDisplayName
     BP2AI_API FString ConvertEnumInternalToDisplay(
         const FString& InternalValue, 
-        const FString& EnumSubCategoryObject);
+        const UEnum* EnumClass);
     
     // Test function declaration (can be removed for final product)
     // This was named TestPhase1MarkdownOnly, implies it's a specific test.
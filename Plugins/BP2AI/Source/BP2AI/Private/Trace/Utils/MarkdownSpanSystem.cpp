@@ -14,6 +14,18 @@
 // Define the thread_local variable
 thread_local FMarkdownGenerationContext* g_MarkdownSpanSystem_CurrentContext = nullptr;
 
+// Format-neutral IR encoding (private-use code points, never produced by blueprint text):
+//   SpanOpen KindChar [SpanArg Argument] SpanText Text SpanClose
+// Argument and Text may contain nested spans.
+namespace MarkdownSpanIR
+{
+    constexpr TCHAR SpanOpen  = TCHAR(0xE000);
+    constexpr TCHAR SpanArg   = TCHAR(0xE001);
+    constexpr TCHAR SpanText  = TCHAR(0xE002);
+    constexpr TCHAR SpanClose = TCHAR(0xE003);
+    constexpr TCHAR KindBase  = TCHAR(0xE100);
+}
+
 // Context Management
 const FMarkdownGenerationContext& FMarkdownSpanSystem::GetCurrentContext()
 {
@@ -51,7 +63,7 @@ FString FMarkdownSpanSystem::EscapeHtml(const FString& Text)
 {
     // If text contains our span classes, it's likely already HTML-formatted or structured.
     // Avoid double-escaping. This is a simple check; more robust parsing might be needed for complex cases.
-    if (Text.Contains(TEXT("<span")) || Text.Contains(TEXT("class=\"bp-")))
+    if (Text.Contains(TEXT("<span")) || Text.Contains(TEXT("class=\"bp-")) || HasNeutralSpans(Text))
     {
         return Text; 
     }
@@ -97,6 +109,10 @@ FString FMarkdownSpanSystem::CreateSpanInternal(const FString& CssClass, const F
     // This function is primarily for HTML context.
     // For other contexts, the calling semantic function should handle formatting.
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Custom, Text, CssClass);
+    }
     if (Context.IsHTML() && !CssClass.IsEmpty())
     {
         // Clean the text of Markdown syntax before wrapping in HTML span,
@@ -118,6 +134,10 @@ FString FMarkdownSpanSystem::CreateSpanInternal(const FString& CssClass, const F
 FString FMarkdownSpanSystem::Keyword(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Keyword, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-keyword"), Text);
@@ -133,6 +153,10 @@ FString FMarkdownSpanSystem::Keyword(const FString& Text)
 FString FMarkdownSpanSystem::Variable(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Variable, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-var"), Text);
@@ -157,6 +181,10 @@ FString FMarkdownSpanSystem::Variable(const FString& Text)
 FString FMarkdownSpanSystem::FunctionName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::FunctionName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-func-name"), Text);
@@ -180,6 +208,10 @@ FString FMarkdownSpanSystem::FunctionName(const FString& Text)
 FString FMarkdownSpanSystem::EventName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::EventName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-event-name"), Text);
@@ -195,6 +227,10 @@ FString FMarkdownSpanSystem::EventName(const FString& Text)
 FString FMarkdownSpanSystem::MacroName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::MacroName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-macro-name"), Text);
@@ -218,6 +254,10 @@ FString FMarkdownSpanSystem::MacroName(const FString& Text)
 FString FMarkdownSpanSystem::DataType(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::DataType, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-data-type"), Text);
@@ -241,6 +281,10 @@ FString FMarkdownSpanSystem::DataType(const FString& Text)
 FString FMarkdownSpanSystem::PinName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::PinName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-pin-name"), Text);
@@ -264,6 +308,10 @@ FString FMarkdownSpanSystem::PinName(const FString& Text)
 FString FMarkdownSpanSystem::ParamName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::ParamName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-param-name"), Text);
@@ -287,6 +335,10 @@ FString FMarkdownSpanSystem::ParamName(const FString& Text)
 FString FMarkdownSpanSystem::Operator(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Operator, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-operator"), Text);
@@ -302,6 +354,10 @@ FString FMarkdownSpanSystem::Operator(const FString& Text)
 FString FMarkdownSpanSystem::LiteralString(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralString, Text);
+    }
     if (Context.IsHTML())
     {
         // For HTML, we pass the original Text which might include quotes.
@@ -335,6 +391,10 @@ FString FMarkdownSpanSystem::LiteralString(const FString& Text)
 FString FMarkdownSpanSystem::LiteralNumber(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralNumber, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-number"), Text);
@@ -350,6 +410,10 @@ FString FMarkdownSpanSystem::LiteralNumber(const FString& Text)
 FString FMarkdownSpanSystem::LiteralBoolean(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralBoolean, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-bool"), Text);
@@ -365,6 +429,10 @@ FString FMarkdownSpanSystem::LiteralBoolean(const FString& Text)
 FString FMarkdownSpanSystem::LiteralName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-name"), Text);
@@ -388,6 +456,10 @@ FString FMarkdownSpanSystem::LiteralName(const FString& Text)
 FString FMarkdownSpanSystem::LiteralObject(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralObject, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-object"), Text);
@@ -411,6 +483,10 @@ FString FMarkdownSpanSystem::LiteralObject(const FString& Text)
 FString FMarkdownSpanSystem::LiteralTag(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralTag, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-tag"), Text);
@@ -434,6 +510,10 @@ FString FMarkdownSpanSystem::LiteralTag(const FString& Text)
 FString FMarkdownSpanSystem::LiteralContainer(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralContainer, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-container"), Text);
@@ -449,6 +529,10 @@ FString FMarkdownSpanSystem::LiteralContainer(const FString& Text)
 FString FMarkdownSpanSystem::LiteralStructType(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralStructType, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-struct-type"), Text);
@@ -472,6 +556,10 @@ FString FMarkdownSpanSystem::LiteralStructType(const FString& Text)
 FString FMarkdownSpanSystem::LiteralStructVal(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralStructVal, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-struct-val"), Text);
@@ -487,6 +575,10 @@ FString FMarkdownSpanSystem::LiteralStructVal(const FString& Text)
 FString FMarkdownSpanSystem::LiteralText(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralText, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-text"), Text);
@@ -505,6 +597,10 @@ FString FMarkdownSpanSystem::LiteralText(const FString& Text)
 FString FMarkdownSpanSystem::LiteralUnknown(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::LiteralUnknown, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-literal-unknown"), Text);
@@ -520,6 +616,10 @@ FString FMarkdownSpanSystem::LiteralUnknown(const FString& Text)
 FString FMarkdownSpanSystem::EnumType(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::EnumType, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-enum-type"), Text);
@@ -543,6 +643,10 @@ FString FMarkdownSpanSystem::EnumType(const FString& Text)
 FString FMarkdownSpanSystem::EnumValue(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::EnumValue, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-enum-value"), Text);
@@ -566,6 +670,10 @@ FString FMarkdownSpanSystem::EnumValue(const FString& Text)
 FString FMarkdownSpanSystem::ClassName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::ClassName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-class-name"), Text);
@@ -589,6 +697,10 @@ FString FMarkdownSpanSystem::ClassName(const FString& Text)
 FString FMarkdownSpanSystem::ComponentName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::ComponentName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-component-name"), Text);
@@ -612,6 +724,10 @@ FString FMarkdownSpanSystem::ComponentName(const FString& Text)
 FString FMarkdownSpanSystem::WidgetName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::WidgetName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-widget-name"), Text);
@@ -635,6 +751,10 @@ FString FMarkdownSpanSystem::WidgetName(const FString& Text)
 FString FMarkdownSpanSystem::DelegateName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::DelegateName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-delegate-name"), Text);
@@ -658,6 +778,10 @@ FString FMarkdownSpanSystem::DelegateName(const FString& Text)
 FString FMarkdownSpanSystem::TimelineName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::TimelineName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-timeline-name"), Text);
@@ -681,6 +805,10 @@ FString FMarkdownSpanSystem::TimelineName(const FString& Text)
 FString FMarkdownSpanSystem::Modifier(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Modifier, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-modifier"), Text);
@@ -696,6 +824,10 @@ FString FMarkdownSpanSystem::Modifier(const FString& Text)
 FString FMarkdownSpanSystem::Info(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Info, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-info"), Text);
@@ -711,6 +843,10 @@ FString FMarkdownSpanSystem::Info(const FString& Text)
 FString FMarkdownSpanSystem::Error(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::Error, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-error"), Text);
@@ -730,6 +866,10 @@ FString FMarkdownSpanSystem::Error(const FString& Text)
 FString FMarkdownSpanSystem::GraphName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::GraphName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-graph-name"), Text);
@@ -753,6 +893,10 @@ FString FMarkdownSpanSystem::GraphName(const FString& Text)
 FString FMarkdownSpanSystem::MontageName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::MontageName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-montage-name"), Text);
@@ -776,6 +920,10 @@ FString FMarkdownSpanSystem::MontageName(const FString& Text)
 FString FMarkdownSpanSystem::ActionName(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::ActionName, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-action-name"), Text);
@@ -799,6 +947,10 @@ FString FMarkdownSpanSystem::ActionName(const FString& Text)
 FString FMarkdownSpanSystem::NodeTitle(const FString& Text)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::NodeTitle, Text);
+    }
     if (Context.IsHTML())
     {
         return CreateSpanInternal(TEXT("bp-node-title"), Text);
@@ -813,6 +965,15 @@ FString FMarkdownSpanSystem::NodeTitle(const FString& Text)
 
 // ✅ NEW: Type-aware rendering for enhanced HTML output
 FString FMarkdownSpanSystem::CreateTypeSpan(const FBlueprintTypeInfo& TypeInfo)
+{
+    if (GetCurrentContext().IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::TypeSpan, TypeInfo.DisplayName, TypeInfo.CSSClasses);
+    }
+    return RenderTypeSpan(TypeInfo.CSSClasses, TypeInfo.DisplayName);
+}
+
+FString FMarkdownSpanSystem::RenderTypeSpan(const FString& CssClasses, const FString& DisplayName)
 {
     const FMarkdownGenerationContext& Context = GetCurrentContext();
     
@@ -820,17 +981,287 @@ FString FMarkdownSpanSystem::CreateTypeSpan(const FBlueprintTypeInfo& TypeInfo)
     {
         // HTML output with full CSS styling
         return FString::Printf(TEXT("<span class=\"%s\">%s</span>"), 
-            *TypeInfo.CSSClasses, 
-            *EscapeHtml(TypeInfo.DisplayName));
+            *CssClasses, 
+            *EscapeHtml(DisplayName));
     }
     else if (Context.IsClean())
     {
         // Clean text output
-        return TypeInfo.DisplayName;
+        return DisplayName;
     }
     else
     {
         // Markdown output with backticks
-        return FString::Printf(TEXT("`%s`"), *TypeInfo.DisplayName);
+        return FString::Printf(TEXT("`%s`"), *DisplayName);
+    }
+}
+
+FString FMarkdownSpanSystem::FormatSwitch(const FString& HTMLText, const FString& OtherText)
+{
+    const FMarkdownGenerationContext& Context = GetCurrentContext();
+    if (Context.IsNeutral())
+    {
+        // Identical variants need no switch
+        if (HTMLText.Equals(OtherText, ESearchCase::CaseSensitive))
+        {
+            return OtherText;
+        }
+        return EncodeSpan(EMarkdownSpanKind::FormatSwitch, OtherText, HTMLText);
     }
+    return Context.IsHTML() ? HTMLText : OtherText;
+}
+
+FString FMarkdownSpanSystem::PlainDescription(const FString& Text)
+{
+    if (GetCurrentContext().IsNeutral())
+    {
+        return EncodeSpan(EMarkdownSpanKind::PlainDescription, Text);
+    }
+
+    FString Result = Text.Replace(TEXT("**"), TEXT("")).Replace(TEXT("`"), TEXT(""));
+    Result = Result.TrimStartAndEnd();
+    if (Result.StartsWith(TEXT("* ")))
+    {
+        Result.RightChopInline(2);
+    }
+    return Result;
+}
+
+// ============================================================================
+// Format-neutral trace IR
+// ============================================================================
+
+FString FMarkdownSpanSystem::EncodeSpan(EMarkdownSpanKind Kind, const FString& Text, const FString& Argument)
+{
+    FString Encoded;
+    Encoded.Reserve(Text.Len() + Argument.Len() + 5);
+    Encoded.AppendChar(MarkdownSpanIR::SpanOpen);
+    Encoded.AppendChar(TCHAR(MarkdownSpanIR::KindBase + static_cast<uint8>(Kind)));
+    if (!Argument.IsEmpty())
+    {
+        Encoded.AppendChar(MarkdownSpanIR::SpanArg);
+        Encoded += Argument;
+    }
+    Encoded.AppendChar(MarkdownSpanIR::SpanText);
+    Encoded += Text;
+    Encoded.AppendChar(MarkdownSpanIR::SpanClose);
+    return Encoded;
+}
+
+bool FMarkdownSpanSystem::HasNeutralSpans(const FString& Text)
+{
+    int32 Index = INDEX_NONE;
+    return Text.FindChar(MarkdownSpanIR::SpanOpen, Index);
+}
+
+namespace MarkdownSpanIR
+{
+    typedef FString (*FSpanRenderFunc)(const FString&);
+
+    // Indexed by EMarkdownSpanKind (Keyword .. NodeTitle)
+    static const FSpanRenderFunc SemanticRenderers[] =
+    {
+        nullptr, // Custom
+        &FMarkdownSpanSystem::Keyword,
+        &FMarkdownSpanSystem::Variable,
+        &FMarkdownSpanSystem::FunctionName,
+        &FMarkdownSpanSystem::EventName,
+        &FMarkdownSpanSystem::MacroName,
+        &FMarkdownSpanSystem::DataType,
+        &FMarkdownSpanSystem::PinName,
+        &FMarkdownSpanSystem::ParamName,
+        &FMarkdownSpanSystem::Operator,
+        &FMarkdownSpanSystem::LiteralString,
+        &FMarkdownSpanSystem::LiteralNumber,
+        &FMarkdownSpanSystem::LiteralBoolean,
+        &FMarkdownSpanSystem::LiteralName,
+        &FMarkdownSpanSystem::LiteralObject,
+        &FMarkdownSpanSystem::LiteralTag,
+        &FMarkdownSpanSystem::LiteralContainer,
+        &FMarkdownSpanSystem::LiteralStructType,
+        &FMarkdownSpanSystem::LiteralStructVal,
+        &FMarkdownSpanSystem::LiteralText,
+        &FMarkdownSpanSystem::LiteralUnknown,
+        &FMarkdownSpanSystem::EnumType,
+        &FMarkdownSpanSystem::EnumValue,
+        &FMarkdownSpanSystem::ClassName,
+        &FMarkdownSpanSystem::ComponentName,
+        &FMarkdownSpanSystem::WidgetName,
+        &FMarkdownSpanSystem::DelegateName,
+        &FMarkdownSpanSystem::TimelineName,
+        &FMarkdownSpanSystem::Modifier,
+        &FMarkdownSpanSystem::Info,
+        &FMarkdownSpanSystem::Error,
+        &FMarkdownSpanSystem::GraphName,
+        &FMarkdownSpanSystem::MontageName,
+        &FMarkdownSpanSystem::ActionName,
+        &FMarkdownSpanSystem::NodeTitle,
+    };
+    static_assert(UE_ARRAY_COUNT(SemanticRenderers) == static_cast<int32>(EMarkdownSpanKind::TypeSpan), "SemanticRenderers must cover every semantic span kind");
+}
+
+// Renders one span from the IR. Inner spans are rendered first, exactly as the eager
+// FMarkdownSpan calls would have nested them during a direct trace.
+static FString RenderNeutralSegment(const TCHAR*& Cursor, const TCHAR* End, TCHAR Terminator);
+
+static FString RenderNeutralSpan(const TCHAR*& Cursor, const TCHAR* End)
+{
+    // Cursor is on SpanOpen
+    ++Cursor;
+    if (Cursor >= End)
+    {
+        return FString();
+    }
+    const int32 KindIndex = static_cast<int32>(*Cursor - MarkdownSpanIR::KindBase);
+    ++Cursor;
+
+    FString Argument;
+    if (Cursor < End && *Cursor == MarkdownSpanIR::SpanArg)
+    {
+        ++Cursor;
+        Argument = RenderNeutralSegment(Cursor, End, MarkdownSpanIR::SpanText);
+    }
+    if (Cursor < End && *Cursor == MarkdownSpanIR::SpanText)
+    {
+        ++Cursor;
+    }
+    const FString Text = RenderNeutralSegment(Cursor, End, MarkdownSpanIR::SpanClose);
+    if (Cursor < End && *Cursor == MarkdownSpanIR::SpanClose)
+    {
+        ++Cursor;
+    }
+
+    if (KindIndex < 0 || KindIndex >= static_cast<int32>(EMarkdownSpanKind::Count))
+    {
+        UE_LOG(LogBP2AI, Warning, TEXT("FMarkdownSpanSystem::RenderNeutral - Unknown span kind %d, emitting raw text."), KindIndex);
+        return Text;
+    }
+
+    const EMarkdownSpanKind Kind = static_cast<EMarkdownSpanKind>(KindIndex);
+    switch (Kind)
+    {
+    case EMarkdownSpanKind::Custom:
+        return FMarkdownSpanSystem::CreateSpanInternal(Argument, Text);
+    case EMarkdownSpanKind::TypeSpan:
+        {
+            FBlueprintTypeInfo TypeInfo;
+            TypeInfo.DisplayName = Text;
+            TypeInfo.CSSClasses = Argument;
+            return FMarkdownSpanSystem::CreateTypeSpan(TypeInfo);
+        }
+    case EMarkdownSpanKind::FormatSwitch:
+        return FMarkdownSpanSystem::FormatSwitch(Argument, Text);
+    case EMarkdownSpanKind::PlainDescription:
+        return FMarkdownSpanSystem::PlainDescription(Text);
+    default:
+        return MarkdownSpanIR::SemanticRenderers[KindIndex](Text);
+    }
+}
+
+static FString RenderNeutralSegment(const TCHAR*& Cursor, const TCHAR* End, TCHAR Terminator)
+{
+    FString Result;
+    const TCHAR* RunStart = Cursor;
+    while (Cursor < End && *Cursor != Terminator)
+    {
+        if (*Cursor == MarkdownSpanIR::SpanOpen)
+        {
+            Result.AppendChars(RunStart, UE_PTRDIFF_TO_INT32(Cursor - RunStart));
+            Result += RenderNeutralSpan(Cursor, End);
+            RunStart = Cursor;
+        }
+        else
+        {
+            ++Cursor;
+        }
+    }
+    Result.AppendChars(RunStart, UE_PTRDIFF_TO_INT32(Cursor - RunStart));
+    return Result;
+}
+
+FString FMarkdownSpanSystem::RenderNeutral(const FString& Text, const FMarkdownGenerationContext& TargetContext)
+{
+    check(!TargetContext.IsNeutral());
+    if (!HasNeutralSpans(Text))
+    {
+        return Text;
+    }
+
+    TGuardValue<FMarkdownGenerationContext*> ContextGuard(g_MarkdownSpanSystem_CurrentContext, const_cast<FMarkdownGenerationContext*>(&TargetContext));
+    const TCHAR* Cursor = *Text;
+    const TCHAR* End = Cursor + Text.Len();
+    return RenderNeutralSegment(Cursor, End, TCHAR(0));
+}
+
+static void RenderNeutralArray(TArray<FString>& Lines, const FMarkdownGenerationContext& TargetContext)
+{
+    for (FString& Line : Lines)
+    {
+        Line = FMarkdownSpanSystem::RenderNeutral(Line, TargetContext);
+    }
+}
+
+static void RenderNeutralSteps(TArray<FSemanticExecutionStep>& Steps, const FMarkdownGenerationContext& TargetContext)
+{
+    for (FSemanticExecutionStep& Step : Steps)
+    {
+        Step.NodeName = FMarkdownSpanSystem::RenderNeutral(Step.NodeName, TargetContext);
+        Step.TargetExpression = FMarkdownSpanSystem::RenderNeutral(Step.TargetExpression, TargetContext);
+        Step.LinkAnchor = FMarkdownSpanSystem::RenderNeutral(Step.LinkAnchor, TargetContext);
+        Step.IndentPrefix = FMarkdownSpanSystem::RenderNeutral(Step.IndentPrefix, TargetContext);
+        Step.BranchType = FMarkdownSpanSystem::RenderNeutral(Step.BranchType, TargetContext);
+        for (FSemanticArgument& Arg : Step.Arguments)
+        {
+            Arg.Name = FMarkdownSpanSystem::RenderNeutral(Arg.Name, TargetContext);
+            Arg.ValueRepresentation = FMarkdownSpanSystem::RenderNeutral(Arg.ValueRepresentation, TargetContext);
+            Arg.DataType = FMarkdownSpanSystem::RenderNeutral(Arg.DataType, TargetContext);
+        }
+    }
+}
+
+FTracingResults FMarkdownSpanSystem::RenderTracingResults(const FTracingResults& NeutralResults, const FMarkdownGenerationContext& TargetContext)
+{
+    FTracingResults Rendered = NeutralResults;
+    Rendered.RootBlueprintName = RenderNeutral(NeutralResults.RootBlueprintName, TargetContext);
+
+    for (FTraceEntry& Trace : Rendered.ExecutionTraces)
+    {
+        const bool bTraceIdFromName = HasNeutralSpans(Trace.TraceId);
+        Trace.TraceName = RenderNeutral(Trace.TraceName, TargetContext);
+        Trace.NodeType = RenderNeutral(Trace.NodeType, TargetContext);
+        // TraceId is derived from the formatted name; derive it again from the rendered name
+        Trace.TraceId = bTraceIdFromName ? Trace.TraceName.Replace(TEXT(" "), TEXT("-")).ToLower() : Trace.TraceId;
+        RenderNeutralArray(Trace.ExecutionLines, TargetContext);
+        RenderNeutralSteps(Trace.ExecutionSteps, TargetContext);
+    }
+
+    for (FGraphDefinitionEntry& Definition : Rendered.GraphDefinitions)
+    {
+        Definition.GraphName = RenderNeutral(Definition.GraphName, TargetContext);
+        Definition.Category = RenderNeutral(Definition.Category, TargetContext);
+        Definition.AssetContext = RenderNeutral(Definition.AssetContext, TargetContext);
+        Definition.AnchorId = RenderNeutral(Definition.AnchorId, TargetContext);
+        RenderNeutralArray(Definition.InputSpecs, TargetContext);
+        RenderNeutralArray(Definition.OutputSpecs, TargetContext);
+        RenderNeutralArray(Definition.ExecutionFlow, TargetContext);
+        RenderNeutralSteps(Definition.SemanticExecutionFlow, TargetContext);
+    }
+
+    for (FSectionMetadata& Section : Rendered.SectionHeaders)
+    {
+        Section.SectionName = RenderNeutral(Section.SectionName, TargetContext);
+    }
+
+    RenderNeutralArray(Rendered.CollectedTraceHeaders, TargetContext);
+    RenderNeutralArray(Rendered.CollectedGraphDefinitions, TargetContext);
+    RenderNeutralArray(Rendered.CollectedExecutableGraphs, TargetContext);
+    RenderNeutralArray(Rendered.CollectedPureGraphs, TargetContext);
+
+    Rendered.CollectedGraphDefinitionsWithCategories.Reset();
+    for (const TPair<FString, FString>& Pair : NeutralResults.CollectedGraphDefinitionsWithCategories)
+    {
+        Rendered.CollectedGraphDefinitionsWithCategories.Add(RenderNeutral(Pair.Key, TargetContext), RenderNeutral(Pair.Value, TargetContext));
+    }
+
+    return Rendered;
 }
@@ -11,6 +11,54 @@
 #include "Trace/MarkdownGenerationContext.h" // For FMarkdownGenerationContext
 #include "Trace/Generation/GenerationShared.h"
 
+/**
+ * Span kinds recorded in the format-neutral trace IR (EOutputFormat::Neutral).
+ * Order matches the semantic methods of FMarkdownSpanSystem.
+ */
+enum class EMarkdownSpanKind : uint8
+{
+    Custom,             // FMarkdownSpan::Create(CssClass, Text)
+    Keyword,
+    Variable,
+    FunctionName,
+    EventName,
+    MacroName,
+    DataType,
+    PinName,
+    ParamName,
+    Operator,
+    LiteralString,
+    LiteralNumber,
+    LiteralBoolean,
+    LiteralName,
+    LiteralObject,
+    LiteralTag,
+    LiteralContainer,
+    LiteralStructType,
+    LiteralStructVal,
+    LiteralText,
+    LiteralUnknown,
+    EnumType,
+    EnumValue,
+    ClassName,
+    ComponentName,
+    WidgetName,
+    DelegateName,
+    TimelineName,
+    Modifier,
+    Info,
+    Error,
+    GraphName,
+    MontageName,
+    ActionName,
+    NodeTitle,
+    TypeSpan,           // CreateTypeSpan (argument = CSS classes)
+    FormatSwitch,       // HTML variant (argument) / Markdown + CleanText variant (text)
+    PlainDescription,   // Emphasis and bullet stripped after rendering
+
+    Count
+};
+
 /**
  * Internal system for context-aware semantic text formatting.
  * FMarkdownSpan acts as a public wrapper around this system.
@@ -70,8 +118,23 @@ public:
     // ✅ NEW: Type-aware rendering
     static FString CreateTypeSpan(const FBlueprintTypeInfo& TypeInfo);
 
+    // Format-dependent construction that cannot be expressed as a single span
+    // (links, HTML-only markup). Returns the variant for the current context.
+    static FString FormatSwitch(const FString& HTMLText, const FString& OtherText);
+
+    // Removes Markdown emphasis/code markers and a leading "* " bullet
+    static FString PlainDescription(const FString& Text);
+
+    // ✅ Format-neutral trace IR: trace once, render per output format
+    static bool HasNeutralSpans(const FString& Text);
+    static FString RenderNeutral(const FString& Text, const FMarkdownGenerationContext& TargetContext);
+    static FTracingResults RenderTracingResults(const FTracingResults& NeutralResults, const FMarkdownGenerationContext& TargetContext);
+
     
 private:
+    static FString EncodeSpan(EMarkdownSpanKind Kind, const FString& Text, const FString& Argument = FString());
+    static FString RenderTypeSpan(const FString& CssClasses, const FString& DisplayName);
+
     // Hide constructor, destructor - all static methods
     FMarkdownSpanSystem() = delete;
     ~FMarkdownSpanSystem() = delete;
@@ -159,7 +159,7 @@ bool IsTrivialDefault(TSharedPtr<const FBlueprintPin> Pin)
 
         if (ValStr.IsEmpty() && ObjStr.IsEmpty() && StructMap.IsEmpty()) return true;
 
-        const FName Category = FName(*Pin->Category);
+        const FName Category = Pin->PinCategory;
 
         if (!AutoValStr.IsEmpty() && !ValStr.IsEmpty()) {
             if (ValStr.TrimQuotes().Equals(AutoValStr.TrimQuotes(), ESearchCase::IgnoreCase)) {
@@ -229,8 +229,7 @@ bool IsTrivialDefault(TSharedPtr<const FBlueprintPin> Pin)
             return false;
         }
 
-        const FName Container = FName(*Pin->ContainerType);
-        if (Container == FName(TEXT("Array")) || Container == FName(TEXT("Set")) || Container == FName(TEXT("Map"))) {
+        if (Pin->IsContainer()) {
             return ValStr.IsEmpty() || ValStr == TEXT("()") || ValStr == TEXT("[]") || ValStr == TEXT("{}");
         }
     
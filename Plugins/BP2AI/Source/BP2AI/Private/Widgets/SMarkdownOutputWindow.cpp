@@ -380,9 +380,10 @@ void SBlueprintExecFlowWindow::UpdateFromSelection()
 
     FExecutionFlowGenerator FlowGenerator;
 
-    // 1. Generate Raw Markdown (for text box)
-    FMarkdownGenerationContext MarkdownContext(FMarkdownGenerationContext::EOutputFormat::RawMarkdown);
-    FString RawMarkdownOutput = FlowGenerator.GenerateDocumentForNodes(SelectedEditorNodes, Settings, MarkdownContext);
+    // 1. Trace once, render Raw Markdown (for text box) and the Complete Interactive HTML Document
+    FString RawMarkdownOutput;
+    FString CompleteInteractiveHTML;
+    FlowGenerator.GenerateMarkdownAndHTMLForNodes(SelectedEditorNodes, Settings, RawMarkdownOutput, CompleteInteractiveHTML);
 
     if (OutputTextBox.IsValid())
     {
@@ -390,10 +391,6 @@ void SBlueprintExecFlowWindow::UpdateFromSelection()
     }
     UE_LOG(LogUI, Log, TEXT("SBlueprintExecFlowWindow: Raw Markdown generated (%d chars)"), RawMarkdownOutput.Len());
 
-    // 2. Generate Complete Interactive HTML Document
-    FMarkdownGenerationContext HTMLContext(FMarkdownGenerationContext::EOutputFormat::StyledHTML);
-    FString CompleteInteractiveHTML = FlowGenerator.GenerateDocumentForNodes(SelectedEditorNodes, Settings, HTMLContext);
-
     UE_LOG(LogUI, Display, TEXT("SBlueprintExecFlowWindow: Complete Interactive HTML generated (Length: %d chars)"), CompleteInteractiveHTML.Len());
 
     // Store the complete HTML document (not just body content)
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Commandlets/BP2AIExportCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BP2AIExportCommandlet.generated.h"
+
+/**
+ * 无界面批量导出（构建机使用）
+ *
+ * 用法：
+ *   UnrealEditor-Cmd <Project>.uproject -run=BP2AIExport [-Paths=/Game/A,/Game/B] [-Output=<Dir>]
+ *       [-MaxInFlight=N] [-Full] [-Manifest=<File>] [-NoManifest] [-GcBudgetMB=M] [-GcInterval=N] [-Prefetch=K] [-Shard=i/N]
+ *   UnrealEditor-Cmd <Project>.uproject -run=BP2AIExport -Merge [-Output=<Dir>] [-ShardCount=N]
+ *
+ *   -Paths      导出的包路径（逗号分隔，递归），默认 /Game
+ *   -Output     输出目录，默认 Saved/BP2AI/Exports
+ *   -MaxInFlight 同时在途（已快照、未提交）的蓝图数量上限（0 = 自动，1 = 全部在游戏线程串行执行）；
+ *               不改变工作线程数，追踪/构建任务运行在引擎任务调度器的工作线程上
+ *   -Full       忽略增量清单，全部重新导出
+ *   -Manifest   增量清单路径，默认 <Output>/ExportManifest.json
+ *   -NoManifest 不读取也不写入清单（等同于一次性的全量导出）
+ *   -GcBudgetMB 工作集超过 M MB 时卸载导出加载的包并 GC（0 = 总物理内存的 60%，-1 = 关闭）
+ *   -GcInterval 额外的固定回收间隔：每提交 N 个蓝图回收一次，默认 0（只按内存压力）
+ *   -Prefetch   异步预取的后续资产数量（-1 = 按内存预算自动，0 = 关闭）
+ *   -Shard      只导出第 i 个分片（共 N 个，按包大小均衡），写出部分索引与部分清单到 <Output>/_Shards
+ *   -Merge      合并所有分片的部分索引为 <Output>/Index.json，并把部分清单并入主清单
+ *
+ * 结束时输出一行机器可读的汇总：BP2AI_EXPORT_SUMMARY {json}
+ * 不经过 Slate / ToolMenus / WebBrowser 代码路径。
+ */
+UCLASS()
+class BP2AI_API UBP2AIExportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBP2AIExportCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
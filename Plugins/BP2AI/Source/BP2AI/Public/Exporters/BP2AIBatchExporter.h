@@ -9,9 +9,15 @@
 
 #include "CoreMinimal.h"
 #include "Engine/Blueprint.h"
+#include "Models/BlueprintNode.h"
+#include "Models/BlueprintGraphSnapshot.h"
+#include "Extractors/BlueprintReferencedGraphs.h"
 
 class UEdGraph;
 class UEdGraphNode;
+class FBP2AIDocumentSink;
+class FBlueprintGraphPreloader;
+struct FBP2AIDocumentWriteResult;
 struct FGenerationSettings;
 
 // 阶段2 Task2.2: 增加结构化导出信息（统计 + Markdown）
@@ -93,6 +99,30 @@ struct FCompleteBlueprintData
 
     // 渲染为单个蓝图级 Markdown 文档
     FString ToMarkdown() const;
+
+    // 逐段写入输出接口（写文件时直接流式输出，不生成完整字符串）
+    void WriteMarkdown(FBP2AIDocumentSink& Out) const;
+};
+
+// 流水线：游戏线程捕获的单图表快照（节点标题与引用已解析，之后的追踪/构建不再访问 UEdGraph）
+struct FGraphExportSnapshot
+{
+    bool    bIsValid = false;       // IsGraphValid 结果；无效图表导出为空条目（与旧行为一致）
+    FString GraphName;              // 图表名称
+    FString Category;               // 类别: Event / Function / Macro / Delegate
+    int32   NodeCount = 0;          // 节点数量
+    FString RootBlueprintName;      // 追踪上下文蓝图名
+    FBlueprintGraphSnapshot Nodes;  // 已提取的节点模型（紧凑存储，追踪时再生成兼容视图）
+};
+
+// 流水线：游戏线程捕获的蓝图级快照（元数据已填好，图表待追踪）
+struct FBlueprintExportSnapshot
+{
+    FCompleteBlueprintData Data;    // Graphs 为空，其余字段已在游戏线程导出
+    TArray<FGraphExportSnapshot> Graphs;
+    FBlueprintReferencedGraphMap ReferencedGraphs;  // 宏/折叠图/被调用函数的图表，构建阶段追踪只使用这些
+    FBlueprintInterfaceSignatureMap InterfaceSignatures;  // 被调用接口函数的签名（接口定义段）
+    bool bIncludeNestedFunctions = true;
 };
 
 /**
@@ -117,6 +147,18 @@ public:
     // 蓝图级完整导出（阶段2 Task2.3）：聚合所有图表并返回完整数据
     static FCompleteBlueprintData ExportCompleteBlueprint(UBlueprint* Blueprint, bool bIncludeNestedFunctions = true);
 
+    // 流水线阶段1（游戏线程）：读取 UObject（含被引用的图表），生成不依赖 UEdGraph 的快照
+    static FBlueprintExportSnapshot CaptureBlueprintSnapshot(UBlueprint* Blueprint, bool bIncludeNestedFunctions = true);
+
+    // 流水线阶段2（任意线程）：追踪并构建所有图表，返回完整数据
+    static FCompleteBlueprintData BuildFromSnapshot(const FBlueprintExportSnapshot& Snapshot);
+
+    // 单图表快照（游戏线程）与基于快照的追踪构建
+    // BlueprintSnapshot 非空时追踪只使用其中捕获的引用图表与接口签名（可在任意线程运行）；为空时按需查找 UObject，只能在游戏线程
+    FGraphExportSnapshot CaptureGraphSnapshot(UEdGraph* Graph, const FString& Category) const;
+    FExportedGraphInfo ExportGraphSnapshotDetailed(const FGraphExportSnapshot& Snapshot, bool bIncludeNestedFunctions = true,
+        const FBlueprintExportSnapshot* BlueprintSnapshot = nullptr);
+
     // 阶段3：导出元数据的静态函数
     static FCompleteBlueprintData::FBlueprintMetadata ExportMetadata(UBlueprint* Blueprint);
     static TArray<FCompleteBlueprintData::FComponentInfo> ExportComponents(UBlueprint* Blueprint);
@@ -124,10 +166,28 @@ public:
     static TArray<FCompleteBlueprintData::FFunctionInfo> ExportFunctions(UBlueprint* Blueprint);
     static TArray<FCompleteBlueprintData::FReferenceInfo> ExportReferences(UBlueprint* Blueprint);
 
-    // 写出 Markdown 文档的工具方法（由调用方控制输出路径）
+    // 写出 Markdown 文档的工具方法（由调用方控制输出路径；UTF-8 流式写入临时文件后原子替换）
     static bool WriteCompleteBlueprintMarkdown(const FCompleteBlueprintData& Data, const FString& TargetFilePath, bool bCreateDirectories = true);
 
+    // 同上，返回写出状态与内容哈希；RecordedContentHash 为上次记录的哈希，内容相同时不改动文件
+    static FBP2AIDocumentWriteResult WriteCompleteBlueprintDocument(const FCompleteBlueprintData& Data, const FString& TargetFilePath, uint64 RecordedContentHash = 0);
+
+    // 写出已渲染的文档内容（流水线写出阶段使用）
+    static bool WriteMarkdownFile(const FString& Content, const FString& TargetFilePath, bool bCreateDirectories = true);
+
+    // 默认输出目录（Saved/BP2AI/Exports）与按包路径镜像的输出文件路径
+    static FString GetDefaultExportDir();
+    static FString BuildExportFilePath(const FString& BaseDir, const FString& PackagePath, const FString& BlueprintName);
+
+    // 导出设置哈希（CreateDefaultSettings + 嵌套函数开关），增量导出清单用于判断输出是否过期
+    static uint32 GetExportSettingsHash(bool bIncludeNestedFunctions = true);
+
 private:
+    // 解析节点引用（CapturedRefs）后生成快照并释放节点表
+    static FGraphExportSnapshot BuildGraphSnapshot(UEdGraph* Graph, const FString& Category, TMap<FGuid, TSharedPtr<FBlueprintNode>>& ExtractedNodes);
+    // 从已捕获的图表出发，逐层捕获其引用的图表（游戏线程）；每层缺失的包由 Preloader 批量加载
+    static void CaptureReferencedGraphs(FBlueprintExportSnapshot& Snapshot, TArray<FString> PendingPaths, FBlueprintGraphPreloader& Preloader);
+
     FGenerationSettings CreateDefaultSettings() const;
     bool IsGraphValid(UEdGraph* Graph) const;
     void LogExportResult(const FString& GraphName, const FString& Content) const;
@@ -136,7 +196,4 @@ private:
     int32 CountLines(const FString& Content) const;
     // 统计辅助：扫描 ```blueprint 代码块数量
     int32 CountBlueprintBlocks(const FString& Content) const;
-
-    // 后处理 Markdown：去除冗余块并添加 Target 信息
-    FString PostProcessMarkdown(const FString& Markdown, UEdGraph* Graph) const;
 };
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Exporters/BP2AIDocumentWriter.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+#include "Hash/xxhash.h"
+#include "Templates/Function.h"
+
+class FArchive;
+
+/**
+ * 文档输出接口：文档构建器直接向其追加文本，不需要先拼出完整的 FString
+ */
+class BP2AI_API FBP2AIDocumentSink
+{
+public:
+    virtual ~FBP2AIDocumentSink() = default;
+
+    virtual void Append(FStringView Text) = 0;
+
+    // 单行格式化，短行使用栈上缓冲
+    template <typename FmtType, typename... Types>
+    void Appendf(const FmtType& Fmt, Types... Args)
+    {
+        TStringBuilder<512> Line;
+        Line.Appendf(Fmt, Args...);
+        Append(Line.ToView());
+    }
+
+    // 按行追加，行间插入 '\n'（与 FString::Join(Lines, TEXT("\n")) 的结果一致）
+    void AppendLines(const TArray<FString>& Lines);
+};
+
+// 写入内存字符串（ToMarkdown / 预览窗口等仍需要 FString 的调用方）
+class BP2AI_API FBP2AIStringDocumentSink : public FBP2AIDocumentSink
+{
+public:
+    explicit FBP2AIStringDocumentSink(FString& InOutput) : Output(InOutput) {}
+
+    virtual void Append(FStringView Text) override { Output.Append(Text.GetData(), Text.Len()); }
+
+private:
+    FString& Output;
+};
+
+// 单个文档的写出结果
+enum class EBP2AIDocumentWriteStatus : uint8
+{
+    Written,        // 已写出（新文件或内容变化）
+    Unchanged,      // 与现有文件内容相同，未改动目标文件
+    Failed
+};
+
+struct FBP2AIDocumentWriteResult
+{
+    EBP2AIDocumentWriteStatus Status = EBP2AIDocumentWriteStatus::Failed;
+    uint64 ContentHash = 0;         // UTF-8 内容的 XXH3-64
+    int64 Bytes = 0;
+
+    bool IsSuccess() const { return Status != EBP2AIDocumentWriteStatus::Failed; }
+};
+
+/**
+ * 流式 UTF-8 文件写入器
+ *
+ * 文本经固定大小的缓冲区逐块转换为 UTF-8 并写入临时文件，Commit 时再原子地重命名为目标文件。
+ * 单个文档的额外内存占用与蓝图大小无关；写入失败或未 Commit 时目标文件保持不变。
+ * 写入时同时计算内容哈希；内容与现有文件相同时不替换目标文件（不改变修改时间）。
+ */
+class BP2AI_API FBP2AIDocumentWriter : public FBP2AIDocumentSink
+{
+public:
+    static constexpr int32 BufferSize = 64 * 1024;
+
+    explicit FBP2AIDocumentWriter(const FString& InTargetFilePath);
+    virtual ~FBP2AIDocumentWriter();
+
+    FBP2AIDocumentWriter(const FBP2AIDocumentWriter&) = delete;
+    FBP2AIDocumentWriter& operator=(const FBP2AIDocumentWriter&) = delete;
+
+    // 打开临时文件；失败时返回 false（之后的 Append 被忽略）
+    bool Open(bool bCreateDirectories = true);
+
+    virtual void Append(FStringView Text) override;
+
+    // 刷新缓冲并把临时文件重命名为目标文件
+    bool Commit();
+
+    // 放弃写入并删除临时文件
+    void Abort();
+
+    // 内容与现有文件相同时跳过替换（默认开启）
+    void SetSkipIfUnchanged(bool bInSkipIfUnchanged) { bSkipIfUnchanged = bInSkipIfUnchanged; }
+
+    bool IsOpen() const { return Archive.IsValid(); }
+    bool HasError() const { return bError; }
+    bool WasUnchanged() const { return bUnchanged; }
+    int64 GetBytesWritten() const { return BytesWritten; }
+    uint64 GetContentHash() const { return ContentHash; }
+    const FString& GetTargetFilePath() const { return TargetFilePath; }
+
+    /**
+     * 渲染并写出一个文档。RecordedContentHash 为上次写出时记录的哈希（0 = 未知）：
+     * 已知且目标文件大小一致时先只计算哈希，相同则完全不触碰文件系统。
+     */
+    static FBP2AIDocumentWriteResult WriteDocument(const FString& InTargetFilePath, TFunctionRef<void(FBP2AIDocumentSink&)> Render,
+        uint64 RecordedContentHash = 0, bool bCreateDirectories = true);
+
+    // 只计算渲染结果的 UTF-8 哈希与字节数，不写文件
+    static uint64 HashDocument(TFunctionRef<void(FBP2AIDocumentSink&)> Render, int64& OutBytes);
+
+    // 哈希的文本形式（清单中保存为十六进制字符串）
+    static FString ContentHashToString(uint64 Hash);
+    static uint64 ContentHashFromString(const FString& HashString);
+
+private:
+    FBP2AIDocumentWriter() = default;
+
+    void EncodeChunk(const TCHAR* Chars, int32 NumChars);
+    void FlushBuffer();
+    bool IsExistingFileIdentical() const;
+
+    FString TargetFilePath;
+    FString TempFilePath;
+    TUniquePtr<FArchive> Archive;
+
+    TArray<UTF8CHAR> Buffer;
+    int32 BufferUsed = 0;
+    int64 BytesWritten = 0;
+
+    FXxHash64Builder HashBuilder;
+    uint64 ContentHash = 0;
+    bool bHashOnly = false;
+    bool bSkipIfUnchanged = true;
+    bool bUnchanged = false;
+
+    // 上一次 Append 以高代理项结尾时暂存，与下一次的低代理项一起编码
+    TCHAR PendingHighSurrogate = 0;
+    bool bError = false;
+};
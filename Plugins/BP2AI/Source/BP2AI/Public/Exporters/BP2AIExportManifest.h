@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Exporters/BP2AIExportManifest.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class IAssetRegistry;
+
+// 增量导出：单个蓝图包的导出记录
+struct FBP2AIExportManifestEntry
+{
+    FString PackageHash;        // FAssetPackageData 保存哈希（为空表示未知，总是重新导出）
+    FString DependencyHash;     // 传递硬依赖包（最多 PipelineReferencedGraphMaxDepth 层）的保存哈希组合（依赖变化时使引用方失效）
+    FString ExporterVersion;    // 插件版本 + 输出格式版本
+    uint32  SettingsHash = 0;   // 导出设置哈希（FBP2AIBatchExporter::GetExportSettingsHash）
+    FString OutputPath;         // 上次写出的文件路径
+    uint64  ContentHash = 0;    // 上次写出内容的 XXH3-64（写出队列据此跳过内容相同的文件）
+};
+
+/**
+ * 增量导出清单（Saved/BP2AI/Exports/ExportManifest.json）
+ *
+ * 判断依据全部来自资产注册表，不需要加载资产：
+ *   - 包自身的保存哈希
+ *   - 传递硬依赖包的保存哈希（被直接或间接引用的资产变化时，引用方重新导出）
+ *   - 插件/输出格式版本与导出设置哈希
+ *   - 上次的输出文件仍然存在
+ */
+class BP2AI_API FBP2AIExportManifest
+{
+public:
+    // 输出格式发生变化时递增，使旧清单全部失效
+    static constexpr int32 FormatVersion = 1;
+
+    static FString GetDefaultManifestPath();
+    static FString GetExporterVersion();
+
+    // 读取清单；文件不存在或格式不兼容时返回 false 并保持为空
+    bool Load(const FString& InManifestPath);
+    bool Save() const;
+    bool SaveTo(const FString& InManifestPath) const;
+
+    // 根据资产注册表计算资产当前的记录（OutputPath 留空）
+    static FBP2AIExportManifestEntry BuildCurrentEntry(IAssetRegistry& AssetRegistry, const FAssetData& AssetData, uint32 SettingsHash);
+
+    // 与上次记录一致且输出文件存在时可跳过
+    bool IsUpToDate(FName PackageName, const FBP2AIExportManifestEntry& CurrentEntry) const;
+
+    // 返回需要重新导出的资产及其当前记录（bFullExport 时返回全部资产）
+    TMap<FName, FBP2AIExportManifestEntry> CollectPendingEntries(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Assets, uint32 SettingsHash, bool bFullExport = false) const;
+
+    void UpdateEntry(FName PackageName, const FBP2AIExportManifestEntry& Entry);
+    const FBP2AIExportManifestEntry* FindEntry(FName PackageName) const { return Entries.Find(PackageName); }
+
+    // 合并另一份清单（分片导出的增量记录），同名条目以 Other 为准
+    void Append(const FBP2AIExportManifest& Other);
+
+    int32 Num() const { return Entries.Num(); }
+
+private:
+    FString ManifestPath;
+    TMap<FName, FBP2AIExportManifestEntry> Entries;
+};
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Exporters/BP2AIExportPipeline.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Templates/Function.h"
+
+// 批量导出流水线配置
+struct FBP2AIExportPipelineOptions
+{
+    int32 MaxInFlight = 0;                  // 已快照但尚未写出的蓝图上限（0 = 按工作线程数自动决定）
+    int32 GcMemoryBudgetMB = 0;             // 工作集超过预算时回收并卸载导出加载的包（0 = 总物理内存的 60%，<0 = 关闭）
+    int32 GcInterval = 0;                   // 额外的固定间隔：每提交 N 个蓝图回收一次（0 = 只按内存压力）
+    bool bParallel = true;                  // false: 所有阶段在游戏线程串行执行
+    bool bIncludeNestedFunctions = true;
+    int32 PrefetchWindow = -1;              // 异步预取的后续资产数量（-1 = 按内存预算自动，0 = 关闭）
+    int32 PrefetchMemoryBudgetMB = 0;       // 自动预取的内存预算（0 = 当前可用物理内存的 1/4）
+
+    // 资产过滤（为空则全部导出）
+    TFunction<bool(const FAssetData& AssetData)> ShouldExportAsset;
+    // 输出路径（必须提供）
+    TFunction<FString(const FAssetData& AssetData, const FString& BlueprintName)> ResolveOutputPath;
+    // 进度回调：每个资产开始前调用（游戏线程），返回 false 表示用户取消
+    TFunction<bool(int32 Index, int32 Total, const FAssetData& AssetData)> OnAssetStarted;
+    // 上次写出该资产时记录的内容哈希（游戏线程调用；0 = 未知），内容相同时不改动输出文件
+    TFunction<uint64(const FAssetData& AssetData)> GetRecordedContentHash;
+    // 写出成功（含内容未变）后按资产顺序调用（游戏线程），用于更新增量导出清单
+    TFunction<void(const FAssetData& AssetData, const FString& TargetFilePath, uint64 ContentHash)> OnAssetExported;
+};
+
+// 批量导出结果统计
+struct FBP2AIExportPipelineSummary
+{
+    int32 SuccessCount = 0;
+    int32 FailureCount = 0;
+    int32 SkippedCount = 0;                 // ShouldExportAsset 过滤掉的资产（例如增量导出中未变化的蓝图）
+    int32 TotalAssets = 0;
+    int64 NodeCount = 0;                    // 成功导出的蓝图节点总数（吞吐统计）
+    int32 UnchangedFileCount = 0;           // 成功导出但内容与现有文件相同、未重写的文档（计入 SuccessCount）
+    int32 WriteFailureCount = 0;            // 写出失败的文档（计入 FailureCount）
+    int64 BytesWritten = 0;                 // 实际写出的字节数
+    int32 GcCount = 0;                      // 内存回收次数
+    int32 UnloadedPackageCount = 0;         // 回收时卸载的、仅为导出而加载的包数量
+    uint64 PeakWorkingSetBytes = 0;         // 每次提交后采样的工作集峰值
+    uint64 AverageWorkingSetBytes = 0;      // 每次提交后采样的工作集平均值
+    bool bCancelled = false;
+};
+
+/**
+ * 分阶段文件夹导出流水线
+ *
+ * 阶段划分：
+ *   0. 预取（异步加载器）：为后续 K 个资产发起 LoadPackageAsync，加载完成但未处理的包保持强引用
+ *   1. 加载 + 快照（游戏线程）：GetAsset → FBP2AIBatchExporter::CaptureBlueprintSnapshot，
+ *      把蓝图的图表以及它们引用的宏/折叠图/函数图表读成快照，节点标题与引用在此解析
+ *   2. 追踪 + 构建（工作线程）：BuildFromSnapshot，只读取快照，不查找或加载 UEdGraph
+ *   3. 写出（专用 I/O 线程，有界队列）：WriteMarkdown 流式写入 UTF-8 文件，内容与记录的哈希相同时跳过；
+ *      按入队顺序写出，保证写出顺序与串行导出一致
+ *   4. 提交（游戏线程）：按顺序统计、打印日志、释放 UBlueprint 引用
+ *
+ * 阶段之间的有界队列容量为 MaxInFlight。每次提交后采样工作集，超过 GcMemoryBudgetMB 时
+ * 排空流水线，卸载运行期间仅为导出而加载的包（UPackageTools::UnloadPackages）并执行 GC。
+ */
+class BP2AI_API FBP2AIExportPipeline
+{
+public:
+    explicit FBP2AIExportPipeline(const FBP2AIExportPipelineOptions& InOptions);
+
+    // 必须在游戏线程调用；返回时所有任务均已完成
+    FBP2AIExportPipelineSummary Run(const TArray<FAssetData>& Assets);
+
+private:
+    int32 ResolveMaxInFlight() const;
+    uint64 ResolveGcMemoryBudgetBytes() const;
+
+    FBP2AIExportPipelineOptions Options;
+};
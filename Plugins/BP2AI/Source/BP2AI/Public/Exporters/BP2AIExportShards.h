@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Exporters/BP2AIExportShards.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class IAssetRegistry;
+
+// 分片描述：-Shard=i/N（i 从 0 开始）
+struct FBP2AIExportShard
+{
+    int32 Index = 0;
+    int32 Count = 1;
+
+    bool IsSharded() const { return Count > 1; }
+    FString GetName() const { return FString::Printf(TEXT("%dof%d"), Index, Count); }
+
+    // 解析 "i/N"；格式错误或越界时返回 false
+    static bool Parse(const FString& Value, FBP2AIExportShard& OutShard);
+};
+
+// 项目索引中的一条记录
+struct FBP2AIExportIndexEntry
+{
+    FString PackageName;
+    FString OutputFile;     // 相对于输出目录
+};
+
+/**
+ * 多进程分片导出
+ *
+ * 每个进程导出一个分片并写出部分索引与部分清单（<Output>/_Shards/），
+ * 合并步骤把所有部分索引合成 <Output>/Index.json，并把部分清单并入主清单。
+ */
+class BP2AI_API FBP2AIExportShards
+{
+public:
+    // 按包文件大小做确定性的贪心均衡划分（大包优先，分给当前最轻的分片），返回属于 Shard 的资产（按包名排序）
+    static TArray<FAssetData> SelectShard(IAssetRegistry& AssetRegistry, const TArray<FAssetData>& Assets, const FBP2AIExportShard& Shard);
+
+    static FString GetShardDir(const FString& OutputDir);
+    static FString GetPartialIndexPath(const FString& OutputDir, const FBP2AIExportShard& Shard);
+    static FString GetPartialManifestPath(const FString& OutputDir, const FBP2AIExportShard& Shard);
+    static FString GetProjectIndexPath(const FString& OutputDir);
+
+    static bool WritePartialIndex(const FString& OutputDir, const FBP2AIExportShard& Shard, const TArray<FBP2AIExportIndexEntry>& Entries);
+
+    // 合并 _Shards 下的全部部分索引与部分清单；ExpectedShardCount > 0 时校验分片数量
+    static bool Merge(const FString& OutputDir, const FString& ManifestPath, int32 ExpectedShardCount);
+};
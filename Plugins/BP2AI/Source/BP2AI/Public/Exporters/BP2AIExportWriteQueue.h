@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Exporters/BP2AIExportWriteQueue.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+#include "Tasks/Task.h"
+#include "Templates/Function.h"
+#include "Exporters/BP2AIDocumentWriter.h"
+
+class FRunnableThread;
+class FEvent;
+
+// 写出队列中的一个文档
+struct FBP2AIExportWriteRequest
+{
+    FString TargetFilePath;
+    uint64 RecordedContentHash = 0;                 // 上次写出时记录的内容哈希（0 = 未知）
+    UE::Tasks::FTask Prerequisite;                  // 文档构建任务，完成后才开始写出
+    TFunction<void(FBP2AIDocumentSink&)> Render;
+    TFunction<void(const FBP2AIDocumentWriteResult&)> OnCompleted;     // 在 I/O 线程调用
+};
+
+/**
+ * 专用 I/O 线程上的有界写出队列（write-behind）
+ *
+ * 请求按入队顺序写出；队列满时 Enqueue 阻塞调用方。
+ * 每个文档先与记录的内容哈希比较，内容相同时不改动目标文件。
+ * 析构时写完剩余请求后再退出线程。
+ */
+class BP2AI_API FBP2AIExportWriteQueue : public FRunnable
+{
+public:
+    explicit FBP2AIExportWriteQueue(int32 InCapacity);
+    virtual ~FBP2AIExportWriteQueue();
+
+    FBP2AIExportWriteQueue(const FBP2AIExportWriteQueue&) = delete;
+    FBP2AIExportWriteQueue& operator=(const FBP2AIExportWriteQueue&) = delete;
+
+    // 线程创建失败时返回 false（调用方应改为同步写出）
+    bool IsRunning() const { return Thread != nullptr; }
+
+    void Enqueue(FBP2AIExportWriteRequest&& Request);
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    void Process(FBP2AIExportWriteRequest& Request);
+
+    const int32 Capacity;
+    FCriticalSection Mutex;
+    TArray<FBP2AIExportWriteRequest> Pending;
+    FEvent* WorkEvent = nullptr;
+    FEvent* SpaceEvent = nullptr;
+    std::atomic<bool> bStopping { false };
+    FRunnableThread* Thread = nullptr;
+};
@@ -30,7 +30,7 @@ public:
      * @param bIncludeNestedFunctions Whether to traverse into nested function calls
      * @return Map of node GUIDs to extracted node data
      */
-    TMap<FString, TSharedPtr<FBlueprintNode>> ExtractFromSelectedNodes(
+    TMap<FGuid, TSharedPtr<FBlueprintNode>> ExtractFromSelectedNodes(
         const TArray<UEdGraphNode*>& SelectedNodes,
         bool bIncludeNestedFunctions = false) const;
     
@@ -40,12 +40,12 @@ public:
      * @param OutNodes Map to populate with extracted nodes
      * @return True if extraction was successful (even if no nodes found)
      */
-    bool ExtractNodesFromGraph(const FString& GraphPath, TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const;
+    bool ExtractNodesFromGraph(const FString& GraphPath, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const;
     
 private:
     // Core extraction methods
-    TSharedPtr<FBlueprintNode> ExtractNodeData(UEdGraphNode* GraphNode) const;
-    void ResolveLinks(TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes) const;
+    TArray<TSharedPtr<FBlueprintNode>> ExtractNodeData(const TArray<UEdGraphNode*>& GraphNodes) const;
+    void ResolveLinks(TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes) const;
     void ExpandNestedFunctions(TArray<UEdGraphNode*>& Nodes, TSet<UEdGraph*>& ProcessedGraphs) const;
     
     // Graph resolution helpers
@@ -60,12 +60,12 @@ private:
     UBlueprint* FindOwningBlueprint(UEdGraph* Graph, const FString& GraphPath) const;
     
     // Node processing helpers
-    bool ProcessGraphNodes(UEdGraph* Graph, TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const;
+    bool ProcessGraphNodes(UEdGraph* Graph, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const;
     void ConvertNodesToBlueprints(
         const TArray<UEdGraphNode*>& Nodes, 
         const FString& GraphName,
-        TMap<FString, TSharedPtr<FBlueprintNode>>& OutNodes) const;
-    void FinalizeExtractedNodes(TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes) const;
+        TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes) const;
+    void FinalizeExtractedNodes(TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes) const;
     
     // Utility helpers
     FString ExtractSimpleNameFromPath(const FString& Path) const;
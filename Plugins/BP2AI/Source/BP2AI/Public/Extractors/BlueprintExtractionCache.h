@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Extractors/BlueprintExtractionCache.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/BlueprintGraphSnapshot.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraph;
+class UBlueprint;
+struct FEdGraphEditAction;
+
+/**
+ * 按 UEdGraph 缓存整图提取结果（ExtractNodesFromGraph）
+ *
+ * 函数/宏/折叠图在定义生成、图表发现和内联展开中会被反复提取；
+ * 缓存保存紧凑快照，命中时生成新的兼容视图，调用方可以自由修改返回的节点表。
+ * 图表变更通知（AddOnGraphChangedHandler）以及所属蓝图的 OnChanged/OnCompiled 会使条目失效，
+ * 因此每个图表在每次编辑之后最多转换一次。
+ *
+ * 查找可在任意线程进行；写入需要在游戏线程注册委托，其他线程上的提取结果不进入缓存。
+ */
+class BP2AI_API FBlueprintExtractionCache
+{
+public:
+    static FBlueprintExtractionCache& Get();
+
+    ~FBlueprintExtractionCache();
+
+    // 命中时把缓存的节点模型展开到 OutNodes 并返回 true
+    bool Find(const UEdGraph* Graph, TMap<FGuid, TSharedPtr<FBlueprintNode>>& OutNodes);
+
+    // 保存已解析链接的提取结果并注册失效通知；非游戏线程上直接忽略
+    void Store(UEdGraph* Graph, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes);
+
+    void Invalidate(const UEdGraph* Graph);
+    void InvalidateBlueprint(const UBlueprint* Blueprint);
+
+    // 清空所有条目并注销委托（模块关闭时调用）
+    void Reset();
+
+    int32 Num() const;
+
+private:
+    FBlueprintExtractionCache() = default;
+
+    struct FEntry
+    {
+        TWeakObjectPtr<UEdGraph> Graph;
+        FObjectKey Blueprint;
+        FDelegateHandle GraphChangedHandle;
+        FBlueprintGraphSnapshot Nodes;
+    };
+
+    struct FBlueprintHooks
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        FDelegateHandle ChangedHandle;
+        FDelegateHandle CompiledHandle;
+        int32 NumGraphs = 0;
+    };
+
+    void HandleGraphChanged(const FEdGraphEditAction& Action, FObjectKey GraphKey);
+    void HandleBlueprintChanged(UBlueprint* Blueprint);
+
+    // 以下函数要求调用方已持有 Mutex
+    void RemoveEntryLocked(FObjectKey GraphKey);
+    void ReleaseBlueprintHooksLocked(FObjectKey BlueprintKey);
+
+    mutable FCriticalSection Mutex;
+    TMap<FObjectKey, FEntry> Entries;
+    TMap<FObjectKey, FBlueprintHooks> BlueprintHooks;
+};
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Extractors/BlueprintGraphPathCache.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraph;
+
+/**
+ * 图表路径 → UEdGraph 的会话级缓存（ResolveTargetGraph）
+ *
+ * 同一个函数/宏图表在一次追踪中会按完整路径反复解析，每次 FindObject 都要拆分路径并逐级查找外部对象。
+ * 条目只保存弱引用：图表被回收（包卸载、GC）后条目自动失效，下次查找时移除。
+ * 未找到的路径不缓存，后续加载后仍可命中。
+ *
+ * 可在任意线程查找；写入同样加锁。
+ */
+class BP2AI_API FBlueprintGraphPathCache
+{
+public:
+    static FBlueprintGraphPathCache& Get();
+
+    // 命中且图表仍然存活时返回图表，否则返回 nullptr
+    UEdGraph* Find(const FString& GraphPath);
+
+    void Add(const FString& GraphPath, UEdGraph* Graph);
+
+    void Reset();
+
+    int32 Num() const;
+
+private:
+    FBlueprintGraphPathCache() = default;
+
+    mutable FRWLock Lock;
+    TMap<FString, TWeakObjectPtr<UEdGraph>> Graphs;
+};
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Extractors/BlueprintGraphPreloader.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/BlueprintNode.h"
+
+/**
+ * 追踪前的批量预加载：收集调用/宏节点引用的图表，一次性加载尚未在内存中的包
+ *
+ * 追踪途中遇到未加载的跨蓝图引用时，ResolveTargetGraph 只能逐个同步 LoadPackage + FullyLoad；
+ * 这里先为所有缺失的包发起 LoadPackageAsync，再统一等待。各包的读取与反序列化可以并行，
+ * 但 Load 本身是同步调用，返回时加载已经完成。
+ * 批量导出流水线中被引用的包通常已作为蓝图包的导入随阶段0的预取加载，这里只补齐剩余部分。
+ * 宏/折叠图的路径在加载完成后写入 FBlueprintGraphPathCache。
+ *
+ * 只在游戏线程使用。加载完成的包不额外持有强引用，调用方需保证使用这些图表之前不发生 GC
+ * （编辑器界面在同一帧内完成追踪；批量导出在同一次 CaptureBlueprintSnapshot 内捕获引用图表）。
+ */
+class BP2AI_API FBlueprintGraphPreloader
+{
+public:
+    // 从节点属性收集引用：MacroGraphReference / BoundGraphName（图表路径）、FunctionParentClassPath（蓝图类）
+    void AddReferencesFrom(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes);
+
+    // 批量同步加载：为尚未加载的包发起请求并等待全部完成，再把收集到的图表路径写入路径缓存。
+    // 可多次调用（已处理过的包不再重复请求），返回本次新加载的包数
+    int32 Load();
+
+    int32 NumPackages() const { return Packages.Num(); }
+
+private:
+    void AddPackageOf(const FString& ObjectPath);
+
+    TSet<FString> GraphPaths;
+    TSet<FName> Packages;
+    TSet<FName> IssuedPackages;
+};
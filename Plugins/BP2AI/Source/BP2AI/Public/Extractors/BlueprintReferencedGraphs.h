@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Extractors/BlueprintReferencedGraphs.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FBlueprintGraphSnapshot;
+
+// 图表路径 → 游戏线程捕获的快照；同一图表的不同路径写法共享一份，解析失败的路径值为 nullptr
+using FBlueprintReferencedGraphMap = TMap<FString, TSharedPtr<const FBlueprintGraphSnapshot>>;
+
+// 蓝图接口函数的参数说明（"`名称` (类型)"，已排序），由 BPI 的 UFunction 生成
+struct FBlueprintInterfaceSignature
+{
+    TArray<FString> InputSpecs;
+    TArray<FString> OutputSpecs;
+};
+
+// 接口图表名提示（"接口名.函数名"）→ 签名
+using FBlueprintInterfaceSignatureMap = TMap<FString, FBlueprintInterfaceSignature>;
+
+/**
+ * 追踪期间的引用图表与接口签名来源（当前线程）
+ *
+ * 批量导出在捕获快照时把宏/折叠图/被调用函数的图表与接口签名一并捕获；构建阶段在此作用域内追踪，
+ * FBlueprintDataExtractor::ExtractNodesFromGraph 只从这些快照生成节点表，接口定义只使用捕获的签名，
+ * 不解析或加载 UObject。作用域可以嵌套，析构时恢复外层。
+ */
+class BP2AI_API FBlueprintReferencedGraphScope
+{
+public:
+    FBlueprintReferencedGraphScope(const FBlueprintReferencedGraphMap& InGraphs, const FBlueprintInterfaceSignatureMap& InInterfaceSignatures);
+    ~FBlueprintReferencedGraphScope();
+
+    FBlueprintReferencedGraphScope(const FBlueprintReferencedGraphScope&) = delete;
+    FBlueprintReferencedGraphScope& operator=(const FBlueprintReferencedGraphScope&) = delete;
+
+    // 当前线程的引用图表 / 接口签名；不在作用域内时返回 nullptr
+    static const FBlueprintReferencedGraphMap* GetActive();
+    static const FBlueprintInterfaceSignatureMap* GetActiveInterfaceSignatures();
+
+private:
+    const FBlueprintReferencedGraphMap* PreviousGraphs;
+    const FBlueprintInterfaceSignatureMap* PreviousInterfaceSignatures;
+};
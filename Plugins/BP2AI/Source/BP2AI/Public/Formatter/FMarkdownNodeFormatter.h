@@ -18,6 +18,7 @@
 class FBlueprintNode;
 class FBlueprintPin;
 class FMarkdownDataTracer;
+struct FResolvedPinKey;
 // struct FMarkdownSpan; // Include MarkdownFormattingUtils.h where needed instead
 
 /**
@@ -36,8 +37,8 @@ public:
 			TSharedPtr<const FBlueprintNode> Node,
 			const TOptional<FCapturedEventData>& CapturedData,
 			FMarkdownDataTracer& DataTracer,
-			const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-			TSet<FString>& VisitedDataPins,
+			const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+			TSet<FResolvedPinKey>& VisitedDataPins,
 			bool bGenerateLinkOnly = false,
 			bool bSymbolicTraceForData = false,
 			const FString& CurrentBlueprintContext = TEXT("") 
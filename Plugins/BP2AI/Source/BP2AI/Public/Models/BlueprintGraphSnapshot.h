@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Models/BlueprintGraphSnapshot.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/BlueprintNode.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraphNode;
+
+// 句柄均为快照内数组下标
+using FBPStringId = int32;		// 0 = 空字符串
+using FBPNodeHandle = int32;
+using FBPPinHandle = int32;
+
+/**
+ * 字符串驻留池：相同内容只保存一份（大小写敏感，默认值 "a" 与 "A" 不合并）
+ */
+class BP2AI_API FBlueprintStringPool
+{
+public:
+	FBlueprintStringPool();
+
+	FBPStringId Intern(const FString& Value);
+	const FString& Get(FBPStringId Id) const { return Strings[Id]; }
+	int32 Num() const { return Strings.Num(); }
+
+	// 构建结束后释放查找表，只保留字符串本身
+	void FinishBuilding();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, FBPStringId, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	TArray<FString> Strings;
+	TMap<FString, FBPStringId, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Lookup;
+};
+
+// 连续数组中的一段 [First, First + Num)
+struct FBlueprintSnapshotRange
+{
+	int32 First = 0;
+	int32 Num = 0;
+};
+
+struct FBlueprintSnapshotProperty
+{
+	FBPStringId Key = 0;
+	FBPStringId Value = 0;
+};
+
+struct FBlueprintNodeRecord
+{
+	FBPStringId Guid = 0;
+	FGuid GraphNodeGuid;			// 节点表中的键
+	FBPStringId NodeType = 0;
+	EBlueprintNodeKind NodeKind = EBlueprintNodeKind::Unknown;
+	FBPStringId UEClass = 0;
+	FBPStringId Name = 0;
+	FBPStringId NodeComment = 0;
+	FBPStringId PreservedCompPropName = 0;
+	FBPStringId PreservedDelPropName = 0;
+	FBPStringId TestStringMember = 0;
+	FBPStringId BoundEventOwnerClassPath = 0;
+	FVector2D Position = FVector2D::ZeroVector;
+	TWeakObjectPtr<UEdGraphNode> OriginalEdGraphNode;
+	bool bNameResolved = false;		// 为 false 时兼容视图中的节点仍按需解析标题
+	bool bRefsResolved = false;		// FBlueprintNode::CapturedRefs
+	uint8 UserGraphType = 0;
+	FBPStringId UserGraphPath = 0;
+	FBPStringId UserGraphNameHint = 0;
+	FBPStringId UserFunctionAssetPath = 0;
+
+	FBlueprintSnapshotRange Pins;			// 该节点的引脚在 Pins 数组中连续存放
+	FBlueprintSnapshotRange RawProperties;
+};
+
+struct FBlueprintPinRecord
+{
+	FBPNodeHandle Node = INDEX_NONE;
+	FBPStringId Id = 0;
+	FBPStringId PinId = 0;
+	FBPStringId NodeGuid = 0;
+	FBPStringId Name = 0;
+	FBPStringId FriendlyName = 0;
+	FBPStringId Category = 0;
+	FBPStringId SubCategory = 0;
+	FBPStringId SubCategoryObject = 0;
+	FBPStringId ContainerType = 0;
+	FBPStringId DefaultValue = 0;
+	FBPStringId DefaultObject = 0;
+	FBPStringId MapValueTerminalCategory = 0;
+	FBPStringId MapValueTerminalSubCategoryObjectPath = 0;
+	FBPStringId DefaultValueEnumDisplayName = 0;
+	FName PinName;
+	FGuid GraphPinId;				// 引脚表中的键
+	FGuid GraphNodeGuid;
+	FName PinCategory;
+	FName PinSubCategory;
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
+	EPinContainerType PinContainerType = EPinContainerType::None;
+	bool bHidden = false;
+	bool bAdvancedView = false;
+	bool bIsReference = false;
+	bool bIsConst = false;
+	bool bSubCategoryObjectIsEnum = false;
+	bool bMapValueTerminalIsEnum = false;
+
+	FBlueprintSnapshotRange DefaultStruct;
+	FBlueprintSnapshotRange RawProperties;
+	FBlueprintSnapshotRange LinkedPins;		// 边数组中的目标引脚（已解析，不再保存 LinkTargets）
+	FBlueprintSnapshotRange SourcePinFor;	// 边数组中的来源引脚
+};
+
+/**
+ * 紧凑的图表快照：节点与引脚存放在连续数组中，以 int32 句柄互相引用，字符串驻留
+ *
+ * 与 TMap<FGuid, TSharedPtr<FBlueprintNode>> 相比没有逐节点/逐引脚的堆对象和引用环，
+ * 适合在导出流水线中长时间持有。现有追踪器仍使用共享指针模型，
+ * 迁移期间通过 CreateCompatibilityView 按需生成。
+ */
+class BP2AI_API FBlueprintGraphSnapshot
+{
+public:
+	// 从已解析链接的节点表构建（链接只保留两端都在表内的引脚）
+	// bResolveNames：在此处解析所有节点标题（游戏线程），之后读取快照不再访问 UEdGraph；
+	// 为 false 时只保存已解析的标题
+	static FBlueprintGraphSnapshot Build(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes, bool bResolveNames = true);
+
+	// 兼容视图：重建与原表等价的共享指针模型（节点与引脚顺序不变）
+	TMap<FGuid, TSharedPtr<FBlueprintNode>> CreateCompatibilityView() const;
+
+	// 打断引脚之间的 LinkedPins/SourcePinFor 引用环并清空节点表，使其可以被释放
+	static void ReleaseNodeMap(TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes);
+
+	bool IsEmpty() const { return Nodes.IsEmpty(); }
+	int32 NumNodes() const { return Nodes.Num(); }
+	int32 NumPins() const { return Pins.Num(); }
+
+	FBPNodeHandle FindNode(const FGuid& Guid) const;
+	const FBlueprintNodeRecord& GetNode(FBPNodeHandle Handle) const { return Nodes[Handle]; }
+	const FBlueprintPinRecord& GetPin(FBPPinHandle Handle) const { return Pins[Handle]; }
+	const FString& GetString(FBPStringId Id) const { return StringPool.Get(Id); }
+
+	TConstArrayView<FBlueprintPinRecord> GetNodePins(FBPNodeHandle Handle) const;
+	TConstArrayView<FBPPinHandle> GetLinkedPins(FBPPinHandle Handle) const;
+	TConstArrayView<FBPPinHandle> GetSourcePins(FBPPinHandle Handle) const;
+	TConstArrayView<FBlueprintSnapshotProperty> GetProperties(const FBlueprintSnapshotRange& Range) const;
+
+	// 节点 RawProperties 查找；不存在时返回 nullptr
+	const FString* FindNodeProperty(FBPNodeHandle Handle, const FString& Key) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FBlueprintSnapshotRange AddProperties(const TMap<FString, FString>& Properties);
+
+	FBlueprintStringPool StringPool;
+	TArray<FBlueprintNodeRecord> Nodes;
+	TArray<FBlueprintPinRecord> Pins;
+	TArray<FBlueprintSnapshotProperty> Properties;
+	TArray<FBPPinHandle> Edges;
+	TMap<FGuid, FBPNodeHandle> NodeIndexByGuid;
+	uint32 NodeSetHash = 0;			// 源节点表的 FBlueprintNode::NodeSetHash，兼容视图中的节点沿用
+};
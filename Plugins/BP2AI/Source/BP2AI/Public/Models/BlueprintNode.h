@@ -9,8 +9,25 @@
 
 #include "CoreMinimal.h"
 #include "Models/BlueprintPin.h"
+#include "Models/BlueprintNodeKind.h"
 #include "UObject/WeakObjectPtr.h" // Added include for TWeakObjectPtr
 #include "EdGraph/EdGraphNode.h"   // Added include for UEdGraphNode
+#include <atomic>
+
+/**
+ * 游戏线程上预先解析的节点引用（调用/宏/折叠节点指向的用户图表）
+ *
+ * 解析要查找 UEdGraph / UBlueprint / UFunction；批量导出在捕获快照时写入，
+ * 工作线程追踪时直接读取，不再访问 UObject。
+ */
+struct FBlueprintNodeCapturedRefs
+{
+	bool bResolved = false;
+	uint8 UserGraphType = 0;		// FMarkdownPathTracer::EUserGraphType
+	FString UserGraphPath;
+	FString UserGraphNameHint;
+	FString UserFunctionAssetPath;	// CallFunction：定义该函数的蓝图资产路径；原生函数为空
+};
 
 /**
  * Base class for Blueprint node models
@@ -25,13 +42,18 @@ public:
 
 	/** Core properties */
 	FString Guid;
+	FGuid GraphNodeGuid; // UEdGraphNode::NodeGuid; key in node maps (Guid is its string form, for output)
 	FString NodeType;
+	EBlueprintNodeKind NodeKind = EBlueprintNodeKind::Unknown;	// 与 NodeType 同步，通过 SetNodeType 赋值
 	FString UEClass;
-	FString Name;
 	FVector2D Position;
-	TMap<FString, TSharedPtr<FBlueprintPin>> Pins;
+	TMap<FGuid, TSharedPtr<FBlueprintPin>> Pins;	// Keyed by FBlueprintPin::GraphPinId
 	TMap<FString, FString> RawProperties;
 	FString NodeComment;
+	// 所在提取结果的节点集合标识（排序后的 GUID 哈希，ResolveLinks 写入）。
+	// 集合外的连线在 ResolveLinks 中被丢弃，同一节点在局部选择和整图提取下的解析结果可能不同
+	uint32 NodeSetHash = 0;
+	FBlueprintNodeCapturedRefs CapturedRefs;
 
 	// Store critical bound event properties separately to prevent loss during ResolveLinks
 	FString PreservedCompPropName;
@@ -48,9 +70,24 @@ public:
 	UEdGraphNode* GetEdGraphNode() const { return OriginalEdGraphNode.Get(); }
 	// --- END ADDED GETTER ---
 
+	/** Node title (ENodeTitleType::FullTitle). Resolved from OriginalEdGraphNode on first access and cached;
+	 *  empty if the source node is gone. */
+	const FString& GetName() const;
+	/** For logs: the title if already resolved and non-empty, otherwise NodeType. Never calls into the editor node. */
+	const FString& GetLogName() const;
+	void SetName(const FString& InName);
+
+	/** Sets NodeType and classifies it into NodeKind */
+	void SetNodeType(const FString& InNodeType);
+	bool IsNameResolved() const { return bNameResolved.load(std::memory_order_acquire); }
+
+	/** Serializes reads of editor node state (titles, pin caches) between the game thread and worker threads */
+	static FCriticalSection& GetEdGraphAccessLock();
+
 	/** Common node helper methods */
 	TSharedPtr<FBlueprintPin> GetPin(const FString& InPinName) const;
-	TSharedPtr<FBlueprintPin> GetPin(const FString& InPinName, const FString& Direction) const;
+	TSharedPtr<FBlueprintPin> GetPin(const FString& InPinName, EEdGraphPinDirection Direction) const;
+	TSharedPtr<FBlueprintPin> GetPin(const FString& InPinName, const FString& Direction) const;	// "EGPD_Input" / "EGPD_Output"
 
 	/** Get all pins matching criteria */
 	TArray<TSharedPtr<FBlueprintPin>> GetOutputPins(const FString& Category = TEXT(""), bool bIncludeHidden = false) const;
@@ -59,4 +96,9 @@ public:
 	/** Break reference cycles before destruction */
 	void BreakReferenceCycles();
 	void PreserveCriticalProperties();
+
+private:
+	// GetNodeTitle goes through FText formatting; most titles are never printed
+	mutable FString Name;
+	mutable std::atomic<bool> bNameResolved { false };
 };
\ No newline at end of file
@@ -15,9 +15,54 @@
 #include "UObject/NameTypes.h"     // Include for FName
 
 class UEdGraphNode;
+class UClass;
 
 /**
- * Factory for creating Blueprint node model objects using a handler map.
+ * 两阶段提取的第一阶段产物：在游戏线程上从 UEdGraphPin 原样复制的数据。
+ * 对象引用只保存指针，路径字符串在第二阶段生成。
+ */
+struct FBlueprintPinCapture
+{
+	FGuid PinId;
+	FName PinName;
+	FText FriendlyName;
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
+	FName PinCategory;
+	FName PinSubCategory;
+	const UObject* PinSubCategoryObject = nullptr;
+	FName TerminalCategory;
+	const UObject* TerminalSubCategoryObject = nullptr;
+	EPinContainerType ContainerType = EPinContainerType::None;
+	bool bIsReference = false;
+	bool bIsConst = false;
+	bool bHidden = false;
+	bool bAdvancedView = false;
+	FString DefaultValue;
+	FText DefaultTextValue;
+	FString AutogeneratedDefaultValue;
+	const UObject* DefaultObject = nullptr;
+	bool bSubCategoryObjectIsEnum = false;
+	bool bTerminalIsEnum = false;
+	FString DefaultValueEnumDisplayName;	// 枚举显示名查找需要 UEnum，在捕获阶段完成
+	TArray<FBlueprintPin::FLinkTarget> LinkTargets;
+};
+
+struct FBlueprintNodeCapture
+{
+	// 已创建的节点模型，只含 GUID 与类型专属处理器写入的属性（处理器需要访问 UObject，留在第一阶段）
+	TSharedPtr<FBlueprintNode> Node;
+	const UClass* NodeClass = nullptr;
+	FString Comment;
+	int32 PosX = 0;
+	int32 PosY = 0;
+	FName VariableMemberName;		// VariableGet/VariableSet 的变量名，用于重建结构体默认值
+	bool bIsComposite = false;
+	TArray<FBlueprintPinCapture> Pins;
+};
+
+/**
+ * Factory for creating Blueprint node model objects.
+ * Type-specific handlers are resolved once per concrete UClass and cached.
  */
 class BP2AI_API FBlueprintNodeFactory
 {
@@ -33,6 +78,18 @@ public:
 	 */
 	static TSharedPtr<FBlueprintNode> CreateNode(UEdGraphNode* GraphNode);
 
+	/**
+	 * Two-phase batch creation: captures every node on the calling thread, then builds
+	 * the models and derived strings with ParallelFor. Invalid nodes are skipped.
+	 */
+	static TArray<TSharedPtr<FBlueprintNode>> CreateNodes(TConstArrayView<UEdGraphNode*> GraphNodes);
+
+	/** Phase 1: copy raw UObject data and run the type-specific extractors. Must run where UObjects may be read. */
+	static bool CaptureNode(UEdGraphNode* GraphNode, FBlueprintNodeCapture& OutCapture);
+
+	/** Phase 2: build pins and derived strings from a capture. Only reads names of captured objects; safe on worker threads. */
+	static TSharedPtr<FBlueprintNode> BuildNode(FBlueprintNodeCapture& Capture);
+
 	/**
 	 * Create a node model from a class path string (for testing or serialization).
 	 * NOTE: This creates a basic node; it does not extract detailed properties.
@@ -42,7 +99,7 @@ public:
 	 */
 	static TSharedPtr<FBlueprintNode> CreateNodeFromClassPath(const FString& Guid, const FString& ClassPath);
 
-	/** Ensures the property extractor handlers map is initialized */
+	/** Ensures the property extractor handlers are registered (thread-safe) */
 	static void EnsureExtractorsInitialized();
 
 private:
@@ -53,11 +110,12 @@ private:
 	 */
 	static FString GetNodeTypeName(const FString& ClassPath);
 
-	/** Initializes the handler map (called once internally). */
+	/** Registers every handler (called once internally, from a thread-safe static initializer). */
 	static void InitializeExtractors();
 
-	/** Map of UClass FNames to their specific property extraction handlers */
-	static TMap<FName, FNodePropertyExtractorFunc> PropertyExtractors;
-	/** Flag to ensure one-time initialization of the handler map */
-	static bool bExtractorsInitialized;
+	/**
+	 * Registers a handler for NodeClass. Per node, only the primary handler of the nearest registered
+	 * class in its hierarchy runs; additive handlers run for NodeClass and all of its subclasses.
+	 */
+	static void RegisterExtractor(const UClass* NodeClass, FNodePropertyExtractorFunc Func, bool bAdditive = false);
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Models/BlueprintNodeKind.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 节点种类：FBlueprintNode::NodeType 的枚举形式，提取时计算一次
+ * 数据追踪按种类查跳转表分派处理器，不再在每次解析时按字符串查表。
+ * 只列出有专门处理的类型，其余节点为 Unknown（NodeType 字符串仍然保留）。
+ */
+enum class EBlueprintNodeKind : uint8
+{
+	Unknown = 0,
+
+	// 重路由
+	Knot,
+	NiagaraReroute,
+
+	// 基础
+	VariableGet,
+	VariableSet,
+	Literal,
+	Self,
+	Tunnel,
+	FunctionEntry,
+	FunctionResult,
+	Composite,
+
+	// 运算符
+	PromotableOperator,
+	CommutativeAssociativeBinaryOperator,
+	BooleanNot,
+
+	// 结构体
+	BreakStruct,
+	MakeStruct,
+	SetFieldsInStruct,
+
+	// 函数 / 宏
+	CallFunction,
+	CallParentFunction,
+	MacroInstance,
+
+	// 容器
+	MakeArray,
+	GetArrayItem,
+	CallArrayFunction,
+	MakeMap,
+	MakeSet,
+
+	// 委托 / 流程
+	CreateDelegate,
+	Select,
+
+	// 对象管理
+	SpawnActorFromClass,
+	AddComponent,
+	CreateWidget,
+	DynamicCast,
+	GetClassDefaults,
+	GetSubsystem,
+	GetEngineSubsystem,
+	GetSubsystemFromPC,
+
+	// 延迟 / 时间轴
+	Timeline,
+	Delay,
+	MoveComponentTo,
+	AIMoveTo,
+
+	// 枚举
+	EnumEquality,
+	EnumInequality,
+	CastByteToEnum,
+	EnumLiteral,
+
+	// 文本 / 数据表
+	FormatText,
+	GetDataTableRow,
+
+	// 事件
+	Event,
+	CustomEvent,
+	ComponentBoundEvent,
+	ActorBoundEvent,
+	InputAxisEvent,
+	EnhancedInputAction,
+	InputAction,
+	InputKey,
+
+	Count
+};
+
+namespace BlueprintNodeKind
+{
+	// NodeType 字符串 → 种类（不区分大小写，与 NodeType 的字符串比较一致）；未知类型返回 Unknown
+	BP2AI_API EBlueprintNodeKind FromNodeType(const FString& NodeType);
+}
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
 
 
 /**
@@ -26,7 +28,7 @@ public:
 	FString Name;
 	FName PinName; 
 	FString FriendlyName;
-	FString Direction; // "EGPD_Output" or "EGPD_Input"
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
 	FString Category;  // "exec", "bool", "int", etc.
 	FString SubCategory;
 	FString SubCategoryObject;
@@ -37,10 +39,35 @@ public:
 	FString DefaultObject;
 	TMap<FString, FString> DefaultStruct;
 	TMap<FString, FString> RawProperties;
+
+	/** Typed copies of the pin type, captured once by the factory; use these for comparisons.
+	 *  The string fields above are kept for output and logging. */
+	FName PinCategory;
+	FName PinSubCategory;
+	EPinContainerType PinContainerType = EPinContainerType::None;
+	bool bHidden = false;
+	bool bAdvancedView = false;
+
 	// Solving TerminalCategory and TerminalSubCategoryObject 
 	FString MapValueTerminalCategory;
 	FString MapValueTerminalSubCategoryObjectPath;
+
+	/** Enum info, read from the pin type by the factory on the game thread; formatting never looks the UEnum up by path */
+	bool bSubCategoryObjectIsEnum = false;
+	bool bMapValueTerminalIsEnum = false;
+	FString DefaultValueEnumDisplayName;	// Display name of DefaultValue; empty unless the pin is an enum with a default
 	
+	/** Outgoing link captured by the factory from UEdGraphPin::LinkedTo */
+	struct FLinkTarget
+	{
+		FGuid NodeGuid;
+		FGuid PinId;
+	};
+
+	FGuid GraphPinId;                   // UEdGraphPin::PinId; key in FBlueprintNode::Pins
+	FGuid GraphNodeGuid;                // Owning node's UEdGraphNode::NodeGuid; key in node maps
+	TArray<FLinkTarget> LinkTargets;    // Output pins only; resolved into LinkedPins/SourcePinFor by ResolveLinks
+
 	/** Linked pins - resolved during post-processing */
 	TArray<TSharedPtr<FBlueprintPin>> LinkedPins;
 	TArray<TSharedPtr<FBlueprintPin>> SourcePinFor;
@@ -51,6 +78,10 @@ public:
 	bool IsExecution() const;
 	bool IsHidden() const;
 	bool IsAdvancedView() const;
+	bool IsContainer() const { return PinContainerType != EPinContainerType::None; }
+
+	/** "EGPD_Input" / "EGPD_Output", for logs and output */
+	const TCHAR* GetDirectionString() const;
     
 	/** Get a formatted type signature string */
 	FString GetTypeSignature() const;
@@ -41,9 +41,9 @@ private:
 	TArray<UEdGraphNode*> GetSelectedBlueprintNodes() const;
 
 	// --- MODIFIED: Removed const ---
-	FString GenerateMarkdown(const TMap<FString, TSharedPtr<FBlueprintNode>>& Nodes);
-	FString FormatNode(const TSharedPtr<FBlueprintNode>& Node, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes);
-	FString FormatPin(const TSharedPtr<FBlueprintPin>& Pin, const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes);
+	FString GenerateMarkdown(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes);
+	FString FormatNode(const TSharedPtr<FBlueprintNode>& Node, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes);
+	FString FormatPin(const TSharedPtr<FBlueprintPin>& Pin, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes);
 	// --- END MODIFIED ---
 
 	FReply OnCopyToClipboardClicked();
@@ -69,6 +69,24 @@ namespace BP2AIExportConfig
 	 */
 	constexpr bool bSeparateUserGraphs = true;
 
+	/**
+	 * bp2ai.Trace.MaxDataDepth
+	 * 作用：数据引脚追踪（嵌套表达式）的深度上限，超出部分显示为 [Trace Depth Limit]
+	 * 使用场景：大型数学/结构体网络被截断时调大；同一图表内的上游由显式工作栈解析，调大不会加深调用栈
+	 * 注意：跨图表（宏、折叠图、函数）嵌套另有固定的栈保护上限（48 层解析帧），不受本设置影响，超出时显示为 [Trace Nesting Limit]
+	 * 建议值：15-256
+	 */
+	constexpr int32 DataTraceMaxDepth = 64;
+
+	/**
+	 * bp2ai.Trace.SharedExpressionMinUses
+	 * 作用：一次执行追踪内被引用至少这么多次（>=）的纯节点输出只展开一次，写成 "let 名称 = 表达式"，其余位置引用名称；
+	 * 只计该执行链实际渲染的引用，其他事件上的引用不计入
+	 * 使用场景：同一个计算结果被多个分支/节点使用，重复内联导致输出过长时开启
+	 * 建议值：0（关闭）或 3
+	 */
+	constexpr int32 SharedExpressionMinUses = 0;
+
 	/**
 	 * ========================================
 	 * 日志控制 (Logging Controls)
@@ -90,5 +108,58 @@ namespace BP2AIExportConfig
 	 * 受影响的 Category: LogDataTracer, LogPathTracer, LogFormatter, LogExtractor, LogBlueprintNodeFactory, LogModels
 	 */
 	constexpr bool bSilenceInternalCategoriesDuringBatchExport = true;
+
+	/**
+	 * ========================================
+	 * 批量导出流水线 (Batch Export Pipeline)
+	 * ========================================
+	 */
+
+	/**
+	 * bp2ai.Pipeline.Enabled
+	 * 作用：文件夹导出使用分阶段流水线（游戏线程加载/快照 → 工作线程追踪/构建 → 按序写出）
+	 * 使用场景：大项目批量导出时打开以利用多核；排查线程问题时关闭，所有阶段在游戏线程内串行执行
+	 * 注意：两种模式输出内容逐字节一致
+	 */
+	constexpr bool bParallelFolderExport = true;
+
+	/**
+	 * bp2ai.Pipeline.MaxInFlight
+	 * 作用：同时在流水线中的蓝图数量上限（已快照但尚未写出），即阶段间有界队列的容量
+	 * 使用场景：控制峰值内存；0 表示按工作线程数自动决定
+	 * 建议值：0 或 4-64
+	 */
+	constexpr int32 PipelineMaxInFlight = 0;
+
+	/**
+	 * bp2ai.Pipeline.PrefetchWindow
+	 * 作用：处理当前蓝图时，用 LoadPackageAsync 提前加载后续多少个蓝图包
+	 * 使用场景：磁盘/反序列化是瓶颈时保持 CPU 忙碌；-1 表示按内存预算自动决定，0 关闭预取
+	 * 建议值：-1 或 2-32
+	 */
+	constexpr int32 PipelinePrefetchWindow = -1;
+
+	/**
+	 * bp2ai.Pipeline.PrefetchMemoryBudgetMB
+	 * 作用：自动预取时允许已加载但尚未处理的包占用的内存预算
+	 * 使用场景：内存较小的构建机上限制预取；0 表示使用当前可用物理内存的 1/4
+	 */
+	constexpr int32 PipelinePrefetchMemoryBudgetMB = 0;
+
+	/**
+	 * bp2ai.Pipeline.GcMemoryBudgetMB
+	 * 作用：批量导出时工作集超过该预算才卸载导出加载的包并执行 GC（替代固定每 20 个回收一次）
+	 * 使用场景：小蓝图多时避免无谓的 GC 停顿；大型 Widget 蓝图多时避免内存耗尽
+	 * 0 表示总物理内存的 60%；-1 关闭按内存回收
+	 */
+	constexpr int32 PipelineGcMemoryBudgetMB = 0;
+
+	/**
+	 * bp2ai.Pipeline.ReferencedGraphMaxDepth
+	 * 作用：快照阶段沿宏/折叠图/函数调用逐层捕获被引用图表的层数上限（工作线程追踪只能使用捕获到的图表）
+	 * 使用场景：独立定义的用户图表出现 "Could not extract nodes" 时调大；调小可缩短快照时间、降低内存
+	 * 建议值：8-32
+	 */
+	constexpr int32 PipelineReferencedGraphMaxDepth = 16;
 }
 
@@ -44,8 +44,8 @@ public:
     TArray<FString> TraceExecutionPath(
         TSharedPtr<const FBlueprintNode> StartNode,
         const TOptional<FCapturedEventData>& CapturedData,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
         bool bInShouldTraceSymbolicallyForData,
         bool bInDefineUserGraphsSeparately,
         bool bInExpandCompositesInline,
@@ -55,15 +55,26 @@ public:
     );
 
     // User graph detection
+    // 节点带有捕获阶段解析的 CapturedRefs 时直接返回；否则只能在游戏线程上查找 UObject
     EUserGraphType IsInternalUserGraph(
         TSharedPtr<const FBlueprintNode> Node,
         FString& OutGraphPath,
         FString& OutGraphNameHint
     ) const;
 
+    // 游戏线程：为节点表解析 IsInternalUserGraph 与用户函数归属并写入 CapturedRefs，
+    // 之后这些节点（及其快照）可以在工作线程上追踪
+    static void CaptureNodeReferences(const TMap<FGuid, TSharedPtr<FBlueprintNode>>& Nodes);
+
+    // CallFunction 节点调用的函数由蓝图定义时返回该蓝图资产路径（用于生成定义链接），原生函数返回空
+    static FString ResolveUserFunctionAssetPath(const FBlueprintNode& Node);
+
     // Utility methods
     static FString SanitizeAnchorName(const FString& InputName);
 
+    // 在函数调用步骤行尾追加 " (Target: Class)"（来自提取阶段记录的 CallTargetClass）
+    void SetAnnotateCallTargets(bool bInAnnotateCallTargets) { bAnnotateCallTargets = bInAnnotateCallTargets; }
+
 private:
     // Core references
     FMarkdownDataTracer& DataTracerRef;
@@ -84,14 +95,15 @@ private:
     bool bCurrentTraceDataSymbolically = false;
     bool bCurrentDefineUserGraphsSeparately = false;
     bool bCurrentExpandCompositesInline = false;
+    bool bAnnotateCallTargets = false;
 
     // Core tracing methods
     void TracePathRecursive(
         TSharedPtr<const FBlueprintNode> CurrentNode,
         const TOptional<FCapturedEventData>& CurrentCapturedData,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
-        TSet<FString>& ProcessedInCurrentPath,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
+        TSet<FGuid>& ProcessedInCurrentPath,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -100,7 +112,7 @@ private:
     );
     TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> HandleInitialChecksAndFindExecutable(
         TSharedPtr<const FBlueprintNode> CurrentNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
         int32 CurrentDepth,
         const FString& CurrentIndentPrefix,
         TArray<FString>& OutLines
@@ -108,18 +120,21 @@ private:
 
     bool HandlePathLoop(
         TSharedPtr<const FBlueprintNode> NodeToCheck,
-        TSet<FString>& ProcessedInCurrentPath,
+        TSet<FGuid>& ProcessedInCurrentPath,
         const FString& CurrentIndentPrefix,
         TArray<FString>& OutLines
     );
     
     // Helper methods
     FString GenerateMarkdownLine(const FString& Content, const FString& IndentPrefix) const;
+    // 写出一个步骤行；先写出格式化该步骤时首次引用的共享表达式绑定（let 行，同一缩进）
+    void AddStepLine(TArray<FString>& OutLines, const FString& Content, const FString& IndentPrefix);
+    void AppendCallTargetAnnotation(TSharedPtr<const FBlueprintNode> Node, FString& InOutDescription) const;
     FString CalculateNextPrefix(const FString& CurrentPrefix, bool bIsLastSegment) const;
 
     TTuple<TSharedPtr<const FBlueprintNode>, TSharedPtr<const FBlueprintPin>> _find_next_executable_node(
         TSharedPtr<const FBlueprintNode> FromNode,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
         TArray<FString>& OutLines,
         const FString& SearchIndentPrefix
     );
@@ -132,9 +147,9 @@ private:
         const FString& ActualGraphPath,
         const FString& UniqueGraphNameHint,
         bool bIsInternalGraphCall,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
-        TSet<FString>& ProcessedInCurrentPath,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
+        TSet<FGuid>& ProcessedInCurrentPath,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -147,23 +162,23 @@ private:
     TSharedPtr<const FBlueprintNode> ExecutableNode,
     TSharedPtr<const FBlueprintPin> TargetPinForExecutable,
     const FString& ExecutableGuid,
-    TSet<FString>& InOutProcessedGlobally,
-    TSet<FString>& ProcessedInCurrentPath,
+    TSet<FGuid>& InOutProcessedGlobally,
+    TSet<FGuid>& ProcessedInCurrentPath,
     const FString& CurrentIndentPrefix,
     TArray<FString>& OutLines,
     bool& bWasAlreadyGloballyProcessed,
-    const FString& CurrentGuid,
+    const FGuid& CurrentGuid,
     bool bAddedExecutableToPath,
-    const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes  // ADD THIS LINE
+    const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes  // ADD THIS LINE
 );
 
     void ProcessNodeFormattingAndBranching(
         TSharedPtr<const FBlueprintNode> ExecutableNode,
         const FString& ExecutableGuid,
         const TOptional<FCapturedEventData>& CurrentCapturedData,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
-        TSet<FString>& ProcessedInCurrentPath,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
+        TSet<FGuid>& ProcessedInCurrentPath,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -172,6 +187,11 @@ private:
     );
 
     // Static helper functions (moved to private for organization)
+    static EUserGraphType ResolveInternalUserGraph_Helper(
+        TSharedPtr<const FBlueprintNode> Node,
+        FString& OutGraphPath,
+        FString& OutGraphNameHint);
+
     static EUserGraphType CheckMacroInstanceType_Helper(
         TSharedPtr<const FBlueprintNode> Node,
         const FString& CallingBlueprintName,
@@ -200,8 +220,8 @@ private:
         const FString& DisplayTargetPrefix,
         const FString& FinalLinkTextForDisplay,
         const FString& ArgsStr,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -216,8 +236,8 @@ private:
         const FString& DisplayTargetPrefix,
         const FString& FinalLinkTextForDisplay,
         const FString& ArgsStr,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -232,9 +252,9 @@ private:
         const FString& DisplayTargetPrefix,
         const FString& FinalLinkTextForDisplay,
         const FString& ArgsStr,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
-        TSet<FString>& ProcessedInCurrentPath,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
+        TSet<FGuid>& ProcessedInCurrentPath,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -250,8 +270,8 @@ private:
         const FString& DisplayTargetPrefix,
         const FString& FinalLinkTextForDisplay,
         const FString& ArgsStr,
-        const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-        TSet<FString>& InOutProcessedGlobally,
+        const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+        TSet<FGuid>& InOutProcessedGlobally,
         const FString& CurrentIndentPrefix,
         bool bIsLastSegment,
         TArray<FString>& OutLines,
@@ -266,8 +286,8 @@ private:
        const FString& DisplayTargetPrefix,
        const FString& FinalLinkTextForDisplay,
        const FString& ArgsStr,
-       const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
-       TSet<FString>& InOutProcessedGlobally,
+       const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
+       TSet<FGuid>& InOutProcessedGlobally,
        const FString& CurrentIndentPrefix,
        bool bIsLastSegment,
        TArray<FString>& OutLines,
@@ -14,28 +14,100 @@
 #include "Models/BlueprintNode.h"
 #include "Trace/FMarkdownPathTracer.h" // For FMarkdownPathTracer::EUserGraphType
 #include "Trace/Generation/GenerationShared.h" // For FGenerationSettings
+#include "Trace/ResolvedPinValueCache.h"
 
 // Forward Declarations
 class FMarkdownDataTracer;
 // class FMarkdownPathTracer; // Now included above
 
+/**
+ * ResolvedPinCache / VisitedPins 的键：引脚身份（节点 Guid + 引脚 Id）加上追踪上下文
+ * 取代原先每次调用都拼接的 "NodeGuid_PinId_Ctx..._Sym..." 字符串
+ *
+ * 蓝图上下文在追踪器内驻留为整数 Id（FMarkdownDataTracer::InternBlueprintContext），
+ * 哈希在构造时计算一次，查找与比较都不再触碰字符串。
+ */
+struct FResolvedPinKey
+{
+	FGuid NodeGuid;
+	FGuid PinId;
+	int32 ContextId = 0;			// 0 = 空上下文
+	bool bSymbolic = false;
+	uint32 Hash = 0;
+
+	FResolvedPinKey() = default;
+	FResolvedPinKey(const FBlueprintPin& Pin, int32 InContextId, bool bInSymbolic)
+		: NodeGuid(Pin.GraphNodeGuid)
+		, PinId(Pin.GraphPinId)
+		, ContextId(InContextId)
+		, bSymbolic(bInSymbolic)
+	{
+		Hash = HashCombineFast(GetTypeHash(PinId), GetTypeHash(NodeGuid));
+		Hash = HashCombineFast(Hash, (static_cast<uint32>(ContextId) << 1) | (bSymbolic ? 1u : 0u));
+	}
+
+	bool operator==(const FResolvedPinKey& Other) const
+	{
+		return Hash == Other.Hash && PinId == Other.PinId && NodeGuid == Other.NodeGuid
+			&& ContextId == Other.ContextId && bSymbolic == Other.bSymbolic;
+	}
+
+	friend uint32 GetTypeHash(const FResolvedPinKey& Key)
+	{
+		return Key.Hash;
+	}
+
+	// 仅用于日志
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("%s_%s_Ctx%d_Sym%d"), *NodeGuid.ToString(), *PinId.ToString(), ContextId, bSymbolic);
+	}
+};
+
+// ResolvedPinCache 命中统计（ClearCache 时清零，EndTraceSession 时输出到日志）
+// SessionHits：本地未命中、由跨追踪的 FResolvedPinValueCache 提供的结果，不计入 Hits/Misses
+struct FResolvedPinCacheStats
+{
+	int32 Hits = 0;
+	int32 Misses = 0;
+	int32 SessionHits = 0;
+
+	float GetHitRate() const
+	{
+		const int32 Total = Hits + Misses;
+		return Total > 0 ? static_cast<float>(Hits) / Total : 0.f;
+	}
+};
+
+/**
+ * 数据追踪处理器的公共参数：同一次分派中不变的节点表、访问集合、提取器和调用上下文
+ * 由 TraceSourceNode 构造一次并按引用传给处理器；只引用调用方的对象，不能超出该次调用保存。
+ * 进入其他图表（宏、折叠图、函数）时处理器改用 ResolvePinValueRecursive 的完整参数版本。
+ */
+struct FNodeTraceContext
+{
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap;
+	TSet<FResolvedPinKey>& VisitedPins;
+	const FBlueprintDataExtractor& DataExtractor;
+	const TSharedPtr<const FBlueprintNode>& CallingNode;				// 外层图表中调用当前图表的节点，可为空
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap;		// 外层图表的节点表，可为空
+	bool bSymbolicTrace;
+	const FString& CurrentBlueprintContext;
+};
+
 class BP2AI_API FMarkdownDataTracer
 {
 public:
-	using FNodeTraceHandlerFunc = TFunction<FString(
-		TSharedPtr<const FBlueprintNode> Node,
-		TSharedPtr<const FBlueprintPin> PinToTrace,
+	// 处理器都是无状态的静态函数，按 EBlueprintNodeKind 存放在跳转表中
+	using FNodeTraceHandlerFunc = FString(*)(
+		const TSharedPtr<const FBlueprintNode>& Node,
+		const TSharedPtr<const FBlueprintPin>& PinToTrace,
 		FMarkdownDataTracer* Tracer,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
-		const FBlueprintDataExtractor& DataExtractor,
-		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
-		bool bSymbolicTrace,
-		const FString& CurrentBlueprintContext
-	)>;
+		const FNodeTraceContext& TraceContext
+	);
 
+	// 构造只保存引用；处理器表与运算符/类型转换表是进程级只读注册表，所有实例共享
 	FMarkdownDataTracer(const FBlueprintDataExtractor& InDataExtractor);
 	const FBlueprintDataExtractor& GetDataExtractorRef() const { return DataExtractorRef; }
 	
@@ -44,34 +116,45 @@ public:
 
 	FString TracePinValue(
 		TSharedPtr<const FBlueprintPin> PinToResolve,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
 		bool bSymbolicTrace = false,
 		const FString& CurrentBlueprintContext = TEXT("")
 	);
 
 	void ClearCache();
 
+	// 蓝图上下文字符串 → 缓存键中的整数 Id（比较不区分大小写，与原字符串键一致）
+	int32 InternBlueprintContext(const FString& BlueprintContext);
+	const FResolvedPinCacheStats& GetPinCacheStats() const { return PinCacheStats; }
+
 	FString ResolvePinValueRecursive(
 		TSharedPtr<const FBlueprintPin> PinToResolve,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
+		TSet<FResolvedPinKey>& VisitedPins,
 		TSharedPtr<const FBlueprintNode> CallingNode = nullptr,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap = nullptr,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap = nullptr,
 		bool bSymbolicTrace = false,
 		const FString& CurrentBlueprintContext = TEXT("")
 	);
 
+	// 在处理器所在的图表和调用上下文中继续解析
+	FString ResolvePinValueRecursive(TSharedPtr<const FBlueprintPin> PinToResolve, int32 Depth, const FNodeTraceContext& TraceContext)
+	{
+		return ResolvePinValueRecursive(PinToResolve, TraceContext.CurrentNodesMap, Depth, TraceContext.VisitedPins,
+			TraceContext.CallingNode, TraceContext.OuterNodesMap, TraceContext.bSymbolicTrace, TraceContext.CurrentBlueprintContext);
+	}
+
 	FString TraceTargetPin(
 		TSharedPtr<const FBlueprintPin> TargetPin,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& AllNodes,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
+		TSet<FResolvedPinKey>& VisitedPins,
 		const FString& CurrentBlueprintContext
 	);
 
-	const TMap<FString, FString>& GetMathOperatorMap() const { return MathOperatorMap; }
-	const TMap<FString, FString>& GetTypeConversionMap() const { return TypeConversionMap; }
+	static const TMap<FString, FString>& GetMathOperatorMap();
+	static const TMap<FString, FString>& GetTypeConversionMap();
 
 	const FBlueprintDataExtractor& DataExtractorRef;
 
@@ -89,6 +172,10 @@ public:
 	TSet<FString>* CurrentProcessedSeparateGraphPathsPtr = nullptr;
 	
 	bool bCurrentShowTrivialDefaultParams = false; 
+
+	// 登记需要单独定义的图表（去重后写入 StartTraceSession 传入的队列）；
+	// 同时记录给正在解析的引脚，缓存命中时重放
+	void QueueGraphForSeparateDefinition(const FString& NameHint, const FString& GraphPath, FMarkdownPathTracer::EUserGraphType GraphType);
 	
 	const TMap<FName, FString>* GetCurrentCallsiteArguments() const { return CurrentCallsiteArgumentsPtr; }
 	void SetCurrentCallsiteArguments(const TMap<FName, FString>* InCallsiteArgumentsPtr)
@@ -96,27 +183,124 @@ public:
 		CurrentCallsiteArgumentsPtr = InCallsiteArgumentsPtr;
 	}
 
+	// --- 公共子表达式绑定（FGenerationSettings::SharedExpressionMinUses） ---
+	// 一次执行追踪（TraceExecutionPath）内，被引用至少 SharedExpressionMinUses 次（>=）的纯节点输出只展开一次，
+	// 写成 "let Name = 表达式"，其余位置引用 Name。开始时只扫描从 StartNode 执行链可达的节点及其纯数据上游，
+	// 其他事件链上的引用不计入。
+	void BeginSharedExpressionScope(const FBlueprintNode& StartNode, const TMap<FGuid, TSharedPtr<FBlueprintNode>>& AllNodes);
+	void EndSharedExpressionScope();
+	// 取出自上次调用以来首次被引用的绑定行（依赖在前），应写在引用它们的步骤行之前
+	void TakePendingSharedBindings(TArray<FString>& OutBindingLines);
+	void DiscardPendingSharedBindings();
+	// 为 true 时不做替换（例如 "Previously detailed" 摘要行，后面不会跟绑定行）
+	bool bSuspendSharedExpressions = false;
+
+	// 执行分支的绑定作用域：分支内写出的 let 只在该分支（及其子步骤）可见。
+	// 析构时恢复进入分支前的已声明集合，兄弟分支再引用同一绑定时会在自己的步骤前重新写出 let
+	class FSharedBindingBranchScope
+	{
+	public:
+		explicit FSharedBindingBranchScope(FMarkdownDataTracer& InTracer)
+			: Tracer(InTracer)
+			, SavedDeclaredBindings(InTracer.DeclaredSharedBindings)
+		{
+		}
+		~FSharedBindingBranchScope()
+		{
+			Tracer.PendingSharedBindings.Reset();
+			Tracer.DeclaredSharedBindings = MoveTemp(SavedDeclaredBindings);
+		}
+
+	private:
+		FMarkdownDataTracer& Tracer;
+		TSet<int32> SavedDeclaredBindings;
+	};
+
 	
 	private:
-	const int32 MaxTraceDepth; 
+	// 数据追踪的逻辑深度上限，来自 FGenerationSettings::MaxDataTraceDepth（StartTraceSession 时设置）
+	int32 MaxTraceDepth;
+	// 原生调用栈上同时打开的 ResolvePinValueRecursive 帧上限。同一图表内的上游由 PrimeUpstreamPins
+	// 迭代解析，只有跨图表（宏、折叠图、函数）才会继续嵌套，工作线程的栈比游戏线程小。
+	// 这是栈保护而非逻辑深度，不随 MaxDataTraceDepth 变化；触发时输出 [Trace Nesting Limit]
+	static constexpr int32 MaxOpenResolveFrames = 48;
 	
     const FGenerationSettings* CurrentSettings = nullptr; // Member to store settings
 	
 	const TMap<FName, FString>* CurrentCallsiteArgumentsPtr = nullptr;
 	
-	TMap<FString, FString> ResolvedPinCache; 
-	TMap<FString, FString> MathOperatorMap; 
-	TMap<FString, FString> TypeConversionMap; 
-	TMap<FString, FNodeTraceHandlerFunc> NodeHandlers; 
+	TMap<FResolvedPinKey, FString> ResolvedPinCache; 
+	// 解析时登记过图表定义的条目（少数，主要是宏），本地命中时同样重放
+	TMap<FResolvedPinKey, TArray<FTraceGraphDefinitionRequest>> ResolvedPinGraphRequests;
+	FResolvedPinCacheStats PinCacheStats;
+	// 尚未返回的 ResolvePinValueRecursive 帧登记的图表定义；所有帧返回后清空
+	TArray<FTraceGraphDefinitionRequest> RecordedGraphRequests;
+	int32 OpenResolveFrames = 0;
+	// 追踪器生命周期内只增不删：正在进行的 VisitedPins 集合可能仍持有旧 Id
+	TMap<FString, int32> BlueprintContextIds;
+
+	void ReplayGraphRequests(TArrayView<const FTraceGraphDefinitionRequest> GraphRequests);
+
+	struct FSharedExpressionBinding
+	{
+		FResolvedPinKey SourceKey;		// 共享输出引脚的缓存键
+		FString Name;
+		FString Expression;
+		TArray<int32> Dependencies;		// 表达式中引用的其他绑定
+	};
+
+	// 替换只在扫描过的图表顶层进行：宏/折叠图内部和带调用点的解析照常内联
+	bool AreSharedExpressionsActive() const { return SharedExpressionNodesMap && !bSuspendSharedExpressions; }
+	// 缓存键中的上下文 Id；替换生效时的结果含有绑定名，用单独的位与普通结果区分
+	int32 GetPinKeyContextId(const FString& BlueprintContext);
+	static constexpr int32 SharedExpressionContextFlag = 1 << 30;
+
+	FString ResolveSharedExpression(
+		const TSharedPtr<const FBlueprintPin>& SourcePin,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+		int32 Depth,
+		TSet<FResolvedPinKey>& VisitedPins,
+		bool bSymbolicTrace,
+		const FString& CurrentBlueprintContext
+	);
+	FString MakeSharedBindingName(const FBlueprintPin& SourcePin, const FBlueprintNode* SourceNode);
+	// 记录一次引用：正在解析的帧记下它（缓存命中时重放），尚未写出的绑定连同依赖进入待写列表
+	void NoteSharedBindingUse(int32 BindingIndex);
+	void DeclareSharedBinding(int32 BindingIndex);
+
+	const TMap<FGuid, TSharedPtr<FBlueprintNode>>* SharedExpressionNodesMap = nullptr;
+	TSet<const FBlueprintPin*> SharedExpressionSources;
+	// 绑定名和表达式在追踪器生命周期内复用（ClearCache 时清空），每个表达式只解析一次
+	TArray<FSharedExpressionBinding> SharedBindings;
+	TMap<FResolvedPinKey, int32> SharedBindingIndices;
+	TSet<FString> SharedBindingNames;
+	TArray<int32> PendingSharedBindings;
+	TSet<int32> DeclaredSharedBindings;		// 当前分支及其祖先步骤已写出或待写的绑定（见 FSharedBindingBranchScope）
+	// 与 RecordedGraphRequests / ResolvedPinGraphRequests 相同：帧内记录、按键保存、命中时重放
+	TArray<int32> RecordedBindingUses;
+	TMap<FResolvedPinKey, TArray<int32>> ResolvedPinBindingUses;
+
+	// 用显式工作栈按后序预先解析 SourceNode 在同一图表内的上游输入引脚，结果写入 ResolvedPinCache，
+	// 随后处理器的递归调用直接命中缓存，原生栈深度不再随表达式深度增长。SourceDepth 为随后 TraceSourceNode 的深度
+	void PrimeUpstreamPins(
+		const FBlueprintNode& SourceNode,
+		int32 SourceDepth,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+		TSet<FResolvedPinKey>& VisitedPins,
+		const TSharedPtr<const FBlueprintNode>& CallingNode,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+		bool bSymbolicTrace,
+		const FString& CurrentBlueprintContext
+	);
 
 	FString TraceSourceNode(
 		TSharedPtr<const FBlueprintNode> SourceNode,
 		TSharedPtr<const FBlueprintPin> SourcePin,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>& CurrentNodesMap,
 		int32 Depth,
-		TSet<FString>& VisitedPins,
+		TSet<FResolvedPinKey>& VisitedPins,
 		TSharedPtr<const FBlueprintNode> CallingNode,
-		const TMap<FString, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
+		const TMap<FGuid, TSharedPtr<FBlueprintNode>>* OuterNodesMap,
 		bool bSymbolicTrace,
 		const FString& CurrentBlueprintContext
 	);
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 A-Maze Games
+ * Website: www.a-maze.games
+ * All rights reserved.
+ */
+// Source/BP2AI/Public/Trace/ResolvedPinValueCache.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Trace/FMarkdownPathTracer.h" // For FMarkdownPathTracer::EUserGraphType
+#include <atomic>
+
+class UEdGraphNode;
+class UObject;
+struct FTransactionObjectEvent;
+
+// 追踪途中登记的"需要单独定义的图表"（提示名, 完整路径, 类型），与 StartTraceSession 的队列元素一致
+using FTraceGraphDefinitionRequest = TTuple<FString, FString, FMarkdownPathTracer::EUserGraphType>;
+
+/**
+ * FResolvedPinValueCache 的键
+ *
+ * 节点用 UEdGraphNode 的弱引用（对象索引 + 序列号）标识：复制出来的蓝图节点 Guid 相同，
+ * 重新加载后的节点是新对象，都不会误命中。比较与哈希都不解析弱引用。
+ * 影响结果的追踪设置（符号模式、显示平凡默认参数、输出格式、深度上限）和编辑纪元一并进入键。
+ * 节点所在提取结果的节点集合也进入键：编辑器追踪只提取选中的节点，集合外的连线被丢弃，
+ * 同一引脚在局部选择下得到的默认值/未连接结果不能提供给整图追踪（反之亦然）。
+ */
+struct FResolvedPinValueKey
+{
+    TWeakObjectPtr<UEdGraphNode> Node;
+    FGuid PinId;
+    FString BlueprintContext;       // 比较不区分大小写，与 FMarkdownDataTracer::InternBlueprintContext 一致
+    uint32 NodeSetHash = 0;         // FBlueprintNode::NodeSetHash
+    uint32 EditEpoch = 0;
+    int32 MaxDepth = 0;             // FGenerationSettings::MaxDataTraceDepth
+    uint8 Flags = 0;
+    uint32 Hash = 0;
+
+    FResolvedPinValueKey() = default;
+    FResolvedPinValueKey(const TWeakObjectPtr<UEdGraphNode>& InNode, const FGuid& InPinId, const FString& InBlueprintContext, uint32 InNodeSetHash,
+                         uint32 InEditEpoch, bool bSymbolic, bool bShowTrivialDefaultParams, uint8 OutputFormat, int32 InMaxDepth)
+        : Node(InNode)
+        , PinId(InPinId)
+        , BlueprintContext(InBlueprintContext)
+        , NodeSetHash(InNodeSetHash)
+        , EditEpoch(InEditEpoch)
+        , MaxDepth(InMaxDepth)
+        , Flags(static_cast<uint8>((OutputFormat << 2) | (bShowTrivialDefaultParams ? 2 : 0) | (bSymbolic ? 1 : 0)))
+    {
+        Hash = HashCombineFast(GetTypeHash(PinId), GetTypeHash(Node));
+        Hash = HashCombineFast(Hash, GetTypeHash(BlueprintContext));
+        Hash = HashCombineFast(Hash, NodeSetHash);
+        Hash = HashCombineFast(Hash, (EditEpoch << 8) | Flags);
+        Hash = HashCombineFast(Hash, GetTypeHash(MaxDepth));
+    }
+
+    bool operator==(const FResolvedPinValueKey& Other) const
+    {
+        return Hash == Other.Hash && PinId == Other.PinId && Node.HasSameIndexAndSerialNumber(Other.Node)
+            && NodeSetHash == Other.NodeSetHash && EditEpoch == Other.EditEpoch && MaxDepth == Other.MaxDepth
+            && Flags == Other.Flags && BlueprintContext == Other.BlueprintContext;
+    }
+
+    friend uint32 GetTypeHash(const FResolvedPinValueKey& Key)
+    {
+        return Key.Hash;
+    }
+};
+
+/**
+ * 跨追踪的引脚值缓存（ResolvePinValueRecursive）
+ *
+ * 每次 PerformTracing 都会新建追踪器并清空 ResolvedPinCache，同一个纯节点的输出在一次批量导出
+ * （或同一编辑器会话的多次选择刷新）中会被重复解析。这里按引脚身份 + 编辑纪元保存结果，
+ * 生命周期与模块相同，覆盖整个批量导出和编辑器会话。
+ *
+ * 失效：任何图表、节点、蓝图或用户定义结构体/枚举被修改（Modify / 撤销重做）都会推进编辑纪元，
+ * 旧纪元的键不再匹配，下一次写入时整体丢弃。使用单一纪元而不是逐图表版本号，
+ * 因为函数/宏调用的追踪结果同样依赖被调用图表的内容。GC 之后移除节点已回收的条目。
+ *
+ * 条目同时记录解析期间登记的单独定义图表，命中时由追踪器重新登记，保证定义队列与未命中时一致。
+ *
+ * 查找与写入可在任意线程进行；委托在游戏线程注册（模块启动时）。
+ */
+class BP2AI_API FResolvedPinValueCache
+{
+public:
+    static FResolvedPinValueCache& Get();
+
+    ~FResolvedPinValueCache();
+
+    // 注册编辑/GC 通知；Shutdown 注销并清空（模块启动/关闭时调用）
+    void Initialize();
+    void Shutdown();
+
+    uint32 GetEditEpoch() const { return EditEpoch.load(std::memory_order_acquire); }
+
+    // 命中时返回 true，并把登记的图表定义追加到 OutGraphRequests
+    bool Find(const FResolvedPinValueKey& Key, FString& OutValue, TArray<FTraceGraphDefinitionRequest>& OutGraphRequests) const;
+
+    void Add(const FResolvedPinValueKey& Key, const FString& Value, TArrayView<const FTraceGraphDefinitionRequest> GraphRequests);
+
+    void Reset();
+
+    int32 Num() const;
+
+private:
+    FResolvedPinValueCache() = default;
+
+    struct FEntry
+    {
+        FString Value;
+        TArray<FTraceGraphDefinitionRequest> GraphRequests;
+    };
+
+    void HandleObjectModified(UObject* Object);
+    void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+    void HandlePostGarbageCollect();
+    void BumpEditEpoch(const UObject* Object);
+
+    // 超过上限时整体丢弃，避免长时间的编辑器会话无限增长
+    static constexpr int32 MaxEntries = 1 << 17;
+
+    mutable FRWLock Lock;
+    TMap<FResolvedPinValueKey, FEntry> Entries;
+    uint32 EntriesEpoch = 0;
+    std::atomic<uint32> EditEpoch{ 1 };
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle ObjectTransactedHandle;
+    FDelegateHandle PostGarbageCollectHandle;
+};